@@ -1,11 +1,14 @@
 // File: Aircraft.cpp - COMPLETELY FIXED
 #include "Aircraft.h"
+#include "FlightKernel.h"
 #include "GlobalConfig.h"
+#include "PerformanceEnvelope.h"
 #include <cmath>
 #include <algorithm>
 
 Aircraft::Aircraft(std::unique_ptr<IFlightModel> flightModel)
-    : m_flightModel(std::move(flightModel)), m_fuel(1000.0), m_pathRecordTimer(0.0) {
+    : m_flightModel(std::move(flightModel)), m_envelope(nullptr), m_fuel(1000.0), m_flightPathStart(0), m_flightPathOffset(0), m_pathRecordTimer(0.0) {
+    m_flightPath.reserve(2 * kFlightPathLength);
     reset();
 }
 
@@ -31,18 +34,24 @@ void Aircraft::reset() {
 
     m_fuel = 1000.0;
     m_flightPath.clear();
+    m_flightPathStart = 0;
+    m_flightPathOffset = 0;
     m_pathRecordTimer = 0.0;
 }
 
 void Aircraft::update(double deltaTime) {
+    update(deltaTime, GlobalConfig::instance().snapshot());
+}
+
+void Aircraft::update(double deltaTime, const ConfigSnapshot& config) {
     if (m_fuel <= 0.0) {
         m_controls.throttle = 0.0;
     }
 
-    updatePhysics(deltaTime);
+    updatePhysics(deltaTime, config);
     updateOrientation(deltaTime);
     updateFuel(deltaTime);
-    enforceConstraints();
+    enforceConstraints(config);
 
     m_pathRecordTimer += deltaTime;
     if (m_pathRecordTimer >= 0.5) {
@@ -51,57 +60,21 @@ void Aircraft::update(double deltaTime) {
     }
 }
 
-void Aircraft::updatePhysics(double deltaTime) {
+void Aircraft::updatePhysics(double deltaTime, const ConfigSnapshot& config) {
     // Compute new forces
     FlightState newState;
-    m_flightModel->computeForces(m_flightState, m_controls, altitude(), deltaTime, newState);
+    m_flightModel->computeForces(m_flightState, m_controls, altitude(), deltaTime, config, newState);
 
     // Update state
     m_flightState = newState;
 
-    // Update position based on velocity
-    m_position.x += m_flightState.velocityX * deltaTime;
-    m_position.y += m_flightState.velocityY * deltaTime;
-    m_position.z += m_flightState.velocityZ * deltaTime;
-
-    // Ground collision
-    if (m_position.z <= 0.0) {
-        m_position.z = 0.0;
-
-        // Stop vertical motion
-        if (m_flightState.velocityZ < 0.0) {
-            m_flightState.velocityZ = 0.0;
-        }
-
-        // Ground friction
-        m_flightState.velocityX *= 0.95;
-        m_flightState.velocityY *= 0.95;
-
-        // If almost stopped, set to zero
-        if (speed() < 5.0) {
-            m_flightState.velocityX = 0.0;
-            m_flightState.velocityY = 0.0;
-        }
-    }
+    // Update position based on velocity, then ground contact
+    integratePosition(m_flightState, m_position.x, m_position.y, m_position.z, deltaTime);
 }
 
 void Aircraft::updateOrientation(double deltaTime) {
-    // Update angles based on angular velocities
-    m_orientation.bank += m_flightState.angularVelocityX;
-    m_orientation.pitch += m_flightState.angularVelocityY;
-    m_orientation.heading += m_flightState.angularVelocityZ;
-
-    // Normalize heading (0-360)
-    while (m_orientation.heading >= 360.0) m_orientation.heading -= 360.0;
-    while (m_orientation.heading < 0.0) m_orientation.heading += 360.0;
-
-    // Clamp pitch and bank
-    m_orientation.pitch = std::clamp(m_orientation.pitch, -90.0, 90.0);
-    m_orientation.bank = std::clamp(m_orientation.bank, -180.0, 180.0);
-
-    // Natural damping for stability
-    m_orientation.bank *= 0.98;
-    m_orientation.pitch *= 0.98;
+    // Angular velocities are per-step increments already
+    advanceOrientation(m_flightState, m_orientation.heading, m_orientation.pitch, m_orientation.bank);
 }
 
 void Aircraft::updateFuel(double deltaTime) {
@@ -110,29 +83,12 @@ void Aircraft::updateFuel(double deltaTime) {
     if (m_fuel < 0.0) m_fuel = 0.0;
 }
 
-void Aircraft::enforceConstraints() {
-    auto& config = GlobalConfig::instance();
-
-    // Altitude limit
-    if (m_position.z > config.maxAltitude()) {
-        m_position.z = config.maxAltitude();
-        m_flightState.velocityZ = std::min(0.0, m_flightState.velocityZ);
-    }
-
-    // Speed limit
-    double currentSpeed = speed();
-    if (currentSpeed > config.maxSpeed()) {
-        double scale = config.maxSpeed() / currentSpeed;
-        m_flightState.velocityX *= scale;
-        m_flightState.velocityY *= scale;
-        m_flightState.velocityZ *= scale;
-    }
+void Aircraft::enforceConstraints(const ConfigSnapshot& config) {
+    applyFlightLimits(m_flightState, m_position.z, config.maxAltitude, config.maxSpeed);
 }
 
 double Aircraft::speed() const {
-    return std::sqrt(m_flightState.velocityX * m_flightState.velocityX +
-        m_flightState.velocityY * m_flightState.velocityY +
-        m_flightState.velocityZ * m_flightState.velocityZ);
+    return flightSpeed(m_flightState);
 }
 
 double Aircraft::verticalSpeed() const {
@@ -140,7 +96,15 @@ double Aircraft::verticalSpeed() const {
 }
 
 bool Aircraft::isStalled() const {
-    return speed() < m_flightModel->getStallSpeed() && altitude() > 10.0;
+    const double stallSpeed = m_envelope
+        ? m_envelope->stallSpeed(altitude(), m_controls.flaps, PerformanceEnvelope::loadFactorForBank(m_orientation.bank))
+        : m_flightModel->getStallSpeed();
+    return speed() < stallSpeed && altitude() > 10.0;
+}
+
+bool Aircraft::isOverspeed() const {
+    const double maxSpeed = m_envelope ? m_envelope->maxSpeed(altitude(), m_controls.flaps) : m_flightModel->getMaxSpeed();
+    return speed() > maxSpeed;
 }
 
 bool Aircraft::isOnGround() const {
@@ -148,8 +112,15 @@ bool Aircraft::isOnGround() const {
 }
 
 void Aircraft::recordPosition() {
+    // Slide the trail back to the front once per kFlightPathLength points instead of shifting it
+    // on every insert; the reserved buffer never reallocates.
+    if (m_flightPath.size() == m_flightPath.capacity()) {
+        m_flightPath.erase(m_flightPath.begin(), m_flightPath.begin() + static_cast<ptrdiff_t>(m_flightPathStart));
+        m_flightPathStart = 0;
+    }
     m_flightPath.push_back(m_position);
-    if (m_flightPath.size() > 1000) {
-        m_flightPath.erase(m_flightPath.begin());
+    if (flightPathSize() > kFlightPathLength) {
+        ++m_flightPathStart;
+        ++m_flightPathOffset;
     }
 }
\ No newline at end of file
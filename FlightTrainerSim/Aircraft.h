@@ -8,11 +8,15 @@
 #include <vector>
 #include <algorithm>
 
-struct Position3D {
-    double x = 0.0;
-    double y = 0.0;
-    double z = 0.0;
+class PerformanceEnvelope;
+
+template <typename T>
+struct BasicPosition3D {
+    T x = T(0);
+    T y = T(0);
+    T z = T(0);
 };
+using Position3D = BasicPosition3D<double>;
 
 struct Orientation {
     double heading = 0.0;
@@ -23,6 +27,8 @@ struct Orientation {
 class Aircraft {
 public:
     explicit Aircraft(std::unique_ptr<IFlightModel> flightModel);
+    // Advances one tick reading limits from `config`; the one-argument form uses the current snapshot.
+    void update(double deltaTime, const ConfigSnapshot& config);
     void update(double deltaTime);
     void reset();
     
@@ -30,23 +36,30 @@ public:
     const Orientation& orientation() const { return m_orientation; }
     double altitude() const { return m_position.z; }
     double speed() const;
-    double verticalSpeed() const { return m_flightState.velocityZ; }
+    double verticalSpeed() const;
     double heading() const { return m_orientation.heading; }
     double pitch() const { return m_orientation.pitch; }
     double bank() const { return m_orientation.bank; }
     double fuel() const { return m_fuel; }
     double thrust() const { return m_flightState.thrust; }
+    // Below the envelope's stall speed for the altitude, flaps and bank (without an envelope, the
+    // model's stall speed), off the ground.
     bool isStalled() const;
-    bool isOnGround() const { return m_position.z <= 0.1; }
+    bool isOverspeed() const;
+    bool isOnGround() const;
     
     const FlightState& flightState() const { return m_flightState; }
     const ControlInputs& controls() const { return m_controls; }
     const IFlightModel* flightModel() const { return m_flightModel.get(); }
+    const PerformanceEnvelope* envelope() const { return m_envelope; }
     
     void setPosition(const Position3D& pos) { m_position = pos; }
     void setOrientation(const Orientation& orient) { m_orientation = orient; }
+    void setFlightState(const FlightState& state) { m_flightState = state; }
     void setControls(const ControlInputs& controls) { m_controls = controls; }
     void setFuel(double fuel) { m_fuel = fuel; }
+    // Not owned; e.g. from PerformanceEnvelope::forModel(). Kept across reset().
+    void setEnvelope(const PerformanceEnvelope* envelope) { m_envelope = envelope; }
     
     void setElevator(double value) { m_controls.elevator = std::clamp(value, -1.0, 1.0); }
     void setAileron(double value) { m_controls.aileron = std::clamp(value, -1.0, 1.0); }
@@ -55,23 +68,30 @@ public:
     void setFlaps(double value) { m_controls.flaps = std::clamp(value, 0.0, 1.0); }
     void setGear(bool down) { m_controls.gearDown = down; }
     
-    const std::vector<Position3D>& flightPath() const { return m_flightPath; }
+    static constexpr size_t kFlightPathLength = 1000;
+    // The last kFlightPathLength recorded positions, oldest first, contiguous.
+    const Position3D* flightPath() const { return m_flightPath.data() + m_flightPathStart; }
+    size_t flightPathSize() const { return m_flightPath.size() - m_flightPathStart; }
+    // Points dropped from the front of the path since the last reset.
+    size_t flightPathOffset() const { return m_flightPathOffset; }
     void recordPosition();
     
 private:
     std::unique_ptr<IFlightModel> m_flightModel;
+    const PerformanceEnvelope* m_envelope;
     Position3D m_position;
     Orientation m_orientation;
     FlightState m_flightState;
     ControlInputs m_controls;
     double m_fuel;
-    std::vector<Position3D> m_flightPath;
+    std::vector<Position3D> m_flightPath;           // up to twice the trail; it starts at m_flightPathStart
+    size_t m_flightPathStart, m_flightPathOffset;
     double m_pathRecordTimer;
     
-    void updatePhysics(double deltaTime);
+    void updatePhysics(double deltaTime, const ConfigSnapshot& config);
     void updateOrientation(double deltaTime);
     void updateFuel(double deltaTime);
-    void enforceConstraints();
+    void enforceConstraints(const ConfigSnapshot& config);
 };
 
 #endif
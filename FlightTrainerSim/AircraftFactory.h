@@ -5,20 +5,37 @@
 #include "Aircraft.h"
 #include "IFlightModel.h"
 #include <memory>
+#include <string>
 
 enum class AircraftType { Trainer, Jet, Cargo };
 
 class AircraftFactory {
 public:
-    static std::unique_ptr<Aircraft> createAircraft(AircraftType type) {
-        std::unique_ptr<IFlightModel> model;
+    // Command-line names of the types, as the tools take them in --aircraft.
+    struct Key { const char* key; AircraftType type; };
+    static constexpr Key kKeys[] = {
+        { "trainer", AircraftType::Trainer }, { "jet", AircraftType::Jet }, { "cargo", AircraftType::Cargo },
+    };
+    static bool typeForKey(const std::string& key, AircraftType& type) {
+        for (const Key& entry : kKeys) {
+            if (key == entry.key) {
+                type = entry.type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static std::unique_ptr<IFlightModel> createFlightModel(AircraftType type) {
         switch (type) {
-            case AircraftType::Trainer: model = std::make_unique<TrainerFlightModel>(); break;
-            case AircraftType::Jet: model = std::make_unique<JetFlightModel>(); break;
-            case AircraftType::Cargo: model = std::make_unique<CargoFlightModel>(); break;
-            default: model = std::make_unique<TrainerFlightModel>();
+            case AircraftType::Trainer: return std::make_unique<TrainerFlightModel>();
+            case AircraftType::Jet: return std::make_unique<JetFlightModel>();
+            case AircraftType::Cargo: return std::make_unique<CargoFlightModel>();
+            default: return std::make_unique<TrainerFlightModel>();
         }
-        return std::make_unique<Aircraft>(std::move(model));
+    }
+    static std::unique_ptr<Aircraft> createAircraft(AircraftType type) {
+        return std::make_unique<Aircraft>(createFlightModel(type));
     }
     static std::string getAircraftTypeName(AircraftType type) {
         switch (type) {
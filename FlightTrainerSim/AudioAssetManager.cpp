@@ -0,0 +1,147 @@
+// File: AudioAssetManager.cpp
+#include "AudioAssetManager.h"
+#include <QFile>
+#include <QString>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+namespace {
+    struct WavSource {
+        std::unique_ptr<QFile> file;
+        const uchar* data = nullptr;   // first sample of the data chunk
+        size_t frames = 0;
+        int channels = 0, bytesPerSample = 0, sampleRate = 0;
+        bool isFloat = false;
+        size_t outFrames = 0;
+    };
+
+    uint32_t readU32(const uchar* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24); }
+    uint16_t readU16(const uchar* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+
+    // Validates the RIFF/WAVE headers of a mapped file and locates its PCM data.
+    bool parseWav(const uchar* bytes, size_t size, WavSource& source) {
+        if (size < 12 || std::memcmp(bytes, "RIFF", 4) != 0 || std::memcmp(bytes + 8, "WAVE", 4) != 0) return false;
+        int format = 0, bits = 0;
+        size_t offset = 12;
+        while (offset + 8 <= size) {
+            const uchar* chunk = bytes + offset;
+            const size_t length = readU32(chunk + 4);
+            const size_t body = offset + 8;
+            if (length > size - body) return false;
+            if (std::memcmp(chunk, "fmt ", 4) == 0 && length >= 16) {
+                format = readU16(chunk + 8);
+                source.channels = readU16(chunk + 10);
+                source.sampleRate = static_cast<int>(readU32(chunk + 12));
+                bits = readU16(chunk + 22);
+                if (format == 0xFFFE && length >= 26) format = readU16(chunk + 32);   // WAVE_FORMAT_EXTENSIBLE subtype
+            } else if (std::memcmp(chunk, "data", 4) == 0) {
+                if (source.channels <= 0 || source.sampleRate <= 0) return false;
+                source.isFloat = format == 3;
+                if (!(format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) && !(format == 3 && bits == 32)) return false;
+                source.bytesPerSample = bits / 8;
+                source.data = bytes + body;
+                source.frames = length / (static_cast<size_t>(source.bytesPerSample) * source.channels);
+                return source.frames > 0;
+            }
+            offset = body + length + (length & 1);
+        }
+        return false;
+    }
+
+    float readSample(const WavSource& source, size_t frame) {
+        const uchar* p = source.data + frame * source.bytesPerSample * source.channels;
+        float sum = 0.0f;
+        for (int c = 0; c < source.channels; ++c, p += source.bytesPerSample) {
+            switch (source.bytesPerSample) {
+            case 1: sum += (p[0] - 128) / 128.0f; break;
+            case 2: sum += static_cast<int16_t>(readU16(p)) / 32768.0f; break;
+            case 3: sum += static_cast<int32_t>((p[0] << 8) | (p[1] << 16) | (static_cast<uint32_t>(p[2]) << 24)) / 2147483648.0f; break;
+            default:
+                if (source.isFloat) {
+                    const uint32_t raw = readU32(p);
+                    float value;
+                    std::memcpy(&value, &raw, sizeof(value));
+                    sum += value;
+                } else {
+                    sum += static_cast<int32_t>(readU32(p)) / 2147483648.0f;
+                }
+                break;
+            }
+        }
+        return sum / source.channels;
+    }
+}
+
+AudioAssetManager::AudioAssetManager() : m_finished(false), m_cancel(false), m_poolBytes(0) {
+    for (auto& ready : m_ready) ready.store(false, std::memory_order_relaxed);
+}
+
+AudioAssetManager::~AudioAssetManager() {
+    m_cancel.store(true, std::memory_order_relaxed);
+    if (m_loader.joinable()) m_loader.join();
+}
+
+const char* AudioAssetManager::fileName(SoundType type) {
+    switch (type) {
+    case SoundType::EngineIdle: return "engine_idle.wav";
+    case SoundType::EngineHigh: return "engine_high.wav";
+    case SoundType::Stall: return "stall_warning.wav";
+    case SoundType::Warning: return "warning.wav";
+    case SoundType::GearUp: return "gear_up.wav";
+    case SoundType::GearDown: return "gear_down.wav";
+    case SoundType::FlapsMove: return "flaps.wav";
+    case SoundType::WindNoise: return "wind.wav";
+    default: return "";
+    }
+}
+
+void AudioAssetManager::startLoading(const std::string& directory, int sampleRate) {
+    if (m_loader.joinable()) return;
+    m_loader = std::thread(&AudioAssetManager::load, this, directory, sampleRate);
+}
+
+void AudioAssetManager::load(std::string directory, int sampleRate) {
+    // Pass 1: map every file that exists and read its header, to size the pool in one allocation.
+    std::array<WavSource, kSoundCount> sources;
+    size_t total = 0;
+    for (size_t i = 0; i < kSoundCount; ++i) {
+        const std::string path = directory + "/" + fileName(static_cast<SoundType>(i));
+        auto file = std::make_unique<QFile>(QString::fromStdString(path));
+        if (!file->open(QIODevice::ReadOnly)) continue;
+        const uchar* bytes = file->map(0, file->size());
+        WavSource& source = sources[i];
+        if (!bytes || !parseWav(bytes, static_cast<size_t>(file->size()), source)) {
+            std::fprintf(stderr, "Audio: ignoring unreadable asset %s\n", path.c_str());
+            source = WavSource();
+            continue;
+        }
+        source.file = std::move(file);
+        source.outFrames = static_cast<size_t>(static_cast<double>(source.frames - 1) * sampleRate / source.sampleRate) + 1;
+        total += source.outFrames;
+    }
+    m_pool.resize(total);
+    m_poolBytes.store(total * sizeof(float), std::memory_order_relaxed);
+
+    // Pass 2: decode straight into the pool, publishing each clip as soon as it is complete.
+    float* out = m_pool.data();
+    for (size_t i = 0; i < kSoundCount && !m_cancel.load(std::memory_order_relaxed); ++i) {
+        WavSource& source = sources[i];
+        if (!source.file) continue;
+        const double step = static_cast<double>(source.sampleRate) / sampleRate;
+        for (size_t frame = 0; frame < source.outFrames; ++frame) {
+            const double position = frame * step;
+            const size_t index = static_cast<size_t>(position);
+            const float a = readSample(source, index);
+            const float b = index + 1 < source.frames ? readSample(source, index + 1) : a;
+            out[frame] = a + (b - a) * static_cast<float>(position - index);
+        }
+        m_clips[i].samples = out;
+        m_clips[i].frames = source.outFrames;
+        m_ready[i].store(true, std::memory_order_release);
+        out += source.outFrames;
+        source.file.reset();
+    }
+    m_finished.store(true, std::memory_order_release);
+}
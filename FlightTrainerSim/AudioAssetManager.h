@@ -0,0 +1,68 @@
+// File: AudioAssetManager.h
+#ifndef AUDIOASSETMANAGER_H
+#define AUDIOASSETMANAGER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class SoundType {
+    EngineIdle,
+    EngineHigh,
+    Stall,
+    Warning,
+    GearUp,
+    GearDown,
+    FlapsMove,
+    WindNoise,
+    Count
+};
+
+// Decoded mono float PCM at the output sample rate.
+struct PcmClip {
+    const float* samples = nullptr;
+    size_t frames = 0;
+};
+
+// Finds the optional WAV files under a directory and decodes them on a background thread. Files are
+// memory-mapped, converted to mono float and resampled to the output rate into one pool sized up
+// front, so clip pointers stay valid for the manager's lifetime. Each slot of the flat SoundType
+// table is published with a release store once decoded; clip() is a single acquire load.
+class AudioAssetManager {
+public:
+    static constexpr size_t kSoundCount = static_cast<size_t>(SoundType::Count);
+
+    AudioAssetManager();
+    ~AudioAssetManager();
+    AudioAssetManager(const AudioAssetManager&) = delete;
+    AudioAssetManager& operator=(const AudioAssetManager&) = delete;
+
+    // Returns immediately; call once.
+    void startLoading(const std::string& directory, int sampleRate);
+    // nullptr until the sound has been decoded (or when it has no asset).
+    const PcmClip* clip(SoundType type) const {
+        const size_t index = static_cast<size_t>(type);
+        return m_ready[index].load(std::memory_order_acquire) ? &m_clips[index] : nullptr;
+    }
+    bool isReady(SoundType type) const { return clip(type) != nullptr; }
+    // True once every asset has been tried, loaded or not.
+    bool finished() const { return m_finished.load(std::memory_order_acquire); }
+    size_t poolBytes() const { return m_poolBytes.load(std::memory_order_relaxed); }
+
+    static const char* fileName(SoundType type);
+
+private:
+    void load(std::string directory, int sampleRate);
+
+    std::array<PcmClip, kSoundCount> m_clips;
+    std::array<std::atomic<bool>, kSoundCount> m_ready;
+    std::atomic<bool> m_finished, m_cancel;
+    std::atomic<size_t> m_poolBytes;
+    std::vector<float> m_pool;
+    std::thread m_loader;
+};
+
+#endif
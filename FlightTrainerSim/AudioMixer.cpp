@@ -0,0 +1,69 @@
+// File: AudioMixer.cpp
+#include "AudioMixer.h"
+#include <QAudioSink>
+#include <algorithm>
+#include <cstring>
+
+AudioMixer::AudioMixer(AudioSynth* synth, const QAudioFormat& format, QObject* parent)
+    : QIODevice(parent), m_synth(synth), m_format(format), m_sink(nullptr),
+      m_scratch(AudioSynth::kBlockFrames * 16), m_bytesPerFrame(format.bytesPerFrame()) {
+    m_synth->setSampleRate(format.sampleRate());
+}
+
+qint64 AudioMixer::bytesAvailable() const {
+    // Endless stream; advertise one block so the sink keeps pulling.
+    return AudioSynth::kBlockFrames * m_bytesPerFrame + QIODevice::bytesAvailable();
+}
+
+qint64 AudioMixer::writeData(const char*, qint64) {
+    return -1;
+}
+
+qint64 AudioMixer::readData(char* data, qint64 maxSize) {
+    if (m_bytesPerFrame <= 0) return 0;
+    const int channels = m_format.channelCount();
+    const qint64 frames = maxSize / m_bytesPerFrame;
+    qint64 done = 0;
+    while (done < frames) {
+        const int count = static_cast<int>(std::min<qint64>(frames - done, static_cast<qint64>(m_scratch.size())));
+        m_synth->render(m_scratch.data(), count);
+        char* out = data + done * m_bytesPerFrame;
+        for (int i = 0; i < count; ++i) {
+            const float value = m_scratch[static_cast<size_t>(i)];
+            for (int c = 0; c < channels; ++c) {
+                switch (m_format.sampleFormat()) {
+                case QAudioFormat::Int16: {
+                    const qint16 s = static_cast<qint16>(value * 32767.0f);
+                    std::memcpy(out, &s, sizeof(s));
+                    break;
+                }
+                case QAudioFormat::Int32: {
+                    const qint32 s = static_cast<qint32>(value * 2147483520.0f);
+                    std::memcpy(out, &s, sizeof(s));
+                    break;
+                }
+                case QAudioFormat::UInt8:
+                    *reinterpret_cast<quint8*>(out) = static_cast<quint8>(128.0f + value * 127.0f);
+                    break;
+                default:
+                    std::memcpy(out, &value, sizeof(value));
+                    break;
+                }
+                out += m_format.bytesPerSample();
+            }
+        }
+        done += count;
+    }
+    updateLatency(frames * m_bytesPerFrame);
+    return frames * m_bytesPerFrame;
+}
+
+void AudioMixer::updateLatency(qint64 pulledBytes) {
+    if (!m_sink) return;
+    // Everything still queued in the device plus what was just rendered plays before a new parameter
+    // can be heard; the synth adds up to one block on top of that.
+    const qint64 queued = std::max<qint64>(0, m_sink->bufferSize() - m_sink->bytesFree()) + pulledBytes;
+    const double bytesPerSecond = static_cast<double>(m_format.sampleRate()) * m_bytesPerFrame;
+    const double blockMs = 1000.0 * AudioSynth::kBlockFrames / m_format.sampleRate();
+    m_synth->setOutputLatencyMs(1000.0 * queued / bytesPerSecond + blockMs);
+}
@@ -0,0 +1,38 @@
+// File: AudioMixer.h
+#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include "AudioSynth.h"
+#include <QAudioFormat>
+#include <QIODevice>
+#include <vector>
+
+class QAudioSink;
+
+// Pull-mode source for a QAudioSink. Lives on the audio thread: the sink calls readData() there
+// whenever it has room, the synth renders into a preallocated scratch buffer and the samples are
+// converted to the device format. Each pull also refreshes the synth's measured output latency.
+class AudioMixer : public QIODevice {
+    Q_OBJECT
+public:
+    AudioMixer(AudioSynth* synth, const QAudioFormat& format, QObject* parent = nullptr);
+    void setSink(QAudioSink* sink) { m_sink = sink; }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    void updateLatency(qint64 pulledBytes);
+
+    AudioSynth* m_synth;
+    QAudioFormat m_format;
+    QAudioSink* m_sink;
+    std::vector<float> m_scratch;
+    int m_bytesPerFrame;
+};
+
+#endif
@@ -0,0 +1,184 @@
+// File: AudioSynth.cpp
+#include "AudioSynth.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr double kTwoPi = 6.283185307179586;
+    constexpr double kSpoolSeconds = 1.2;       // engine RPM lag behind the throttle
+    constexpr double kFadeSeconds = 0.05;
+    constexpr double kBuffetSeconds = 0.15;
+    constexpr double kWindSeconds = 0.3;
+    constexpr double kWarningSeconds = 0.6;
+    constexpr double kWarningHz = 880.0;
+    constexpr double kWarningGateHz = 4.0;
+    constexpr double kBuffetHz = 9.0;
+
+    double smoothing(double seconds, double blockSeconds) { return 1.0 - std::exp(-blockSeconds / seconds); }
+
+    size_t slot(SoundType type) { return static_cast<size_t>(type); }
+}
+
+AudioSynth::AudioSynth(int sampleRate)
+    : m_throttle(0.0f), m_airspeed(0.0f), m_gain(0.8f), m_stall(false), m_active(false), m_latencyMs(0.0),
+      m_sampleRate(0), m_dt(0.0), m_block{}, m_blockPos(kBlockFrames),
+      m_rpm(0.0), m_master(0.0), m_windLevel(0.0), m_buffetLevel(0.0),
+      m_enginePhase(0.0), m_buffetPhase(0.0), m_warningPhase(0.0),
+      m_windLow(0.0), m_windBand(0.0), m_buffetLow(0.0), m_noiseState(0x9E3779B9u),
+      m_assets(nullptr), m_seenPlay{}, m_seenStop{}, m_warningFramesLeft(0) {
+    for (auto& serial : m_playSerial) serial.store(0, std::memory_order_relaxed);
+    for (auto& serial : m_stopSerial) serial.store(0, std::memory_order_relaxed);
+    setSampleRate(sampleRate);
+}
+
+void AudioSynth::setSampleRate(int sampleRate) {
+    m_sampleRate = std::max(sampleRate, 8000);
+    m_dt = 1.0 / m_sampleRate;
+    m_blockPos = kBlockFrames;
+}
+
+float AudioSynth::noise() {
+    // xorshift32 - cheap white noise in [-1, 1].
+    m_noiseState ^= m_noiseState << 13;
+    m_noiseState ^= m_noiseState >> 17;
+    m_noiseState ^= m_noiseState << 5;
+    return static_cast<float>(m_noiseState) * (2.0f / 4294967295.0f) - 1.0f;
+}
+
+float AudioSynth::play(Voice& voice, double rate, bool loop) {
+    if (!voice.playing || !voice.clip) return 0.0f;
+    const PcmClip& clip = *voice.clip;
+    const size_t index = static_cast<size_t>(voice.position);
+    const size_t next = index + 1 < clip.frames ? index + 1 : (loop ? 0 : index);
+    const float frac = static_cast<float>(voice.position - index);
+    const float value = clip.samples[index] + (clip.samples[next] - clip.samples[index]) * frac;
+    voice.position += rate;
+    if (voice.position >= clip.frames) {
+        if (loop) voice.position = std::fmod(voice.position, static_cast<double>(clip.frames));
+        else voice.playing = false;
+    }
+    return value;
+}
+
+void AudioSynth::render(float* out, int frames) {
+    while (frames > 0) {
+        if (m_blockPos == kBlockFrames) {
+            renderBlock();
+            m_blockPos = 0;
+        }
+        const int count = std::min(frames, kBlockFrames - m_blockPos);
+        std::copy_n(m_block.data() + m_blockPos, count, out);
+        m_blockPos += count;
+        out += count;
+        frames -= count;
+    }
+}
+
+void AudioSynth::renderBlock() {
+    // Parameters are sampled once per block, which bounds control latency to one block.
+    const double throttle = std::clamp(static_cast<double>(m_throttle.load(std::memory_order_relaxed)), 0.0, 1.0);
+    const double speed = std::max(0.0, static_cast<double>(m_airspeed.load(std::memory_order_relaxed)));
+    const bool stall = m_stall.load(std::memory_order_relaxed);
+    const bool active = m_active.load(std::memory_order_relaxed);
+    const double gain = std::clamp(static_cast<double>(m_gain.load(std::memory_order_relaxed)), 0.0, 1.0);
+
+    // Pick up clips as they finish decoding; loops run continuously and are faded by their layer level.
+    for (size_t i = 0; i < m_voices.size(); ++i) {
+        Voice& voice = m_voices[i];
+        if (!voice.clip && m_assets) voice.clip = m_assets->clip(static_cast<SoundType>(i));
+        const uint32_t played = m_playSerial[i].load(std::memory_order_relaxed);
+        const uint32_t stopped = m_stopSerial[i].load(std::memory_order_relaxed);
+        if (stopped != m_seenStop[i]) {
+            m_seenStop[i] = stopped;
+            if (i != slot(SoundType::Warning)) voice.playing = false;
+        }
+        if (played != m_seenPlay[i]) {
+            m_seenPlay[i] = played;
+            if (i == slot(SoundType::Warning)) {
+                // Repeated requests while the chime sounds extend nothing; it repeats once finished.
+                if (voice.clip && !voice.playing) voice = { voice.clip, 0.0, true };
+                else if (!voice.clip && m_warningFramesLeft <= 0) m_warningFramesLeft = static_cast<int>(kWarningSeconds * m_sampleRate);
+            } else {
+                voice.position = 0.0;
+                voice.playing = true;
+            }
+        }
+    }
+    for (SoundType loop : { SoundType::EngineIdle, SoundType::EngineHigh, SoundType::Stall, SoundType::WindNoise })
+        m_voices[slot(loop)].playing = true;
+    Voice& idle = m_voices[slot(SoundType::EngineIdle)];
+    Voice& high = m_voices[slot(SoundType::EngineHigh)];
+    Voice& windClip = m_voices[slot(SoundType::WindNoise)];
+    Voice& stallClip = m_voices[slot(SoundType::Stall)];
+    const bool sampledEngine = idle.clip || high.clip;
+
+    const double blockSeconds = kBlockFrames * m_dt;
+    const double speedRatio = std::min(speed / 250.0, 1.2);
+
+    // Block-start and block-end levels; samples ramp between them so steps never click.
+    const double rpm0 = m_rpm, master0 = m_master, wind0 = m_windLevel, buffet0 = m_buffetLevel;
+    m_rpm += (0.2 + 0.75 * throttle + 0.05 * speedRatio - m_rpm) * smoothing(kSpoolSeconds, blockSeconds);
+    m_master += ((active ? 1.0 : 0.0) - m_master) * smoothing(kFadeSeconds, blockSeconds);
+    m_windLevel += (std::min(0.35 * speedRatio * speedRatio, 0.45) - m_windLevel) * smoothing(kWindSeconds, blockSeconds);
+    m_buffetLevel += ((stall ? 0.5 : 0.0) - m_buffetLevel) * smoothing(kBuffetSeconds, blockSeconds);
+
+    // Wind gets brighter with speed: a two-pole lowpass whose cutoff rises with airspeed.
+    const double windCutoff = 0.02 + 0.18 * std::min(speedRatio, 1.0);
+    const int warningTotal = static_cast<int>(kWarningSeconds * m_sampleRate);
+    const double gatePeriod = m_sampleRate / kWarningGateHz;
+
+    for (int i = 0; i < kBlockFrames; ++i) {
+        const double t = (i + 1) / static_cast<double>(kBlockFrames);
+        const double rpm = rpm0 + (m_rpm - rpm0) * t;
+        const double master = master0 + (m_master - master0) * t;
+
+        // Engine: firing frequency and harmonics follow RPM, loudness grows with power.
+        const double engineLevel = 0.15 + 0.35 * rpm;
+        double sample;
+        if (sampledEngine) {
+            // Recordings are pitched around their natural speed and crossfaded idle -> high.
+            const double rate = 0.7 + 0.6 * rpm;
+            const double mix = idle.clip && high.clip ? rpm : (high.clip ? 1.0 : 0.0);
+            sample = engineLevel * ((1.0 - mix) * play(idle, rate, true) + mix * play(high, rate, true));
+        } else {
+            const double frequency = 35.0 + 145.0 * rpm;
+            m_enginePhase += kTwoPi * frequency * m_dt;
+            if (m_enginePhase > kTwoPi) m_enginePhase -= kTwoPi;
+            const double p = m_enginePhase;
+            const double tone = std::sin(p) + 0.5 * std::sin(2.0 * p) + 0.3 * std::sin(3.0 * p) + 0.15 * std::sin(5.0 * p);
+            sample = engineLevel * 0.5 * tone;
+        }
+
+        const float white = noise();
+        const double wind = wind0 + (m_windLevel - wind0) * t;
+        if (windClip.clip) {
+            sample += wind * 1.5 * play(windClip, 1.0, true);
+        } else {
+            m_windLow += windCutoff * (white - m_windLow);
+            m_windBand += windCutoff * (m_windLow - m_windBand);
+            sample += wind * 3.0 * m_windBand;
+        }
+
+        const double buffet = buffet0 + (m_buffetLevel - buffet0) * t;
+        if (stallClip.clip) {
+            sample += buffet * 2.0 * play(stallClip, 1.0, true);
+        } else if (buffet > 1.0e-4) {
+            m_buffetPhase += kTwoPi * kBuffetHz * m_dt;
+            if (m_buffetPhase > kTwoPi) m_buffetPhase -= kTwoPi;
+            m_buffetLow += 0.04 * (white - m_buffetLow);
+            sample += buffet * 4.0 * m_buffetLow * (0.5 + 0.5 * std::sin(m_buffetPhase));
+        }
+
+        if (m_warningFramesLeft > 0) {
+            const int elapsed = warningTotal - m_warningFramesLeft;
+            m_warningPhase += kTwoPi * kWarningHz * m_dt;
+            if (m_warningPhase > kTwoPi) m_warningPhase -= kTwoPi;
+            if (std::fmod(elapsed, gatePeriod) < gatePeriod * 0.5) sample += 0.25 * std::sin(m_warningPhase);
+            --m_warningFramesLeft;
+        }
+        for (SoundType shot : { SoundType::Warning, SoundType::GearUp, SoundType::GearDown, SoundType::FlapsMove })
+            sample += 0.6 * play(m_voices[slot(shot)], 1.0, false);
+
+        m_block[static_cast<size_t>(i)] = static_cast<float>(std::tanh(sample * master) * gain);
+    }
+}
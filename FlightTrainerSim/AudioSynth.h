@@ -0,0 +1,77 @@
+// File: AudioSynth.h
+#ifndef AUDIOSYNTH_H
+#define AUDIOSYNTH_H
+
+#include "AudioAssetManager.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Procedural cockpit sound: an engine tone whose pitch follows a spooling RPM, airspeed-driven wind
+// noise, stall buffet and a warning chime. Where AudioAssetManager has decoded a recording for a
+// layer, that clip replaces the procedural voice (engine clips are pitched with RPM); one-shot
+// clips such as gear and flaps play on top. The simulation writes parameters with relaxed atomic
+// stores (never blocks, never allocates); the audio thread reads them once per fixed block of
+// kBlockFrames and renders mono samples in [-1, 1]. Only render() touches the oscillator state.
+class AudioSynth {
+public:
+    static constexpr int kBlockFrames = 128;
+
+    explicit AudioSynth(int sampleRate = 48000);
+
+    // Simulation thread.
+    void setThrottle(double throttle) { m_throttle.store(static_cast<float>(throttle), std::memory_order_relaxed); }
+    void setAirspeed(double knots) { m_airspeed.store(static_cast<float>(knots), std::memory_order_relaxed); }
+    void setStall(bool stalled) { m_stall.store(stalled, std::memory_order_relaxed); }
+    void triggerWarning() { triggerSound(SoundType::Warning); }
+    void triggerSound(SoundType type) { m_playSerial[static_cast<size_t>(type)].fetch_add(1, std::memory_order_relaxed); }
+    void stopSound(SoundType type) { m_stopSerial[static_cast<size_t>(type)].fetch_add(1, std::memory_order_relaxed); }
+    // Inactive fades everything out, e.g. while paused.
+    void setActive(bool active) { m_active.store(active, std::memory_order_relaxed); }
+    void setGain(double gain) { m_gain.store(static_cast<float>(gain), std::memory_order_relaxed); }
+
+    // Audio thread. The sample rate and assets must be set before the first render(); clips appear
+    // as the manager finishes decoding them.
+    void setSampleRate(int sampleRate);
+    void setAssets(const AudioAssetManager* assets) { m_assets = assets; }
+    int sampleRate() const { return m_sampleRate; }
+    void render(float* out, int frames);
+
+    // Time from a parameter store to the sound leaving the device, as measured by the output.
+    void setOutputLatencyMs(double ms) { m_latencyMs.store(ms, std::memory_order_relaxed); }
+    double outputLatencyMs() const { return m_latencyMs.load(std::memory_order_relaxed); }
+
+private:
+    struct Voice {
+        const PcmClip* clip = nullptr;
+        double position = 0.0;
+        bool playing = false;
+    };
+
+    void renderBlock();
+    float noise();
+    float play(Voice& voice, double rate, bool loop);
+
+    std::atomic<float> m_throttle, m_airspeed, m_gain;
+    std::atomic<bool> m_stall, m_active;
+    std::array<std::atomic<uint32_t>, AudioAssetManager::kSoundCount> m_playSerial, m_stopSerial;
+    std::atomic<double> m_latencyMs;
+
+    int m_sampleRate;
+    double m_dt;
+    std::array<float, kBlockFrames> m_block;
+    int m_blockPos;
+
+    // Smoothed state, advanced per block.
+    double m_rpm, m_master, m_windLevel, m_buffetLevel;
+    // Per-sample state.
+    double m_enginePhase, m_buffetPhase, m_warningPhase;
+    double m_windLow, m_windBand, m_buffetLow;
+    uint32_t m_noiseState;
+    const AudioAssetManager* m_assets;
+    std::array<Voice, AudioAssetManager::kSoundCount> m_voices;
+    std::array<uint32_t, AudioAssetManager::kSoundCount> m_seenPlay, m_seenStop;
+    int m_warningFramesLeft;
+};
+
+#endif
@@ -1,102 +1,109 @@
 // File: AudioSystem.cpp
 #include "AudioSystem.h"
-#include <QUrl>
-#include <QFile>
+#include "AudioMixer.h"
+#include "GlobalConfig.h"
+#include <QAudioDevice>
+#include <QAudioSink>
+#include <QMediaDevices>
+#include <QtDebug>
 
 AudioSystem::AudioSystem(QObject* parent)
-    : QObject(parent), m_enabled(false) {
-    // Audio disabled by default - can be enabled if sound files available
-    // initializeSounds();
+    : QObject(parent), m_enabled(false), m_requested(GlobalConfig::instance().audioEnabled()),
+      m_deviceState(DeviceState::Closed), m_audioContext(new QObject), m_mixer(nullptr), m_sink(nullptr) {
+    m_audioThread.setObjectName("Audio");
+    m_audioContext->moveToThread(&m_audioThread);
+    m_audioThread.start(QThread::TimeCriticalPriority);
+    if (m_requested) openDevice();
 }
 
-void AudioSystem::initializeSounds() {
-    // Engine sounds
-    auto engineIdle = std::make_unique<QSoundEffect>();
-    QString enginePath = getSoundPath(SoundType::EngineIdle);
-    if (QFile::exists(enginePath)) {
-        engineIdle->setSource(QUrl::fromLocalFile(enginePath));
-        engineIdle->setLoopCount(QSoundEffect::Infinite);
-        engineIdle->setVolume(0.3);
-        m_sounds[SoundType::EngineIdle] = std::move(engineIdle);
-        m_enabled = true;
-    }
+void AudioSystem::openDevice() {
+    // The sink must be created on the thread that services it. The result comes back as a queued
+    // call to this object, which Qt drops if we are destroyed first.
+    m_deviceState = DeviceState::Opening;
+    QMetaObject::invokeMethod(m_audioContext, [this]() {
+        const bool open = openOutput();
+        QMetaObject::invokeMethod(this, [this, open]() {
+            m_deviceState = open ? DeviceState::Open : DeviceState::Failed;
+            m_enabled = m_requested && open;
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+AudioSystem::~AudioSystem() {
+    QMetaObject::invokeMethod(m_audioContext, [this]() { closeOutput(); }, Qt::BlockingQueuedConnection);
+    m_audioThread.quit();
+    m_audioThread.wait();
+    delete m_audioContext;
+}
 
-    // Warning sound
-    auto warning = std::make_unique<QSoundEffect>();
-    QString warningPath = getSoundPath(SoundType::Warning);
-    if (QFile::exists(warningPath)) {
-        warning->setSource(QUrl::fromLocalFile(warningPath));
-        warning->setVolume(0.8);
-        m_sounds[SoundType::Warning] = std::move(warning);
+bool AudioSystem::openOutput() {
+    const QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    if (device.isNull()) {
+        qInfo("Audio: no output device, sound disabled");
+        return false;
     }
 
-    // Stall warning
-    auto stall = std::make_unique<QSoundEffect>();
-    QString stallPath = getSoundPath(SoundType::Stall);
-    if (QFile::exists(stallPath)) {
-        stall->setSource(QUrl::fromLocalFile(stallPath));
-        stall->setLoopCount(QSoundEffect::Infinite);
-        stall->setVolume(0.9);
-        m_sounds[SoundType::Stall] = std::move(stall);
+    QAudioFormat format;
+    format.setSampleRate(48000);
+    format.setChannelCount(2);
+    format.setSampleFormat(QAudioFormat::Int16);
+    if (!device.isFormatSupported(format)) format = device.preferredFormat();
+
+    m_synth.setAssets(&m_assets);
+    m_mixer = new AudioMixer(&m_synth, format);
+    m_mixer->open(QIODevice::ReadOnly);
+    m_sink = new QAudioSink(device, format);
+    m_sink->setBufferSize(format.bytesForDuration(kTargetBufferMs * 1000));
+    m_mixer->setSink(m_sink);
+    m_sink->start(m_mixer);
+    if (m_sink->error() != QAudio::NoError) {
+        qWarning("Audio: cannot start output on %s", qPrintable(device.description()));
+        closeOutput();
+        return false;
     }
+
+    const double bufferMs = format.durationForBytes(static_cast<qint32>(m_sink->bufferSize())) / 1000.0;
+    qInfo("Audio: %s, %d Hz x %d, %.1f ms buffer, %d-frame blocks", qPrintable(device.description()),
+          format.sampleRate(), format.channelCount(), bufferMs, AudioSynth::kBlockFrames);
+    if (bufferMs > 20.0) qWarning("Audio: device buffer of %.1f ms exceeds the 20 ms latency budget", bufferMs);
+    m_assets.startLoading("./sounds", format.sampleRate());
+    return true;
 }
 
-QString AudioSystem::getSoundPath(SoundType type) const {
-    QString basePath = "./sounds/";
-
-    switch (type) {
-    case SoundType::EngineIdle: return basePath + "engine_idle.wav";
-    case SoundType::EngineHigh: return basePath + "engine_high.wav";
-    case SoundType::Stall: return basePath + "stall_warning.wav";
-    case SoundType::Warning: return basePath + "warning.wav";
-    case SoundType::GearUp: return basePath + "gear_up.wav";
-    case SoundType::GearDown: return basePath + "gear_down.wav";
-    case SoundType::FlapsMove: return basePath + "flaps.wav";
-    case SoundType::WindNoise: return basePath + "wind.wav";
-    default: return "";
-    }
+void AudioSystem::closeOutput() {
+    if (m_sink) m_sink->stop();
+    delete m_sink;
+    delete m_mixer;
+    m_sink = nullptr;
+    m_mixer = nullptr;
 }
 
 void AudioSystem::playSound(SoundType type) {
     if (!m_enabled) return;
 
-    auto it = m_sounds.find(type);
-    if (it != m_sounds.end() && it->second) {
-        it->second->play();
-    }
+    if (type == SoundType::Stall) m_synth.setStall(true);
+    else m_synth.triggerSound(type);
 }
 
 void AudioSystem::stopSound(SoundType type) {
     if (!m_enabled) return;
 
-    auto it = m_sounds.find(type);
-    if (it != m_sounds.end() && it->second) {
-        it->second->stop();
-    }
+    if (type == SoundType::Stall) m_synth.setStall(false);
+    else m_synth.stopSound(type);
 }
 
 void AudioSystem::setEngineVolume(double throttle) {
     if (!m_enabled) return;
 
-    auto it = m_sounds.find(SoundType::EngineIdle);
-    if (it != m_sounds.end() && it->second) {
-        double volume = 0.3 + (throttle * 0.5); // 0.3 to 0.8
-        it->second->setVolume(volume);
-
-        if (!it->second->isPlaying()) {
-            it->second->play();
-        }
-    }
+    // Engine pitch and loudness follow a spooled RPM derived from this inside the synth.
+    m_synth.setThrottle(throttle);
+    m_synth.setActive(true);
 }
 
 void AudioSystem::setWindVolume(double speed) {
     if (!m_enabled) return;
 
-    auto it = m_sounds.find(SoundType::WindNoise);
-    if (it != m_sounds.end() && it->second) {
-        double volume = std::min(speed / 200.0, 0.5); // Max 0.5 at 200+ knots
-        it->second->setVolume(volume);
-    }
+    m_synth.setAirspeed(speed);
 }
 
 void AudioSystem::playWarning() {
@@ -104,16 +111,15 @@ void AudioSystem::playWarning() {
 }
 
 void AudioSystem::stopAll() {
-    for (auto& [type, sound] : m_sounds) {
-        if (sound) {
-            sound->stop();
-        }
-    }
+    m_synth.setStall(false);
+    m_synth.setActive(false);
 }
 
 void AudioSystem::setEnabled(bool enabled) {
-    m_enabled = enabled;
-    if (!enabled) {
+    m_requested = enabled;
+    if (enabled && m_deviceState == DeviceState::Closed) openDevice();
+    m_enabled = enabled && m_deviceState == DeviceState::Open;
+    if (!m_enabled) {
         stopAll();
     }
 }
\ No newline at end of file
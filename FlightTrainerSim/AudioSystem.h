@@ -2,27 +2,28 @@
 #ifndef AUDIOSYSTEM_H
 #define AUDIOSYSTEM_H
 
+#include "AudioAssetManager.h"
+#include "AudioSynth.h"
 #include <QObject>
-#include <QSoundEffect>
-#include <memory>
-#include <map>
-
-enum class SoundType {
-    EngineIdle,
-    EngineHigh,
-    Stall,
-    Warning,
-    GearUp,
-    GearDown,
-    FlapsMove,
-    WindNoise
-};
+#include <QThread>
+
+class QAudioSink;
+class AudioMixer;
 
+// Front end for the procedural cockpit sound. The calls below are made from the simulation tick and
+// only store atomics into the synth; a dedicated time-critical thread owns the audio sink and pulls
+// samples from the mixer, so the tick never blocks on or allocates for audio. Recorded assets in
+// ./sounds are decoded in the background once the device is open and blended in as they become ready.
+// Sound is off unless GlobalConfig::audioEnabled() or setEnabled(true) asks for it; the device is
+// then opened on the audio thread and sound starts when it reports ready.
 class AudioSystem : public QObject {
     Q_OBJECT
 public:
+    // Audio period requested from the device; the backend may round it.
+    static constexpr int kTargetBufferMs = 10;
+
     explicit AudioSystem(QObject* parent = nullptr);
-    ~AudioSystem() = default;
+    ~AudioSystem();
 
     void playSound(SoundType type);
     void stopSound(SoundType type);
@@ -31,15 +32,31 @@ public:
     void playWarning();
     void stopAll();
 
+    // False until the device has opened, even when requested.
     bool isEnabled() const { return m_enabled; }
     void setEnabled(bool enabled);
+    // Measured parameter-to-speaker latency, 0 until the device has started pulling.
+    double outputLatencyMs() const { return m_synth.outputLatencyMs(); }
+    // Whether a recorded asset backs this sound yet; until then the procedural voice plays.
+    bool isSoundLoaded(SoundType type) const { return m_assets.isReady(type); }
+    bool assetsLoaded() const { return m_assets.finished(); }
 
 private:
-    bool m_enabled;
-    std::map<SoundType, std::unique_ptr<QSoundEffect>> m_sounds;
-
-    void initializeSounds();
-    QString getSoundPath(SoundType type) const;
+    enum class DeviceState { Closed, Opening, Open, Failed };
+
+    bool m_enabled, m_requested;
+    DeviceState m_deviceState;
+    AudioAssetManager m_assets;
+    AudioSynth m_synth;
+    QThread m_audioThread;
+    QObject* m_audioContext;
+    AudioMixer* m_mixer;
+    QAudioSink* m_sink;
+
+    // Opens the device on the audio thread without waiting for it.
+    void openDevice();
+    bool openOutput();
+    void closeOutput();
 };
 
 #endif
\ No newline at end of file
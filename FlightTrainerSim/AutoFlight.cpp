@@ -0,0 +1,57 @@
+// File: AutoFlight.cpp
+#include "AutoFlight.h"
+#include "FrameArena.h"
+#include "PerformanceEnvelope.h"
+#include <chrono>
+
+AutoFlight::AutoFlight(std::unique_ptr<Aircraft> aircraft, std::unique_ptr<TrainingScenario> scenario, std::unique_ptr<PilotAgent> agent)
+    : m_aircraft(std::move(aircraft)), m_scenario(std::move(scenario)), m_agent(std::move(agent)), m_simulationTime(0.0), m_trimmed(true) {
+    reset();
+}
+
+void AutoFlight::reset() {
+    const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+    m_scenario->reset();
+    m_aircraft->setEnvelope(&PerformanceEnvelope::forModel(*m_aircraft->flightModel(), config));
+    m_trimmed = m_scenario->placeAircraft(*m_aircraft, config);
+    m_agent->reset();
+    m_metrics.reset();
+    m_simulationTime = 0.0;
+}
+
+void AutoFlight::step(double deltaTime, const ConfigSnapshot& config) {
+    FrameArena::current().reset();
+    ControlInputs controls = m_aircraft->controls();
+    m_agent->control(*m_aircraft, m_scenario.get(), deltaTime, controls);
+    m_aircraft->setControls(controls);
+    m_aircraft->update(deltaTime, config);
+    m_scenario->update(*m_aircraft, deltaTime);
+    m_metrics.recordSnapshot(*m_aircraft, m_simulationTime);
+    m_simulationTime += deltaTime;
+}
+
+bool AutoFlight::finished() const {
+    return m_scenario->isCompleted() || m_scenario->isFailed() || m_scenario->getProgress() >= 100.0;
+}
+
+AutoFlightResult AutoFlight::run(double maxSeconds, const ConfigSnapshot& config) {
+    AutoFlightResult result;
+    const double deltaTime = config.physicsTimeStep();
+    reserve(maxSeconds, config);
+    const auto start = std::chrono::steady_clock::now();
+    while (!finished() && m_simulationTime < maxSeconds) {
+        step(deltaTime, config);
+        ++result.steps;
+    }
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.simulatedSeconds = m_simulationTime;
+    result.completed = m_scenario->isCompleted() || m_scenario->getProgress() >= 100.0;
+    result.failed = m_scenario->isFailed();
+    result.progress = m_scenario->getProgress();
+    result.finalState = m_scenario->currentState();
+    result.trimmed = m_trimmed;
+    DebriefReport report;
+    report.generate(m_metrics, *m_scenario, *m_aircraft);
+    result.score = report.overallScore();
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+// File: AutoFlight.h
+#ifndef AUTOFLIGHT_H
+#define AUTOFLIGHT_H
+
+#include "Aircraft.h"
+#include "FlightMetrics.h"
+#include "GlobalConfig.h"
+#include "PilotAgent.h"
+#include "TrainingScenario.h"
+#include <memory>
+
+struct AutoFlightResult {
+    bool completed = false, failed = false;
+    double progress = 0.0;
+    double simulatedSeconds = 0.0, wallSeconds = 0.0;
+    long steps = 0;
+    ScenarioState finalState = ScenarioState::PreFlight;
+    double score = 0.0;
+    // False if the scenario's initial condition did not trim and the flight began from reset.
+    bool trimmed = true;
+};
+
+// One scenario flown by an agent with no window, timers or audio: the agent, physics, scenario
+// and metrics run in the same order as a SimulationEngine tick, as fast as the CPU allows.
+class AutoFlight {
+public:
+    AutoFlight(std::unique_ptr<Aircraft> aircraft, std::unique_ptr<TrainingScenario> scenario, std::unique_ptr<PilotAgent> agent);
+
+    void reset();
+    void step(double deltaTime, const ConfigSnapshot& config);
+    // Scenario completed or failed, or every waypoint reached.
+    bool finished() const;
+    // Steps until finished or `maxSeconds` of simulated time, then scores the flight.
+    AutoFlightResult run(double maxSeconds, const ConfigSnapshot& config);
+    // Sizes the metrics history for a flight of up to `maxSeconds`; run() does this itself.
+    void reserve(double maxSeconds, const ConfigSnapshot& config) { m_metrics.reserve(maxSeconds, config.physicsTimeStep()); }
+
+    const Aircraft& aircraft() const { return *m_aircraft; }
+    const TrainingScenario& scenario() const { return *m_scenario; }
+    const FlightMetrics& metrics() const { return m_metrics; }
+    PilotAgent& agent() { return *m_agent; }
+    double simulationTime() const { return m_simulationTime; }
+
+private:
+    std::unique_ptr<Aircraft> m_aircraft;
+    std::unique_ptr<TrainingScenario> m_scenario;
+    std::unique_ptr<PilotAgent> m_agent;
+    FlightMetrics m_metrics;
+    double m_simulationTime;
+    bool m_trimmed;
+};
+
+#endif
\ No newline at end of file
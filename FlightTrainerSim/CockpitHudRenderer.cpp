@@ -0,0 +1,283 @@
+// File: CockpitHudRenderer.cpp
+#include "CockpitHudRenderer.h"
+#include "Profiler.h"
+#include <QPainter>
+#include <QString>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    constexpr int kTapeWidth = 80, kTapeHeight = 300;
+    constexpr int kHeadingWidth = 400, kHeadingHeight = 50;
+    constexpr int kStripPad = 20;
+    constexpr int kSpeedTapeMax = 500;
+    constexpr double kSpeedScale = 2.0;
+    constexpr int kAltitudeTapeMax = 10000;
+    constexpr double kAltitudeScale = 0.1;
+    constexpr double kHeadingScale = 3.0;
+    constexpr int kHeadingStripMin = -90, kHeadingStripMax = 450;
+}
+
+CockpitHudRenderer::CockpitHudRenderer()
+    : m_tapeFont("Courier", 12, QFont::Bold), m_labelFont("Courier", 10, QFont::Bold), m_warningFont("Courier", 16, QFont::Bold)
+    , m_layout(), m_cacheDpr(0.0) {}
+
+void CockpitHudRenderer::render(QPainter& painter, const QSize& size, qreal devicePixelRatio) {
+    ensureCaches(size, devicePixelRatio);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    drawHUD(painter);
+}
+
+QImage CockpitHudRenderer::createLayer(int width, int height) const {
+    QImage layer(QSize(width, height) * m_cacheDpr, QImage::Format_ARGB32_Premultiplied);
+    layer.setDevicePixelRatio(m_cacheDpr);
+    layer.fill(Qt::transparent);
+    return layer;
+}
+
+void CockpitHudRenderer::ensureCaches(const QSize& size, qreal devicePixelRatio) {
+    if (devicePixelRatio != m_cacheDpr) {
+        m_cacheDpr = devicePixelRatio;
+        buildStrips();
+        buildReticle();
+        m_readoutGlyphs.build(m_tapeFont, hudWarningColor(), devicePixelRatio);
+        m_headingGlyphs.build(m_labelFont, hudWarningColor(), devicePixelRatio);
+        m_labelGlyphs.build(m_labelFont, hudSecondaryColor(), devicePixelRatio);
+        m_warningGlyphs.build(m_warningFont, hudCriticalColor(), devicePixelRatio);
+        m_chrome = QImage();
+    }
+    if (size != m_size) {
+        m_size = size;
+        m_chrome = QImage();
+    }
+    if (m_chrome.isNull()) buildChrome();
+}
+
+void CockpitHudRenderer::buildChrome() {
+    const int w = m_size.width(), h = m_size.height(), cx = w / 2, cy = h / 2;
+    m_layout.cx = cx;
+    m_layout.cy = cy;
+    m_layout.attitudeSize = 300;
+    m_layout.airspeed = QRect(50, cy - kTapeHeight / 2, kTapeWidth, kTapeHeight);
+    m_layout.altimeter = QRect(w - 50 - kTapeWidth, cy - kTapeHeight / 2, kTapeWidth, kTapeHeight);
+    m_layout.heading = QRect(cx - kHeadingWidth / 2, h - 80, kHeadingWidth, kHeadingHeight);
+    m_layout.verticalSpeed = QRect(w - 200, cy - 100, 40, 200);
+    m_layout.throttle = QRect(50, h - 200, 60, 150);
+
+    m_chrome = QImage(m_size * m_cacheDpr, QImage::Format_RGB32);
+    m_chrome.setDevicePixelRatio(m_cacheDpr);
+    m_chrome.fill(Qt::black);
+    QPainter painter(&m_chrome);
+    painter.setRenderHint(QPainter::Antialiasing);
+    const int size = m_layout.attitudeSize, radius = size / 2;
+    painter.setPen(QPen(hudPrimaryColor(), 3));
+    painter.setBrush(QBrush(QColor(0, 20, 0, 200)));
+    painter.drawEllipse(cx - radius, cy - radius, size, size);
+    painter.setPen(QPen(hudPrimaryColor(), 2));
+    painter.setBrush(QBrush(QColor(0, 20, 0, 150)));
+    for (const QRect& box : { m_layout.airspeed, m_layout.altimeter, m_layout.heading, m_layout.verticalSpeed, m_layout.throttle }) {
+        painter.drawRect(box);
+    }
+}
+
+void CockpitHudRenderer::buildReticle() {
+    // Aircraft symbol and crosshair, centred on the layer.
+    m_reticle = createLayer(104, 44);
+    QPainter painter(&m_reticle);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.translate(52, 22);
+    painter.setPen(QPen(hudWarningColor(), 4));
+    painter.drawLine(-50, 0, -15, 0);
+    painter.drawLine(15, 0, 50, 0);
+    painter.drawLine(0, -5, 0, 5);
+    painter.setPen(QPen(hudWarningColor(), 2));
+    const int size = 20;
+    painter.drawLine(-size, 0, size, 0);
+    painter.drawLine(0, -size, 0, size);
+    painter.drawEllipse(-3, -3, 6, 6);
+}
+
+void CockpitHudRenderer::buildStrips() {
+    // Scrolling tape strips: value v sits at row kStripPad + (max - v) * scale.
+    m_airspeedStrip = createLayer(kTapeWidth, static_cast<int>(kSpeedTapeMax * kSpeedScale) + 2 * kStripPad);
+    {
+        QPainter painter(&m_airspeedStrip);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::TextAntialiasing);
+        painter.setFont(m_tapeFont);
+        painter.setPen(hudPrimaryColor());
+        for (int s = 0; s <= kSpeedTapeMax; s += 20) {
+            const int rowY = kStripPad + static_cast<int>((kSpeedTapeMax - s) * kSpeedScale);
+            painter.drawLine(kTapeWidth - 15, rowY, kTapeWidth, rowY);
+            if (s % 40 == 0) painter.drawText(5, rowY + 5, QString::number(s));
+        }
+    }
+    m_altitudeStrip = createLayer(kTapeWidth, static_cast<int>(kAltitudeTapeMax * kAltitudeScale) + 2 * kStripPad);
+    {
+        QPainter painter(&m_altitudeStrip);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::TextAntialiasing);
+        painter.setFont(m_tapeFont);
+        painter.setPen(hudPrimaryColor());
+        for (int a = 0; a <= kAltitudeTapeMax; a += 200) {
+            const int rowY = kStripPad + static_cast<int>((kAltitudeTapeMax - a) * kAltitudeScale);
+            painter.drawLine(0, rowY, 15, rowY);
+            if (a % 500 == 0) painter.drawText(20, rowY + 5, QString::number(a));
+        }
+    }
+    // The heading strip runs a quarter turn past each end so any view window is contiguous.
+    m_headingStrip = createLayer(static_cast<int>((kHeadingStripMax - kHeadingStripMin) * kHeadingScale) + 1, kHeadingHeight);
+    {
+        QPainter painter(&m_headingStrip);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::TextAntialiasing);
+        painter.setFont(m_labelFont);
+        painter.setPen(hudPrimaryColor());
+        for (int d = kHeadingStripMin; d <= kHeadingStripMax; d += 10) {
+            const int colX = static_cast<int>((d - kHeadingStripMin) * kHeadingScale);
+            painter.drawLine(colX, 40, colX, 50);
+            if (d % 30 == 0) painter.drawText(colX - 10, 25, QString::number(((d + 360) % 360) / 10));
+        }
+    }
+}
+
+void CockpitHudRenderer::blitStrip(QPainter& painter, const QImage& strip, const QRect& target, double sourceX, double sourceY) const {
+    const QRectF source(sourceX, sourceY, target.width(), target.height());
+    const QRectF visible = source & QRectF(QPointF(0, 0), strip.deviceIndependentSize());
+    if (visible.isEmpty()) return;
+    const QRectF dest(target.left() + visible.left() - sourceX, target.top() + visible.top() - sourceY,
+                      visible.width(), visible.height());
+    painter.drawImage(dest, strip, QRectF(visible.topLeft() * m_cacheDpr, visible.size() * m_cacheDpr));
+}
+
+void CockpitHudRenderer::drawHUD(QPainter& painter) {
+    if (m_modelName.empty()) {
+        painter.fillRect(QRect(QPoint(0, 0), m_size), Qt::black);
+        painter.setPen(hudSecondaryColor());
+        painter.setFont(m_warningFont);
+        painter.drawText(QRect(QPoint(0, 0), m_size), Qt::AlignCenter, "NO AIRCRAFT DATA");
+        return;
+    }
+    painter.drawImage(0, 0, m_chrome);
+    const HudLayout& l = m_layout;
+    drawAttitudeIndicator(painter, l.cx, l.cy, l.attitudeSize);
+    drawAirspeedIndicator(painter, l.airspeed);
+    drawAltimeter(painter, l.altimeter);
+    drawHeadingIndicator(painter, l.heading);
+    drawVerticalSpeed(painter, l.verticalSpeed);
+    drawThrottleGauge(painter, l.throttle);
+    painter.drawImage(l.cx - 52, l.cy - 22, m_reticle);
+    drawWarnings(painter);
+    char fuel[32];
+    std::snprintf(fuel, sizeof(fuel), "FUEL: %d kg", static_cast<int>(m_state.fuel));
+    const int infoX = m_size.width() - 250, infoBaseline = 20 + m_labelGlyphs.ascent();
+    m_labelGlyphs.drawText(painter, infoX, infoBaseline, m_modelName.c_str());
+    m_labelGlyphs.drawText(painter, infoX, infoBaseline + m_labelGlyphs.lineSpacing(), fuel);
+}
+
+void CockpitHudRenderer::drawAttitudeIndicator(QPainter& painter, int cx, int cy, int size) {
+    PROFILE_SCOPE(ProfileStage::HudAttitude);
+    painter.save();
+    int radius = size / 2;
+    painter.translate(cx, cy);
+    painter.rotate(-m_state.bank);
+    int pitchPixels = static_cast<int>(m_state.pitch * 3.0);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QBrush(QColor(50, 100, 200, 150)));
+    painter.drawRect(-radius, -radius, size, radius + pitchPixels);
+    painter.setBrush(QBrush(QColor(139, 115, 85, 150)));
+    painter.drawRect(-radius, pitchPixels, size, radius - pitchPixels);
+    painter.setPen(QPen(hudPrimaryColor(), 3));
+    painter.drawLine(-radius, pitchPixels, radius, pitchPixels);
+    painter.restore();
+}
+
+void CockpitHudRenderer::drawAirspeedIndicator(QPainter& painter, const QRect& box) {
+    PROFILE_SCOPE(ProfileStage::HudAirspeed);
+    double speed = m_state.speed;
+    int centerY = box.top() + box.height() / 2;
+    blitStrip(painter, m_airspeedStrip, box, 0.0, kStripPad + (kSpeedTapeMax - speed) * kSpeedScale - box.height() / 2);
+    if (m_state.maxSpeed > 0.0) {
+        // Envelope cues along the tape's right edge: red below stall and above max speed, a
+        // marker at best climb.
+        auto tapeY = [&](double v) { return std::clamp(static_cast<int>(centerY + (speed - v) * kSpeedScale), box.top(), box.bottom()); };
+        const int bandX = box.right() - 5;
+        const int stallY = tapeY(m_state.stallSpeed), maxY = tapeY(m_state.maxSpeed);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QBrush(hudCriticalColor()));
+        painter.drawRect(bandX, stallY, 5, box.bottom() - stallY);
+        painter.drawRect(bandX, box.top(), 5, maxY - box.top());
+        painter.setPen(QPen(hudPrimaryColor(), 3));
+        const int climbY = tapeY(m_state.bestClimbSpeed);
+        painter.drawLine(bandX - 8, climbY, box.right(), climbY);
+    }
+    painter.setPen(QPen(hudWarningColor(), 2));
+    painter.setBrush(QBrush(QColor(0, 0, 0, 200)));
+    QRect speedBox(box.left() + 10, centerY - 15, box.width() - 20, 30);
+    painter.drawRect(speedBox);
+    char text[16];
+    std::snprintf(text, sizeof(text), "%d", static_cast<int>(speed));
+    m_readoutGlyphs.drawText(painter, speedBox, Qt::AlignCenter, text);
+}
+
+void CockpitHudRenderer::drawAltimeter(QPainter& painter, const QRect& box) {
+    PROFILE_SCOPE(ProfileStage::HudAltimeter);
+    double alt = m_state.position.z;
+    int centerY = box.top() + box.height() / 2;
+    blitStrip(painter, m_altitudeStrip, box, 0.0, kStripPad + (kAltitudeTapeMax - alt) * kAltitudeScale - box.height() / 2);
+    painter.setPen(QPen(hudWarningColor(), 2));
+    painter.setBrush(QBrush(QColor(0, 0, 0, 200)));
+    QRect altBox(box.left() + 10, centerY - 15, box.width() - 20, 30);
+    painter.drawRect(altBox);
+    char text[16];
+    std::snprintf(text, sizeof(text), "%d", static_cast<int>(alt));
+    m_readoutGlyphs.drawText(painter, altBox, Qt::AlignCenter, text);
+}
+
+void CockpitHudRenderer::drawHeadingIndicator(QPainter& painter, const QRect& box) {
+    PROFILE_SCOPE(ProfileStage::HudHeading);
+    double heading = std::fmod(m_state.heading, 360.0);
+    if (heading < 0) heading += 360.0;
+    int centerX = box.left() + box.width() / 2;
+    blitStrip(painter, m_headingStrip, box, (heading - kHeadingStripMin) * kHeadingScale - box.width() / 2, 0.0);
+    painter.setPen(QPen(hudWarningColor(), 3));
+    painter.drawLine(centerX, box.top(), centerX, box.top() + box.height());
+    char text[16];
+    std::snprintf(text, sizeof(text), "%d\xB0", static_cast<int>(m_state.heading));
+    m_headingGlyphs.drawText(painter, centerX - 15, box.top() + 15, text);
+}
+
+void CockpitHudRenderer::drawVerticalSpeed(QPainter& painter, const QRect& box) {
+    PROFILE_SCOPE(ProfileStage::HudVerticalSpeed);
+    double vs = m_state.verticalSpeed;
+    int centerY = box.top() + box.height() / 2;
+    int pointerY = centerY - static_cast<int>(vs * 4.0);
+    pointerY = std::clamp(pointerY, box.top(), box.top() + box.height());
+    painter.setPen(QPen(hudWarningColor(), 3));
+    painter.drawLine(box.left(), pointerY, box.left() + box.width(), pointerY);
+}
+
+void CockpitHudRenderer::drawThrottleGauge(QPainter& painter, const QRect& box) {
+    PROFILE_SCOPE(ProfileStage::HudThrottle);
+    double throttle = m_state.throttle;
+    int fillHeight = static_cast<int>(throttle * box.height());
+    painter.setPen(QPen(hudPrimaryColor(), 2));
+    painter.setBrush(QBrush(hudPrimaryColor()));
+    painter.drawRect(box.left() + 5, box.top() + box.height() - fillHeight, box.width() - 10, fillHeight);
+    char text[16];
+    std::snprintf(text, sizeof(text), "THR %d%%", static_cast<int>(throttle * 100));
+    m_labelGlyphs.drawText(painter, box.left(), box.top() + box.height() + 15, text);
+}
+
+void CockpitHudRenderer::drawWarnings(QPainter& painter) {
+    PROFILE_SCOPE(ProfileStage::HudWarnings);
+    const char* warnings[4];
+    int count = 0;
+    if (m_state.stalled) warnings[count++] = "STALL";
+    if (m_state.overspeed) warnings[count++] = "OVERSPEED";
+    if (m_state.fuel < 100.0) warnings[count++] = "LOW FUEL";
+    if (m_state.position.z < 50 && !m_state.onGround) warnings[count++] = "ALTITUDE";
+    for (int i = 0; i < count; ++i) m_warningGlyphs.drawText(painter, 20, 60 + i * 30, warnings[i]);
+}
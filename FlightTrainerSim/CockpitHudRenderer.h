@@ -0,0 +1,61 @@
+// File: CockpitHudRenderer.h
+#ifndef COCKPITHUDRENDERER_H
+#define COCKPITHUDRENDERER_H
+
+#include "HudGlyphAtlas.h"
+#include "RenderState.h"
+#include <QImage>
+#include <QFont>
+#include <QColor>
+#include <QRect>
+#include <QSize>
+#include <string>
+
+class QPainter;
+
+// Draws the cockpit HUD for one render state. Owns no widget, and all caches are QImages, so an
+// instance can paint a window or an offscreen frame on any thread (one instance per thread).
+class CockpitHudRenderer {
+public:
+    CockpitHudRenderer();
+    // An empty model name means no aircraft is attached.
+    void setAircraftModel(const std::string& modelName) { m_modelName = modelName; }
+    void setRenderState(const AircraftRenderState& state) { m_state = state; }
+    const AircraftRenderState& renderState() const { return m_state; }
+    void render(QPainter& painter, const QSize& size, qreal devicePixelRatio);
+private:
+    struct HudLayout {
+        int cx, cy, attitudeSize;
+        QRect airspeed, altimeter, heading, verticalSpeed, throttle;
+    };
+    AircraftRenderState m_state;
+    std::string m_modelName;
+    QFont m_tapeFont, m_labelFont, m_warningFont;
+    HudLayout m_layout;
+    QSize m_size;
+    // Static chrome is rebuilt on resize; tape strips and glyph atlases only when the device pixel ratio changes.
+    QImage m_chrome, m_reticle;
+    QImage m_airspeedStrip, m_altitudeStrip, m_headingStrip;
+    HudGlyphAtlas m_readoutGlyphs, m_headingGlyphs, m_labelGlyphs, m_warningGlyphs;
+    qreal m_cacheDpr;
+    void ensureCaches(const QSize& size, qreal devicePixelRatio);
+    void buildChrome();
+    void buildReticle();
+    void buildStrips();
+    QImage createLayer(int width, int height) const;
+    void blitStrip(QPainter& painter, const QImage& strip, const QRect& target, double sourceX, double sourceY) const;
+    void drawHUD(QPainter& painter);
+    void drawAttitudeIndicator(QPainter& painter, int cx, int cy, int size);
+    void drawAirspeedIndicator(QPainter& painter, const QRect& box);
+    void drawAltimeter(QPainter& painter, const QRect& box);
+    void drawHeadingIndicator(QPainter& painter, const QRect& box);
+    void drawVerticalSpeed(QPainter& painter, const QRect& box);
+    void drawThrottleGauge(QPainter& painter, const QRect& box);
+    void drawWarnings(QPainter& painter);
+    QColor hudPrimaryColor() const { return QColor(0, 255, 0); }
+    QColor hudSecondaryColor() const { return QColor(255, 255, 255); }
+    QColor hudWarningColor() const { return QColor(255, 170, 0); }
+    QColor hudCriticalColor() const { return QColor(255, 0, 0); }
+};
+
+#endif
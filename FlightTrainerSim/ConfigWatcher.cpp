@@ -0,0 +1,40 @@
+// File: ConfigWatcher.cpp
+#include "ConfigWatcher.h"
+#include "GlobalConfig.h"
+#include <QFileInfo>
+
+ConfigWatcher::ConfigWatcher(const QString& path, QObject* parent)
+    : QObject(parent), m_path(QFileInfo(path).absoluteFilePath()), m_lastSize(-1) {
+    const QFileInfo info(m_path);
+    if (info.exists()) {
+        m_watcher.addPath(m_path);
+        m_lastModified = info.lastModified();
+        m_lastSize = info.size();
+    }
+    m_watcher.addPath(info.absolutePath());
+    // A save arrives as several notifications; settle before reading.
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(100);
+    connect(&m_debounce, &QTimer::timeout, this, &ConfigWatcher::reload);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &ConfigWatcher::onPathChanged);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ConfigWatcher::onPathChanged);
+}
+
+void ConfigWatcher::onPathChanged() {
+    m_debounce.start();
+}
+
+void ConfigWatcher::reload() {
+    const QFileInfo info(m_path);
+    if (!info.exists()) return;
+    // A replaced file drops out of the watch list.
+    if (!m_watcher.files().contains(m_path)) m_watcher.addPath(m_path);
+    if (info.lastModified() == m_lastModified && info.size() == m_lastSize) return;
+    m_lastModified = info.lastModified();
+    m_lastSize = info.size();
+
+    auto& config = GlobalConfig::instance();
+    std::string error;
+    if (config.loadFile(m_path.toStdString(), error)) emit configReloaded(config.snapshot().version);
+    else emit reloadFailed(QString::fromStdString(error));
+}
@@ -0,0 +1,35 @@
+// File: ConfigWatcher.h
+#ifndef CONFIGWATCHER_H
+#define CONFIGWATCHER_H
+
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+// Reloads GlobalConfig from its file when the file is edited, replaced or created. The parent
+// directory is watched too, since editors often save by writing a new file and renaming it.
+class ConfigWatcher : public QObject {
+    Q_OBJECT
+public:
+    explicit ConfigWatcher(const QString& path, QObject* parent = nullptr);
+    const QString& path() const { return m_path; }
+
+signals:
+    void configReloaded(quint64 version);
+    void reloadFailed(const QString& error);
+
+private slots:
+    void onPathChanged();
+    void reload();
+
+private:
+    QString m_path;
+    QFileSystemWatcher m_watcher;
+    QTimer m_debounce;
+    QDateTime m_lastModified;
+    qint64 m_lastSize;
+};
+
+#endif
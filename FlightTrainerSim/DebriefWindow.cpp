@@ -6,6 +6,18 @@
 #include <QHeaderView>
 #include <QFont>
 
+namespace {
+    // One point per snapshot, or its low and high when it merged several samples, so the chart's
+    // min/max columns still reach every peak of a decimated session.
+    void appendEnvelope(std::vector<double>& times, std::vector<double>& values, double t, double lo, double hi) {
+        times.push_back(t);
+        values.push_back(lo);
+        if (hi == lo) return;
+        times.push_back(t);
+        values.push_back(hi);
+    }
+}
+
 DebriefWindow::DebriefWindow(QWidget* parent) : QDialog(parent) {
     setupUI();
     resize(800, 600);
@@ -20,10 +32,13 @@ void DebriefWindow::setupUI() {
     titleLabel->setAlignment(Qt::AlignCenter);
     titleLabel->setStyleSheet("background-color: #1a5490; color: white; padding: 10px;");
     mainLayout->addWidget(titleLabel);
+    m_tabs = new QTabWidget();
+    auto* summaryTab = new QWidget();
+    auto* summaryLayout = new QVBoxLayout(summaryTab);
     m_summaryText = new QTextEdit();
     m_summaryText->setReadOnly(true);
     m_summaryText->setFont(QFont("Courier", 10));
-    mainLayout->addWidget(m_summaryText);
+    summaryLayout->addWidget(m_summaryText);
     m_scoresTable = new QTableWidget();
     m_scoresTable->setColumnCount(2);
     m_scoresTable->setHorizontalHeaderLabels({"Category", "Score"});
@@ -31,7 +46,10 @@ void DebriefWindow::setupUI() {
     m_scoresTable->verticalHeader()->setVisible(false);
     m_scoresTable->setAlternatingRowColors(true);
     m_scoresTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    mainLayout->addWidget(m_scoresTable);
+    summaryLayout->addWidget(m_scoresTable);
+    m_tabs->addTab(summaryTab, "Summary");
+    m_tabs->addTab(createChartsTab(), "Flight Data");
+    mainLayout->addWidget(m_tabs);
     auto* buttonLayout = new QHBoxLayout();
     buttonLayout->addStretch();
     m_closeButton = new QPushButton("Close");
@@ -41,6 +59,42 @@ void DebriefWindow::setupUI() {
     mainLayout->addLayout(buttonLayout);
 }
 
+QWidget* DebriefWindow::createChartsTab() {
+    auto* tab = new QWidget();
+    auto* layout = new QVBoxLayout(tab);
+    m_altitudeChart = new TimeSeriesChart("Altitude", "ft", QColor(0, 200, 255));
+    m_speedChart = new TimeSeriesChart("Airspeed", "kts", QColor(0, 230, 120));
+    m_verticalSpeedChart = new TimeSeriesChart("Vertical Speed", "ft/min", QColor(255, 190, 0));
+    TimeSeriesChart* charts[] = { m_altitudeChart, m_speedChart, m_verticalSpeedChart };
+    for (auto* source : charts) {
+        for (auto* target : charts) {
+            if (source != target) connect(source, &TimeSeriesChart::viewChanged, target, &TimeSeriesChart::setView);
+        }
+    }
+    layout->addWidget(m_altitudeChart);
+    layout->addWidget(m_speedChart);
+    layout->addWidget(m_verticalSpeedChart);
+    auto* hint = new QLabel("Scroll to zoom, drag to pan, double-click to reset");
+    hint->setStyleSheet("color: gray;");
+    layout->addWidget(hint);
+    return tab;
+}
+
+void DebriefWindow::setChartData(const FlightMetrics& metrics) {
+    const auto& snapshots = metrics.snapshots();
+    std::vector<double> altitudeTimes, speedTimes, verticalSpeedTimes, altitude, speed, verticalSpeed;
+    for (auto* series : { &altitudeTimes, &speedTimes, &verticalSpeedTimes, &altitude, &speed, &verticalSpeed })
+        series->reserve(metrics.snapshotStride() > 1 ? 2 * snapshots.size() : snapshots.size());
+    for (const auto& s : snapshots) {
+        appendEnvelope(altitudeTimes, altitude, s.timestamp, s.altitudeMin, s.altitudeMax);
+        appendEnvelope(speedTimes, speed, s.timestamp, s.speedMin, s.speedMax);
+        appendEnvelope(verticalSpeedTimes, verticalSpeed, s.timestamp, s.verticalSpeedMin, s.verticalSpeedMax);
+    }
+    m_altitudeChart->setSeries(std::move(altitudeTimes), altitude);
+    m_speedChart->setSeries(std::move(speedTimes), speed);
+    m_verticalSpeedChart->setSeries(std::move(verticalSpeedTimes), verticalSpeed);
+}
+
 void DebriefWindow::setReport(const DebriefReport& report, const FlightMetrics& metrics) {
     m_summaryText->setPlainText(QString::fromStdString(report.summaryText()));
     QString recText = "\n\nRecommendations:\n";
@@ -64,4 +118,5 @@ void DebriefWindow::setReport(const DebriefReport& report, const FlightMetrics&
         row++;
     }
     m_scoresTable->resizeColumnsToContents();
+    setChartData(metrics);
 }
@@ -3,10 +3,12 @@
 #define DEBRIEFWINDOW_H
 
 #include "FlightMetrics.h"
+#include "TimeSeriesChart.h"
 #include <QDialog>
 #include <QTextEdit>
 #include <QTableWidget>
 #include <QPushButton>
+#include <QTabWidget>
 
 class DebriefWindow : public QDialog {
     Q_OBJECT
@@ -17,7 +19,13 @@ private:
     QTextEdit* m_summaryText;
     QTableWidget* m_scoresTable;
     QPushButton* m_closeButton;
+    QTabWidget* m_tabs;
+    TimeSeriesChart* m_altitudeChart;
+    TimeSeriesChart* m_speedChart;
+    TimeSeriesChart* m_verticalSpeedChart;
     void setupUI();
+    QWidget* createChartsTab();
+    void setChartData(const FlightMetrics& metrics);
 };
 
 #endif
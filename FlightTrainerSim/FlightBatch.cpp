@@ -0,0 +1,159 @@
+// File: FlightBatch.cpp
+#include "FlightBatch.h"
+#include "FlightKernel.h"
+#include "GlobalConfig.h"
+#include <cmath>
+
+template <typename T>
+FlightBatch<T>::FlightBatch(const FlightModelParams& params)
+    : m_params(params), m_rebaseDistance(kDefaultRebaseDistance), m_count(0) {}
+
+template <typename T>
+size_t FlightBatch<T>::add(const Aircraft& aircraft) {
+    if (m_count % kLanes == 0) m_blocks.push_back(Block{});
+    const size_t index = m_count++;
+    Block& block = m_blocks.back();
+    const Position3D& position = aircraft.position();
+    const Orientation& orientation = aircraft.orientation();
+    const FlightState& state = aircraft.flightState();
+    // Same rule as rebase(): close enough to the world origin, the position is used as it is.
+    const bool local = std::abs(position.x) > m_rebaseDistance || std::abs(position.y) > m_rebaseDistance;
+    m_originX.push_back(local ? position.x : 0.0);
+    m_originY.push_back(local ? position.y : 0.0);
+    lane(block.x, index) = local ? T(0) : T(position.x);
+    lane(block.y, index) = local ? T(0) : T(position.y);
+    lane(block.z, index) = T(position.z);
+    lane(block.heading, index) = T(orientation.heading);
+    lane(block.pitch, index) = T(orientation.pitch);
+    lane(block.bank, index) = T(orientation.bank);
+    lane(block.velocityX, index) = T(state.velocityX);
+    lane(block.velocityY, index) = T(state.velocityY);
+    lane(block.velocityZ, index) = T(state.velocityZ);
+    lane(block.rateX, index) = T(state.angularVelocityX);
+    lane(block.rateY, index) = T(state.angularVelocityY);
+    lane(block.rateZ, index) = T(state.angularVelocityZ);
+    lane(block.thrust, index) = T(state.thrust);
+    lane(block.drag, index) = T(state.drag);
+    lane(block.lift, index) = T(state.lift);
+    lane(block.fuel, index) = T(aircraft.fuel());
+    setControls(index, aircraft.controls());
+    return index;
+}
+
+template <typename T>
+void FlightBatch<T>::clear() {
+    m_count = 0;
+    m_blocks.clear();
+    m_originX.clear();
+    m_originY.clear();
+}
+
+template <typename T>
+void FlightBatch<T>::setControls(size_t index, const ControlInputs& controls) {
+    Block& block = m_blocks[index / kLanes];
+    lane(block.elevator, index) = T(controls.elevator);
+    lane(block.aileron, index) = T(controls.aileron);
+    lane(block.rudder, index) = T(controls.rudder);
+    lane(block.throttle, index) = T(controls.throttle);
+    lane(block.flaps, index) = T(controls.flaps);
+}
+
+template <typename T>
+void FlightBatch<T>::step(double deltaTime, const ConfigSnapshot& config) {
+    const FlightModelParams params = m_params;
+    for (Block& block : m_blocks) {
+        stepBlock(block, params, T(deltaTime), T(config.gravity), T(config.maxAltitude), T(config.maxSpeed));
+    }
+    rebase();
+}
+
+template <typename T>
+void FlightBatch<T>::stepBlock(Block& b, const FlightModelParams& params, T deltaTime, T gravity, T maxAltitude, T maxSpeed) {
+    // exp() stays scalar without a vector math library, so it gets its own loop.
+    for (size_t i = 0; i < kLanes; ++i) b.density[i] = airDensity(b.z[i]);
+
+    // Each aircraft is worked on in locals and stored back whole: a kernel writing through
+    // references into the block only on some paths would become a conditional store, which
+    // keeps the loop from being vectorized.
+    const T fuelRate = T(params.fuelConsumptionRate);
+    for (size_t i = 0; i < kLanes; ++i) {
+        const T fuel = b.fuel[i];
+        const T throttle = fuel <= T(0) ? T(0) : b.throttle[i];
+        T x = b.x[i], y = b.y[i], z = b.z[i];
+        T heading = b.heading[i], pitch = b.pitch[i], bank = b.bank[i];
+        BasicFlightState<T> state;
+        state.velocityX = b.velocityX[i];
+        state.velocityY = b.velocityY[i];
+        state.velocityZ = b.velocityZ[i];
+        BasicFlightState<T> next;
+        computeFlightForces(params, state, b.elevator[i], b.aileron[i], b.rudder[i], throttle, b.flaps[i],
+                            b.density[i], deltaTime, gravity, next);
+        integratePosition(next, x, y, z, deltaTime);
+        advanceOrientation(next, heading, pitch, bank);
+        applyFlightLimits(next, z, maxAltitude, maxSpeed);
+
+        b.throttle[i] = throttle;
+        b.fuel[i] = std::max(fuel - fuelRate * throttle * deltaTime, T(0));
+        b.x[i] = x;
+        b.y[i] = y;
+        b.z[i] = z;
+        b.heading[i] = heading;
+        b.pitch[i] = pitch;
+        b.bank[i] = bank;
+        b.velocityX[i] = next.velocityX;
+        b.velocityY[i] = next.velocityY;
+        b.velocityZ[i] = next.velocityZ;
+        b.rateX[i] = next.angularVelocityX;
+        b.rateY[i] = next.angularVelocityY;
+        b.rateZ[i] = next.angularVelocityZ;
+        b.thrust[i] = next.thrust;
+        b.drag[i] = next.drag;
+        b.lift[i] = next.lift;
+    }
+}
+
+template <typename T>
+void FlightBatch<T>::rebase() {
+    const T limit = T(m_rebaseDistance);
+    for (size_t index = 0; index < m_count; ++index) {
+        Block& block = m_blocks[index / kLanes];
+        T& x = lane(block.x, index);
+        T& y = lane(block.y, index);
+        if (std::abs(x) > limit || std::abs(y) > limit) {
+            m_originX[index] += x;
+            m_originY[index] += y;
+            x = y = T(0);
+        }
+    }
+}
+
+template <typename T>
+Position3D FlightBatch<T>::position(size_t index) const {
+    const Block& block = m_blocks[index / kLanes];
+    return { m_originX[index] + lane(block.x, index), m_originY[index] + lane(block.y, index), double(lane(block.z, index)) };
+}
+
+template <typename T>
+Orientation FlightBatch<T>::orientation(size_t index) const {
+    const Block& block = m_blocks[index / kLanes];
+    return { double(lane(block.heading, index)), double(lane(block.pitch, index)), double(lane(block.bank, index)) };
+}
+
+template <typename T>
+BasicFlightState<T> FlightBatch<T>::flightState(size_t index) const {
+    const Block& block = m_blocks[index / kLanes];
+    BasicFlightState<T> state;
+    state.velocityX = lane(block.velocityX, index);
+    state.velocityY = lane(block.velocityY, index);
+    state.velocityZ = lane(block.velocityZ, index);
+    state.angularVelocityX = lane(block.rateX, index);
+    state.angularVelocityY = lane(block.rateY, index);
+    state.angularVelocityZ = lane(block.rateZ, index);
+    state.thrust = lane(block.thrust, index);
+    state.drag = lane(block.drag, index);
+    state.lift = lane(block.lift, index);
+    return state;
+}
+
+template class FlightBatch<float>;
+template class FlightBatch<double>;
@@ -0,0 +1,78 @@
+// File: FlightBatch.h
+#ifndef FLIGHTBATCH_H
+#define FLIGHTBATCH_H
+
+#include "Aircraft.h"
+#include <cstddef>
+#include <vector>
+
+struct ConfigSnapshot;
+
+// Many aircraft of one flight model stepped together, for batch sweeps. State is kept
+// in blocks of kLanes aircraft with one array per field, and step() runs the FlightKernel math
+// across each block in a loop the compiler vectorizes, so FlightBatch<float> processes twice as
+// many aircraft per instruction as FlightBatch<double>. The simulated aircraft itself stays an
+// Aircraft, in double.
+//
+// Float loses resolution far from the world origin (0.25 ft at 3,000,000 ft), so each aircraft
+// keeps its horizontal position as a float offset from its own double-precision origin. Once the
+// offset passes rebaseDistance() it is folded into the origin, which bounds the rounding of every
+// step to what float gives near zero no matter where the aircraft is. Altitude stays absolute: it
+// is bounded by the ceiling anyway, and ground contact and air density need it.
+template <typename T>
+class FlightBatch {
+public:
+    static constexpr double kDefaultRebaseDistance = 4096.0;
+
+    explicit FlightBatch(const FlightModelParams& params);
+
+    // Copies the aircraft's position, orientation, state, controls and fuel; returns its index.
+    size_t add(const Aircraft& aircraft);
+    void clear();
+    size_t size() const { return m_count; }
+
+    void setControls(size_t index, const ControlInputs& controls);
+    // One physics step for every aircraft, as Aircraft::update does it (without the flight path).
+    void step(double deltaTime, const ConfigSnapshot& config);
+
+    Position3D position(size_t index) const;
+    Orientation orientation(size_t index) const;
+    BasicFlightState<T> flightState(size_t index) const;
+    double fuel(size_t index) const { return lane(m_blocks[index / kLanes].fuel, index); }
+
+    double rebaseDistance() const { return m_rebaseDistance; }
+    // Infinity keeps positions absolute; only useful to measure what the local origin buys. Set it
+    // before add(), which places new aircraft by the same rule.
+    void setRebaseDistance(double distance) { m_rebaseDistance = distance; }
+
+private:
+    static constexpr size_t kLanes = 16;
+    // Fields of one block share a base address, so unlike separate arrays the compiler can see
+    // that they never overlap and needs no run-time alias checks to vectorize.
+    struct alignas(64) Block {
+        T x[kLanes], y[kLanes], z[kLanes];             // x, y relative to the origin; z absolute
+        T heading[kLanes], pitch[kLanes], bank[kLanes];
+        T velocityX[kLanes], velocityY[kLanes], velocityZ[kLanes];
+        T rateX[kLanes], rateY[kLanes], rateZ[kLanes];
+        T thrust[kLanes], drag[kLanes], lift[kLanes];
+        T elevator[kLanes], aileron[kLanes], rudder[kLanes], throttle[kLanes], flaps[kLanes];
+        T fuel[kLanes];
+        T density[kLanes];                              // scratch: air density per aircraft
+    };
+
+    static T lane(const T (&field)[kLanes], size_t index) { return field[index % kLanes]; }
+    static T& lane(T (&field)[kLanes], size_t index) { return field[index % kLanes]; }
+    static void stepBlock(Block& block, const FlightModelParams& params, T deltaTime, T gravity, T maxAltitude, T maxSpeed);
+    void rebase();
+
+    FlightModelParams m_params;
+    double m_rebaseDistance;
+    size_t m_count;
+    std::vector<Block> m_blocks;                        // unused lanes of the last one are zero
+    std::vector<double> m_originX, m_originY;
+};
+
+extern template class FlightBatch<float>;
+extern template class FlightBatch<double>;
+
+#endif
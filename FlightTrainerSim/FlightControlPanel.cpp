@@ -89,12 +89,14 @@ void FlightControlPanel::onAutopilotToggled(bool enabled) {
     m_elevatorSlider->setEnabled(!enabled);
     m_aileronSlider->setEnabled(!enabled);
     m_rudderSlider->setEnabled(!enabled);
+    m_throttleSlider->setEnabled(!enabled);
     if (enabled) {
         m_elevatorSlider->setValue(0);
         m_aileronSlider->setValue(0);
         m_rudderSlider->setValue(0);
     }
     onControlChanged();
+    emit autopilotToggled(enabled);
 }
 
 void FlightControlPanel::updateLabels() {
@@ -16,6 +16,7 @@ public:
     ControlInputs getControls() const;
 signals:
     void controlsChanged(const ControlInputs& controls);
+    void autopilotToggled(bool enabled);
 private slots:
     void onControlChanged();
     void onAutopilotToggled(bool enabled);
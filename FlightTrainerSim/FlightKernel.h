@@ -0,0 +1,106 @@
+// File: FlightKernel.h
+#ifndef FLIGHTKERNEL_H
+#define FLIGHTKERNEL_H
+
+#include "IFlightModel.h"
+#include <algorithm>
+#include <cmath>
+
+// The per-step flight math, templated on the scalar. Aircraft runs it in double; FlightBatch runs it
+// in float or double over arrays. The bodies are written without data-dependent branches so a
+// loop over many aircraft vectorizes, and in double they give bit-for-bit the same results as the
+// original per-model code.
+
+template <typename T>
+inline T airDensity(T altitude) {
+    return T(1.225) * std::exp(-altitude / T(10000));
+}
+
+template <typename T>
+inline T flightSpeed(const BasicFlightState<T>& state) {
+    return std::sqrt(state.velocityX * state.velocityX + state.velocityY * state.velocityY + state.velocityZ * state.velocityZ);
+}
+
+// New velocities, rates and forces from the current state. `density` is airDensity(altitude).
+template <typename T>
+inline void computeFlightForces(const FlightModelParams& p, const BasicFlightState<T>& state,
+                                T elevator, T aileron, T rudder, T throttle, T flaps,
+                                T density, T deltaTime, T gravity, BasicFlightState<T>& out) {
+    const T mass = T(p.mass), wingArea = T(p.wingArea), afterburnerBoost = T(p.afterburnerBoost);
+    const T speed = std::max(flightSpeed(state), T(1));   // no division by zero
+    const T q = T(0.5) * density * speed * speed;
+
+    const T boost = throttle > T(p.afterburnerThrottle) ? afterburnerBoost : T(1);
+    const T thrust = throttle * T(p.maxThrust) * boost;
+    const T drag = q * wingArea * (T(p.dragCoeff) + flaps * T(p.flapDrag));
+    const T lift = q * wingArea * (T(p.liftCoeff) + flaps * T(p.flapLift)) * (T(1) + elevator * T(p.elevatorLift));
+    const T weight = mass * gravity;
+
+    const T accelX = (thrust - drag) / mass;
+    const T accelY = (aileron * T(p.sideForce)) * q / mass;
+    const T accelZ = (lift - weight) / mass + (elevator * T(p.elevatorClimb));
+
+    out.velocityX = state.velocityX + accelX * deltaTime;
+    out.velocityY = state.velocityY + accelY * deltaTime;
+    out.velocityZ = state.velocityZ + accelZ * deltaTime;
+    out.angularVelocityX = aileron * T(p.bankRate) * deltaTime;
+    out.angularVelocityY = elevator * T(p.pitchRate) * deltaTime;
+    out.angularVelocityZ = rudder * T(p.yawRate) * deltaTime;
+    out.thrust = thrust;
+    out.drag = drag;
+    out.lift = lift;
+}
+
+// Moves the position by the velocity, then resolves ground contact: no sinking, rolling friction,
+// and a dead stop below 5 units of speed.
+template <typename T>
+inline void integratePosition(BasicFlightState<T>& state, T& x, T& y, T& z, T deltaTime) {
+    x += state.velocityX * deltaTime;
+    y += state.velocityY * deltaTime;
+    z += state.velocityZ * deltaTime;
+
+    // Both sides of every select are computed up front, so nothing branches.
+    const bool ground = z <= T(0);
+    const T noSink = std::max(state.velocityZ, T(0));
+    const T rolledX = state.velocityX * T(0.95), rolledY = state.velocityY * T(0.95);
+    z = ground ? T(0) : z;
+    state.velocityZ = ground ? noSink : state.velocityZ;
+    state.velocityX = ground ? rolledX : state.velocityX;
+    state.velocityY = ground ? rolledY : state.velocityY;
+    const bool slow = flightSpeed(state) < T(5);
+    const bool stopped = ground & slow;
+    state.velocityX = stopped ? T(0) : state.velocityX;
+    state.velocityY = stopped ? T(0) : state.velocityY;
+}
+
+// Applies the rates, wraps heading into [0, 360), clamps and damps pitch and bank. A step turns
+// far less than a full circle, so one wrap either way is enough.
+template <typename T>
+inline void advanceOrientation(const BasicFlightState<T>& state, T& heading, T& pitch, T& bank) {
+    bank += state.angularVelocityX;
+    pitch += state.angularVelocityY;
+    heading += state.angularVelocityZ;
+    const T wrappedDown = heading - T(360);
+    heading = heading >= T(360) ? wrappedDown : heading;
+    const T wrappedUp = heading + T(360);
+    heading = heading < T(0) ? wrappedUp : heading;
+    pitch = std::min(std::max(pitch, T(-90)), T(90)) * T(0.98);
+    bank = std::min(std::max(bank, T(-180)), T(180)) * T(0.98);
+}
+
+// Altitude ceiling (no further climb at it) and overall speed limit.
+template <typename T>
+inline void applyFlightLimits(BasicFlightState<T>& state, T& z, T maxAltitude, T maxSpeed) {
+    const bool ceiling = z > maxAltitude;
+    const T noClimb = std::min(T(0), state.velocityZ);
+    z = ceiling ? maxAltitude : z;
+    state.velocityZ = ceiling ? noClimb : state.velocityZ;
+
+    // Exactly 1 at or under the limit; dividing unconditionally keeps the division off a branch.
+    const T scale = maxSpeed / std::max(flightSpeed(state), maxSpeed);
+    state.velocityX *= scale;
+    state.velocityY *= scale;
+    state.velocityZ *= scale;
+}
+
+#endif
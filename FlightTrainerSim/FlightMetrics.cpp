@@ -1,12 +1,51 @@
 // File: FlightMetrics.cpp
 #include "FlightMetrics.h"
+#include "FlightRecorder.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <sstream>
 
-FlightMetrics::FlightMetrics() : m_stallCount(0) {}
-void FlightMetrics::reset() { m_snapshots.clear(); m_deviations.clear(); m_stallCount = 0; }
+namespace {
+    // A snapshot of one sample spans only its own values.
+    void widen(MetricSnapshot& s) {
+        s.altitudeMin = s.altitudeMax = s.altitude;
+        s.speedMin = s.speedMax = s.speed;
+        s.verticalSpeedMin = s.verticalSpeedMax = s.verticalSpeed;
+    }
+
+    void merge(MetricSnapshot& into, const MetricSnapshot& later) {
+        into.altitudeMin = std::min(into.altitudeMin, later.altitudeMin);
+        into.altitudeMax = std::max(into.altitudeMax, later.altitudeMax);
+        into.speedMin = std::min(into.speedMin, later.speedMin);
+        into.speedMax = std::max(into.speedMax, later.speedMax);
+        into.verticalSpeedMin = std::min(into.verticalSpeedMin, later.verticalSpeedMin);
+        into.verticalSpeedMax = std::max(into.verticalSpeedMax, later.verticalSpeedMax);
+        into.stalled = into.stalled || later.stalled;
+        into.overspeed = into.overspeed || later.overspeed;
+    }
+}
+
+FlightMetrics::FlightMetrics() { reset(); }
+
+void FlightMetrics::reset() {
+    m_snapshots.clear();
+    m_deviations.clear();
+    m_stallCount = 0;
+    m_overspeedCount = 0;
+    m_sampleCount = 0;
+    m_stride = 1;
+    m_firstTimestamp = m_lastTimestamp = m_lastVerticalSpeed = 0.0;
+    m_verticalSpeedSteps = 0.0;
+}
+
+void FlightMetrics::reserve(double seconds, double timeStep) {
+    const double wanted = static_cast<double>(m_snapshots.size()) + std::ceil(seconds / (timeStep * m_stride)) + 1.0;
+    if (wanted <= static_cast<double>(m_snapshots.capacity())) return;
+    // At least double, so topping up a little at a time still copies the history only a few times.
+    const double capacity = std::max(wanted, 2.0 * static_cast<double>(m_snapshots.capacity()));
+    m_snapshots.reserve(capacity < static_cast<double>(kMaxSnapshots) ? static_cast<size_t>(capacity) : kMaxSnapshots);
+}
 
 void FlightMetrics::recordSnapshot(const Aircraft& aircraft, double timestamp) {
     MetricSnapshot snap;
@@ -17,8 +56,56 @@ void FlightMetrics::recordSnapshot(const Aircraft& aircraft, double timestamp) {
     snap.verticalSpeed = aircraft.verticalSpeed();
     snap.deviationFromPath = 0.0;
     snap.stalled = aircraft.isStalled();
-    if (snap.stalled) m_stallCount++;
-    m_snapshots.push_back(snap);
+    snap.overspeed = aircraft.isOverspeed();
+    recordSnapshot(snap);
+}
+
+void FlightMetrics::recordSnapshot(const MetricSnapshot& snapshot) {
+    if (snapshot.stalled) m_stallCount++;
+    if (snapshot.overspeed) m_overspeedCount++;
+    if (m_sampleCount == 0) m_firstTimestamp = snapshot.timestamp;
+    else m_verticalSpeedSteps += std::abs(snapshot.verticalSpeed - m_lastVerticalSpeed);
+    m_lastTimestamp = snapshot.timestamp;
+    m_lastVerticalSpeed = snapshot.verticalSpeed;
+    if (m_sampleCount++ % m_stride != 0) {
+        MetricSnapshot single = snapshot;
+        widen(single);
+        merge(m_snapshots.back(), single);
+        return;
+    }
+
+    // Grow by doubling, but never past the cap, which push_back alone would overshoot.
+    if (m_snapshots.size() == m_snapshots.capacity())
+        m_snapshots.reserve(std::min(std::max<size_t>(2 * m_snapshots.capacity(), 1024), kMaxSnapshots));
+    m_snapshots.push_back(snapshot);
+    widen(m_snapshots.back());
+    if (m_snapshots.size() == kMaxSnapshots) {
+        // Fold each odd entry into the even one before it: those fall on multiples of the doubled
+        // stride, as will the next one.
+        for (size_t i = 0; i < kMaxSnapshots / 2; ++i) {
+            if (i > 0) m_snapshots[i] = m_snapshots[2 * i];
+            merge(m_snapshots[i], m_snapshots[2 * i + 1]);
+        }
+        m_snapshots.resize(kMaxSnapshots / 2);
+        m_stride *= 2;
+    }
+}
+
+void FlightMetrics::loadRecording(const FlightRecordReader& recording) {
+    reset();
+    m_snapshots.reserve(std::min(recording.size(), kMaxSnapshots));
+    for (const auto& r : recording) {
+        MetricSnapshot snap;
+        snap.timestamp = r.timestamp;
+        snap.altitude = r.altitude;
+        snap.speed = r.speed;
+        snap.heading = r.heading;
+        snap.verticalSpeed = r.verticalSpeed;
+        snap.deviationFromPath = 0.0;
+        snap.stalled = (r.events & FlightEvent::Stall) != 0;
+        snap.overspeed = (r.events & FlightEvent::Overspeed) != 0;
+        recordSnapshot(snap);
+    }
 }
 
 void FlightMetrics::recordDeviation(const std::string& type, double value) {
@@ -40,29 +127,42 @@ double FlightMetrics::maxDeviation(const std::string& type) const {
 int FlightMetrics::stallCount() const { return m_stallCount; }
 
 double FlightMetrics::totalFlightTime() const {
-    if (m_snapshots.empty()) return 0.0;
-    return m_snapshots.back().timestamp - m_snapshots.front().timestamp;
+    return m_sampleCount > 0 ? m_lastTimestamp - m_firstTimestamp : 0.0;
+}
+
+double FlightMetrics::averageVerticalSpeedStep() const {
+    return m_sampleCount > 1 ? m_verticalSpeedSteps / static_cast<double>(m_sampleCount - 1) : 0.0;
 }
 
 DebriefReport::DebriefReport() : m_overallScore(0.0) {}
 
 void DebriefReport::generate(const FlightMetrics& metrics, const TrainingScenario& scenario, const Aircraft& aircraft) {
+    generate(metrics, scenario.name(), aircraft.flightModel()->getModelName(),
+             completionScore(scenario.currentState(), scenario.getProgress()));
+}
+
+double DebriefReport::completionScore(ScenarioState state, double progress) {
+    if (state == ScenarioState::Completed) return 100.0;
+    if (state == ScenarioState::Failed) return 0.0;
+    return progress;
+}
+
+void DebriefReport::generate(const FlightMetrics& metrics, const std::string& scenarioName,
+                             const std::string& aircraftModel, double completion) {
     m_categoryScores.clear();
     m_recommendations.clear();
     m_categoryScores["Altitude Control"] = calculateAltitudeScore(metrics);
     m_categoryScores["Speed Control"] = calculateSpeedScore(metrics);
     m_categoryScores["Smoothness"] = calculateSmoothness(metrics);
     m_categoryScores["Precision"] = calculatePrecision(metrics);
-    if (scenario.isCompleted()) m_categoryScores["Scenario Completion"] = 100.0;
-    else if (scenario.isFailed()) m_categoryScores["Scenario Completion"] = 0.0;
-    else m_categoryScores["Scenario Completion"] = scenario.getProgress();
+    m_categoryScores["Scenario Completion"] = completion;
     m_overallScore = 0.0;
     for (const auto& [category, score] : m_categoryScores) m_overallScore += score;
     m_overallScore /= m_categoryScores.size();
     std::ostringstream oss;
     oss << "Flight Training Debrief\n=======================\n\n";
-    oss << "Scenario: " << scenario.name() << "\n";
-    oss << "Aircraft: " << aircraft.flightModel()->getModelName() << "\n";
+    oss << "Scenario: " << scenarioName << "\n";
+    oss << "Aircraft: " << aircraftModel << "\n";
     oss << "Flight Time: " << static_cast<int>(metrics.totalFlightTime()) << " seconds\n\n";
     oss << "Overall Score: " << static_cast<int>(m_overallScore) << "/100\n\n";
     oss << "Category Breakdown:\n";
@@ -85,6 +185,7 @@ double DebriefReport::calculateAltitudeScore(const FlightMetrics& metrics) {
 double DebriefReport::calculateSpeedScore(const FlightMetrics& metrics) {
     double avgDev = metrics.averageDeviation("speed");
     if (metrics.stallCount() > 0) return 30.0;
+    if (metrics.overspeedCount() > 0) return 40.0;
     if (avgDev < 5.0) return 100.0;
     if (avgDev < 10.0) return 85.0;
     if (avgDev < 20.0) return 70.0;
@@ -92,14 +193,8 @@ double DebriefReport::calculateSpeedScore(const FlightMetrics& metrics) {
 }
 
 double DebriefReport::calculateSmoothness(const FlightMetrics& metrics) {
-    const auto& snaps = metrics.snapshots();
-    if (snaps.size() < 2) return 100.0;
-    double totalJerk = 0.0;
-    for (size_t i = 1; i < snaps.size(); ++i) {
-        double dVS = std::abs(snaps[i].verticalSpeed - snaps[i-1].verticalSpeed);
-        totalJerk += dVS;
-    }
-    double avgJerk = totalJerk / (snaps.size() - 1);
+    if (metrics.sampleCount() < 2) return 100.0;
+    double avgJerk = metrics.averageVerticalSpeedStep();
     if (avgJerk < 5.0) return 100.0;
     if (avgJerk < 10.0) return 85.0;
     if (avgJerk < 20.0) return 70.0;
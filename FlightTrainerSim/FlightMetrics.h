@@ -8,33 +8,61 @@
 #include <string>
 #include <map>
 
+class FlightRecordReader;
+
 struct MetricSnapshot {
     double timestamp, altitude, speed, heading, verticalSpeed, deviationFromPath;
-    bool stalled;
+    bool stalled, overspeed;
+    // Extremes (and any stall or overspeed) over the samples a stored snapshot stands for; the
+    // fields above are its first sample. Filled in by FlightMetrics, ignored on input.
+    double altitudeMin, altitudeMax, speedMin, speedMax, verticalSpeedMin, verticalSpeedMax;
 };
 
+// Per-session flight statistics. Totals are kept incrementally over every sample; the snapshot
+// history (for charts) is capped at kMaxSnapshots by merging neighbouring snapshots and halving the
+// rate whenever it fills, so an eight-hour session costs the same memory as a one-hour one. Merged
+// snapshots keep their extremes, so decimation never hides a peak.
 class FlightMetrics {
 public:
+    static constexpr size_t kMaxSnapshots = size_t(1) << 18;
+
     FlightMetrics();
+    // Makes room for at least the next `seconds` of history, up to kMaxSnapshots, so it is not
+    // reallocated mid-flight; kept across reset(). Without it the history grows as it fills.
+    void reserve(double seconds, double timeStep);
     void reset();
     void recordSnapshot(const Aircraft& aircraft, double timestamp);
+    void recordSnapshot(const MetricSnapshot& snapshot);
+    void loadRecording(const FlightRecordReader& recording);
     void recordDeviation(const std::string& type, double value);
     const std::vector<MetricSnapshot>& snapshots() const { return m_snapshots; }
+    // Every sample recorded, and how many of them one stored snapshot stands for.
+    size_t sampleCount() const { return m_sampleCount; }
+    size_t snapshotStride() const { return m_stride; }
     const std::map<std::string, std::vector<double>>& deviations() const { return m_deviations; }
     double averageDeviation(const std::string& type) const;
     double maxDeviation(const std::string& type) const;
     int stallCount() const;
+    int overspeedCount() const { return m_overspeedCount; }
     double totalFlightTime() const;
+    // Mean |change in vertical speed| between consecutive samples.
+    double averageVerticalSpeedStep() const;
 private:
     std::vector<MetricSnapshot> m_snapshots;
     std::map<std::string, std::vector<double>> m_deviations;
-    int m_stallCount;
+    int m_stallCount, m_overspeedCount;
+    size_t m_sampleCount, m_stride;
+    double m_firstTimestamp, m_lastTimestamp, m_lastVerticalSpeed;
+    double m_verticalSpeedSteps;
 };
 
 class DebriefReport {
 public:
     DebriefReport();
     void generate(const FlightMetrics& metrics, const TrainingScenario& scenario, const Aircraft& aircraft);
+    void generate(const FlightMetrics& metrics, const std::string& scenarioName,
+                  const std::string& aircraftModel, double completion);
+    static double completionScore(ScenarioState state, double progress);
     double overallScore() const { return m_overallScore; }
     const std::string& summaryText() const { return m_summaryText; }
     const std::map<std::string, double>& categoryScores() const { return m_categoryScores; }
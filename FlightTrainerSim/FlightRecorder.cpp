@@ -0,0 +1,214 @@
+// File: FlightRecorder.cpp
+#include "FlightRecorder.h"
+#include "Aircraft.h"
+#include "TrainingScenario.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+    // Mapping grows in whole multiples of this, which keeps every remap page- and
+    // allocation-granularity aligned on all platforms.
+    constexpr qint64 kMapChunkBytes = 4 * 1024 * 1024;
+    constexpr qint64 kMaxGrowBytes = 64 * 1024 * 1024;
+
+    template <size_t N>
+    void copyField(char (&dst)[N], const std::string& src) {
+        std::memset(dst, 0, N);
+        std::memcpy(dst, src.data(), std::min(src.size(), N - 1));
+    }
+
+    template <size_t N>
+    std::string readField(const char (&src)[N]) {
+        return std::string(src, std::find(src, src + N, '\0'));
+    }
+}
+
+FlightRecorder::FlightRecorder(size_t queueCapacity)
+    : m_queue(queueCapacity), m_map(nullptr), m_mappedSize(0), m_count(0)
+    , m_running(false), m_written(0), m_dropped(0) {}
+
+FlightRecorder::~FlightRecorder() {
+    close();
+}
+
+bool FlightRecorder::open(const std::string& path, const FlightSessionInfo& info) {
+    close();
+    m_file.setFileName(QString::fromStdString(path));
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) return false;
+    m_map = nullptr;
+    m_mappedSize = 0;
+    m_count = 0;
+    if (!ensureCapacity(sizeof(FlightRecordHeader))) {
+        m_file.close();
+        return false;
+    }
+
+    FlightRecordHeader header{};
+    std::memcpy(header.magic, kFlightRecordMagic, sizeof(header.magic));
+    header.version = kFlightRecordVersion;
+    header.recordSize = sizeof(FlightRecord);
+    header.recordCount = 0;
+    header.startTimeMs = info.startTimeMs;
+    header.timeStep = info.timeStep;
+    copyField(header.aircraftModel, info.aircraftModel);
+    copyField(header.scenarioName, info.scenarioName);
+    copyField(header.traineeId, info.traineeId);
+    std::memcpy(m_map, &header, sizeof(header));
+
+    m_path = path;
+    m_written.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_running.store(true, std::memory_order_release);
+    m_writer = std::thread(&FlightRecorder::writerLoop, this);
+    return true;
+}
+
+void FlightRecorder::close() {
+    if (!m_running.exchange(false, std::memory_order_acq_rel)) return;
+    if (m_writer.joinable()) m_writer.join();
+
+    // Trim the preallocated tail so the file ends exactly after the last record.
+    const qint64 usedBytes = static_cast<qint64>(sizeof(FlightRecordHeader) + m_count * sizeof(FlightRecord));
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_mappedSize = 0;
+    m_file.resize(usedBytes);
+    m_file.close();
+}
+
+bool FlightRecorder::push(const FlightRecord& record) {
+    if (!isOpen()) return false;
+    if (!m_queue.tryPush(record)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void FlightRecorder::writerLoop() {
+    while (m_running.load(std::memory_order_acquire)) {
+        if (drain() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    drain();
+}
+
+size_t FlightRecorder::drain() {
+    size_t drained = 0;
+    FlightRecord record;
+    while (m_queue.tryPop(record)) {
+        const qint64 offset = static_cast<qint64>(sizeof(FlightRecordHeader) + m_count * sizeof(FlightRecord));
+        if (!ensureCapacity(offset + static_cast<qint64>(sizeof(FlightRecord)))) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        std::memcpy(m_map + offset, &record, sizeof(FlightRecord));
+        ++m_count;
+        ++drained;
+    }
+    if (drained > 0) {
+        flushHeader();
+        m_written.store(m_count, std::memory_order_relaxed);
+    }
+    return drained;
+}
+
+bool FlightRecorder::ensureCapacity(qint64 requiredBytes) {
+    if (m_map && requiredBytes <= m_mappedSize) return true;
+    qint64 newSize = std::max(kMapChunkBytes, m_mappedSize);
+    while (newSize < requiredBytes) newSize += std::min(newSize, kMaxGrowBytes);
+
+    // The file cannot be resized while mapped on Windows, so drop the view first.
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_mappedSize = 0;
+    if (!m_file.resize(newSize)) return false;
+    m_map = m_file.map(0, newSize);
+    if (!m_map) return false;
+    m_mappedSize = newSize;
+    return true;
+}
+
+void FlightRecorder::flushHeader() {
+    if (!m_map) return;
+    reinterpret_cast<FlightRecordHeader*>(m_map)->recordCount = m_count;
+}
+
+FlightRecord FlightRecorder::capture(const Aircraft& aircraft, const TrainingScenario& scenario,
+                                     double timestamp, uint32_t events) {
+    const auto& state = aircraft.flightState();
+    const auto& controls = aircraft.controls();
+    FlightRecord r{};
+    r.timestamp = timestamp;
+    r.x = aircraft.position().x;
+    r.y = aircraft.position().y;
+    r.altitude = aircraft.altitude();
+    r.heading = aircraft.heading();
+    r.pitch = aircraft.pitch();
+    r.bank = aircraft.bank();
+    r.velocityX = state.velocityX;
+    r.velocityY = state.velocityY;
+    r.velocityZ = state.velocityZ;
+    r.speed = aircraft.speed();
+    r.verticalSpeed = aircraft.verticalSpeed();
+    r.thrust = state.thrust;
+    r.drag = state.drag;
+    r.lift = state.lift;
+    r.elevator = controls.elevator;
+    r.aileron = controls.aileron;
+    r.rudder = controls.rudder;
+    r.throttle = controls.throttle;
+    r.flaps = controls.flaps;
+    r.fuel = aircraft.fuel();
+    r.scenarioProgress = scenario.getProgress();
+    r.scenarioState = static_cast<uint32_t>(scenario.currentState());
+    if (aircraft.isStalled()) events |= FlightEvent::Stall;
+    if (controls.gearDown) events |= FlightEvent::GearDown;
+    if (aircraft.isOnGround()) events |= FlightEvent::OnGround;
+    if (aircraft.isOverspeed()) events |= FlightEvent::Overspeed;
+    r.events = events;
+    return r;
+}
+
+bool FlightRecordReader::open(const std::string& path) {
+    close();
+    m_file.setFileName(QString::fromStdString(path));
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+    const qint64 fileSize = m_file.size();
+    if (fileSize < static_cast<qint64>(sizeof(FlightRecordHeader))) {
+        m_file.close();
+        return false;
+    }
+    uchar* data = m_file.map(0, fileSize);
+    if (!data) {
+        m_file.close();
+        return false;
+    }
+    const auto* header = reinterpret_cast<const FlightRecordHeader*>(data);
+    if (std::memcmp(header->magic, kFlightRecordMagic, sizeof(header->magic)) != 0 ||
+        header->version != kFlightRecordVersion || header->recordSize != sizeof(FlightRecord)) {
+        m_file.unmap(data);
+        m_file.close();
+        return false;
+    }
+    // A recording that is still open (or was cut short) may claim fewer bytes than mapped, never more.
+    const uint64_t available = (fileSize - sizeof(FlightRecordHeader)) / sizeof(FlightRecord);
+    m_count = static_cast<size_t>(std::min(header->recordCount, available));
+    m_data = data;
+    return true;
+}
+
+void FlightRecordReader::close() {
+    if (m_data) m_file.unmap(const_cast<uchar*>(m_data));
+    m_data = nullptr;
+    m_count = 0;
+    if (m_file.isOpen()) m_file.close();
+}
+
+std::string FlightRecordReader::aircraftModel() const { return m_data ? readField(header().aircraftModel) : std::string(); }
+std::string FlightRecordReader::scenarioName() const { return m_data ? readField(header().scenarioName) : std::string(); }
+std::string FlightRecordReader::traineeId() const { return m_data ? readField(header().traineeId) : std::string(); }
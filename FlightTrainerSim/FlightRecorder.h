@@ -0,0 +1,135 @@
+// File: FlightRecorder.h
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include "SpscQueue.h"
+#include <QFile>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+class Aircraft;
+class TrainingScenario;
+
+namespace FlightEvent {
+    constexpr uint32_t Stall = 1u << 0;
+    constexpr uint32_t LowFuel = 1u << 1;
+    constexpr uint32_t AltitudeWarning = 1u << 2;
+    constexpr uint32_t StateChanged = 1u << 3;
+    constexpr uint32_t WaypointReached = 1u << 4;
+    constexpr uint32_t GearDown = 1u << 5;
+    constexpr uint32_t OnGround = 1u << 6;
+    constexpr uint32_t Overspeed = 1u << 7;
+}
+
+// One physics tick. Layout is written to disk verbatim; any change must bump kFlightRecordVersion.
+struct FlightRecord {
+    double timestamp;
+    double x, y, altitude;
+    double heading, pitch, bank;
+    double velocityX, velocityY, velocityZ;
+    double speed, verticalSpeed;
+    double thrust, drag, lift;
+    double elevator, aileron, rudder, throttle, flaps;
+    double fuel, scenarioProgress;
+    uint32_t scenarioState;
+    uint32_t events;
+};
+static_assert(sizeof(FlightRecord) == 184, "FlightRecord layout changed");
+
+struct FlightRecordHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t recordCount;
+    int64_t startTimeMs;
+    double timeStep;
+    char aircraftModel[48];
+    char scenarioName[48];
+    char traineeId[32];
+    char reserved[88];
+};
+static_assert(sizeof(FlightRecordHeader) == 256, "FlightRecordHeader layout changed");
+
+constexpr char kFlightRecordMagic[8] = { 'F', 'T', 'S', 'F', 'D', 'R', '\0', '\1' };
+constexpr uint32_t kFlightRecordVersion = 1;
+
+struct FlightSessionInfo {
+    std::string aircraftModel, scenarioName, traineeId;
+    double timeStep = 0.0;
+    int64_t startTimeMs = 0;
+};
+
+// Appends records to a memory-mapped file. push() is called from the simulation thread and
+// only touches a lock-free queue; a background thread drains it into the mapping.
+class FlightRecorder {
+public:
+    explicit FlightRecorder(size_t queueCapacity = 16384);
+    ~FlightRecorder();
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    bool open(const std::string& path, const FlightSessionInfo& info);
+    void close();
+    bool isOpen() const { return m_running.load(std::memory_order_acquire); }
+    const std::string& path() const { return m_path; }
+
+    bool push(const FlightRecord& record);
+    uint64_t recordsWritten() const { return m_written.load(std::memory_order_relaxed); }
+    uint64_t droppedRecords() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    static FlightRecord capture(const Aircraft& aircraft, const TrainingScenario& scenario,
+                                double timestamp, uint32_t events);
+
+private:
+    SpscQueue<FlightRecord> m_queue;
+    QFile m_file;
+    std::string m_path;
+    uchar* m_map;
+    qint64 m_mappedSize;
+    uint64_t m_count;
+    std::thread m_writer;
+    std::atomic<bool> m_running;
+    std::atomic<uint64_t> m_written, m_dropped;
+
+    void writerLoop();
+    size_t drain();
+    bool ensureCapacity(qint64 requiredBytes);
+    void flushHeader();
+};
+
+// Read-only, zero-copy view over a recording. Records point straight into the file mapping.
+class FlightRecordReader {
+public:
+    FlightRecordReader() = default;
+    explicit FlightRecordReader(const std::string& path) { open(path); }
+    ~FlightRecordReader() { close(); }
+    FlightRecordReader(const FlightRecordReader&) = delete;
+    FlightRecordReader& operator=(const FlightRecordReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    const FlightRecordHeader& header() const { return *reinterpret_cast<const FlightRecordHeader*>(m_data); }
+    const FlightRecord* records() const {
+        return m_data ? reinterpret_cast<const FlightRecord*>(m_data + sizeof(FlightRecordHeader)) : nullptr;
+    }
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    const FlightRecord& operator[](size_t i) const { return records()[i]; }
+    const FlightRecord* begin() const { return records(); }
+    const FlightRecord* end() const { return records() + m_count; }
+
+    std::string aircraftModel() const;
+    std::string scenarioName() const;
+    std::string traineeId() const;
+
+private:
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    size_t m_count = 0;
+};
+
+#endif
@@ -0,0 +1,68 @@
+// File: FrameArena.cpp
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+FrameArena::FrameArena() : m_block(0), m_offset(0), m_usedBefore(0) {
+    m_blocks.reserve(8);
+    m_blocks.push_back({ std::make_unique<char[]>(kBlockSize), kBlockSize });
+}
+
+FrameArena& FrameArena::current() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    for (;;) {
+        Block& block = m_blocks[m_block];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        const size_t aligned = static_cast<size_t>(((base + m_offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base);
+        if (aligned + size <= block.size) {
+            m_offset = aligned + size;
+            return block.data.get() + aligned;
+        }
+        m_usedBefore += m_offset;
+        m_offset = 0;
+        if (++m_block == m_blocks.size()) {
+            const size_t blockSize = std::max(kBlockSize, size + alignment);
+            m_blocks.push_back({ std::make_unique<char[]>(blockSize), blockSize });
+        }
+    }
+}
+
+std::string_view FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list measure;
+    va_copy(measure, args);
+    const int length = std::vsnprintf(nullptr, 0, fmt, measure);
+    va_end(measure);
+    if (length <= 0) {
+        va_end(args);
+        return {};
+    }
+    // vsnprintf always writes the terminator; it is left out of the view.
+    char* text = static_cast<char*>(allocate(static_cast<size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, fmt, args);
+    va_end(args);
+    return std::string_view(text, static_cast<size_t>(length));
+}
+
+void FrameArena::reset() {
+    m_block = 0;
+    m_offset = 0;
+    m_usedBefore = 0;
+}
+
+size_t FrameArena::used() const {
+    return m_usedBefore + m_offset;
+}
+
+size_t FrameArena::capacity() const {
+    size_t total = 0;
+    for (const auto& block : m_blocks) total += block.size;
+    return total;
+}
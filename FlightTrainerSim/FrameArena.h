@@ -0,0 +1,48 @@
+// File: FrameArena.h
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Bump allocator for temporaries that live for one simulation tick. reset() rewinds to the start
+// but keeps every block, so once the arena has grown to a tick's high-water mark it never touches
+// the heap again. Nothing allocated here may be kept past the next reset().
+class FrameArena {
+public:
+    static constexpr size_t kBlockSize = 16 * 1024;
+
+    FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // The calling thread's arena; whoever drives the tick resets it at the start of each one.
+    static FrameArena& current();
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    // printf-style text in arena memory, not null-terminated.
+    std::string_view format(const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+    void reset();
+
+    size_t used() const;
+    size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> m_blocks;
+    size_t m_block;         // block currently being filled
+    size_t m_offset;        // bytes used in it
+    size_t m_usedBefore;    // bytes used in the blocks before it
+};
+
+#endif
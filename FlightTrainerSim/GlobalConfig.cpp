@@ -0,0 +1,97 @@
+// File: GlobalConfig.cpp
+#include "GlobalConfig.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+    struct ConfigKey {
+        const char* name;
+        double ConfigSnapshot::*field;
+        double minValue, maxValue;
+    };
+
+    const ConfigKey kConfigKeys[] = {
+        { "update_rate_hz", &ConfigSnapshot::updateRateHz, 1.0, 1000.0 },
+        { "max_altitude", &ConfigSnapshot::maxAltitude, 1.0, 1.0e6 },
+        { "max_speed", &ConfigSnapshot::maxSpeed, 1.0, 1.0e5 },
+        { "gravity", &ConfigSnapshot::gravity, 0.0, 100.0 },
+        { "cockpit_max_fps", &ConfigSnapshot::cockpitMaxFps, 0.0, 1000.0 },
+        { "outside_max_fps", &ConfigSnapshot::outsideMaxFps, 0.0, 1000.0 },
+        { "hitch_threshold_ms", &ConfigSnapshot::hitchThresholdMs, 0.0, 10000.0 },
+        { "net_send_rate_hz", &ConfigSnapshot::netSendRateHz, 1.0, 120.0 },
+        { "input_poll_hz", &ConfigSnapshot::inputPollHz, 50.0, 8000.0 },
+        { "input_deadzone", &ConfigSnapshot::inputDeadzone, 0.0, 0.5 },
+        { "input_expo", &ConfigSnapshot::inputExpo, 0.0, 1.0 },
+    };
+
+    std::string trim(const std::string& text) {
+        const size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return std::string();
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+}
+
+GlobalConfig::GlobalConfig() : m_snapshot(nullptr), m_configPath("./flightsim.conf")
+    , m_useMetric(false), m_showDebug(false), m_aaSamples(4)
+    , m_recordFlights(true), m_recordingDir("./recordings")
+    , m_sessionIndexPath("./recordings/sessions.fsi"), m_cacheDir("./cache"), m_sharedStateKey("FlightTrainerSim.state")
+    , m_traceEnabled(false), m_audioEnabled(false), m_netHostPort(0), m_callsign("TRAINEE") {
+    publish(ConfigSnapshot());
+}
+
+const ConfigSnapshot& GlobalConfig::publish(const ConfigSnapshot& next) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    return publishLocked(next);
+}
+
+const ConfigSnapshot& GlobalConfig::publishLocked(const ConfigSnapshot& next) {
+    auto snapshot = std::make_unique<ConfigSnapshot>(next);
+    snapshot->version = m_snapshots.size() + 1;
+    const ConfigSnapshot* published = snapshot.get();
+    m_snapshots.push_back(std::move(snapshot));
+    m_snapshot.store(published, std::memory_order_release);
+    return *published;
+}
+
+bool GlobalConfig::loadFile(const std::string& path, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    ConfigSnapshot next = snapshot();
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        const std::string where = path + ":" + std::to_string(lineNumber) + ": ";
+        const size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = where + "expected key = value";
+            return false;
+        }
+        const std::string key = trim(line.substr(0, equals));
+        const std::string text = trim(line.substr(equals + 1));
+        const ConfigKey* match = nullptr;
+        for (const ConfigKey& candidate : kConfigKeys) {
+            if (key == candidate.name) match = &candidate;
+        }
+        if (!match) {
+            error = where + "unknown key '" + key + "'";
+            return false;
+        }
+        char* end = nullptr;
+        const double value = std::strtod(text.c_str(), &end);
+        if (text.empty() || *end != '\0' || !(value >= match->minValue && value <= match->maxValue)) {
+            char range[64];
+            std::snprintf(range, sizeof(range), " must be a number in [%g, %g]", match->minValue, match->maxValue);
+            error = where + key + range;
+            return false;
+        }
+        next.*(match->field) = value;
+    }
+    publishLocked(next);
+    return true;
+}
@@ -2,35 +2,129 @@
 #ifndef GLOBALCONFIG_H
 #define GLOBALCONFIG_H
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Rates and limits that can be tuned while the simulation runs. Snapshots are immutable once
+// published; a tick takes one at its start and reads only that, so a reload mid-tick cannot mix
+// old and new values.
+struct ConfigSnapshot {
+    uint64_t version = 0;
+    double updateRateHz = 60.0;
+    double maxAltitude = 50000.0;
+    double maxSpeed = 1200.0;
+    double gravity = 9.81;
+    double cockpitMaxFps = 0.0;
+    double outsideMaxFps = 0.0;
+    double hitchThresholdMs = 50.0;
+    double netSendRateHz = 20.0;
+    double inputPollHz = 1000.0;
+    double inputDeadzone = 0.05;
+    double inputExpo = 0.2;
+
+    double physicsTimeStep() const { return 1.0 / updateRateHz; }
+};
+
 class GlobalConfig {
 public:
     static GlobalConfig& instance() {
         static GlobalConfig config;
         return config;
     }
-    
-    double updateRateHz() const { return m_updateRateHz; }
-    double physicsTimeStep() const { return 1.0 / m_updateRateHz; }
-    double maxAltitude() const { return m_maxAltitude; }
-    double maxSpeed() const { return m_maxSpeed; }
-    double gravity() const { return m_gravity; }
+
+    // Lock-free; the returned snapshot stays valid for the life of the process.
+    const ConfigSnapshot& snapshot() const { return *m_snapshot.load(std::memory_order_acquire); }
+    // Copies `next`, stamps it with the next version and makes it current.
+    const ConfigSnapshot& publish(const ConfigSnapshot& next);
+    // Reads `key = value` lines over the current snapshot and publishes the result. On any error
+    // nothing is published and `error` says why.
+    bool loadFile(const std::string& path, std::string& error);
+    const std::string& configPath() const { return m_configPath; }
+    void setConfigPath(const std::string& path) { m_configPath = path; }
+
+    double updateRateHz() const { return snapshot().updateRateHz; }
+    double physicsTimeStep() const { return snapshot().physicsTimeStep(); }
+    double maxAltitude() const { return snapshot().maxAltitude; }
+    double maxSpeed() const { return snapshot().maxSpeed; }
+    double gravity() const { return snapshot().gravity; }
     bool useMetricUnits() const { return m_useMetric; }
     bool showDebugInfo() const { return m_showDebug; }
     int antiAliasingSamples() const { return m_aaSamples; }
+    bool recordFlights() const { return m_recordFlights; }
+    const std::string& recordingDirectory() const { return m_recordingDir; }
+    const std::string& traineeId() const { return m_traineeId; }
+    const std::string& sessionIndexPath() const { return m_sessionIndexPath; }
+    // Tables precomputed per flight model (TrimTable, PerformanceEnvelope); rebuilt when missing or stale.
+    const std::string& cacheDirectory() const { return m_cacheDir; }
+    // Shared-memory segment the engine publishes each tick to; empty disables publication.
+    const std::string& sharedStateKey() const { return m_sharedStateKey; }
+    double cockpitMaxFps() const { return snapshot().cockpitMaxFps; }
+    double outsideMaxFps() const { return snapshot().outsideMaxFps; }
+    bool traceEnabled() const { return m_traceEnabled; }
+    // Cockpit sound; off unless asked for, and then only once an output device has opened.
+    bool audioEnabled() const { return m_audioEnabled; }
+    double hitchThresholdMs() const { return snapshot().hitchThresholdMs; }
+    // Multiplayer: a UDP port to host a session on (0 = not hosting), or "host:port" to join.
+    int netHostPort() const { return m_netHostPort; }
+    const std::string& netJoinAddress() const { return m_netJoinAddress; }
+    const std::string& callsign() const { return m_callsign; }
+    double netSendRateHz() const { return snapshot().netSendRateHz; }
+    // Joystick/HOTAS: an evdev node, "auto" for the first joystick found, or empty for none.
+    const std::string& inputDevice() const { return m_inputDevice; }
     
-    void setUpdateRate(double hz) { m_updateRateHz = hz; }
+    void setUpdateRate(double hz) { update([hz](ConfigSnapshot& c) { c.updateRateHz = hz; }); }
     void setUseMetric(bool metric) { m_useMetric = metric; }
     void setShowDebug(bool show) { m_showDebug = show; }
+    void setRecordFlights(bool record) { m_recordFlights = record; }
+    void setRecordingDirectory(const std::string& dir) { m_recordingDir = dir; }
+    void setTraineeId(const std::string& id) { m_traineeId = id; }
+    void setSessionIndexPath(const std::string& path) { m_sessionIndexPath = path; }
+    void setCacheDirectory(const std::string& dir) { m_cacheDir = dir; }
+    void setSharedStateKey(const std::string& key) { m_sharedStateKey = key; }
+    void setCockpitMaxFps(double fps) { update([fps](ConfigSnapshot& c) { c.cockpitMaxFps = fps; }); }
+    void setOutsideMaxFps(double fps) { update([fps](ConfigSnapshot& c) { c.outsideMaxFps = fps; }); }
+    void setTraceEnabled(bool enabled) { m_traceEnabled = enabled; }
+    void setAudioEnabled(bool enabled) { m_audioEnabled = enabled; }
+    void setHitchThresholdMs(double ms) { update([ms](ConfigSnapshot& c) { c.hitchThresholdMs = ms; }); }
+    void setNetHostPort(int port) { m_netHostPort = port; }
+    void setNetJoinAddress(const std::string& address) { m_netJoinAddress = address; }
+    void setCallsign(const std::string& callsign) { m_callsign = callsign; }
+    void setNetSendRateHz(double hz) { update([hz](ConfigSnapshot& c) { c.netSendRateHz = hz; }); }
+    void setInputDevice(const std::string& device) { m_inputDevice = device; }
 
 private:
-    GlobalConfig() : m_updateRateHz(60.0), m_maxAltitude(50000.0), m_maxSpeed(1200.0)
-        , m_gravity(9.81), m_useMetric(false), m_showDebug(false), m_aaSamples(4) {}
+    GlobalConfig();
     GlobalConfig(const GlobalConfig&) = delete;
     GlobalConfig& operator=(const GlobalConfig&) = delete;
-    
-    double m_updateRateHz, m_maxAltitude, m_maxSpeed, m_gravity;
+
+    // Read-modify-write under the writer lock, so concurrent setters cannot drop each other's edits.
+    template <typename Edit>
+    void update(Edit edit) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        ConfigSnapshot next = snapshot();
+        edit(next);
+        publishLocked(next);
+    }
+    const ConfigSnapshot& publishLocked(const ConfigSnapshot& next);
+
+    // Superseded snapshots are kept, not freed: readers hold plain references and reloads are rare.
+    std::atomic<const ConfigSnapshot*> m_snapshot;
+    // Serializes writers; readers never take it.
+    std::mutex m_writeMutex;
+    std::vector<std::unique_ptr<const ConfigSnapshot>> m_snapshots;
+    std::string m_configPath;
     bool m_useMetric, m_showDebug;
     int m_aaSamples;
+    bool m_recordFlights;
+    std::string m_recordingDir, m_traineeId, m_sessionIndexPath, m_cacheDir, m_sharedStateKey;
+    bool m_traceEnabled, m_audioEnabled;
+    int m_netHostPort;
+    std::string m_netJoinAddress, m_callsign;
+    std::string m_inputDevice;
 };
 
 #endif
@@ -0,0 +1,73 @@
+// File: HudGlyphAtlas.cpp
+#include "HudGlyphAtlas.h"
+#include <QPainter>
+#include <QFontMetrics>
+#include <QString>
+
+HudGlyphAtlas::HudGlyphAtlas() : m_ascent(0), m_descent(0), m_lineSpacing(0), m_margin(2), m_dpr(1.0) {}
+
+void HudGlyphAtlas::build(const QFont& font, const QColor& color, qreal devicePixelRatio) {
+    const QFontMetrics metrics(font);
+    m_ascent = metrics.ascent();
+    m_descent = metrics.descent();
+    m_lineSpacing = metrics.lineSpacing();
+    m_dpr = devicePixelRatio;
+    m_glyphs.fill(Glyph());
+
+    auto included = [](int c) { return (c >= 32 && c < 127) || c == kDegree; };
+    const int cellHeight = m_ascent + m_descent;
+    int totalWidth = 0;
+    for (int c = 0; c < 256; ++c) {
+        if (included(c)) totalWidth += metrics.horizontalAdvance(QChar(c)) + 2 * m_margin;
+    }
+    m_image = QImage(QSize(totalWidth, cellHeight) * m_dpr, QImage::Format_ARGB32_Premultiplied);
+    m_image.setDevicePixelRatio(m_dpr);
+    m_image.fill(Qt::transparent);
+
+    QPainter painter(&m_image);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.setFont(font);
+    painter.setPen(color);
+    int x = 0;
+    for (int c = 0; c < 256; ++c) {
+        if (!included(c)) continue;
+        Glyph& glyph = m_glyphs[c];
+        glyph.advance = metrics.horizontalAdvance(QChar(c));
+        const int cellWidth = glyph.advance + 2 * m_margin;
+        painter.drawText(x + m_margin, m_ascent, QString(QChar(c)));
+        glyph.source = QRectF(x * m_dpr, 0, cellWidth * m_dpr, cellHeight * m_dpr);
+        glyph.valid = true;
+        x += cellWidth;
+    }
+}
+
+int HudGlyphAtlas::textWidth(const char* text) const {
+    int width = 0;
+    for (const char* p = text; *p; ++p) width += m_glyphs[static_cast<unsigned char>(*p)].advance;
+    return width;
+}
+
+void HudGlyphAtlas::drawText(QPainter& painter, int x, int baseline, const char* text) const {
+    if (isNull()) return;
+    const qreal top = baseline - m_ascent;
+    for (const char* p = text; *p; ++p) {
+        const Glyph& glyph = m_glyphs[static_cast<unsigned char>(*p)];
+        if (!glyph.valid) continue;
+        if (*p != ' ') {
+            const QRectF target(x - m_margin, top, glyph.source.width() / m_dpr, glyph.source.height() / m_dpr);
+            painter.drawImage(target, m_image, glyph.source);
+        }
+        x += glyph.advance;
+    }
+}
+
+void HudGlyphAtlas::drawText(QPainter& painter, const QRect& rect, int alignment, const char* text) const {
+    const int width = textWidth(text);
+    int x = rect.left();
+    if (alignment & Qt::AlignHCenter) x = rect.left() + (rect.width() - width) / 2;
+    else if (alignment & Qt::AlignRight) x = rect.right() + 1 - width;
+    int baseline = rect.top() + m_ascent;
+    if (alignment & Qt::AlignVCenter) baseline = rect.top() + (rect.height() + m_ascent - m_descent) / 2;
+    else if (alignment & Qt::AlignBottom) baseline = rect.bottom() + 1 - m_descent;
+    drawText(painter, x, baseline, text);
+}
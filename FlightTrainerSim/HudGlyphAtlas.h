@@ -0,0 +1,40 @@
+// File: HudGlyphAtlas.h
+#ifndef HUDGLYPHATLAS_H
+#define HUDGLYPHATLAS_H
+
+#include <QImage>
+#include <QFont>
+#include <QColor>
+#include <QRectF>
+#include <array>
+
+class QPainter;
+
+// Pre-rendered ASCII glyphs (plus '\xB0' for the degree sign) in one font and colour.
+// Text is blitted glyph by glyph from the atlas, so HUD readouts need no QString, shaping or
+// glyph rasterisation per frame. The atlas is a QImage so it can be drawn from render threads.
+class HudGlyphAtlas {
+public:
+    HudGlyphAtlas();
+    void build(const QFont& font, const QColor& color, qreal devicePixelRatio);
+    bool isNull() const { return m_image.isNull(); }
+    int ascent() const { return m_ascent; }
+    int descent() const { return m_descent; }
+    int lineSpacing() const { return m_lineSpacing; }
+    int textWidth(const char* text) const;
+    void drawText(QPainter& painter, int x, int baseline, const char* text) const;
+    void drawText(QPainter& painter, const QRect& rect, int alignment, const char* text) const;
+private:
+    struct Glyph {
+        QRectF source;
+        int advance = 0;
+        bool valid = false;
+    };
+    static constexpr unsigned char kDegree = 0xB0;
+    std::array<Glyph, 256> m_glyphs;
+    QImage m_image;
+    int m_ascent, m_descent, m_lineSpacing, m_margin;
+    qreal m_dpr;
+};
+
+#endif
@@ -5,17 +5,23 @@
 #include <memory>
 #include <string>
 
-struct FlightState {
-    double velocityX = 0.0;
-    double velocityY = 0.0;
-    double velocityZ = 0.0;
-    double angularVelocityX = 0.0;
-    double angularVelocityY = 0.0;
-    double angularVelocityZ = 0.0;
-    double thrust = 0.0;
-    double drag = 0.0;
-    double lift = 0.0;
+struct ConfigSnapshot;
+
+// Templated on the scalar so batch paths can run the same kernels in float (see FlightKernel.h);
+// the simulated aircraft itself is always double.
+template <typename T>
+struct BasicFlightState {
+    T velocityX = T(0);
+    T velocityY = T(0);
+    T velocityZ = T(0);
+    T angularVelocityX = T(0);
+    T angularVelocityY = T(0);
+    T angularVelocityZ = T(0);
+    T thrust = T(0);
+    T drag = T(0);
+    T lift = T(0);
 };
+using FlightState = BasicFlightState<double>;
 
 struct ControlInputs {
     double elevator = 0.0;
@@ -26,46 +32,95 @@ struct ControlInputs {
     bool gearDown = true;
 };
 
+// Everything that distinguishes one flight model from another; the force equations themselves are
+// shared (computeFlightForces in FlightKernel.h).
+struct FlightModelParams {
+    double mass, wingArea;
+    double dragCoeff, liftCoeff;
+    double flapDrag, flapLift;          // added to the coefficients at full flaps
+    double elevatorLift;                // lift factor at full elevator
+    double sideForce;                   // aileron side-force coefficient
+    double elevatorClimb;               // direct vertical acceleration at full elevator
+    double bankRate, pitchRate, yawRate;
+    double maxThrust;
+    double afterburnerThrottle, afterburnerBoost;   // thrust multiplied above that throttle
+    double maxSpeed, stallSpeed, fuelConsumptionRate;
+};
+
 class IFlightModel {
 public:
     virtual ~IFlightModel() = default;
     virtual void computeForces(const FlightState& state, const ControlInputs& controls,
-                               double altitude, double deltaTime, FlightState& outNewState) = 0;
+                               double altitude, double deltaTime, const ConfigSnapshot& config,
+                               FlightState& outNewState) = 0;
     virtual double getMaxThrust() const = 0;
     virtual double getMaxSpeed() const = 0;
     virtual double getStallSpeed() const = 0;
     virtual double getFuelConsumptionRate() const = 0;
     virtual std::string getModelName() const = 0;
+    virtual const FlightModelParams& params() const = 0;
+    // The model name in lower case with dashes, for file names.
+    std::string fileKey() const;
 };
 
 class TrainerFlightModel : public IFlightModel {
 public:
-    void computeForces(const FlightState&, const ControlInputs&, double, double, FlightState&) override;
-    double getMaxThrust() const override { return 12000.0; }
-    double getMaxSpeed() const override { return 250.0; }
-    double getStallSpeed() const override { return 55.0; }
-    double getFuelConsumptionRate() const override { return 15.0; }
+    static constexpr FlightModelParams kParams = {
+        5500.0, 15.8,                   // mass, wing area
+        0.025, 5.5, 0.1, 1.5, 0.3,      // drag, lift, flap drag, flap lift, elevator lift
+        2.0, 15.0,                      // side force, elevator climb
+        30.0, 20.0, 15.0,               // bank, pitch, yaw rates
+        12000.0, 1.0, 1.0,              // max thrust, no afterburner
+        250.0, 55.0, 15.0,              // max speed, stall speed, fuel rate
+    };
+
+    void computeForces(const FlightState&, const ControlInputs&, double, double, const ConfigSnapshot&, FlightState&) override;
+    double getMaxThrust() const override { return kParams.maxThrust; }
+    double getMaxSpeed() const override { return kParams.maxSpeed; }
+    double getStallSpeed() const override { return kParams.stallSpeed; }
+    double getFuelConsumptionRate() const override { return kParams.fuelConsumptionRate; }
     std::string getModelName() const override { return "T-38 Trainer"; }
+    const FlightModelParams& params() const override { return kParams; }
 };
 
 class JetFlightModel : public IFlightModel {
 public:
-    void computeForces(const FlightState&, const ControlInputs&, double, double, FlightState&) override;
-    double getMaxThrust() const override { return 128000.0; }
-    double getMaxSpeed() const override { return 1200.0; }
-    double getStallSpeed() const override { return 120.0; }
-    double getFuelConsumptionRate() const override { return 120.0; }
+    static constexpr FlightModelParams kParams = {
+        12000.0, 27.87,
+        0.018, 6.2, 0.08, 1.2, 0.25,
+        2.5, 20.0,
+        45.0, 30.0, 20.0,
+        128000.0, 0.9, 1.5,             // afterburner above 90% throttle
+        1200.0, 120.0, 120.0,
+    };
+
+    void computeForces(const FlightState&, const ControlInputs&, double, double, const ConfigSnapshot&, FlightState&) override;
+    double getMaxThrust() const override { return kParams.maxThrust; }
+    double getMaxSpeed() const override { return kParams.maxSpeed; }
+    double getStallSpeed() const override { return kParams.stallSpeed; }
+    double getFuelConsumptionRate() const override { return kParams.fuelConsumptionRate; }
     std::string getModelName() const override { return "F-16 Fighting Falcon"; }
+    const FlightModelParams& params() const override { return kParams; }
 };
 
 class CargoFlightModel : public IFlightModel {
 public:
-    void computeForces(const FlightState&, const ControlInputs&, double, double, FlightState&) override;
-    double getMaxThrust() const override { return 180000.0; }
-    double getMaxSpeed() const override { return 470.0; }
-    double getStallSpeed() const override { return 105.0; }
-    double getFuelConsumptionRate() const override { return 200.0; }
+    static constexpr FlightModelParams kParams = {
+        70000.0, 162.1,
+        0.035, 5.0, 0.15, 2.0, 0.2,
+        1.5, 10.0,
+        15.0, 12.0, 10.0,
+        180000.0, 1.0, 1.0,
+        470.0, 105.0, 200.0,
+    };
+
+    void computeForces(const FlightState&, const ControlInputs&, double, double, const ConfigSnapshot&, FlightState&) override;
+    double getMaxThrust() const override { return kParams.maxThrust; }
+    double getMaxSpeed() const override { return kParams.maxSpeed; }
+    double getStallSpeed() const override { return kParams.stallSpeed; }
+    double getFuelConsumptionRate() const override { return kParams.fuelConsumptionRate; }
     std::string getModelName() const override { return "C-130 Hercules"; }
+    const FlightModelParams& params() const override { return kParams; }
 };
 
 #endif
@@ -0,0 +1,209 @@
+// File: InputDevice.cpp
+#include "InputDevice.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+#endif
+
+int64_t InputDevice::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+float InputShaping::shape(InputAxis axis, float value) const {
+    if (axis == InputAxis::Throttle) return std::clamp(value, 0.0f, 1.0f);
+    const float x = std::clamp(value, -1.0f, 1.0f);
+    const float dz = std::clamp(deadzone, 0.0f, 0.9f);
+    float a = std::abs(x);
+    if (a <= dz) return 0.0f;
+    a = (a - dz) / (1.0f - dz);
+    const float k = std::clamp(expo, 0.0f, 1.0f);
+    a = (1.0f - k) * a + k * a * a * a;
+    return std::copysign(a, x);
+}
+
+VirtualInputDevice::VirtualInputDevice(const std::string& name)
+    : m_name(name), m_buttons(0), m_eventNs(0), m_serial(0), m_seenSerial(0) {
+    for (auto& axis : m_axes) axis.store(0.0f, std::memory_order_relaxed);
+}
+
+void VirtualInputDevice::publish() {
+    m_eventNs.store(nowNs(), std::memory_order_relaxed);
+    m_serial.fetch_add(1, std::memory_order_release);
+}
+
+void VirtualInputDevice::set(InputAxis axis, float value) {
+    m_axes[static_cast<size_t>(axis)].store(value, std::memory_order_relaxed);
+    publish();
+}
+
+void VirtualInputDevice::setButtons(uint32_t buttons) {
+    m_buttons.store(buttons, std::memory_order_relaxed);
+    publish();
+}
+
+bool VirtualInputDevice::poll(RawInputState& state) {
+    const uint32_t serial = m_serial.load(std::memory_order_acquire);
+    if (serial == m_seenSerial) return false;
+    m_seenSerial = serial;
+    for (size_t i = 0; i < kInputAxisCount; ++i) state.axes[i] = m_axes[i].load(std::memory_order_relaxed);
+    state.buttons = m_buttons.load(std::memory_order_relaxed);
+    state.axisMask = (1u << kInputAxisCount) - 1;
+    state.eventNs = m_eventNs.load(std::memory_order_relaxed);
+    return true;
+}
+
+#ifdef __linux__
+namespace {
+    constexpr int kButtonCount = 32;                // BTN_JOYSTICK through the gamepad block
+
+    bool testBit(const unsigned long* bits, int bit) {
+        constexpr int kBitsPerLong = static_cast<int>(sizeof(unsigned long) * 8);
+        return (bits[bit / kBitsPerLong] >> (bit % kBitsPerLong)) & 1ul;
+    }
+}
+
+EvdevInputDevice::EvdevInputDevice(int fd, const std::string& name) : m_fd(fd), m_name(name), m_dropping(false) {}
+
+EvdevInputDevice::~EvdevInputDevice() {
+    if (m_fd >= 0) ::close(m_fd);
+}
+
+std::unique_ptr<EvdevInputDevice> EvdevInputDevice::open(const std::string& path, std::string& error) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        error = path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    char name[128] = {};
+    if (ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name) < 0) std::strcpy(name, "Unknown device");
+    // Event times on the clock InputDevice::nowNs() reads, so latency can be measured end to end.
+    int clock = CLOCK_MONOTONIC;
+    ioctl(fd, EVIOCSCLOCKID, &clock);
+
+    unsigned long absBits[(ABS_MAX + 1) / (sizeof(unsigned long) * 8) + 1] = {};
+    ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits);
+    std::unique_ptr<EvdevInputDevice> device(new EvdevInputDevice(fd, name));
+    auto bind = [&](InputAxis axis, std::initializer_list<int> codes, bool inverted) {
+        for (int code : codes) {
+            input_absinfo info{};
+            if (!testBit(absBits, code) || ioctl(fd, EVIOCGABS(code), &info) < 0 || info.maximum <= info.minimum) continue;
+            device->m_ranges[static_cast<size_t>(axis)] = { code, info.minimum, info.maximum, inverted };
+            return;
+        }
+    };
+    bind(InputAxis::Aileron, { ABS_X }, false);
+    bind(InputAxis::Elevator, { ABS_Y }, false);
+    bind(InputAxis::Rudder, { ABS_RUDDER, ABS_RZ }, false);
+    // Throttle levers report their minimum when pushed forward.
+    bind(InputAxis::Throttle, { ABS_THROTTLE, ABS_Z }, true);
+    if (device->m_ranges[static_cast<size_t>(InputAxis::Aileron)].code < 0 &&
+        device->m_ranges[static_cast<size_t>(InputAxis::Elevator)].code < 0) {
+        error = path + ": no stick axes";
+        return nullptr;
+    }
+    return device;
+}
+
+std::vector<std::string> EvdevInputDevice::findJoysticks() {
+    std::vector<std::string> paths;
+    for (int i = 0; i < 64; ++i) {
+        const std::string path = "/dev/input/event" + std::to_string(i);
+        const int fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) continue;
+        unsigned long keyBits[(KEY_MAX + 1) / (sizeof(unsigned long) * 8) + 1] = {};
+        unsigned long absBits[(ABS_MAX + 1) / (sizeof(unsigned long) * 8) + 1] = {};
+        ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits);
+        ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits);
+        ::close(fd);
+        const bool hasButtons = testBit(keyBits, BTN_JOYSTICK) || testBit(keyBits, BTN_GAMEPAD);
+        if (hasButtons && (testBit(absBits, ABS_X) || testBit(absBits, ABS_THROTTLE))) paths.push_back(path);
+    }
+    return paths;
+}
+
+float EvdevInputDevice::normalize(InputAxis axis, int value) const {
+    const AxisRange& range = m_ranges[static_cast<size_t>(axis)];
+    float t = static_cast<float>(value - range.minimum) / static_cast<float>(range.maximum - range.minimum);
+    if (range.inverted) t = 1.0f - t;
+    return axis == InputAxis::Throttle ? t : 2.0f * t - 1.0f;
+}
+
+void EvdevInputDevice::resync(RawInputState& state) {
+    for (size_t i = 0; i < kInputAxisCount; ++i) {
+        input_absinfo info{};
+        if (m_ranges[i].code >= 0 && ioctl(m_fd, EVIOCGABS(m_ranges[i].code), &info) == 0)
+            state.axes[i] = normalize(static_cast<InputAxis>(i), info.value);
+    }
+    unsigned long keys[(KEY_MAX + 1) / (sizeof(unsigned long) * 8) + 1] = {};
+    if (ioctl(m_fd, EVIOCGKEY(sizeof(keys)), keys) >= 0) {
+        state.buttons = 0;
+        for (int b = 0; b < kButtonCount; ++b) {
+            if (testBit(keys, BTN_JOYSTICK + b)) state.buttons |= 1u << b;
+        }
+    }
+}
+
+bool EvdevInputDevice::poll(RawInputState& state) {
+    if (m_fd < 0) return false;
+    state.axisMask = 0;
+    for (size_t i = 0; i < kInputAxisCount; ++i) {
+        if (m_ranges[i].code >= 0) state.axisMask |= 1u << i;
+    }
+
+    bool changed = false;
+    input_event events[64];
+    for (;;) {
+        const ssize_t bytes = ::read(m_fd, events, sizeof(events));
+        if (bytes < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN) {
+                // ENODEV: unplugged. Stop here rather than spin on a dead descriptor.
+                ::close(m_fd);
+                m_fd = -1;
+            }
+            return changed;
+        }
+        const size_t count = static_cast<size_t>(bytes) / sizeof(input_event);
+        for (size_t e = 0; e < count; ++e) {
+            const input_event& ev = events[e];
+            if (ev.type == EV_SYN) {
+                if (ev.code == SYN_DROPPED) {
+                    m_dropping = true;
+                } else if (ev.code == SYN_REPORT) {
+                    if (m_dropping) {
+                        resync(state);
+                        m_dropping = false;
+                    }
+                    state.eventNs = static_cast<int64_t>(ev.input_event_sec) * 1000000000LL + static_cast<int64_t>(ev.input_event_usec) * 1000LL;
+                    changed = true;
+                }
+                continue;
+            }
+            if (m_dropping) continue;
+            if (ev.type == EV_ABS) {
+                for (size_t i = 0; i < kInputAxisCount; ++i) {
+                    if (m_ranges[i].code == ev.code) state.axes[i] = normalize(static_cast<InputAxis>(i), ev.value);
+                }
+            } else if (ev.type == EV_KEY && ev.code >= BTN_JOYSTICK && ev.code < BTN_JOYSTICK + kButtonCount) {
+                const uint32_t bit = 1u << (ev.code - BTN_JOYSTICK);
+                state.buttons = ev.value ? (state.buttons | bit) : (state.buttons & ~bit);
+            }
+        }
+        if (count < sizeof(events) / sizeof(events[0])) return changed;
+    }
+}
+#endif
\ No newline at end of file
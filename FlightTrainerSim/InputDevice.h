@@ -0,0 +1,100 @@
+// File: InputDevice.h
+#ifndef INPUTDEVICE_H
+#define INPUTDEVICE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class InputAxis : uint8_t { Elevator, Aileron, Rudder, Throttle, Count };
+constexpr size_t kInputAxisCount = static_cast<size_t>(InputAxis::Count);
+
+// Device state after range normalization: stick axes in [-1, 1] (pulled back and right positive),
+// throttle in [0, 1]. `axisMask` has a bit per InputAxis the device actually provides.
+struct RawInputState {
+    std::array<float, kInputAxisCount> axes{};
+    uint32_t buttons = 0;
+    uint32_t axisMask = 0;
+    int64_t eventNs = 0;          // steady_clock time of the newest event folded in
+};
+
+// Deadzone around centre, then a cubic expo curve: 0 is linear, 1 is fully cubic. The throttle is
+// only clamped.
+struct InputShaping {
+    float deadzone = 0.05f;
+    float expo = 0.2f;
+    float shape(InputAxis axis, float value) const;
+};
+
+class InputDevice {
+public:
+    virtual ~InputDevice() = default;
+    virtual const std::string& name() const = 0;
+    // Non-blocking. Folds every pending event into `state`; true if anything changed.
+    virtual bool poll(RawInputState& state) = 0;
+    // False once the device has gone away (unplugged); poll() then never reports changes.
+    virtual bool connected() const { return true; }
+
+    static int64_t nowNs();
+};
+
+// Stand-in for a stick, driven from any thread. Each set() is one event, stamped when it is made,
+// so measured latency covers the same path a hardware event takes.
+class VirtualInputDevice : public InputDevice {
+public:
+    explicit VirtualInputDevice(const std::string& name = "Virtual stick");
+    const std::string& name() const override { return m_name; }
+    bool poll(RawInputState& state) override;
+
+    void set(InputAxis axis, float value);
+    void setButtons(uint32_t buttons);
+
+private:
+    void publish();
+
+    std::string m_name;
+    std::array<std::atomic<float>, kInputAxisCount> m_axes;
+    std::atomic<uint32_t> m_buttons;
+    std::atomic<int64_t> m_eventNs;
+    std::atomic<uint32_t> m_serial;
+    uint32_t m_seenSerial;
+};
+
+#ifdef __linux__
+// Joystick or HOTAS read through Linux evdev (/dev/input/event*), non-blocking, with event times
+// on the monotonic clock. X/Y map to aileron/elevator, Rz or rudder pedals to rudder, the throttle
+// (or Z) axis to throttle; joystick buttons fill the low bits of `buttons`.
+class EvdevInputDevice : public InputDevice {
+public:
+    ~EvdevInputDevice() override;
+    // Null with `error` set if the node cannot be opened or has no stick axes.
+    static std::unique_ptr<EvdevInputDevice> open(const std::string& path, std::string& error);
+    // Event nodes that look like joysticks, gamepads or throttles.
+    static std::vector<std::string> findJoysticks();
+
+    const std::string& name() const override { return m_name; }
+    bool poll(RawInputState& state) override;
+    bool connected() const override { return m_fd >= 0; }
+
+private:
+    struct AxisRange {
+        int code = -1;
+        int minimum = 0, maximum = 0;
+        bool inverted = false;
+    };
+
+    EvdevInputDevice(int fd, const std::string& name);
+    void resync(RawInputState& state);
+    float normalize(InputAxis axis, int value) const;
+
+    int m_fd;
+    std::string m_name;
+    std::array<AxisRange, kInputAxisCount> m_ranges;
+    bool m_dropping;                                // kernel buffer overran; skip to the next report
+};
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+// File: InputPoller.cpp
+#include "InputPoller.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+InputPoller::InputPoller(std::unique_ptr<InputDevice> device, size_t queueCapacity)
+    : m_device(std::move(device)), m_queue(queueCapacity), m_latestSequence(0), m_running(false), m_paused(false),
+      m_rateHz(kDefaultRateHz), m_deadzone(InputShaping().deadzone), m_expo(InputShaping().expo), m_polls(0), m_dropped(0),
+      m_maxLateNs(0), m_hasPending(false), m_takenPolledNs(0) {
+    for (auto& word : m_latestWords) word.store(0, std::memory_order_relaxed);
+}
+
+InputPoller::~InputPoller() {
+    stop();
+}
+
+void InputPoller::start() {
+    if (m_running.exchange(true)) return;
+    m_thread = std::thread(&InputPoller::run, this);
+}
+
+void InputPoller::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void InputPoller::setRateHz(double hz) {
+    m_rateHz.store(std::clamp(hz, 50.0, 8000.0), std::memory_order_relaxed);
+}
+
+void InputPoller::setShaping(const InputShaping& shaping) {
+    m_deadzone.store(shaping.deadzone, std::memory_order_relaxed);
+    m_expo.store(shaping.expo, std::memory_order_relaxed);
+}
+
+void InputPoller::setPaused(bool paused) {
+    m_paused.store(paused, std::memory_order_relaxed);
+}
+
+void InputPoller::storeLatest(const InputSample& sample) {
+    uint64_t words[kSampleWords] = {};
+    std::memcpy(words, &sample, sizeof(sample));
+    const uint64_t sequence = m_latestSequence.load(std::memory_order_relaxed);
+    m_latestSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kSampleWords; ++i) m_latestWords[i].store(words[i], std::memory_order_relaxed);
+    m_latestSequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool InputPoller::loadLatest(InputSample& out) const {
+    uint64_t words[kSampleWords];
+    for (;;) {
+        const uint64_t before = m_latestSequence.load(std::memory_order_acquire);
+        if (before == 0) return false;
+        if (before & 1) continue;
+        for (size_t i = 0; i < kSampleWords; ++i) words[i] = m_latestWords[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_latestSequence.load(std::memory_order_relaxed) == before) break;
+    }
+    std::memcpy(&out, words, sizeof(out));
+    return true;
+}
+
+void InputPoller::run() {
+    using Clock = std::chrono::steady_clock;
+    RawInputState raw;
+    auto next = Clock::now();
+    while (m_running.load(std::memory_order_relaxed)) {
+        const auto woke = Clock::now();
+        const int64_t lateNs = std::chrono::duration_cast<std::chrono::nanoseconds>(woke - next).count();
+        if (lateNs > m_maxLateNs.load(std::memory_order_relaxed)) m_maxLateNs.store(lateNs, std::memory_order_relaxed);
+
+        if (m_device->poll(raw)) {
+            InputShaping shaping;
+            shaping.deadzone = m_deadzone.load(std::memory_order_relaxed);
+            shaping.expo = m_expo.load(std::memory_order_relaxed);
+            InputSample sample;
+            sample.eventNs = raw.eventNs;
+            sample.polledNs = InputDevice::nowNs();
+            for (size_t i = 0; i < kInputAxisCount; ++i) sample.axes[i] = shaping.shape(static_cast<InputAxis>(i), raw.axes[i]);
+            sample.buttons = raw.buttons;
+            sample.axisMask = raw.axisMask;
+            storeLatest(sample);
+            if (!m_paused.load(std::memory_order_relaxed) && !m_queue.tryPush(sample))
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_polls.fetch_add(1, std::memory_order_relaxed);
+
+        // Fixed schedule; after a long stall (suspend, debugger) skip ahead instead of bursting.
+        const auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / m_rateHz.load(std::memory_order_relaxed)));
+        next += period;
+        if (next < woke) next = woke + period;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+bool InputPoller::takeUntil(int64_t untilNs, InputSample& out, int* merged) {
+    bool found = false;
+    int count = 0;
+    for (;;) {
+        if (!m_hasPending && !m_queue.tryPop(m_pending)) break;
+        m_hasPending = true;
+        if (m_pending.eventNs > untilNs) break;
+        m_hasPending = false;
+        // Already handed out from the latest-reading slot.
+        if (m_pending.polledNs <= m_takenPolledNs) continue;
+        out = m_pending;
+        found = true;
+        ++count;
+    }
+    // Newer than anything queued when the queue overflowed or the poller was paused.
+    InputSample latest;
+    if (loadLatest(latest) && latest.eventNs <= untilNs && latest.polledNs > (found ? out.polledNs : m_takenPolledNs)) {
+        out = latest;
+        found = true;
+        ++count;
+    }
+    if (found) m_takenPolledNs = out.polledNs;
+    if (merged) *merged = std::max(0, count - 1);
+    return found;
+}
\ No newline at end of file
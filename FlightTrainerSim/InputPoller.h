@@ -0,0 +1,80 @@
+// File: InputPoller.h
+#ifndef INPUTPOLLER_H
+#define INPUTPOLLER_H
+
+#include "InputDevice.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+// One shaped reading of the device, queued for the physics thread.
+struct InputSample {
+    int64_t eventNs = 0;          // when the device reported it (steady clock)
+    int64_t polledNs = 0;         // when the poller picked it up
+    std::array<float, kInputAxisCount> axes{};
+    uint32_t buttons = 0;
+    uint32_t axisMask = 0;
+};
+static_assert(std::is_trivially_copyable<InputSample>::value, "InputSample is copied through atomic words");
+
+// Polls an InputDevice on its own thread at a fixed rate (1 kHz by default) and hands every change
+// to the physics thread through a lock-free queue. The poller never waits on the simulation and the
+// simulation never waits on the device. Every sample is a whole device state, so the newest one
+// is also kept in a slot of its own: a full queue drops a sample (and counts it) but never the
+// latest stick position.
+class InputPoller {
+public:
+    static constexpr double kDefaultRateHz = 1000.0;
+
+    explicit InputPoller(std::unique_ptr<InputDevice> device, size_t queueCapacity = 1024);
+    ~InputPoller();
+    InputPoller(const InputPoller&) = delete;
+    InputPoller& operator=(const InputPoller&) = delete;
+
+    void start();
+    void stop();
+    // Both apply from the next poll.
+    void setRateHz(double hz);
+    void setShaping(const InputShaping& shaping);
+    // While paused nothing is queued, only the latest reading kept, and the first takeUntil after
+    // resuming starts from it.
+    void setPaused(bool paused);
+
+    // Physics thread. The newest sample reported at or before `untilNs`; later ones stay queued
+    // for the step they belong to. `merged` counts samples superseded within this step, including
+    // queued ones overtaken by the latest-reading slot.
+    bool takeUntil(int64_t untilNs, InputSample& out, int* merged = nullptr);
+
+    const InputDevice& device() const { return *m_device; }
+    uint64_t polls() const { return m_polls.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    // Worst overshoot of a poll past its scheduled time, which bounds the added latency.
+    double maxWakeLateUs() const { return m_maxLateNs.load(std::memory_order_relaxed) / 1000.0; }
+
+private:
+    static constexpr size_t kSampleWords = (sizeof(InputSample) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    void run();
+    // Seqlock over m_latestWords; written by the poller only.
+    void storeLatest(const InputSample& sample);
+    bool loadLatest(InputSample& out) const;
+
+    std::unique_ptr<InputDevice> m_device;
+    SpscQueue<InputSample> m_queue;
+    alignas(64) std::atomic<uint64_t> m_latestSequence;
+    std::atomic<uint64_t> m_latestWords[kSampleWords];
+    std::thread m_thread;
+    std::atomic<bool> m_running, m_paused;
+    std::atomic<double> m_rateHz;
+    std::atomic<float> m_deadzone, m_expo;
+    std::atomic<uint64_t> m_polls, m_dropped;
+    std::atomic<int64_t> m_maxLateNs;
+    // Consumer side.
+    InputSample m_pending;
+    bool m_hasPending;
+    int64_t m_takenPolledNs;      // polledNs of the last sample handed out
+};
+
+#endif
\ No newline at end of file
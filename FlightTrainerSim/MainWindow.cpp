@@ -1,14 +1,25 @@
 // File: MainWindow.cpp - FIXED VERSION
 #include "MainWindow.h"
 #include "AircraftFactory.h"
+#include "GlobalConfig.h"
+#include "SessionIndex.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QMessageBox>
+#include <QScreen>
+#include <QShortcut>
+#include <QDateTime>
+#include <QDir>
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent), m_engine(std::make_unique<SimulationEngine>(this))
-    , m_debriefWindow(std::make_unique<DebriefWindow>(this)) {
+    , m_debriefWindow(std::make_unique<DebriefWindow>(this))
+    , m_renderScheduler(std::make_unique<RenderScheduler>(m_engine.get()))
+    , m_configWatcher(std::make_unique<ConfigWatcher>(QString::fromStdString(GlobalConfig::instance().configPath()))) {
     setupUI();
+    setupRendering();
     connectSignals();
     initializeSimulation();
     setWindowTitle("FlightTrainerSim - Professional Flight Training System");
@@ -21,6 +32,48 @@ void MainWindow::setupUI() {
     setupStatusBar();
 }
 
+void MainWindow::setupRendering() {
+    const auto& config = GlobalConfig::instance();
+    if (screen()) m_renderScheduler->setRefreshRate(screen()->refreshRate());
+    m_renderScheduler->addView(m_cockpitView,
+        [this](const AircraftRenderState& state, qint64) { m_cockpitView->setRenderState(state); }, config.cockpitMaxFps());
+    m_renderScheduler->addView(m_outsideView,
+        [this](const AircraftRenderState& state, qint64 stateClockNs) {
+            m_outsideView->setRenderState(state);
+            m_engine->traffic(stateClockNs, m_traffic);
+            m_outsideView->setTraffic(m_traffic);
+        }, config.outsideMaxFps());
+
+    // F3 toggles the stage profiler and its overlay on the outside view.
+    Profiler::setEnabled(config.showDebugInfo());
+    auto* debugShortcut = new QShortcut(QKeySequence(Qt::Key_F3), this);
+    connect(debugShortcut, &QShortcut::activated, this, &MainWindow::onToggleDebugInfo);
+
+    // With --trace, F4 writes the timeline on demand; hitches are written automatically.
+    if (config.traceEnabled()) {
+        TraceRecorder::instance().setThreadName("GUI");
+        TraceRecorder::instance().setHitchDetection(config.hitchThresholdMs(), config.recordingDirectory());
+        TraceRecorder::setEnabled(true);
+    }
+    auto* traceShortcut = new QShortcut(QKeySequence(Qt::Key_F4), this);
+    connect(traceShortcut, &QShortcut::activated, this, &MainWindow::onDumpTrace);
+
+    // Edits to the config file apply live; the engine picks up rate changes on its next tick.
+    connect(m_configWatcher.get(), &ConfigWatcher::configReloaded, this, &MainWindow::onConfigReloaded);
+    connect(m_configWatcher.get(), &ConfigWatcher::reloadFailed, this,
+        [this](const QString& error) { m_warningLabel->setText("⚠ CONFIG NOT RELOADED: " + error); });
+}
+
+void MainWindow::onConfigReloaded(quint64 version) {
+    const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+    m_renderScheduler->setViewMaxFps(m_cockpitView, config.cockpitMaxFps);
+    m_renderScheduler->setViewMaxFps(m_outsideView, config.outsideMaxFps);
+    if (TraceRecorder::enabled()) {
+        TraceRecorder::instance().setHitchDetection(config.hitchThresholdMs, GlobalConfig::instance().recordingDirectory());
+    }
+    m_statusLabel->setText(QString("Configuration v%1 applied").arg(version));
+}
+
 void MainWindow::setupToolbar() {
     m_toolbar = addToolBar("Flight Controls");
     m_toolbar->setMovable(false);
@@ -48,10 +101,8 @@ void MainWindow::setupToolbar() {
     m_toolbar->addWidget(new QLabel(" Scenario: "));
 
     m_scenarioCombo = new QComboBox();
-    m_scenarioCombo->addItem("Basic Takeoff");
-    m_scenarioCombo->addItem("Traffic Pattern");
-    m_scenarioCombo->addItem("IFR Basic Navigation");
-    m_scenarioCombo->addItem("Engine Failure Recovery");
+    for (int i = 0; i < TrainingScenario::builtinCount(); ++i)
+        m_scenarioCombo->addItem(QString::fromStdString(TrainingScenario::builtin(i)->name()));
     m_toolbar->addWidget(m_scenarioCombo);
 
     m_toolbar->addSeparator();
@@ -109,6 +160,7 @@ void MainWindow::connectSignals() {
     connect(m_engine.get(), &SimulationEngine::warningIssued, this, &MainWindow::onWarningIssued);
     connect(m_engine.get(), &SimulationEngine::stateChanged, this, &MainWindow::onStateChanged);
     connect(m_controlPanel, &FlightControlPanel::controlsChanged, this, &MainWindow::onControlsChanged);
+    connect(m_controlPanel, &FlightControlPanel::autopilotToggled, this, &MainWindow::onAutopilotToggled);
 }
 
 void MainWindow::initializeSimulation() {
@@ -143,14 +195,8 @@ void MainWindow::onResetClicked() {
 }
 
 void MainWindow::onScenarioChanged(int index) {
-    std::unique_ptr<TrainingScenario> scenario;
-    switch (index) {
-    case 0: scenario = TrainingScenario::createBasicTakeoffScenario(); break;
-    case 1: scenario = TrainingScenario::createPatternScenario(); break;
-    case 2: scenario = TrainingScenario::createIFRBasicScenario(); break;
-    case 3: scenario = TrainingScenario::createEngineFailureScenario(); break;
-    default: scenario = TrainingScenario::createBasicTakeoffScenario();
-    }
+    std::unique_ptr<TrainingScenario> scenario = TrainingScenario::builtin(index);
+    if (!scenario) scenario = TrainingScenario::createBasicTakeoffScenario();
     m_engine->setScenario(std::move(scenario));
 }
 
@@ -167,19 +213,24 @@ void MainWindow::onAircraftChanged(int index) {
     m_cockpitView->setAircraft(m_engine->activeAircraft());
     m_outsideView->setAircraft(m_engine->activeAircraft());
     m_outsideView->setEnvironment(m_engine->environment());
+    m_renderScheduler->requestFrame();
 }
 
 void MainWindow::onSimulationUpdated() {
-    m_cockpitView->update();
-    m_outsideView->update();
+    m_renderScheduler->requestFrame();
+    if (TraceRecorder::enabled()) {
+        const std::string hitchTrace = TraceRecorder::instance().pollHitch();
+        if (!hitchTrace.empty()) m_statusLabel->setText("Hitch detected - trace written to " + QString::fromStdString(hitchTrace));
+    }
 }
 
 void MainWindow::onScenarioFinished(bool success) {
     updateUI();
+    DebriefReport report;
+    report.generate(*m_engine->metrics(), *m_engine->scenario(), *m_engine->activeAircraft());
+    indexSession(report);
     if (success) {
         m_statusLabel->setText("Scenario Completed Successfully!");
-        DebriefReport report;
-        report.generate(*m_engine->metrics(), *m_engine->scenario(), *m_engine->activeAircraft());
         m_debriefWindow->setReport(report, *m_engine->metrics());
         m_debriefWindow->exec();
     }
@@ -190,7 +241,27 @@ void MainWindow::onScenarioFinished(bool success) {
     }
 }
 
+void MainWindow::indexSession(const DebriefReport& report) {
+    const auto& config = GlobalConfig::instance();
+    if (config.sessionIndexPath().empty()) return;
+    SessionEntry entry;
+    entry.sessionFile = m_engine->recorder()->path();
+    entry.traineeId = config.traineeId();
+    entry.aircraftModel = m_engine->activeAircraft()->flightModel()->getModelName();
+    entry.scenarioName = m_engine->scenario()->name();
+    entry.startTimeMs = m_engine->sessionStartTimeMs();
+    entry.flightTime = m_engine->metrics()->totalFlightTime();
+    entry.overallScore = report.overallScore();
+    entry.categoryScores = report.categoryScores();
+    if (!SessionIndex::appendToFile(config.sessionIndexPath(), entry)) {
+        m_warningLabel->setText("⚠ SESSION INDEX NOT UPDATED");
+    }
+}
+
 void MainWindow::onWarningIssued(const QString& message) {
+    // Warnings repeat every tick while they hold; only a new one needs the label rebuilt.
+    const QString current = m_warningLabel->text();
+    if (current.size() == message.size() + 2 && current.endsWith(message)) return;
     m_warningLabel->setText("⚠ " + message);
 }
 
@@ -198,11 +269,41 @@ void MainWindow::onStateChanged(const QString& state) {
     updateUI();
 }
 
+void MainWindow::onToggleDebugInfo() {
+    auto& config = GlobalConfig::instance();
+    config.setShowDebug(!config.showDebugInfo());
+    Profiler::setEnabled(config.showDebugInfo());
+    m_outsideView->update();
+}
+
+void MainWindow::onDumpTrace() {
+    if (!TraceRecorder::enabled()) {
+        m_statusLabel->setText("Tracing is off - start with --trace");
+        return;
+    }
+    const QString dir = QString::fromStdString(GlobalConfig::instance().recordingDirectory());
+    QDir().mkpath(dir);
+    const QString path = dir + QDateTime::currentDateTime().toString("'/trace_'yyyyMMdd_HHmmss'.json'");
+    if (TraceRecorder::instance().dump(path.toStdString())) m_statusLabel->setText("Trace written to " + path);
+    else m_statusLabel->setText("Trace is empty");
+}
+
 // FIX 3: Always update controls
 void MainWindow::onControlsChanged(const ControlInputs& controls) {
     m_engine->setControlInputs(controls);
 }
 
+// The autopilot flies the scenario's waypoints, or holds what it finds if the scenario has none.
+void MainWindow::onAutopilotToggled(bool enabled) {
+    if (!enabled) {
+        m_engine->setPilotAgent(nullptr);
+        return;
+    }
+    AutopilotTargets targets;
+    targets.navigate = true;
+    m_engine->setPilotAgent(std::make_unique<AutopilotAgent>(targets));
+}
+
 // FIX 4: Proper button state management
 void MainWindow::updateUI() {
     bool isRunning = m_engine->isRunning();
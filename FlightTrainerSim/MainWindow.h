@@ -7,6 +7,8 @@
 #include "Outside3DView.h"
 #include "FlightControlPanel.h"
 #include "DebriefWindow.h"
+#include "RenderScheduler.h"
+#include "ConfigWatcher.h"
 #include <QMainWindow>
 #include <QToolBar>
 #include <QStatusBar>
@@ -32,9 +34,15 @@ private slots:
     void onWarningIssued(const QString& message);
     void onStateChanged(const QString& state);
     void onControlsChanged(const ControlInputs& controls);
+    void onAutopilotToggled(bool enabled);
+    void onToggleDebugInfo();
+    void onDumpTrace();
+    void onConfigReloaded(quint64 version);
 private:
     std::unique_ptr<SimulationEngine> m_engine;
     std::unique_ptr<DebriefWindow> m_debriefWindow;
+    std::unique_ptr<RenderScheduler> m_renderScheduler;
+    std::unique_ptr<ConfigWatcher> m_configWatcher;
     QToolBar* m_toolbar;
     QStatusBar* m_statusBar;
     QLabel *m_statusLabel, *m_warningLabel;
@@ -43,13 +51,16 @@ private:
     Cockpit3DView* m_cockpitView;
     Outside3DView* m_outsideView;
     FlightControlPanel* m_controlPanel;
+    std::vector<TrafficAircraft> m_traffic;
     void setupUI();
+    void setupRendering();
     void setupToolbar();
     void setupCentralWidget();
     void setupStatusBar();
     void connectSignals();
     void initializeSimulation();
     void updateUI();
+    void indexSession(const DebriefReport& report);
 };
 
 #endif
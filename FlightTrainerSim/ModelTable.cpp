@@ -0,0 +1,77 @@
+// File: ModelTable.cpp
+#include "ModelTable.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cmath>
+
+int TableAxis::nearest(double value) const {
+    return std::clamp(static_cast<int>(std::lround((value - first) / step)), 0, count - 1);
+}
+
+void TableAxis::locate(double value, int& index, double& fraction) const {
+    const double position = std::clamp((value - first) / step, 0.0, double(count - 1));
+    index = std::min(static_cast<int>(position), std::max(count - 2, 0));
+    fraction = position - index;
+}
+
+ModelTableWriter::ModelTableWriter(const char (&magic)[8], uint32_t version, const FlightModelParams& params, double gravity) {
+    m_out.append(magic, sizeof(magic));
+    m_out.append(reinterpret_cast<const char*>(&version), sizeof(version));
+    m_out.append(reinterpret_cast<const char*>(&params), sizeof(params));
+    m_out.append(reinterpret_cast<const char*>(&gravity), sizeof(gravity));
+}
+
+void ModelTableWriter::axes(std::initializer_list<const TableAxis*> axes) {
+    for (const TableAxis* axis : axes) {
+        m_out.append(reinterpret_cast<const char*>(&axis->first), sizeof(axis->first));
+        m_out.append(reinterpret_cast<const char*>(&axis->step), sizeof(axis->step));
+        m_out.append(reinterpret_cast<const char*>(&axis->count), sizeof(axis->count));
+    }
+}
+
+bool ModelTableWriter::save(const std::string& path) const {
+    const QString filePath = QString::fromStdString(path);
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    if (file.write(m_out.data(), static_cast<qint64>(m_out.size())) != static_cast<qint64>(m_out.size())) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+bool ModelTableReader::read(void* dst, size_t count) {
+    if (count > remaining()) return false;
+    if (count > 0) std::memcpy(dst, m_data.constData() + m_offset, count);
+    m_offset += count;
+    return true;
+}
+
+bool ModelTableReader::open(const std::string& path, const char (&magic)[8], uint32_t version,
+                            const FlightModelParams& params, double gravity) {
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    m_data = file.readAll();
+    m_offset = 0;
+    char fileMagic[sizeof(magic)];
+    uint32_t fileVersion = 0;
+    FlightModelParams fileParams;
+    double fileGravity = 0.0;
+    return read(fileMagic, sizeof(fileMagic)) && std::memcmp(fileMagic, magic, sizeof(magic)) == 0
+        && read(&fileVersion, sizeof(fileVersion)) && fileVersion == version
+        && read(&fileParams, sizeof(fileParams)) && std::memcmp(&fileParams, &params, sizeof(params)) == 0
+        && read(&fileGravity, sizeof(fileGravity)) && fileGravity == gravity;
+}
+
+bool ModelTableReader::axes(std::initializer_list<const TableAxis*> expected) {
+    for (const TableAxis* axis : expected) {
+        TableAxis fileAxis;
+        if (!read(&fileAxis.first, sizeof(fileAxis.first)) || !read(&fileAxis.step, sizeof(fileAxis.step))
+            || !read(&fileAxis.count, sizeof(fileAxis.count)) || !(fileAxis == *axis)) return false;
+    }
+    return true;
+}
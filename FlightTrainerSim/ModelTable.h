@@ -0,0 +1,101 @@
+// File: ModelTable.h
+#ifndef MODELTABLE_H
+#define MODELTABLE_H
+
+#include "IFlightModel.h"
+#include <QByteArray>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Shared by the tables precomputed per flight model and gravity (TrimTable, PerformanceEnvelope)
+// and cached under GlobalConfig::cacheDirectory(). A cache file holds an 8-byte magic, a version,
+// the model parameters and gravity it was built for, the table's axes, then its columns.
+
+// An evenly spaced grid axis.
+struct TableAxis {
+    double first = 0.0, step = 1.0;
+    int count = 1;
+
+    double value(int index) const { return first + step * index; }
+    int nearest(double value) const;
+    // Lower grid index and the fraction towards the next, clamped to the axis.
+    void locate(double value, int& index, double& fraction) const;
+    bool operator==(const TableAxis& other) const { return first == other.first && step == other.step && count == other.count; }
+};
+
+class ModelTableWriter {
+public:
+    ModelTableWriter(const char (&magic)[8], uint32_t version, const FlightModelParams& params, double gravity);
+    void axes(std::initializer_list<const TableAxis*> axes);
+    template <typename T>
+    void column(const std::vector<T>& values) {
+        m_out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+    // Written whole or not at all; creates the directory if needed.
+    bool save(const std::string& path) const;
+
+private:
+    std::string m_out;
+};
+
+// Reads a cache back only if it was written for these parameters, gravity and axes, so the column
+// sizes, and what they allocate, follow from the table being loaded rather than from the file.
+class ModelTableReader {
+public:
+    bool open(const std::string& path, const char (&magic)[8], uint32_t version, const FlightModelParams& params, double gravity);
+    bool axes(std::initializer_list<const TableAxis*> expected);
+    template <typename T>
+    bool column(std::vector<T>& values, size_t count) {
+        if (count > remaining() / sizeof(T)) return false;
+        values.resize(count);
+        return read(values.data(), count * sizeof(T));
+    }
+    // True once every byte has been read; trailing data means a different layout.
+    bool atEnd() const { return remaining() == 0; }
+
+private:
+    QByteArray m_data;
+    size_t m_offset = 0;
+
+    size_t remaining() const { return static_cast<size_t>(m_data.size()) - m_offset; }
+    bool read(void* dst, size_t count);
+};
+
+// One table per model parameters and gravity for the life of the process: loaded from `path`, or
+// built and saved there if the cache is missing or does not match. Thread-safe. Tables are never
+// freed or replaced, so callers may keep plain references.
+template <typename Table>
+class ModelTableCache {
+public:
+    template <typename Build>
+    static const Table& get(const FlightModelParams& params, double gravity, const std::string& path, Build build) {
+        static std::mutex mutex;
+        static std::vector<Entry> entries;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const Entry& entry : entries) {
+            if (std::memcmp(&entry.params, &params, sizeof(params)) == 0 && entry.gravity == gravity) return *entry.table;
+        }
+        auto table = std::make_unique<Table>(params, gravity);
+        if (!table->load(path)) {
+            build(*table);
+            if (!table->save(path)) std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+        }
+        entries.push_back({ params, gravity, std::move(table) });
+        return *entries.back().table;
+    }
+
+private:
+    struct Entry {
+        FlightModelParams params;
+        double gravity;
+        std::unique_ptr<Table> table;
+    };
+};
+
+#endif
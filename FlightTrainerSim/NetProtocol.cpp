@@ -0,0 +1,223 @@
+// File: NetProtocol.cpp
+#include "NetProtocol.h"
+#include "FlightRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    constexpr double kDistanceScale = 20.0;
+    constexpr int kHeadingField = 8;
+
+    template <typename T>
+    T quantizeClamped(double value, double scale) {
+        const double q = std::round(value * scale);
+        return static_cast<T>(std::clamp(q, static_cast<double>(std::numeric_limits<T>::min()),
+                                         static_cast<double>(std::numeric_limits<T>::max())));
+    }
+
+    uint64_t zigzag(int64_t value) { return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+    int64_t unzigzag(uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+}
+
+std::string NetProtocol::clampName(const std::string& name) {
+    if (name.size() <= kMaxNameLength) return name;
+    size_t length = kMaxNameLength;
+    while (length > 0 && (static_cast<uint8_t>(name[length]) & 0xC0) == 0x80) --length;
+    return name.substr(0, length);
+}
+
+NetAircraftState NetAircraftState::quantize(const FlightRecord& record) {
+    NetAircraftState s;
+    s.timeMs = static_cast<uint32_t>(std::max(0.0, std::round(record.timestamp * 1000.0)));
+    s.x = quantizeClamped<int32_t>(record.x, kDistanceScale);
+    s.y = quantizeClamped<int32_t>(record.y, kDistanceScale);
+    s.z = quantizeClamped<int32_t>(record.altitude, kDistanceScale);
+    s.velocityX = quantizeClamped<int16_t>(record.velocityX, kDistanceScale);
+    s.velocityY = quantizeClamped<int16_t>(record.velocityY, kDistanceScale);
+    s.velocityZ = quantizeClamped<int16_t>(record.velocityZ, kDistanceScale);
+    const double turns = record.heading / 360.0 - std::floor(record.heading / 360.0);
+    s.heading = static_cast<uint16_t>(static_cast<uint32_t>(std::lround(turns * 65536.0)) & 0xFFFF);
+    s.pitch = quantizeClamped<int16_t>(record.pitch, 32767.0 / 180.0);
+    s.bank = quantizeClamped<int16_t>(record.bank, 32767.0 / 180.0);
+    s.throttle = quantizeClamped<uint8_t>(record.throttle, 255.0);
+    s.flags = ((record.events & FlightEvent::GearDown) ? kGearDown : 0) | ((record.events & FlightEvent::Stall) ? kStalled : 0) |
+              ((record.events & FlightEvent::OnGround) ? kOnGround : 0);
+    return s;
+}
+
+Position3D NetAircraftState::position() const {
+    return { x / kDistanceScale, y / kDistanceScale, z / kDistanceScale };
+}
+
+Position3D NetAircraftState::velocity() const {
+    return { velocityX / kDistanceScale, velocityY / kDistanceScale, velocityZ / kDistanceScale };
+}
+
+double NetAircraftState::headingDegrees() const { return heading * (360.0 / 65536.0); }
+double NetAircraftState::pitchDegrees() const { return pitch * (180.0 / 32767.0); }
+double NetAircraftState::bankDegrees() const { return bank * (180.0 / 32767.0); }
+
+AircraftRenderState NetAircraftState::toRenderState() const {
+    AircraftRenderState state;
+    const Position3D v = velocity();
+    state.timestamp = time();
+    state.position = position();
+    state.heading = headingDegrees();
+    state.pitch = pitchDegrees();
+    state.bank = bankDegrees();
+    state.speed = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    state.verticalSpeed = v.z * 60.0;
+    state.throttle = throttle / 255.0;
+    state.stalled = (flags & kStalled) != 0;
+    state.onGround = (flags & kOnGround) != 0;
+    return state;
+}
+
+int64_t NetAircraftState::field(int index) const {
+    switch (index) {
+    case 0: return timeMs;
+    case 1: return x;
+    case 2: return y;
+    case 3: return z;
+    case 4: return velocityX;
+    case 5: return velocityY;
+    case 6: return velocityZ;
+    case 7: return pitch;
+    case kHeadingField: return heading;
+    case 9: return bank;
+    case 10: return throttle;
+    default: return flags;
+    }
+}
+
+void NetAircraftState::setField(int index, int64_t value) {
+    switch (index) {
+    case 0: timeMs = static_cast<uint32_t>(value); break;
+    case 1: x = static_cast<int32_t>(value); break;
+    case 2: y = static_cast<int32_t>(value); break;
+    case 3: z = static_cast<int32_t>(value); break;
+    case 4: velocityX = static_cast<int16_t>(value); break;
+    case 5: velocityY = static_cast<int16_t>(value); break;
+    case 6: velocityZ = static_cast<int16_t>(value); break;
+    case 7: pitch = static_cast<int16_t>(value); break;
+    case kHeadingField: heading = static_cast<uint16_t>(value & 0xFFFF); break;
+    case 9: bank = static_cast<int16_t>(value); break;
+    case 10: throttle = static_cast<uint8_t>(value); break;
+    default: flags = static_cast<uint8_t>(value); break;
+    }
+}
+
+bool NetAircraftState::operator==(const NetAircraftState& other) const {
+    for (int i = 0; i < kFieldCount; ++i) {
+        if (field(i) != other.field(i)) return false;
+    }
+    return true;
+}
+
+void NetWriter::u8(uint8_t value) {
+    if (m_size >= m_capacity) {
+        m_overflow = true;
+        return;
+    }
+    m_data[m_size++] = value;
+}
+
+void NetWriter::u16(uint16_t value) {
+    u8(static_cast<uint8_t>(value & 0xFF));
+    u8(static_cast<uint8_t>(value >> 8));
+}
+
+void NetWriter::varint(uint64_t value) {
+    while (value >= 0x80) {
+        u8(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    u8(static_cast<uint8_t>(value));
+}
+
+void NetWriter::string(const std::string& text) {
+    const size_t length = std::min(text.size(), NetProtocol::kMaxNameLength);
+    u8(static_cast<uint8_t>(length));
+    for (size_t i = 0; i < length; ++i) u8(static_cast<uint8_t>(text[i]));
+}
+
+void NetWriter::header(const NetProtocol::Header& header) {
+    u16(NetProtocol::kMagic);
+    u8(NetProtocol::kVersion);
+    u8(static_cast<uint8_t>(header.type));
+    u16(header.sequence);
+    u16(header.ack);
+}
+
+void NetWriter::delta(const NetAircraftState& state, const NetAircraftState& baseline) {
+    uint16_t mask = 0;
+    for (int i = 0; i < NetAircraftState::kFieldCount; ++i) {
+        if (state.field(i) != baseline.field(i)) mask |= static_cast<uint16_t>(1u << i);
+    }
+    u16(mask);
+    for (int i = 0; i < NetAircraftState::kFieldCount; ++i) {
+        if (!(mask & (1u << i))) continue;
+        int64_t difference = state.field(i) - baseline.field(i);
+        // Heading wraps, so 359 -> 1 degree is a small step rather than a large one.
+        if (i == kHeadingField) difference = static_cast<int16_t>(static_cast<uint16_t>(difference));
+        varint(zigzag(difference));
+    }
+}
+
+uint8_t NetReader::u8() {
+    if (m_pos >= m_size) {
+        m_error = true;
+        return 0;
+    }
+    return m_data[m_pos++];
+}
+
+uint16_t NetReader::u16() {
+    const uint16_t low = u8();
+    return static_cast<uint16_t>(low | (u8() << 8));
+}
+
+uint64_t NetReader::varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const uint8_t byte = u8();
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    m_error = true;
+    return 0;
+}
+
+std::string NetReader::string() {
+    const size_t length = u8();
+    if (m_pos + length > m_size) {
+        m_error = true;
+        return std::string();
+    }
+    std::string text(reinterpret_cast<const char*>(m_data + m_pos), length);
+    m_pos += length;
+    return text;
+}
+
+bool NetReader::header(NetProtocol::Header& header) {
+    if (u16() != NetProtocol::kMagic || u8() != NetProtocol::kVersion) return false;
+    const uint8_t type = u8();
+    if (type < static_cast<uint8_t>(NetProtocol::PacketType::Hello) || type > static_cast<uint8_t>(NetProtocol::PacketType::Bye)) return false;
+    header.type = static_cast<NetProtocol::PacketType>(type);
+    header.sequence = u16();
+    header.ack = u16();
+    return ok();
+}
+
+bool NetReader::delta(const NetAircraftState& baseline, NetAircraftState& out) {
+    out = baseline;
+    const uint16_t mask = u16();
+    if (mask >> NetAircraftState::kFieldCount) m_error = true;
+    for (int i = 0; i < NetAircraftState::kFieldCount && ok(); ++i) {
+        // Wraps rather than overflows on a corrupt difference; setField narrows it anyway.
+        if (mask & (1u << i))
+            out.setField(i, static_cast<int64_t>(static_cast<uint64_t>(baseline.field(i)) + static_cast<uint64_t>(unzigzag(varint()))));
+    }
+    return ok();
+}
@@ -0,0 +1,111 @@
+// File: NetProtocol.h
+#ifndef NETPROTOCOL_H
+#define NETPROTOCOL_H
+
+#include "RenderState.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct FlightRecord;
+
+// Wire format for multiplayer sessions. Every datagram starts with a fixed header; states travel
+// quantized to integers and are delta-encoded field by field against a baseline the receiver has
+// acknowledged, so steady flight costs a couple of bytes per changing field.
+namespace NetProtocol {
+    constexpr uint16_t kMagic = 0x4654;        // "FT"
+    constexpr uint8_t kVersion = 1;
+    constexpr int kMaxParticipants = 32;
+    constexpr size_t kMaxPacketSize = 4096;
+    constexpr size_t kHeaderSize = 8;
+    constexpr int kHistory = 32;              // sent/received states kept as delta baselines
+    constexpr size_t kMaxNameLength = 31;     // callsign and model, in bytes
+    // Worst case for one entity in a snapshot: id, both names, and a mask with every field changed
+    // (each field is at most 32 bits, so its zigzag difference takes at most 5 varint bytes).
+    constexpr size_t kMaxEntitySize = 1 + 2 * (1 + kMaxNameLength) + 2 + 12 * 5;
+    static_assert(kHeaderSize + 9 + kMaxParticipants * kMaxEntitySize <= kMaxPacketSize,
+                  "a snapshot of every participant must fit in one packet");
+
+    enum class PacketType : uint8_t { Hello = 1, Welcome = 2, State = 3, Snapshot = 4, Bye = 5 };
+
+    struct Header {
+        PacketType type = PacketType::Hello;
+        uint16_t sequence = 0;
+        uint16_t ack = 0;                       // newest sequence received from the other side
+    };
+
+    // True if `a` was sent after `b`, allowing for wraparound.
+    inline bool newer(uint16_t a, uint16_t b) { return static_cast<int16_t>(a - b) > 0; }
+    // `name` cut to kMaxNameLength bytes without splitting a UTF-8 sequence.
+    std::string clampName(const std::string& name);
+}
+
+// One aircraft on the wire. Positions and velocities in 1/20 units, angles in 1/65536 turns
+// (pitch and bank in 1/32768 half-turns), throttle in 1/255.
+struct NetAircraftState {
+    static constexpr int kFieldCount = 12;
+    static constexpr uint8_t kGearDown = 1, kStalled = 2, kOnGround = 4;
+
+    uint32_t timeMs = 0;
+    int32_t x = 0, y = 0, z = 0;
+    int16_t velocityX = 0, velocityY = 0, velocityZ = 0;
+    uint16_t heading = 0;
+    int16_t pitch = 0, bank = 0;
+    uint8_t throttle = 0;
+    uint8_t flags = 0;
+
+    static NetAircraftState quantize(const FlightRecord& record);
+    double time() const { return timeMs / 1000.0; }
+    Position3D position() const;
+    Position3D velocity() const;
+    double headingDegrees() const;
+    double pitchDegrees() const;
+    double bankDegrees() const;
+    AircraftRenderState toRenderState() const;
+
+    int64_t field(int index) const;
+    void setField(int index, int64_t value);
+    bool operator==(const NetAircraftState& other) const;
+};
+
+// Serializes into a caller-owned buffer; overflow is sticky and checked once at the end.
+class NetWriter {
+public:
+    NetWriter(uint8_t* buffer, size_t capacity) : m_data(buffer), m_capacity(capacity), m_size(0), m_overflow(false) {}
+    void u8(uint8_t value);
+    void u16(uint16_t value);
+    void varint(uint64_t value);
+    // At most kMaxNameLength bytes.
+    void string(const std::string& text);
+    void header(const NetProtocol::Header& header);
+    // Fields that differ from `baseline`, as a 16-bit mask followed by zigzag varint differences.
+    void delta(const NetAircraftState& state, const NetAircraftState& baseline);
+    uint8_t* data() { return m_data; }
+    size_t size() const { return m_size; }
+    bool ok() const { return !m_overflow; }
+    void patchU8(size_t offset, uint8_t value) { if (offset < m_size) m_data[offset] = value; }
+private:
+    uint8_t* m_data;
+    size_t m_capacity, m_size;
+    bool m_overflow;
+};
+
+class NetReader {
+public:
+    NetReader(const uint8_t* data, size_t size) : m_data(data), m_size(size), m_pos(0), m_error(false) {}
+    uint8_t u8();
+    uint16_t u16();
+    uint64_t varint();
+    std::string string();
+    // Rejects a bad magic or version.
+    bool header(NetProtocol::Header& header);
+    bool delta(const NetAircraftState& baseline, NetAircraftState& out);
+    bool ok() const { return !m_error; }
+    bool atEnd() const { return m_pos >= m_size; }
+private:
+    const uint8_t* m_data;
+    size_t m_size, m_pos;
+    bool m_error;
+};
+
+#endif
@@ -0,0 +1,504 @@
+// File: NetSession.cpp
+#include "NetSession.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    constexpr double kPi = 3.14159265358979323846;
+    constexpr uint8_t kEntityInfo = 0x80;          // entity id flag: callsign and model follow
+    const NetAircraftState kZeroState;
+
+    double wrapDegrees(double degrees) {
+        degrees = std::fmod(degrees + 180.0, 360.0);
+        if (degrees < 0.0) degrees += 360.0;
+        return degrees - 180.0;
+    }
+
+    double normalizeHeading(double degrees) {
+        degrees = std::fmod(degrees, 360.0);
+        return degrees < 0.0 ? degrees + 360.0 : degrees;
+    }
+
+    bool hasEntity(uint32_t present, int entity) { return (present >> entity) & 1u; }
+
+    uint32_t toMs(double seconds) { return static_cast<uint32_t>(std::llround(std::max(0.0, seconds) * 1000.0)); }
+}
+
+void NetClockOffset::observe(double localMinusRemote) {
+    if (!valid || localMinusRemote - offset > RemoteAircraft::kMaxExtrapolation) offset = localMinusRemote;
+    else offset = std::min(localMinusRemote, offset + 1.0e-4);
+    valid = true;
+}
+
+void RemoteAircraft::reset() {
+    m_hasState = false;
+    m_courseRate = m_headingRate = m_pitchRate = m_bankRate = 0.0;
+    m_positionError = Position3D();
+    m_headingError = m_pitchError = m_bankError = 0.0;
+}
+
+void RemoteAircraft::apply(const NetAircraftState& state, double now, double clockOffset) {
+    if (!m_hasState) {
+        m_clockOffset = clockOffset;
+        m_state = state;
+        m_hasState = true;
+        m_errorTime = now;
+        return;
+    }
+    const AircraftRenderState shown = stateAt(now);
+
+    // Rates from the sender's own clock, so network jitter does not distort them.
+    const double elapsed = (static_cast<int32_t>(state.timeMs - m_state.timeMs)) / 1000.0;
+    if (elapsed > 0.0 && elapsed < 2.0) {
+        const Position3D v0 = m_state.velocity(), v1 = state.velocity();
+        const bool moving = v0.x * v0.x + v0.y * v0.y > 1.0 && v1.x * v1.x + v1.y * v1.y > 1.0;
+        m_courseRate = moving ? std::remainder(std::atan2(v1.y, v1.x) - std::atan2(v0.y, v0.x), 2.0 * kPi) / elapsed : 0.0;
+        m_headingRate = wrapDegrees(state.headingDegrees() - m_state.headingDegrees()) / elapsed;
+        m_pitchRate = (state.pitchDegrees() - m_state.pitchDegrees()) / elapsed;
+        m_bankRate = (state.bankDegrees() - m_state.bankDegrees()) / elapsed;
+    } else {
+        m_courseRate = m_headingRate = m_pitchRate = m_bankRate = 0.0;
+    }
+
+    // The correction is what separates the pose on screen from the new extrapolation.
+    m_state = state;
+    m_clockOffset = clockOffset;
+    m_errorTime = now;
+    m_positionError = Position3D();
+    m_headingError = m_pitchError = m_bankError = 0.0;
+    const AircraftRenderState corrected = stateAt(now);
+    m_positionError = { shown.position.x - corrected.position.x, shown.position.y - corrected.position.y,
+                        shown.position.z - corrected.position.z };
+    m_headingError = wrapDegrees(shown.heading - corrected.heading);
+    m_pitchError = shown.pitch - corrected.pitch;
+    m_bankError = shown.bank - corrected.bank;
+}
+
+AircraftRenderState RemoteAircraft::stateAt(double now) const {
+    AircraftRenderState s = m_state.toRenderState();
+    if (!m_hasState) return s;
+    const double t = std::clamp(now - (m_state.time() + m_clockOffset), 0.0, kMaxExtrapolation);
+    const Position3D v = m_state.velocity();
+
+    // Horizontal path is an arc at the observed turn rate; a straight line when not turning.
+    if (std::abs(m_courseRate) > 1.0e-4) {
+        const double angle = m_courseRate * t;
+        const double sine = std::sin(angle), cosine = std::cos(angle);
+        s.position.x += (sine * v.x + (cosine - 1.0) * v.y) / m_courseRate;
+        s.position.y += ((1.0 - cosine) * v.x + sine * v.y) / m_courseRate;
+    } else {
+        s.position.x += v.x * t;
+        s.position.y += v.y * t;
+    }
+    s.position.z += v.z * t;
+    s.heading = m_state.headingDegrees() + m_headingRate * t;
+    s.pitch = std::clamp(m_state.pitchDegrees() + m_pitchRate * t, -90.0, 90.0);
+    s.bank = std::clamp(m_state.bankDegrees() + m_bankRate * t, -180.0, 180.0);
+    s.timestamp += t;
+
+    const double decay = std::exp(-std::max(0.0, now - m_errorTime) / kSmoothingSeconds);
+    s.position.x += m_positionError.x * decay;
+    s.position.y += m_positionError.y * decay;
+    s.position.z += m_positionError.z * decay;
+    s.heading = normalizeHeading(s.heading + m_headingError * decay);
+    s.pitch += m_pitchError * decay;
+    s.bank += m_bankError * decay;
+    return s;
+}
+
+NetSession::NetSession(NetTransport& transport, Role role, const std::string& callsign, const std::string& model)
+    : m_transport(transport), m_role(role), m_callsign(NetProtocol::clampName(callsign)), m_model(NetProtocol::clampName(model)),
+      m_hasLocal(false), m_nextSend(0.0), m_lastHello(-kHelloInterval), m_packet{}, m_incoming{},
+      m_remotes(NetProtocol::kMaxParticipants),
+      m_host(0), m_entityId(-1), m_lastFromHost(0.0), m_nextSequence(1), m_hostAck(0), m_lastSnapshot(0),
+      m_sentSequence{}, m_sent{} {
+    if (m_role == Role::Host) m_clients.resize(NetProtocol::kMaxParticipants);
+    else m_snapshots.resize(NetProtocol::kHistory);
+}
+
+void NetSession::connectTo(NetEndpoint host) {
+    disconnect();
+    m_host = host;
+    m_lastHello = -kHelloInterval;
+}
+
+void NetSession::setLocalState(const FlightRecord& record) {
+    m_local = NetAircraftState::quantize(record);
+    m_hasLocal = true;
+}
+
+int NetSession::participantCount() const {
+    int count = connected() ? 1 : 0;
+    for (size_t i = 0; i < m_remotes.size(); ++i) {
+        if (static_cast<int>(i) != entityId() && m_remotes[i].hasState()) ++count;
+    }
+    return count;
+}
+
+uint16_t NetSession::advance(uint16_t& sequence) {
+    const uint16_t current = sequence;
+    if (++sequence == 0) sequence = 1;              // 0 means "nothing" in acks and baselines
+    return current;
+}
+
+void NetSession::countGap(uint16_t previous, uint16_t current) {
+    if (previous == 0) return;
+    int gap = static_cast<uint16_t>(current - previous) - 1;
+    if (previous > current) --gap;                  // the wrap skipped 0
+    if (gap > 0) m_stats.packetsLost += static_cast<uint64_t>(gap);
+}
+
+void NetSession::send(NetEndpoint to, const NetWriter& writer) {
+    if (!writer.ok()) {
+        if (m_stats.oversized++ == 0) std::fprintf(stderr, "NetSession: packet larger than %zu bytes not sent\n", NetProtocol::kMaxPacketSize);
+        return;
+    }
+    if (m_transport.send(to, m_packet.data(), writer.size())) {
+        ++m_stats.packetsSent;
+        m_stats.bytesSent += writer.size();
+    }
+}
+
+void NetSession::update(double now, double sendRateHz) {
+    receiveAll(now);
+    const double interval = 1.0 / std::clamp(sendRateHz, 1.0, 120.0);
+
+    if (m_role == Role::Host) {
+        expireClients(now);
+        if (now < m_nextSend) return;
+        m_nextSend = std::max(m_nextSend + interval, now);
+        for (size_t id = 1; id < m_clients.size(); ++id) {
+            if (m_clients[id].active) sendSnapshot(m_clients[id], static_cast<int>(id), now);
+        }
+        return;
+    }
+
+    if (m_host == 0) return;
+    if (m_entityId >= 0 && now - m_lastFromHost > kTimeoutSeconds) disconnect();
+    if (m_entityId < 0) {
+        if (now - m_lastHello >= kHelloInterval) {
+            m_lastHello = now;
+            sendHello();
+        }
+        return;
+    }
+    if (now < m_nextSend) return;
+    m_nextSend = std::max(m_nextSend + interval, now);
+    if (m_hasLocal) sendState();
+}
+
+void NetSession::receiveAll(double now) {
+    NetEndpoint from = 0;
+    size_t size = 0;
+    while (m_transport.receive(from, m_incoming.data(), size)) {
+        ++m_stats.packetsReceived;
+        m_stats.bytesReceived += size;
+        NetReader reader(m_incoming.data(), size);
+        NetProtocol::Header header;
+        if (!reader.header(header)) {
+            ++m_stats.undecodable;
+            continue;
+        }
+        if (m_role == Role::Host) handleAtHost(from, header, reader, now);
+        else if (from == m_host) handleAtClient(header, reader, now);
+    }
+}
+
+int NetSession::findClient(NetEndpoint endpoint) const {
+    for (size_t id = 1; id < m_clients.size(); ++id) {
+        if (m_clients[id].active && m_clients[id].endpoint == endpoint) return static_cast<int>(id);
+    }
+    return -1;
+}
+
+void NetSession::handleAtHost(NetEndpoint from, const NetProtocol::Header& header, NetReader& reader, double now) {
+    using NetProtocol::PacketType;
+    int id = findClient(from);
+
+    if (header.type == PacketType::Hello) {
+        std::string callsign = reader.string();
+        std::string model = reader.string();
+        if (!reader.ok()) {
+            ++m_stats.undecodable;
+            return;
+        }
+        if (id < 0) {
+            for (size_t i = 1; i < m_clients.size() && id < 0; ++i) {
+                if (!m_clients[i].active) id = static_cast<int>(i);
+            }
+            if (id < 0) return;                      // full; the client keeps retrying
+            m_remotes[static_cast<size_t>(id)].reset();
+        }
+        // A client says Hello only while it holds no session state, so its baselines start over
+        // too. Answered on every Hello, since the Welcome itself may be lost.
+        Client& client = m_clients[static_cast<size_t>(id)];
+        client = Client();
+        client.active = true;
+        client.endpoint = from;
+        client.lastHeard = now;
+        m_remotes[static_cast<size_t>(id)].callsign = NetProtocol::clampName(callsign);
+        m_remotes[static_cast<size_t>(id)].model = NetProtocol::clampName(model);
+        NetWriter writer(m_packet.data(), m_packet.size());
+        writer.header({ PacketType::Welcome, 0, 0 });
+        writer.u8(static_cast<uint8_t>(id));
+        send(from, writer);
+        return;
+    }
+    if (id < 0) return;
+    Client& client = m_clients[static_cast<size_t>(id)];
+    client.lastHeard = now;
+
+    if (header.type == PacketType::Bye) {
+        client.active = false;
+        m_remotes[static_cast<size_t>(id)].reset();
+        return;
+    }
+    if (header.type != PacketType::State) return;
+
+    if (header.ack != 0 && (client.ackedSnapshot == 0 || NetProtocol::newer(header.ack, client.ackedSnapshot)))
+        client.ackedSnapshot = header.ack;
+    if (client.lastReceived != 0 && !NetProtocol::newer(header.sequence, client.lastReceived)) return;   // late duplicate
+    countGap(client.lastReceived, header.sequence);
+
+    const bool hasBaseline = reader.u8() != 0;
+    const uint16_t baseSequence = reader.u16();
+    NetAircraftState baseline;
+    if (hasBaseline) {
+        const size_t slot = baseSequence % NetProtocol::kHistory;
+        if (client.receivedSequence[slot] != baseSequence) {
+            ++m_stats.undecodable;
+            return;
+        }
+        baseline = client.received[slot];
+    }
+    NetAircraftState state;
+    if (!reader.delta(baseline, state)) {
+        ++m_stats.undecodable;
+        return;
+    }
+    const size_t slot = header.sequence % NetProtocol::kHistory;
+    client.received[slot] = state;
+    client.receivedSequence[slot] = header.sequence;
+    client.lastReceived = header.sequence;
+
+    // Relayed on the host clock, so clients need only one offset.
+    client.clock.observe(now - state.time());
+    NetAircraftState stamped = state;
+    stamped.timeMs = toMs(state.time() + client.clock.offset);
+    RemoteAircraft& remote = m_remotes[static_cast<size_t>(id)];
+    if (!remote.hasState() || remote.lastState().timeMs != stamped.timeMs) remote.apply(stamped, now, 0.0);
+}
+
+void NetSession::handleAtClient(const NetProtocol::Header& header, NetReader& reader, double now) {
+    using NetProtocol::PacketType;
+    switch (header.type) {
+    case PacketType::Welcome: {
+        const int id = reader.u8();
+        if (!reader.ok() || id <= 0 || id >= NetProtocol::kMaxParticipants) {
+            ++m_stats.undecodable;
+            return;
+        }
+        if (m_entityId != id) {
+            disconnect();
+            m_entityId = id;
+        }
+        m_lastFromHost = now;
+        break;
+    }
+    case PacketType::Snapshot:
+        if (m_entityId < 0) return;
+        m_lastFromHost = now;
+        readSnapshot(header, reader, now);
+        break;
+    case PacketType::Bye:
+        disconnect();
+        m_lastHello = now;                            // back off before rejoining
+        break;
+    default:
+        break;
+    }
+}
+
+void NetSession::readSnapshot(const NetProtocol::Header& header, NetReader& reader, double now) {
+    if (header.ack != 0 && (m_hostAck == 0 || NetProtocol::newer(header.ack, m_hostAck))) m_hostAck = header.ack;
+    if (m_lastSnapshot != 0 && !NetProtocol::newer(header.sequence, m_lastSnapshot)) return;
+
+    const bool hasBaseline = reader.u8() != 0;
+    const uint16_t baseSequence = reader.u16();
+    const uint32_t hostTimeMs = static_cast<uint32_t>(reader.varint());
+    const int count = reader.u8();
+    const Snapshot* baseline = nullptr;
+    if (hasBaseline) {
+        const Snapshot& candidate = m_snapshots[baseSequence % NetProtocol::kHistory];
+        if (candidate.sequence != baseSequence) {
+            ++m_stats.undecodable;
+            return;
+        }
+        baseline = &candidate;
+    }
+
+    m_scratch.sequence = header.sequence;
+    m_scratch.present = 0;
+    for (int i = 0; i < count && reader.ok(); ++i) {
+        const uint8_t tag = reader.u8();
+        const int entity = tag & ~kEntityInfo;
+        if (entity >= NetProtocol::kMaxParticipants || hasEntity(m_scratch.present, entity)) {
+            ++m_stats.undecodable;
+            return;
+        }
+        if (tag & kEntityInfo) {
+            std::string callsign = reader.string();
+            std::string model = reader.string();
+            RemoteAircraft& remote = m_remotes[static_cast<size_t>(entity)];
+            if (remote.callsign != callsign) remote.callsign = std::move(callsign);
+            if (remote.model != model) remote.model = std::move(model);
+        }
+        const bool known = baseline && hasEntity(baseline->present, entity);
+        reader.delta(known ? baseline->states[static_cast<size_t>(entity)] : kZeroState, m_scratch.states[static_cast<size_t>(entity)]);
+        m_scratch.present |= 1u << entity;
+    }
+    if (!reader.ok()) {
+        ++m_stats.undecodable;
+        return;
+    }
+    countGap(m_lastSnapshot, header.sequence);
+    m_lastSnapshot = header.sequence;
+    m_snapshots[header.sequence % NetProtocol::kHistory] = m_scratch;
+    m_hostClock.observe(now - hostTimeMs / 1000.0);
+
+    for (int entity = 0; entity < NetProtocol::kMaxParticipants; ++entity) {
+        RemoteAircraft& remote = m_remotes[static_cast<size_t>(entity)];
+        if (!hasEntity(m_scratch.present, entity)) {
+            if (remote.hasState()) remote.reset();
+            continue;
+        }
+        const NetAircraftState& state = m_scratch.states[static_cast<size_t>(entity)];
+        if (!remote.hasState() || remote.lastState().timeMs != state.timeMs) remote.apply(state, now, m_hostClock.offset);
+    }
+}
+
+void NetSession::sendHello() {
+    NetWriter writer(m_packet.data(), m_packet.size());
+    writer.header({ NetProtocol::PacketType::Hello, 0, 0 });
+    writer.string(m_callsign);
+    writer.string(m_model);
+    send(m_host, writer);
+}
+
+void NetSession::sendState() {
+    const uint16_t sequence = advance(m_nextSequence);
+    const size_t baseSlot = m_hostAck % NetProtocol::kHistory;
+    const bool hasBaseline = m_hostAck != 0 && m_sentSequence[baseSlot] == m_hostAck;
+
+    NetWriter writer(m_packet.data(), m_packet.size());
+    writer.header({ NetProtocol::PacketType::State, sequence, m_lastSnapshot });
+    writer.u8(hasBaseline ? 1 : 0);
+    writer.u16(hasBaseline ? m_hostAck : 0);
+    writer.delta(m_local, hasBaseline ? m_sent[baseSlot] : NetAircraftState());
+    send(m_host, writer);
+
+    const size_t slot = sequence % NetProtocol::kHistory;
+    m_sent[slot] = m_local;
+    m_sentSequence[slot] = sequence;
+}
+
+void NetSession::sendSnapshot(Client& client, int clientId, double now) {
+    const uint16_t sequence = advance(client.nextSequence);
+    const Snapshot& candidate = client.sent[client.ackedSnapshot % NetProtocol::kHistory];
+    const Snapshot* baseline = client.ackedSnapshot != 0 && candidate.sequence == client.ackedSnapshot ? &candidate : nullptr;
+
+    m_scratch.sequence = sequence;
+    m_scratch.present = 0;
+    if (m_hasLocal) {
+        m_scratch.states[0] = m_local;
+        m_scratch.states[0].timeMs = toMs(now);
+        m_scratch.present |= 1u;
+    }
+    for (int entity = 1; entity < NetProtocol::kMaxParticipants; ++entity) {
+        if (entity == clientId || !m_remotes[static_cast<size_t>(entity)].hasState()) continue;
+        m_scratch.states[static_cast<size_t>(entity)] = m_remotes[static_cast<size_t>(entity)].lastState();
+        m_scratch.present |= 1u << entity;
+    }
+
+    NetWriter writer(m_packet.data(), m_packet.size());
+    writer.header({ NetProtocol::PacketType::Snapshot, sequence, client.lastReceived });
+    writer.u8(baseline ? 1 : 0);
+    writer.u16(baseline ? baseline->sequence : 0);
+    writer.varint(toMs(now));
+    const size_t countOffset = writer.size();
+    writer.u8(0);
+    int count = 0;
+    for (int entity = 0; entity < NetProtocol::kMaxParticipants; ++entity) {
+        if (!hasEntity(m_scratch.present, entity)) continue;
+        // Unchanged entities still cost their id and an empty mask: absence means "left".
+        const bool known = baseline && hasEntity(baseline->present, entity);
+        writer.u8(static_cast<uint8_t>(entity | (known ? 0 : kEntityInfo)));
+        if (!known) {
+            writer.string(entity == 0 ? m_callsign : m_remotes[static_cast<size_t>(entity)].callsign);
+            writer.string(entity == 0 ? m_model : m_remotes[static_cast<size_t>(entity)].model);
+        }
+        writer.delta(m_scratch.states[static_cast<size_t>(entity)], known ? baseline->states[static_cast<size_t>(entity)] : kZeroState);
+        ++count;
+    }
+    writer.patchU8(countOffset, static_cast<uint8_t>(count));
+    send(client.endpoint, writer);
+    client.sent[sequence % NetProtocol::kHistory] = m_scratch;
+}
+
+void NetSession::expireClients(double now) {
+    for (size_t id = 1; id < m_clients.size(); ++id) {
+        Client& client = m_clients[id];
+        if (client.active && now - client.lastHeard > kTimeoutSeconds) {
+            client.active = false;
+            m_remotes[id].reset();
+        }
+    }
+}
+
+void NetSession::disconnect() {
+    m_entityId = -1;
+    m_hostAck = m_lastSnapshot = 0;
+    m_hostClock = NetClockOffset();
+    m_sentSequence.fill(0);
+    for (Snapshot& snapshot : m_snapshots) snapshot.sequence = 0;
+    for (RemoteAircraft& remote : m_remotes) remote.reset();
+}
+
+void NetSession::leave() {
+    NetWriter writer(m_packet.data(), m_packet.size());
+    if (m_role == Role::Host) {
+        for (size_t id = 1; id < m_clients.size(); ++id) {
+            Client& client = m_clients[id];
+            if (!client.active) continue;
+            writer = NetWriter(m_packet.data(), m_packet.size());
+            writer.header({ NetProtocol::PacketType::Bye, advance(client.nextSequence), client.lastReceived });
+            send(client.endpoint, writer);
+            client.active = false;
+            m_remotes[id].reset();
+        }
+        return;
+    }
+    if (m_entityId >= 0) {
+        writer.header({ NetProtocol::PacketType::Bye, advance(m_nextSequence), m_lastSnapshot });
+        send(m_host, writer);
+    }
+    disconnect();
+    m_host = 0;
+}
+
+void NetSession::traffic(double now, std::vector<TrafficAircraft>& out) const {
+    size_t count = 0;
+    const int self = entityId();
+    for (size_t id = 0; id < m_remotes.size(); ++id) {
+        const RemoteAircraft& remote = m_remotes[id];
+        if (static_cast<int>(id) == self || !remote.hasState()) continue;
+        if (out.size() <= count) out.emplace_back();
+        TrafficAircraft& aircraft = out[count++];
+        aircraft.id = static_cast<int>(id);
+        aircraft.callsign = remote.callsign;
+        aircraft.model = remote.model;
+        aircraft.state = remote.stateAt(now);
+    }
+    out.resize(count);
+}
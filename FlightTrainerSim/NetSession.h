@@ -0,0 +1,160 @@
+// File: NetSession.h
+#ifndef NETSESSION_H
+#define NETSESSION_H
+
+#include "NetProtocol.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Opaque datagram address: an IPv4 address and port for UDP, a peer index in the harness.
+using NetEndpoint = uint64_t;
+
+class NetTransport {
+public:
+    virtual ~NetTransport() = default;
+    virtual bool send(NetEndpoint to, const uint8_t* data, size_t size) = 0;
+    // Non-blocking. `data` has room for NetProtocol::kMaxPacketSize bytes.
+    virtual bool receive(NetEndpoint& from, uint8_t* data, size_t& size) = 0;
+};
+
+struct NetStats {
+    uint64_t packetsSent = 0, packetsReceived = 0;
+    uint64_t bytesSent = 0, bytesReceived = 0;
+    uint64_t packetsLost = 0;         // sequence gaps
+    uint64_t undecodable = 0;         // malformed, or delta against a baseline no longer held
+    uint64_t oversized = 0;           // not sent: larger than NetProtocol::kMaxPacketSize
+};
+
+// Local time minus a remote clock. Follows the fastest packet, since the slower ones only add
+// queuing and jitter, and creeps up by a tenth of a millisecond per packet so a lengthening route
+// is followed; a jump of more than a second (a paused or restarted sender) resets it.
+struct NetClockOffset {
+    double offset = 0.0;
+    bool valid = false;
+    void observe(double localMinusRemote);
+};
+
+// A participant seen from this side. Between packets the pose is extrapolated from the last
+// velocity, turning the velocity at the rate observed between the last two states (dead
+// reckoning); when a packet corrects the extrapolation, the jump decays over kSmoothingSeconds
+// instead of snapping. Extrapolation runs from the state's timestamp mapped onto the local clock,
+// so relay queuing and jitter do not show up as lag.
+class RemoteAircraft {
+public:
+    static constexpr double kMaxExtrapolation = 1.0;
+    static constexpr double kSmoothingSeconds = 0.2;
+
+    void reset();
+    // `clockOffset` converts the state's timestamp to local time.
+    void apply(const NetAircraftState& state, double now, double clockOffset);
+    AircraftRenderState stateAt(double now) const;
+    bool hasState() const { return m_hasState; }
+    const NetAircraftState& lastState() const { return m_state; }
+
+    std::string callsign, model;
+
+private:
+    NetAircraftState m_state;
+    bool m_hasState = false;
+    double m_clockOffset = 0.0;
+    double m_courseRate = 0.0;                      // rad/s, rotation of the horizontal velocity
+    double m_headingRate = 0.0, m_pitchRate = 0.0, m_bankRate = 0.0;
+    Position3D m_positionError;
+    double m_headingError = 0.0, m_pitchError = 0.0, m_bankError = 0.0;
+    double m_errorTime = 0.0;
+};
+
+// Client/server session for up to 32 aircraft. The host is a participant itself (entity 0) and
+// relays: each client sends its own state, the host sends every client one snapshot of all the
+// others, restamped onto the host clock. Both directions delta-encode against the newest state the other side acknowledged, and
+// fall back to absolute values when that baseline has left the history. Nothing is resent; a lost
+// packet just means the next one is encoded against an older baseline. Buffers are sized at
+// construction; update() allocates only for the names of a newly seen participant. Callsigns and
+// models are cut to NetProtocol::kMaxNameLength on joining, so a full snapshot always fits a packet.
+class NetSession {
+public:
+    enum class Role { Host, Client };
+    static constexpr double kTimeoutSeconds = 5.0;
+    static constexpr double kHelloInterval = 0.5;
+
+    NetSession(NetTransport& transport, Role role, const std::string& callsign, const std::string& model);
+
+    Role role() const { return m_role; }
+    // Client: the host to join. Hellos repeat until it answers.
+    void connectTo(NetEndpoint host);
+    void setLocalState(const FlightRecord& record);
+    // Drains incoming packets and sends when due. `now` is local time in seconds.
+    void update(double now, double sendRateHz);
+    void leave();
+
+    bool connected() const { return m_role == Role::Host || m_entityId >= 0; }
+    int entityId() const { return m_role == Role::Host ? 0 : m_entityId; }
+    int participantCount() const;
+    // Dead-reckoned poses of everyone else at `now`.
+    void traffic(double now, std::vector<TrafficAircraft>& out) const;
+    const RemoteAircraft& remote(int entityId) const { return m_remotes[static_cast<size_t>(entityId)]; }
+    const NetStats& stats() const { return m_stats; }
+
+private:
+    struct Snapshot {
+        uint16_t sequence = 0;
+        uint32_t present = 0;
+        std::array<NetAircraftState, NetProtocol::kMaxParticipants> states{};
+    };
+    // Host-side view of one client.
+    struct Client {
+        bool active = false;
+        NetEndpoint endpoint = 0;
+        double lastHeard = 0.0;
+        uint16_t nextSequence = 1;
+        uint16_t lastReceived = 0;                 // newest client state, echoed as our ack
+        uint16_t ackedSnapshot = 0;                // newest snapshot the client has
+        NetClockOffset clock;
+        std::array<uint16_t, NetProtocol::kHistory> receivedSequence{};
+        std::array<NetAircraftState, NetProtocol::kHistory> received{};
+        std::array<Snapshot, NetProtocol::kHistory> sent{};
+    };
+
+    void receiveAll(double now);
+    // Packets arriving at the host, and at a client from the host.
+    void handleAtHost(NetEndpoint from, const NetProtocol::Header& header, NetReader& reader, double now);
+    void handleAtClient(const NetProtocol::Header& header, NetReader& reader, double now);
+    void readSnapshot(const NetProtocol::Header& header, NetReader& reader, double now);
+    void sendSnapshot(Client& client, int clientId, double now);
+    void sendState();
+    void sendHello();
+    void send(NetEndpoint to, const NetWriter& writer);
+    void expireClients(double now);
+    void disconnect();
+    int findClient(NetEndpoint endpoint) const;
+    static uint16_t advance(uint16_t& sequence);
+    void countGap(uint16_t previous, uint16_t current);
+
+    NetTransport& m_transport;
+    Role m_role;
+    std::string m_callsign, m_model;
+    NetAircraftState m_local;
+    bool m_hasLocal;
+    double m_nextSend, m_lastHello;
+    std::array<uint8_t, NetProtocol::kMaxPacketSize> m_packet, m_incoming;
+    std::vector<RemoteAircraft> m_remotes;
+    NetStats m_stats;
+
+    // Host
+    std::vector<Client> m_clients;
+
+    // Client
+    NetEndpoint m_host;
+    int m_entityId;
+    double m_lastFromHost;
+    uint16_t m_nextSequence, m_hostAck, m_lastSnapshot;
+    NetClockOffset m_hostClock;
+    std::array<uint16_t, NetProtocol::kHistory> m_sentSequence;
+    std::array<NetAircraftState, NetProtocol::kHistory> m_sent;
+    std::vector<Snapshot> m_snapshots;
+    Snapshot m_scratch;
+};
+
+#endif
@@ -4,29 +4,23 @@
 
 #include "Aircraft.h"
 #include "Environment.h"
+#include "OutsideSceneRenderer.h"
+#include "RenderState.h"
 #include <QWidget>
-#include <QPainter>
 
 class Outside3DView : public QWidget {
     Q_OBJECT
 public:
     explicit Outside3DView(QWidget* parent = nullptr);
-    void setAircraft(Aircraft* aircraft) { m_aircraft = aircraft; }
-    void setEnvironment(Environment* env) { m_environment = env; }
+    void setAircraft(Aircraft* aircraft);
+    void setEnvironment(Environment* env);
+    void setRenderState(const AircraftRenderState& state) { m_renderer.setRenderState(state); }
+    void setTraffic(const std::vector<TrafficAircraft>& traffic) { m_renderer.setTraffic(traffic); }
 protected:
     void paintEvent(QPaintEvent* event) override;
 private:
     Aircraft* m_aircraft;
-    Environment* m_environment;
-    double m_cameraDistance, m_cameraAngle;
-    void drawScene(QPainter& painter);
-    void drawSkyAndGround(QPainter& painter);
-    void drawAircraft(QPainter& painter, int cx, int cy);
-    void drawFlightPath(QPainter& painter);
-    void drawWaypoints(QPainter& painter);
-    void drawRunway(QPainter& painter);
-    void drawInfoOverlay(QPainter& painter);
-    QPointF worldToScreen(double x, double y, double z) const;
+    OutsideSceneRenderer m_renderer;
 };
 
-#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,176 @@
+// File: OutsideSceneRenderer.cpp
+#include "OutsideSceneRenderer.h"
+#include "SceneGeometry.h"
+#include "Profiler.h"
+#include <QPainter>
+#include <QFont>
+#include <QImage>
+#include <cmath>
+
+OutsideSceneRenderer::OutsideSceneRenderer(int rasterThreads)
+    : m_hasAircraft(false), m_environment(nullptr)
+    , m_cameraDistance(500.0), m_cameraAngle(30.0)
+    , m_rasterizer(std::make_unique<SoftwareRasterizer>(rasterThreads))
+    , m_terrainCenterX(std::nan("")), m_terrainCenterY(std::nan(""))
+    , m_path(nullptr), m_pathCount(0), m_pathFirstIndex(0) {}
+
+void OutsideSceneRenderer::setAircraftModel(const std::string& modelName) {
+    m_hasAircraft = !modelName.empty();
+    m_aircraftMesh = m_hasAircraft ? SceneGeometry::createAircraftMesh(modelName) : RasterMesh();
+    m_path = nullptr;
+    m_pathCount = m_pathFirstIndex = 0;
+    m_overlay.resetPathCache();
+}
+
+void OutsideSceneRenderer::setEnvironment(const Environment* environment) {
+    m_environment = environment;
+    m_runwayMeshes.clear();
+    m_waypointLabels.clear();
+    if (environment) {
+        for (const auto& airfield : environment->airfields()) m_runwayMeshes.push_back(SceneGeometry::createRunwayMesh(airfield));
+    }
+    m_terrainCenterX = m_terrainCenterY = std::nan("");
+}
+
+void OutsideSceneRenderer::setFlightPath(const Position3D* points, size_t count, size_t firstIndex) {
+    m_path = points;
+    m_pathCount = count;
+    m_pathFirstIndex = firstIndex;
+}
+
+void OutsideSceneRenderer::setTraffic(const std::vector<TrafficAircraft>& traffic) {
+    // Assigned element-wise so strings and labels keep their storage from frame to frame.
+    m_traffic.resize(traffic.size());
+    m_trafficLabels.resize(traffic.size());
+    for (size_t i = 0; i < traffic.size(); ++i) {
+        if (m_traffic[i].callsign != traffic[i].callsign || m_trafficLabels[i].isEmpty())
+            m_trafficLabels[i] = QString::fromStdString(traffic[i].callsign);
+        m_traffic[i] = traffic[i];
+    }
+}
+
+const RasterMesh& OutsideSceneRenderer::trafficMesh(const std::string& modelName) {
+    for (const auto& [model, mesh] : m_trafficMeshes) {
+        if (model == modelName) return mesh;
+    }
+    m_trafficMeshes.emplace_back(modelName, SceneGeometry::createAircraftMesh(modelName));
+    return m_trafficMeshes.back().second;
+}
+
+void OutsideSceneRenderer::render(QPainter& painter, const QSize& size) {
+    painter.setRenderHint(QPainter::Antialiasing);
+    renderScene(size);
+    const QImage frame(reinterpret_cast<const uchar*>(m_rasterizer->pixels()), m_rasterizer->width(), m_rasterizer->height(),
+                       m_rasterizer->stride() * static_cast<int>(sizeof(uint32_t)), QImage::Format_RGB32);
+    painter.drawImage(0, 0, frame);
+    m_overlay.setView(m_rasterizer->viewProjection(), size.width(), size.height(), m_rasterizer->camera().nearPlane);
+    if (m_environment) drawWaypoints(painter);
+    if (!m_traffic.empty()) drawTrafficLabels(painter);
+    if (m_hasAircraft) {
+        drawFlightPath(painter);
+        drawInfoOverlay(painter);
+    }
+}
+
+RasterCamera OutsideSceneRenderer::chaseCamera() const {
+    // Same vantage point as the old planar view: behind and above the aircraft on a fixed bearing.
+    const double angle = m_cameraAngle * M_PI / 180.0;
+    RasterCamera camera;
+    camera.eye = Vec3(static_cast<float>(m_state.position.x - m_cameraDistance * std::cos(angle)),
+                      static_cast<float>(m_state.position.y - m_cameraDistance * std::sin(angle)),
+                      static_cast<float>(m_state.position.z + 200.0));
+    camera.target = Vec3(static_cast<float>(m_state.position.x), static_cast<float>(m_state.position.y),
+                         static_cast<float>(m_state.position.z));
+    camera.fovY = static_cast<float>(55.0 * M_PI / 180.0);
+    return camera;
+}
+
+void OutsideSceneRenderer::renderScene(const QSize& size) {
+    PROFILE_SCOPE(ProfileStage::SceneRaster);
+    m_rasterizer->beginFrame(size.width(), size.height(), chaseCamera());
+    const double cellX = std::floor(m_state.position.x / SceneGeometry::kTerrainCellSize);
+    const double cellY = std::floor(m_state.position.y / SceneGeometry::kTerrainCellSize);
+    if (cellX != m_terrainCenterX || cellY != m_terrainCenterY) {
+        SceneGeometry::buildTerrain(m_terrainMesh, m_environment, m_state.position.x, m_state.position.y);
+        m_terrainCenterX = cellX;
+        m_terrainCenterY = cellY;
+    }
+    m_rasterizer->drawMesh(m_terrainMesh, Mat4());
+    for (const auto& runway : m_runwayMeshes) m_rasterizer->drawMesh(runway, Mat4());
+    // Aircraft are drawn at twice their size so attitude reads at chase distance.
+    if (m_hasAircraft) m_rasterizer->drawMesh(m_aircraftMesh, SceneGeometry::aircraftTransform(m_state, 2.0f), false);
+    for (const auto& traffic : m_traffic) {
+        m_rasterizer->drawMesh(trafficMesh(traffic.model), SceneGeometry::aircraftTransform(traffic.state, 2.0f), false);
+    }
+    m_rasterizer->endFrame();
+}
+
+void OutsideSceneRenderer::drawFlightPath(QPainter& painter) {
+    PROFILE_SCOPE(ProfileStage::ScenePath);
+    m_overlay.projectPath(m_path, m_pathCount, m_pathFirstIndex, m_pathLine);
+    if (m_pathLine.runCount() == 0) return;
+    painter.setPen(QPen(QColor(0, 255, 0, 180), 2, Qt::DashLine));
+    for (int run = 0; run < m_pathLine.runCount(); ++run) {
+        painter.drawPolyline(m_pathLine.points.data() + m_pathLine.runStarts[run], m_pathLine.runLength(run));
+    }
+}
+
+void OutsideSceneRenderer::drawWaypoints(QPainter& painter) {
+    PROFILE_SCOPE(ProfileStage::SceneWaypoints);
+    if (!m_environment) return;
+    // Past the fog the markers shrink to dots and lose their labels.
+    constexpr float kLabelDistance = 14000.0f;
+    const auto& waypoints = m_environment->waypoints();
+    if (m_waypointLabels.size() != waypoints.size()) {
+        m_waypointLabels.clear();
+        for (const auto& wp : waypoints) m_waypointLabels.push_back(QString::fromStdString(wp.name));
+    }
+    m_visibleWaypoints.clear();
+    for (size_t i = 0; i < waypoints.size(); ++i) {
+        const Vec3 world(static_cast<float>(waypoints[i].x), static_cast<float>(waypoints[i].y), static_cast<float>(waypoints[i].altitude));
+        QPointF screen;
+        float depth = 0.0f;
+        if (!m_overlay.isVisible(world) || !m_overlay.project(world, screen, &depth)) continue;
+        m_visibleWaypoints.emplace_back(screen, depth < kLabelDistance ? static_cast<int>(i) : -1);
+    }
+    if (m_visibleWaypoints.empty()) return;
+
+    painter.setPen(QPen(QColor(255, 255, 0), 2));
+    painter.setBrush(QColor(255, 255, 0, 150));
+    for (const auto& [screen, label] : m_visibleWaypoints) {
+        const double radius = label >= 0 ? 12.0 : 4.0;
+        painter.drawEllipse(screen, radius, radius);
+    }
+    painter.setFont(QFont("Arial", 9, QFont::Bold));
+    painter.setPen(QColor(255, 255, 255));
+    for (const auto& [screen, label] : m_visibleWaypoints) {
+        if (label < 0) continue;
+        painter.drawText(static_cast<int>(screen.x()) + 15, static_cast<int>(screen.y()) + 5, m_waypointLabels[label]);
+    }
+}
+
+void OutsideSceneRenderer::drawTrafficLabels(QPainter& painter) {
+    PROFILE_SCOPE(ProfileStage::SceneTraffic);
+    painter.setFont(QFont("Arial", 9, QFont::Bold));
+    painter.setPen(QColor(0, 220, 255));
+    for (size_t i = 0; i < m_traffic.size(); ++i) {
+        const Position3D& p = m_traffic[i].state.position;
+        const Vec3 world(static_cast<float>(p.x), static_cast<float>(p.y), static_cast<float>(p.z + 40.0));
+        QPointF screen;
+        if (!m_overlay.isVisible(world) || !m_overlay.project(world, screen)) continue;
+        painter.drawText(static_cast<int>(screen.x()) - 20, static_cast<int>(screen.y()), m_trafficLabels[i]);
+    }
+}
+
+void OutsideSceneRenderer::drawInfoOverlay(QPainter& painter) {
+    PROFILE_SCOPE(ProfileStage::SceneInfo);
+    painter.setFont(QFont("Courier", 10, QFont::Bold));
+    painter.setPen(QColor(255, 255, 255, 200));
+    QString info = QString("Position: (%1, %2)\nAltitude: %3 ft\nSpeed: %4 kts\nHeading: %5°")
+        .arg(static_cast<int>(m_state.position.x))
+        .arg(static_cast<int>(m_state.position.y))
+        .arg(static_cast<int>(m_state.position.z))
+        .arg(static_cast<int>(m_state.speed))
+        .arg(static_cast<int>(m_state.heading));
+    painter.drawText(QRect(10, 10, 250, 100), Qt::AlignLeft | Qt::AlignTop, info);
+}
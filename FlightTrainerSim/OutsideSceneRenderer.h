@@ -0,0 +1,64 @@
+// File: OutsideSceneRenderer.h
+#ifndef OUTSIDESCENERENDERER_H
+#define OUTSIDESCENERENDERER_H
+
+#include "Aircraft.h"
+#include "Environment.h"
+#include "RenderState.h"
+#include "SoftwareRasterizer.h"
+#include "OverlayProjector.h"
+#include <QPointF>
+#include <QSize>
+#include <QString>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class QPainter;
+
+// Chase-camera view of the aircraft: rasterized scene plus flight path, waypoint and info overlays.
+// Owns no widget and paints through any QPainter, so replays can render it offscreen on worker
+// threads (one instance per thread; `rasterThreads` sizes the rasterizer's own pool).
+class OutsideSceneRenderer {
+public:
+    explicit OutsideSceneRenderer(int rasterThreads = 0);
+    // An empty model name means no aircraft is attached.
+    void setAircraftModel(const std::string& modelName);
+    void setEnvironment(const Environment* environment);
+    void setRenderState(const AircraftRenderState& state) { m_state = state; }
+    const AircraftRenderState& renderState() const { return m_state; }
+    // Trail drawn behind the aircraft; `firstIndex` counts points already dropped from its front.
+    // The points must stay valid until render() returns.
+    void setFlightPath(const Position3D* points, size_t count, size_t firstIndex);
+    // Other aircraft, drawn with their own model and labelled with their callsign.
+    void setTraffic(const std::vector<TrafficAircraft>& traffic);
+    void render(QPainter& painter, const QSize& size);
+private:
+    bool m_hasAircraft;
+    AircraftRenderState m_state;
+    const Environment* m_environment;
+    double m_cameraDistance, m_cameraAngle;
+    std::unique_ptr<SoftwareRasterizer> m_rasterizer;
+    RasterMesh m_aircraftMesh, m_terrainMesh;
+    std::vector<RasterMesh> m_runwayMeshes;
+    double m_terrainCenterX, m_terrainCenterY;
+    const Position3D* m_path;
+    size_t m_pathCount, m_pathFirstIndex;
+    OverlayProjector m_overlay;
+    OverlayProjector::Polyline m_pathLine;
+    std::vector<QString> m_waypointLabels;
+    std::vector<std::pair<QPointF, int>> m_visibleWaypoints;
+    std::vector<TrafficAircraft> m_traffic;
+    std::vector<QString> m_trafficLabels;
+    std::vector<std::pair<std::string, RasterMesh>> m_trafficMeshes;
+    void renderScene(const QSize& size);
+    RasterCamera chaseCamera() const;
+    void drawFlightPath(QPainter& painter);
+    void drawWaypoints(QPainter& painter);
+    void drawTrafficLabels(QPainter& painter);
+    const RasterMesh& trafficMesh(const std::string& modelName);
+    void drawInfoOverlay(QPainter& painter);
+};
+
+#endif
@@ -0,0 +1,199 @@
+// File: OverlayProjector.cpp
+#include "OverlayProjector.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+    enum Outcode { Left = 1, Right = 2, Bottom = 4, Top = 8, Near = 16 };
+
+    Vec4 lerp(const Vec4& a, const Vec4& b, float t) {
+        return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t };
+    }
+}
+
+OverlayProjector::OverlayProjector()
+    : m_planes(), m_width(0.0f), m_height(0.0f), m_nearPlane(1.0f)
+    , m_firstChunk(0), m_pathFirst(0), m_pathEnd(0), m_chunksVisible(0) {}
+
+void OverlayProjector::setView(const Mat4& viewProjection, int width, int height, float nearPlane) {
+    m_viewProjection = viewProjection;
+    m_width = static_cast<float>(width);
+    m_height = static_cast<float>(height);
+    m_nearPlane = nearPlane;
+
+    // Side planes from the rows of the matrix (-w <= x, y <= w); near is w >= nearPlane, matching
+    // the rasterizer's clip test.
+    const auto& m = viewProjection.m;
+    auto plane = [&](float sign, int row) {
+        Plane p{ { m[3][0] + sign * m[row][0], m[3][1] + sign * m[row][1], m[3][2] + sign * m[row][2] },
+                 m[3][3] + sign * m[row][3] };
+        const float length = p.normal.length();
+        if (length > 0.0f) {
+            p.normal = p.normal * (1.0f / length);
+            p.d /= length;
+        }
+        return p;
+    };
+    m_planes[0] = plane(1.0f, 0);
+    m_planes[1] = plane(-1.0f, 0);
+    m_planes[2] = plane(1.0f, 1);
+    m_planes[3] = plane(-1.0f, 1);
+    m_planes[4] = plane(0.0f, 0);
+    m_planes[4].d -= nearPlane / std::max(1e-6f, Vec3(m[3][0], m[3][1], m[3][2]).length());
+}
+
+void OverlayProjector::resetPathCache() {
+    m_chunkBounds.clear();
+    m_firstChunk = m_pathFirst = m_pathEnd = 0;
+}
+
+bool OverlayProjector::isVisible(const Vec3& center, float radius) const {
+    for (const Plane& p : m_planes) {
+        if (p.normal.dot(center) + p.d < -radius) return false;
+    }
+    return true;
+}
+
+QPointF OverlayProjector::toScreen(const Vec4& clip) const {
+    const float invW = 1.0f / clip.w;
+    return QPointF((clip.x * invW * 0.5f + 0.5f) * m_width, (0.5f - clip.y * invW * 0.5f) * m_height);
+}
+
+int OverlayProjector::outcode(const Vec4& clip) const {
+    int code = 0;
+    if (clip.x < -clip.w) code |= Left;
+    if (clip.x > clip.w) code |= Right;
+    if (clip.y < -clip.w) code |= Bottom;
+    if (clip.y > clip.w) code |= Top;
+    if (clip.w < m_nearPlane) code |= Near;
+    return code;
+}
+
+bool OverlayProjector::project(const Vec3& world, QPointF& screen, float* depth) const {
+    const Vec4 clip = m_viewProjection.transform(world);
+    if (clip.w < m_nearPlane) return false;
+    screen = toScreen(clip);
+    if (depth) *depth = clip.w;
+    return true;
+}
+
+OverlayProjector::Bounds OverlayProjector::boundsOf(const Position3D* begin, const Position3D* end) {
+    Vec3 lo(static_cast<float>(begin->x), static_cast<float>(begin->y), static_cast<float>(begin->z));
+    Vec3 hi = lo;
+    for (const Position3D* p = begin + 1; p != end; ++p) {
+        lo = { std::min(lo.x, static_cast<float>(p->x)), std::min(lo.y, static_cast<float>(p->y)), std::min(lo.z, static_cast<float>(p->z)) };
+        hi = { std::max(hi.x, static_cast<float>(p->x)), std::max(hi.y, static_cast<float>(p->y)), std::max(hi.z, static_cast<float>(p->z)) };
+    }
+    return { (lo + hi) * 0.5f, (hi - lo).length() * 0.5f };
+}
+
+void OverlayProjector::updateChunkBounds(const Position3D* path, size_t count, size_t firstIndex) {
+    const size_t end = firstIndex + count;
+    if (end < m_pathEnd || firstIndex < m_pathFirst) resetPathCache();
+    m_pathFirst = firstIndex;
+    m_pathEnd = end;
+
+    // Chunks that scrolled off the front are dropped; a partially dropped chunk keeps its old bounds,
+    // which still enclose what remains of it.
+    const size_t firstChunk = firstIndex / kChunkSize;
+    if (firstChunk > m_firstChunk) {
+        const size_t drop = std::min(firstChunk - m_firstChunk, m_chunkBounds.size());
+        m_chunkBounds.erase(m_chunkBounds.begin(), m_chunkBounds.begin() + drop);
+        m_firstChunk = firstChunk;
+    }
+    // Chunk c spans points [c * K, (c + 1) * K] inclusive, sharing its last point with the next chunk,
+    // and is cached once that last point exists.
+    for (size_t c = m_firstChunk + m_chunkBounds.size(); (c + 1) * kChunkSize < end; ++c) {
+        const size_t begin = std::max(c * kChunkSize, firstIndex) - firstIndex;
+        const size_t last = (c + 1) * kChunkSize - firstIndex;
+        m_chunkBounds.push_back(boundsOf(path + begin, path + last + 1));
+    }
+}
+
+void OverlayProjector::projectPath(const Position3D* path, size_t count, size_t firstIndex, Polyline& out, float minSpacing) {
+    out.clear();
+    m_chunksVisible = 0;
+    if (count < 2) return;
+    updateChunkBounds(path, count, firstIndex);
+
+    const float minSpacingSq = minSpacing * minSpacing;
+    bool open = false, havePending = false;
+    QPointF last, pending;
+    auto closeRun = [&]() {
+        if (!open) return;
+        if (havePending) out.points.push_back(pending);
+        if (static_cast<int>(out.points.size()) - out.runStarts.back() < 2) {
+            out.points.resize(out.runStarts.back());
+            out.runStarts.pop_back();
+        }
+        open = havePending = false;
+    };
+    auto append = [&](const QPointF& p) {
+        const QPointF d = p - last;
+        if (d.x() * d.x() + d.y() * d.y() < minSpacingSq) {
+            pending = p;
+            havePending = true;
+            return;
+        }
+        out.points.push_back(p);
+        last = p;
+        havePending = false;
+    };
+    auto toWorld = [](const Position3D& p) {
+        return Vec3(static_cast<float>(p.x), static_cast<float>(p.y), static_cast<float>(p.z));
+    };
+
+    const size_t end = firstIndex + count;
+    const size_t lastChunk = (end - 2) / kChunkSize;
+    Vec4 clipA;
+    int codeA = 0;
+    size_t clipIndex = SIZE_MAX;
+    for (size_t c = firstIndex / kChunkSize; c <= lastChunk; ++c) {
+        const size_t segBegin = std::max(c * kChunkSize, firstIndex);
+        const size_t segEnd = std::min((c + 1) * kChunkSize, end - 1);
+        const size_t cached = c - m_firstChunk;
+        const Bounds bounds = cached < m_chunkBounds.size()
+            ? m_chunkBounds[cached]
+            : boundsOf(path + (segBegin - firstIndex), path + (segEnd - firstIndex) + 1);
+        if (!isVisible(bounds.center, bounds.radius)) {
+            closeRun();
+            continue;
+        }
+        ++m_chunksVisible;
+
+        for (size_t i = segBegin; i < segEnd; ++i) {
+            if (clipIndex != i) {
+                clipA = m_viewProjection.transform(toWorld(path[i - firstIndex]));
+                codeA = outcode(clipA);
+            }
+            const Vec4 clipB = m_viewProjection.transform(toWorld(path[i + 1 - firstIndex]));
+            const int codeB = outcode(clipB);
+            Vec4 a = clipA, b = clipB;
+            const int codeAi = codeA;
+            clipA = clipB;
+            codeA = codeB;
+            clipIndex = i + 1;
+
+            if (codeAi & codeB) {
+                closeRun();
+                continue;
+            }
+            if (codeAi & Near) {
+                a = lerp(a, b, (m_nearPlane - a.w) / (b.w - a.w));
+                closeRun();
+            } else if (codeB & Near) {
+                b = lerp(a, b, (m_nearPlane - a.w) / (b.w - a.w));
+            }
+            if (!open) {
+                out.runStarts.push_back(static_cast<int>(out.points.size()));
+                last = toScreen(a);
+                out.points.push_back(last);
+                open = true;
+            }
+            append(toScreen(b));
+            if (codeB & Near) closeRun();
+        }
+    }
+    closeRun();
+}
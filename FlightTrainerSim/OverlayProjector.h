@@ -0,0 +1,71 @@
+// File: OverlayProjector.h
+#ifndef OVERLAYPROJECTOR_H
+#define OVERLAYPROJECTOR_H
+
+#include "Aircraft.h"
+#include "RasterMath.h"
+#include <QPointF>
+#include <vector>
+
+// Projects 2D overlay geometry (flight path, waypoint markers) with the camera of the current frame.
+// setView() takes the view-projection once; points and bounding spheres are tested against the
+// frustum planes before anything is divided through. Flight paths are culled in fixed chunks whose
+// bounds are cached by absolute point index, so frame cost follows what is in view rather than the
+// length of the recorded history.
+class OverlayProjector {
+public:
+    static constexpr size_t kChunkSize = 32;
+
+    // Visible stretches of a path; run i is points[runStarts[i]] up to the next run's start.
+    struct Polyline {
+        std::vector<QPointF> points;
+        std::vector<int> runStarts;
+
+        void clear() { points.clear(); runStarts.clear(); }
+        int runCount() const { return static_cast<int>(runStarts.size()); }
+        int runLength(int run) const {
+            const int end = run + 1 < runCount() ? runStarts[run + 1] : static_cast<int>(points.size());
+            return end - runStarts[run];
+        }
+    };
+
+    OverlayProjector();
+
+    void setView(const Mat4& viewProjection, int width, int height, float nearPlane);
+    // Drops cached chunk bounds; call when the path being drawn belongs to another aircraft.
+    void resetPathCache();
+
+    bool isVisible(const Vec3& center, float radius = 0.0f) const;
+    // False when behind the near plane. `depth` receives the view distance when given.
+    bool project(const Vec3& world, QPointF& screen, float* depth = nullptr) const;
+
+    // `firstIndex` is the absolute index of path[0], i.e. how many points have been dropped from its
+    // front. Consecutive points closer than `minSpacing` pixels are merged into one vertex.
+    void projectPath(const Position3D* path, size_t count, size_t firstIndex, Polyline& out, float minSpacing = 1.0f);
+
+    size_t chunksVisible() const { return m_chunksVisible; }
+
+private:
+    struct Plane {
+        Vec3 normal;
+        float d;
+    };
+    struct Bounds {
+        Vec3 center;
+        float radius;
+    };
+
+    Mat4 m_viewProjection;
+    Plane m_planes[5];
+    float m_width, m_height, m_nearPlane;
+
+    std::vector<Bounds> m_chunkBounds;   // m_chunkBounds[i] covers absolute chunk m_firstChunk + i
+    size_t m_firstChunk, m_pathFirst, m_pathEnd, m_chunksVisible;
+
+    void updateChunkBounds(const Position3D* path, size_t count, size_t firstIndex);
+    QPointF toScreen(const Vec4& clip) const;
+    int outcode(const Vec4& clip) const;
+    static Bounds boundsOf(const Position3D* begin, const Position3D* end);
+};
+
+#endif
@@ -0,0 +1,174 @@
+// File: PerformanceEnvelope.cpp
+#include "PerformanceEnvelope.h"
+#include "FlightKernel.h"
+#include "GlobalConfig.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+    constexpr double kCeilingClimbRate = 100.0;     // ft/min
+    constexpr double kCeilingStep = 50.0;           // ft
+    constexpr double kClimbStallMargin = 1.2;
+
+    constexpr char kEnvelopeMagic[8] = { 'F', 'T', 'E', 'N', 'V', 'L', '\0', '\1' };
+    constexpr uint32_t kEnvelopeVersion = 2;
+
+    // The same performance, straight from the model's coefficients.
+    class PointPerformance {
+    public:
+        PointPerformance(const FlightModelParams& params, double gravity) : m_p(params), m_weight(params.mass * gravity) {}
+
+        double stall(double altitude, double flaps, double loadFactor) const {
+            const double densityRatio = airDensity(0.0) / airDensity(altitude);
+            return m_p.stallSpeed * std::sqrt(loadFactor * densityRatio * maxLift(0.0) / maxLift(flaps));
+        }
+        // Where full power just balances drag, ignoring the top speed.
+        double levelSpeed(double altitude, double flaps) const {
+            return std::sqrt(2.0 * fullThrust() / (airDensity(altitude) * m_p.wingArea * drag(flaps)));
+        }
+        double max(double altitude, double flaps) const { return std::min(m_p.maxSpeed, levelSpeed(altitude, flaps)); }
+        // Excess power peaks at a third of the level speed squared: thrust is flat with speed.
+        double bestClimb(double altitude, double flaps) const {
+            const double ideal = levelSpeed(altitude, flaps) / std::sqrt(3.0);
+            return std::min(std::max(ideal, kClimbStallMargin * stall(altitude, flaps, 1.0)), max(altitude, flaps));
+        }
+        double climbRate(double altitude, double flaps) const {
+            if (stall(altitude, flaps, 1.0) >= max(altitude, flaps)) return 0.0;
+            const double speed = bestClimb(altitude, flaps);
+            const double dragForce = 0.5 * airDensity(altitude) * speed * speed * m_p.wingArea * drag(flaps);
+            return (fullThrust() - dragForce) * speed / m_weight * 60.0;
+        }
+        double ceiling(double flaps) const {
+            double ceiling = 0.0;
+            for (double altitude = 0.0; altitude <= PerformanceEnvelope::kMaxAltitude; altitude += kCeilingStep) {
+                if (climbRate(altitude, flaps) < kCeilingClimbRate) break;
+                ceiling = altitude;
+            }
+            return ceiling;
+        }
+
+    private:
+        const FlightModelParams& m_p;
+        double m_weight;
+
+        double maxLift(double flaps) const { return (m_p.liftCoeff + flaps * m_p.flapLift) * (1.0 + m_p.elevatorLift); }
+        double drag(double flaps) const { return m_p.dragCoeff + flaps * m_p.flapDrag; }
+        double fullThrust() const { return m_p.maxThrust * (m_p.afterburnerThrottle < 1.0 ? m_p.afterburnerBoost : 1.0); }
+    };
+}
+
+PerformanceEnvelope::PerformanceEnvelope(const FlightModelParams& params, double gravity) : m_params(params), m_gravity(gravity) {
+    m_altitude = { 0.0, 500.0, static_cast<int>(kMaxAltitude / 500.0) + 1 };
+    m_flaps = { 0.0, 0.25, 5 };
+    m_loadFactor = { 1.0, 0.25, static_cast<int>((kMaxLoadFactor - 1.0) / 0.25) + 1 };
+}
+
+void PerformanceEnvelope::build() {
+    const PointPerformance point(m_params, m_gravity);
+    const size_t rows = static_cast<size_t>(m_flaps.count) * m_altitude.count;
+    m_stall.resize(rows * m_loadFactor.count);
+    m_max.resize(rows);
+    m_bestClimb.resize(rows);
+    m_climbRate.resize(rows);
+    m_ceiling.resize(m_flaps.count);
+    for (int f = 0; f < m_flaps.count; ++f) {
+        const double flaps = m_flaps.value(f);
+        for (int a = 0; a < m_altitude.count; ++a) {
+            const double altitude = m_altitude.value(a);
+            const size_t row = static_cast<size_t>(f) * m_altitude.count + a;
+            m_max[row] = point.max(altitude, flaps);
+            m_bestClimb[row] = point.bestClimb(altitude, flaps);
+            m_climbRate[row] = point.climbRate(altitude, flaps);
+            for (int n = 0; n < m_loadFactor.count; ++n) {
+                const double loadFactor = m_loadFactor.value(n);
+                m_stall[(static_cast<size_t>(f) * m_loadFactor.count + n) * m_altitude.count + a] = point.stall(altitude, flaps, loadFactor);
+            }
+        }
+        m_ceiling[f] = point.ceiling(flaps);
+    }
+}
+
+double PerformanceEnvelope::lookup(const std::vector<double>& table, double altitude, double flaps) const {
+    int a, f;
+    double fa, ff;
+    m_altitude.locate(altitude, a, fa);
+    m_flaps.locate(flaps, f, ff);
+    const size_t low = static_cast<size_t>(f) * m_altitude.count + a;
+    const size_t high = low + (m_flaps.count > 1 ? m_altitude.count : 0);
+    const size_t nextA = m_altitude.count > 1 ? 1 : 0;
+    const double lower = table[low] + (table[low + nextA] - table[low]) * fa;
+    const double upper = table[high] + (table[high + nextA] - table[high]) * fa;
+    return lower + (upper - lower) * ff;
+}
+
+double PerformanceEnvelope::stallSpeed(double altitude, double flaps, double loadFactor) const {
+    int n;
+    double fn;
+    m_loadFactor.locate(loadFactor, n, fn);
+    int a, f;
+    double fa, ff;
+    m_altitude.locate(altitude, a, fa);
+    m_flaps.locate(flaps, f, ff);
+    const size_t nextA = m_altitude.count > 1 ? 1 : 0;
+    const size_t nextF = f + 1 < m_flaps.count ? static_cast<size_t>(m_loadFactor.count) * m_altitude.count : 0;
+    // Bilinear in altitude and flaps at each of the two load factors around the one asked for.
+    auto atLoad = [&](int index) {
+        const double* low = &m_stall[(static_cast<size_t>(f) * m_loadFactor.count + index) * m_altitude.count + a];
+        const double* high = low + nextF;
+        const double lower = low[0] + (low[nextA] - low[0]) * fa;
+        const double upper = high[0] + (high[nextA] - high[0]) * fa;
+        return lower + (upper - lower) * ff;
+    };
+    const double lower = atLoad(n);
+    return fn > 0.0 ? lower + (atLoad(n + 1) - lower) * fn : lower;
+}
+
+double PerformanceEnvelope::maxSpeed(double altitude, double flaps) const { return lookup(m_max, altitude, flaps); }
+double PerformanceEnvelope::bestClimbSpeed(double altitude, double flaps) const { return lookup(m_bestClimb, altitude, flaps); }
+double PerformanceEnvelope::climbRate(double altitude, double flaps) const { return lookup(m_climbRate, altitude, flaps); }
+
+double PerformanceEnvelope::serviceCeiling(double flaps) const {
+    int f;
+    double ff;
+    m_flaps.locate(flaps, f, ff);
+    const double lower = m_ceiling[f];
+    return ff > 0.0 ? lower + (m_ceiling[f + 1] - lower) * ff : lower;
+}
+
+double PerformanceEnvelope::loadFactorForBank(double bank) {
+    const double cosine = std::cos(std::min(std::abs(bank), 90.0) * kDegToRad);
+    return cosine * kMaxLoadFactor > 1.0 ? std::max(1.0, 1.0 / cosine) : kMaxLoadFactor;
+}
+
+bool PerformanceEnvelope::save(const std::string& path) const {
+    ModelTableWriter out(kEnvelopeMagic, kEnvelopeVersion, m_params, m_gravity);
+    out.axes({ &m_altitude, &m_flaps, &m_loadFactor });
+    for (const auto* column : { &m_stall, &m_max, &m_bestClimb, &m_climbRate, &m_ceiling }) out.column(*column);
+    return out.save(path);
+}
+
+bool PerformanceEnvelope::load(const std::string& path) {
+    ModelTableReader in;
+    if (!in.open(path, kEnvelopeMagic, kEnvelopeVersion, m_params, m_gravity) || !in.axes({ &m_altitude, &m_flaps, &m_loadFactor }))
+        return false;
+    const size_t rows = static_cast<size_t>(m_flaps.count) * m_altitude.count;
+    std::vector<double> stall, max, bestClimb, climbRate, ceiling;
+    if (!in.column(stall, rows * m_loadFactor.count) || !in.column(max, rows) || !in.column(bestClimb, rows)
+        || !in.column(climbRate, rows) || !in.column(ceiling, m_flaps.count) || !in.atEnd()) return false;
+    m_stall = std::move(stall);
+    m_max = std::move(max);
+    m_bestClimb = std::move(bestClimb);
+    m_climbRate = std::move(climbRate);
+    m_ceiling = std::move(ceiling);
+    return true;
+}
+
+std::string PerformanceEnvelope::cachePath(const IFlightModel& model) {
+    return GlobalConfig::instance().cacheDirectory() + "/envelope-" + model.fileKey() + ".fpe";
+}
+
+const PerformanceEnvelope& PerformanceEnvelope::forModel(const IFlightModel& model, const ConfigSnapshot& config) {
+    return ModelTableCache<PerformanceEnvelope>::get(model.params(), config.gravity, cachePath(model),
+                                                     [](PerformanceEnvelope& envelope) { envelope.build(); });
+}
@@ -0,0 +1,57 @@
+// File: PerformanceEnvelope.h
+#ifndef PERFORMANCEENVELOPE_H
+#define PERFORMANCEENVELOPE_H
+
+#include "IFlightModel.h"
+#include "ModelTable.h"
+#include <string>
+#include <vector>
+
+struct ConfigSnapshot;
+
+// Point performance of one flight model over altitude, flaps and load factor, worked out from its
+// lift, drag and thrust and tabulated so the HUD, warnings and scoring read it with a clamped,
+// interpolated O(1) lookup:
+//   stall speed   the model's stall speed (sea level, clean, 1 g) scaled by density, flap lift
+//                 and load factor, as lift goes with density and the square of speed
+//   max speed     the fastest level speed full power holds, capped at the model's top speed
+//   best climb    the speed of the most excess power, kept between 1.2 x stall and max speed
+//   ceiling       the highest altitude with 100 ft/min to spare at best climb, below the point
+//                 where stall and max speed meet
+// Built once per model and gravity and cached on disk (see ModelTableCache).
+class PerformanceEnvelope {
+public:
+    static constexpr double kMaxAltitude = 60000.0;
+    static constexpr double kMaxLoadFactor = 4.0;
+
+    static const PerformanceEnvelope& forModel(const IFlightModel& model, const ConfigSnapshot& config);
+    static std::string cachePath(const IFlightModel& model);
+    // Load factor of a level turn at this bank (degrees), 1 to kMaxLoadFactor.
+    static double loadFactorForBank(double bank);
+
+    PerformanceEnvelope(const FlightModelParams& params, double gravity);
+    void build();
+    // Fails unless the file was saved for this envelope's parameters, gravity and grid.
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+    double gravity() const { return m_gravity; }
+
+    double stallSpeed(double altitude, double flaps, double loadFactor = 1.0) const;
+    double maxSpeed(double altitude, double flaps) const;
+    double bestClimbSpeed(double altitude, double flaps) const;
+    // Rate of climb at best-climb speed and full power, ft/min.
+    double climbRate(double altitude, double flaps) const;
+    double serviceCeiling(double flaps) const;
+
+private:
+    FlightModelParams m_params;
+    double m_gravity;
+    TableAxis m_altitude, m_flaps, m_loadFactor;
+    std::vector<double> m_stall;                    // [flaps][load factor][altitude]
+    std::vector<double> m_max, m_bestClimb, m_climbRate;   // [flaps][altitude]
+    std::vector<double> m_ceiling;                  // [flaps]
+
+    double lookup(const std::vector<double>& table, double altitude, double flaps) const;
+};
+
+#endif
@@ -0,0 +1,489 @@
+// File: PilotAgent.cpp
+#include "PilotAgent.h"
+#include "FlightKernel.h"
+#include "GlobalConfig.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace {
+    constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+
+    // Outer loops.
+    constexpr double kAltitudeGain = 0.25;            // ft/s of climb per ft of error
+    constexpr double kMaxClimb = 20.0, kMaxDescent = 60.0;
+    constexpr double kRudderPerDegree = 1.0 / 20.0;
+    // Nose-down elevator kept in reserve at the speed cap when holding a speed, and when planning.
+    constexpr double kElevatorReserve = 0.6, kPlanReserve = 0.9;
+    // Waypoint guidance replans this often, looking ahead kHorizonSteps steps of kPlanStep seconds.
+    // A plan arrives within kReachFraction of the tolerance; one that misses costs the horizon plus
+    // its closest approach flown at kMissSpeed, and each ft/s over the cap costs kOverspeedCost a second.
+    constexpr double kReplanInterval = 1.0, kPlanStep = 2.0;
+    constexpr int kHorizonSteps = 60;
+    constexpr double kReachFraction = 0.7, kMissSpeed = 10.0, kOverspeedCost = 10.0;
+    constexpr double kAilerons[] = { -1.0, -0.6, -0.3, -0.1, 0.0, 0.1, 0.3, 0.6, 1.0 };
+    // Negative values are flaps with the throttle closed.
+    constexpr double kAlong[] = { -1.0, -0.5, 0.0, 0.1, 0.25, 0.5, 1.0 };
+
+    double wrapDegrees(double degrees) {
+        degrees = std::fmod(degrees + 180.0, 360.0);
+        return (degrees < 0.0 ? degrees + 360.0 : degrees) - 180.0;
+    }
+
+    // One leg of a plan: the controls held constant until the point mass comes within `reach` of
+    // the target or the horizon runs out.
+    struct PlanLeg {
+        double x, y, z, vx, vy, fuel;
+        double arrival = -1.0, nearest = std::numeric_limits<double>::infinity(), overspeed = 0.0;
+
+        void fly(const FlightModelParams& p, double density, double throttle, double flaps, double aileron, double cap,
+                 const Waypoint& target, double reach, double limit) {
+            const double thrust = throttle * p.maxThrust * (throttle > p.afterburnerThrottle ? p.afterburnerBoost : 1.0);
+            for (int step = 1; step <= kHorizonSteps; ++step) {
+                // Arriving after `limit` seconds cannot beat a plan already found, so stop looking.
+                if (step * kPlanStep > limit && limit < kHorizonSteps * kPlanStep) {
+                    nearest = std::numeric_limits<double>::infinity();
+                    return;
+                }
+                // The altitude loop's climb rate, as far as the speed cap leaves room for it.
+                const double room = std::sqrt(std::max(0.0, cap * cap - vx * vx - vy * vy));
+                const double vz = std::clamp(kAltitudeGain * (target.altitude - z), -std::min(kMaxDescent, room), std::min(kMaxClimb, room));
+                const double q = 0.5 * density * std::max(vx * vx + vy * vy + vz * vz, 1.0);
+                vx += ((fuel > 0.0 ? thrust : 0.0) - q * p.wingArea * (p.dragCoeff + flaps * p.flapDrag)) / p.mass * kPlanStep;
+                vy += aileron * p.sideForce * q / p.mass * kPlanStep;
+                x += vx * kPlanStep;
+                y += vy * kPlanStep;
+                z += vz * kPlanStep;
+                fuel -= p.fuelConsumptionRate * throttle * kPlanStep;
+                overspeed += std::max(0.0, std::hypot(vx, vy) - cap) * kPlanStep;
+                const double distance = std::hypot(target.x - x, target.y - y, target.altitude - z);
+                nearest = std::min(nearest, distance);
+                if (distance < reach) {
+                    arrival = step * kPlanStep;
+                    return;
+                }
+            }
+        }
+
+        double cost() const {
+            return (arrival >= 0.0 ? arrival : kHorizonSteps * kPlanStep + nearest / kMissSpeed) + overspeed * kOverspeedCost;
+        }
+    };
+
+    bool parseNumber(const std::string& word, double& out) {
+        char* end = nullptr;
+        out = std::strtod(word.c_str(), &end);
+        return !word.empty() && end && *end == '\0' && std::isfinite(out);
+    }
+}
+
+PidController::PidController(double kp, double ki, double kd, double minimum, double maximum)
+    : m_kp(kp), m_ki(ki), m_kd(kd), m_minimum(minimum), m_maximum(maximum), m_integral(0.0), m_previousError(0.0),
+      m_hasPrevious(false), m_saturation(0) {}
+
+double PidController::update(double error, double deltaTime, double feedForward) {
+    const double derivative = m_hasPrevious && deltaTime > 0.0 ? (error - m_previousError) / deltaTime : 0.0;
+    m_previousError = error;
+    m_hasPrevious = true;
+    const double integral = m_integral + error * deltaTime;
+    const double output = feedForward + m_kp * error + m_ki * integral + m_kd * derivative;
+    m_saturation = output > m_maximum ? 1 : output < m_minimum ? -1 : 0;
+    if (m_saturation == 0 || (m_saturation > 0) == (error < 0.0)) m_integral = integral;
+    return std::clamp(output, m_minimum, m_maximum);
+}
+
+void PidController::reset() {
+    m_integral = 0.0;
+    m_previousError = 0.0;
+    m_hasPrevious = false;
+    m_saturation = 0;
+}
+
+AutopilotAgent::AutopilotAgent() : AutopilotAgent(AutopilotTargets()) {}
+
+AutopilotAgent::AutopilotAgent(const AutopilotTargets& targets)
+    : m_targets(targets)
+    , m_holdCaptured(false)
+    , m_planLeft(0.0)
+    , m_planWaypoint(0)
+    , m_climbLoop(0.05, 0.02, 0.0, -1.0, 1.0)
+    , m_alongLoop(0.2, 0.02, 0.0, 0.0, 1.0)
+    , m_acrossLoop(0.5, 0.05, 0.0, -1.0, 1.0)
+    {}
+
+void AutopilotAgent::reset() {
+    m_holdCaptured = false;
+    m_planLeft = 0.0;
+    m_climbLoop.reset();
+    m_alongLoop.reset();
+    m_acrossLoop.reset();
+}
+
+uint32_t AutopilotAgent::ownedAxes() const {
+    uint32_t axes = 0;
+    if (m_targets.navigate || m_targets.altitudeHold) axes |= controlAxisBit(ControlAxis::Elevator);
+    if (m_targets.navigate || m_targets.headingHold || m_targets.speedHold) {
+        axes |= controlAxisBit(ControlAxis::Aileron) | controlAxisBit(ControlAxis::Rudder) | controlAxisBit(ControlAxis::Throttle);
+    }
+    if (m_targets.navigate) axes |= controlAxisBit(ControlAxis::Flaps);
+    return axes;
+}
+
+AutopilotTargets AutopilotAgent::holdCurrent(const Aircraft& aircraft) {
+    AutopilotTargets targets;
+    targets.altitudeHold = targets.headingHold = targets.speedHold = true;
+    targets.altitude = aircraft.altitude();
+    targets.heading = trackOf(aircraft);
+    targets.speed = std::hypot(aircraft.flightState().velocityX, aircraft.flightState().velocityY);
+    return targets;
+}
+
+double AutopilotAgent::speedCap(const Aircraft& aircraft, double flaps, double gravity, double reserve) {
+    // Lift at which the reserve elevator exactly stops a climb, then the airspeed that makes it.
+    const FlightModelParams& p = aircraft.flightModel()->params();
+    const double lift = p.mass * (gravity + reserve * p.elevatorClimb) / (1.0 - reserve * p.elevatorLift);
+    const double liftPerQ = p.wingArea * (p.liftCoeff + flaps * p.flapLift);
+    return std::sqrt(2.0 * lift / (airDensity(aircraft.altitude()) * liftPerQ));
+}
+
+double AutopilotAgent::trackOf(const Aircraft& aircraft) {
+    const FlightState& state = aircraft.flightState();
+    if (state.velocityX == 0.0 && state.velocityY == 0.0) return aircraft.heading();
+    return std::fmod(std::atan2(state.velocityX, state.velocityY) / kDegToRad + 360.0, 360.0);
+}
+
+double AutopilotAgent::levelElevator(const Aircraft& aircraft, double flaps, double gravity) {
+    const FlightModelParams& p = aircraft.flightModel()->params();
+    const double speed = std::max(aircraft.speed(), 1.0);
+    const double lift = 0.5 * airDensity(aircraft.altitude()) * speed * speed * p.wingArea * (p.liftCoeff + flaps * p.flapLift);
+    return std::clamp((p.mass * gravity - lift) / (lift * p.elevatorLift + p.mass * p.elevatorClimb), -1.0, 1.0);
+}
+
+double AutopilotAgent::navigate(const Aircraft& aircraft, const TrainingScenario& scenario, double deltaTime, double gravity, ControlInputs& controls) {
+    const std::vector<Waypoint>& waypoints = scenario.targetWaypoints();
+    const size_t index = scenario.currentWaypointIndex();
+    const Waypoint& waypoint = waypoints[index];
+    m_planLeft -= deltaTime;
+    if (m_planLeft <= 0.0 || index != m_planWaypoint) {
+        m_planLeft = kReplanInterval;
+        m_planWaypoint = index;
+        plan(aircraft, waypoint, index + 1 < waypoints.size() ? &waypoints[index + 1] : nullptr, gravity);
+    }
+    controls.throttle = m_plan.throttle;
+    controls.flaps = m_plan.flaps;
+    controls.aileron = m_plan.aileron;
+    const double dz = waypoint.altitude - aircraft.altitude();
+    return std::clamp(kAltitudeGain * dz, -kMaxDescent, kMaxClimb);
+}
+
+void AutopilotAgent::plan(const Aircraft& aircraft, const Waypoint& waypoint, const Waypoint* next, double gravity) {
+    const FlightModelParams& p = aircraft.flightModel()->params();
+    const FlightState& state = aircraft.flightState();
+    const double density = airDensity(0.5 * (aircraft.altitude() + waypoint.altitude));
+    double caps[std::size(kAlong)];
+    for (size_t i = 0; i < std::size(kAlong); ++i) caps[i] = speedCap(aircraft, std::max(-kAlong[i], 0.0), gravity, kPlanReserve);
+
+    double bestCost = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < std::size(kAlong); ++i) {
+        const double throttle = std::max(kAlong[i], 0.0), flaps = std::max(-kAlong[i], 0.0);
+        // Flaps add lift as well as drag: over their speed cap they start a climb the elevator cannot stop.
+        if (flaps > 0.0 && aircraft.speed() > caps[i]) continue;
+        for (double aileron : kAilerons) {
+            PlanLeg leg{ aircraft.position().x, aircraft.position().y, aircraft.altitude(), state.velocityX, state.velocityY, aircraft.fuel() };
+            leg.fly(p, density, throttle, flaps, aileron, caps[i], waypoint, kReachFraction * waypoint.tolerance, bestCost);
+            double cost = leg.cost();
+            if (leg.arrival >= 0.0 && next && cost < bestCost) {
+                // What it leaves for the next waypoint: the best single leg from where this one ends.
+                double nextCost = std::numeric_limits<double>::infinity();
+                for (size_t j = 0; j < std::size(kAlong); ++j) {
+                    if (kAlong[j] < 0.0 && std::hypot(leg.vx, leg.vy) > caps[j]) continue;
+                    for (double nextAileron : kAilerons) {
+                        PlanLeg after{ leg.x, leg.y, leg.z, leg.vx, leg.vy, leg.fuel };
+                        after.fly(p, density, std::max(kAlong[j], 0.0), std::max(-kAlong[j], 0.0), nextAileron, caps[j],
+                                  *next, kReachFraction * next->tolerance, std::min(nextCost, bestCost - cost));
+                        nextCost = std::min(nextCost, after.cost());
+                    }
+                }
+                cost += nextCost;
+            }
+            if (cost < bestCost) {
+                bestCost = cost;
+                m_plan.throttle = throttle;
+                m_plan.flaps = flaps;
+                m_plan.aileron = aileron;
+            }
+        }
+    }
+}
+
+void AutopilotAgent::control(const Aircraft& aircraft, const TrainingScenario* scenario, double deltaTime, ControlInputs& controls) {
+    if (deltaTime <= 0.0) return;
+    const FlightState& state = aircraft.flightState();
+    const double groundSpeed = std::hypot(state.velocityX, state.velocityY);
+    const double gravity = GlobalConfig::instance().snapshot().gravity;
+
+    AutopilotTargets targets = m_targets;
+    double climbRate = 0.0;
+    bool navigating = false;
+    if (targets.navigate) {
+        if (scenario && !scenario->targetWaypoints().empty()) {
+            navigating = true;
+            climbRate = navigate(aircraft, *scenario, deltaTime, gravity, controls);
+            controls.rudder = std::clamp(wrapDegrees(trackOf(aircraft) - aircraft.heading()) * kRudderPerDegree, -1.0, 1.0);
+        }
+        else {
+            if (!m_holdCaptured) m_hold = holdCurrent(aircraft);
+            m_holdCaptured = true;
+            targets = m_hold;
+        }
+    }
+
+    if (!navigating && (targets.headingHold || targets.speedHold)) {
+        double speed = targets.speedHold ? targets.speed : groundSpeed;
+        // Past the speed cap lift outgrows the elevator and the altitude runs away.
+        const double cap = speedCap(aircraft, controls.flaps, gravity, kElevatorReserve);
+        speed = std::min(speed, std::sqrt(std::max(0.0, cap * cap - state.velocityZ * state.velocityZ)));
+        const double heading = (targets.headingHold ? targets.heading : trackOf(aircraft)) * kDegToRad;
+        // Drag always acts along -x, so thrust that cancels it is the along-track feed-forward.
+        const double maxThrust = aircraft.flightModel()->getMaxThrust();
+        controls.throttle = m_alongLoop.update(speed * std::sin(heading) - state.velocityX, deltaTime, state.drag / maxThrust);
+        controls.aileron = m_acrossLoop.update(speed * std::cos(heading) - state.velocityY, deltaTime);
+        controls.rudder = std::clamp(wrapDegrees(trackOf(aircraft) - aircraft.heading()) * kRudderPerDegree, -1.0, 1.0);
+    }
+
+    if (navigating || targets.altitudeHold) {
+        if (!navigating) climbRate = std::clamp(kAltitudeGain * (targets.altitude - aircraft.altitude()), -kMaxDescent, kMaxClimb);
+        // The elevator that holds level flight at this speed and flap setting is the feed-forward.
+        controls.elevator = m_climbLoop.update(climbRate - state.velocityZ, deltaTime, levelElevator(aircraft, controls.flaps, gravity));
+    }
+}
+
+ScriptedPilotAgent::ScriptedPilotAgent() : m_next(0), m_waiting(false), m_waitLeft(0.0), m_manualAxes(0) {}
+
+bool ScriptedPilotAgent::load(const std::string& script, std::string& error) {
+    static const struct { const char* name; ControlAxis axis; } kAxes[] = {
+        { "elevator", ControlAxis::Elevator }, { "aileron", ControlAxis::Aileron }, { "rudder", ControlAxis::Rudder },
+        { "throttle", ControlAxis::Throttle }, { "flaps", ControlAxis::Flaps },
+    };
+    static const struct { const char* name; Field field; } kFields[] = {
+        { "altitude", Field::Altitude }, { "heading", Field::Heading }, { "speed", Field::Speed }, { "progress", Field::Progress },
+    };
+
+    m_steps.clear();
+    std::istringstream lines(script);
+    std::string text;
+    int lineNumber = 0;
+    while (std::getline(lines, text)) {
+        ++lineNumber;
+        text = text.substr(0, text.find('#'));
+        std::istringstream words(text);
+        std::string command, argument, extra;
+        if (!(words >> command)) continue;
+        words >> argument;
+        Step step;
+        step.line = lineNumber;
+        bool ok = true;
+
+        auto axis = std::find_if(std::begin(kAxes), std::end(kAxes), [&](const auto& a) { return command == a.name; });
+        auto field = std::find_if(std::begin(kFields), std::end(kFields), [&](const auto& f) { return command == f.name; });
+        if (axis != std::end(kAxes)) {
+            step.op = Op::Set;
+            step.axis = axis->axis;
+            ok = parseNumber(argument, step.value);
+        }
+        else if (command == "gear") {
+            step.op = Op::Gear;
+            step.above = argument == "down";
+            ok = argument == "up" || argument == "down";
+        }
+        else if (field != std::end(kFields) && field->field != Field::Progress) {
+            step.field = field->field;
+            step.op = argument == "off" ? Op::Release : Op::Hold;
+            ok = step.op == Op::Release || parseNumber(argument, step.value);
+        }
+        else if (command == "navigate") {
+            step.op = Op::Navigate;
+            step.above = argument == "on";
+            ok = argument == "on" || argument == "off";
+        }
+        else if (command == "wait") {
+            step.op = Op::Wait;
+            ok = parseNumber(argument, step.value) && step.value >= 0.0;
+        }
+        else if (command == "until") {
+            step.op = Op::Until;
+            std::string comparison, value;
+            words >> comparison >> value;
+            if (argument == "ground") {
+                step.field = Field::Ground;
+                value = comparison;
+            }
+            else {
+                auto watched = std::find_if(std::begin(kFields), std::end(kFields), [&](const auto& f) { return argument == f.name; });
+                ok = watched != std::end(kFields) && (comparison == "<" || comparison == ">") && parseNumber(value, step.value);
+                if (ok) step.field = watched->field;
+                step.above = comparison == ">";
+                value.clear();
+            }
+            ok = ok && value.empty();
+        }
+        else {
+            ok = false;
+        }
+        if (ok && (words >> extra)) ok = false;
+        if (!ok) {
+            error = "line " + std::to_string(lineNumber) + ": cannot read '" + text + "'";
+            m_steps.clear();
+            reset();
+            return false;
+        }
+        m_steps.push_back(step);
+    }
+    reset();
+    return true;
+}
+
+bool ScriptedPilotAgent::loadFile(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    return load(text.str(), error);
+}
+
+std::string ScriptedPilotAgent::builtinProfile(const std::string& scenarioName) {
+    // The takeoff scenario starts in the air; a touch-and-go at full power starts its roll. Power
+    // comes on only once the wheels are down, or it lifts off again before touching.
+    if (scenarioName == "Basic Takeoff") {
+        return "throttle 0\n"
+               "altitude 0\n"
+               "until ground\n"
+               "throttle 1\n"
+               "wait 1\n"
+               "altitude 1000\n"
+               "until altitude > 950\n";
+    }
+    if (scenarioName == "Traffic Pattern" || scenarioName == "IFR Basic Navigation" || scenarioName == "Engine Failure Recovery") {
+        return "navigate on\n"
+               "until progress > 99.9\n";
+    }
+    return std::string();
+}
+
+void ScriptedPilotAgent::reset() {
+    m_next = 0;
+    m_waiting = false;
+    m_waitLeft = 0.0;
+    m_autopilot.reset();
+    m_targets = AutopilotTargets();
+    m_autopilot.setTargets(m_targets);
+    m_manual = ControlInputs();
+    m_manualAxes = 0;
+}
+
+uint32_t ScriptedPilotAgent::ownedAxes() const {
+    return m_manualAxes | m_autopilot.ownedAxes();
+}
+
+void ScriptedPilotAgent::execute(const Step& step) {
+    switch (step.op) {
+    case Op::Set:
+        switch (step.axis) {
+        case ControlAxis::Elevator: m_manual.elevator = std::clamp(step.value, -1.0, 1.0); break;
+        case ControlAxis::Aileron: m_manual.aileron = std::clamp(step.value, -1.0, 1.0); break;
+        case ControlAxis::Rudder: m_manual.rudder = std::clamp(step.value, -1.0, 1.0); break;
+        case ControlAxis::Throttle: m_manual.throttle = std::clamp(step.value, 0.0, 1.0); break;
+        case ControlAxis::Flaps: m_manual.flaps = std::clamp(step.value, 0.0, 1.0); break;
+        case ControlAxis::Gear: break;
+        }
+        m_manualAxes |= controlAxisBit(step.axis);
+        break;
+    case Op::Gear:
+        m_manual.gearDown = step.above;
+        m_manualAxes |= controlAxisBit(ControlAxis::Gear);
+        break;
+    case Op::Hold:
+    case Op::Release: {
+        const bool hold = step.op == Op::Hold;
+        if (step.field == Field::Altitude) {
+            m_targets.altitudeHold = hold;
+            m_targets.altitude = step.value;
+            if (hold) m_manualAxes &= ~controlAxisBit(ControlAxis::Elevator);
+        }
+        else {
+            if (step.field == Field::Heading) {
+                m_targets.headingHold = hold;
+                m_targets.heading = step.value;
+            }
+            else {
+                m_targets.speedHold = hold;
+                m_targets.speed = step.value;
+            }
+            if (hold) {
+                m_manualAxes &= ~(controlAxisBit(ControlAxis::Aileron) | controlAxisBit(ControlAxis::Rudder) |
+                                  controlAxisBit(ControlAxis::Throttle));
+            }
+        }
+        break;
+    }
+    case Op::Navigate:
+        m_targets.navigate = step.above;
+        if (step.above) {
+            m_manualAxes &= ~(controlAxisBit(ControlAxis::Elevator) | controlAxisBit(ControlAxis::Aileron) |
+                              controlAxisBit(ControlAxis::Rudder) | controlAxisBit(ControlAxis::Throttle) |
+                              controlAxisBit(ControlAxis::Flaps));
+        }
+        break;
+    case Op::Wait:
+        m_waiting = true;
+        m_waitLeft = step.value;
+        break;
+    case Op::Until:
+        m_waiting = true;
+        break;
+    }
+    m_autopilot.setTargets(m_targets);
+}
+
+bool ScriptedPilotAgent::conditionMet(const Step& step, const Aircraft& aircraft, const TrainingScenario* scenario) const {
+    if (step.op == Op::Wait) return m_waitLeft <= 0.0;
+    double value = 0.0;
+    switch (step.field) {
+    case Field::Ground: return aircraft.isOnGround();
+    case Field::Altitude: value = aircraft.altitude(); break;
+    case Field::Heading: value = aircraft.heading(); break;
+    case Field::Speed: value = aircraft.speed(); break;
+    case Field::Progress: value = scenario ? scenario->getProgress() : 0.0; break;
+    }
+    return step.above ? value > step.value : value < step.value;
+}
+
+void ScriptedPilotAgent::control(const Aircraft& aircraft, const TrainingScenario* scenario, double deltaTime, ControlInputs& controls) {
+    // Run every command that is due; a wait or until holds the script until it is satisfied.
+    while (true) {
+        if (m_waiting) {
+            const Step& current = m_steps[m_next - 1];
+            if (current.op == Op::Wait) m_waitLeft -= deltaTime;
+            if (!conditionMet(current, aircraft, scenario)) break;
+            m_waiting = false;
+        }
+        if (m_next >= m_steps.size()) break;
+        execute(m_steps[m_next++]);
+        if (m_waiting && m_steps[m_next - 1].op == Op::Wait) break;
+    }
+
+    // The autopilot flies first; anything the script set directly overrides it.
+    m_autopilot.control(aircraft, scenario, deltaTime, controls);
+    if (m_manualAxes & controlAxisBit(ControlAxis::Elevator)) controls.elevator = m_manual.elevator;
+    if (m_manualAxes & controlAxisBit(ControlAxis::Aileron)) controls.aileron = m_manual.aileron;
+    if (m_manualAxes & controlAxisBit(ControlAxis::Rudder)) controls.rudder = m_manual.rudder;
+    if (m_manualAxes & controlAxisBit(ControlAxis::Throttle)) controls.throttle = m_manual.throttle;
+    if (m_manualAxes & controlAxisBit(ControlAxis::Flaps)) controls.flaps = m_manual.flaps;
+    if (m_manualAxes & controlAxisBit(ControlAxis::Gear)) controls.gearDown = m_manual.gearDown;
+}
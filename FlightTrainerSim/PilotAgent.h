@@ -0,0 +1,153 @@
+// File: PilotAgent.h
+#ifndef PILOTAGENT_H
+#define PILOTAGENT_H
+
+#include "Aircraft.h"
+#include "TrainingScenario.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// PID with output clamping. The integral only moves while the output is inside its limits or the
+// error is pulling it back in, so a saturated loop does not wind up.
+class PidController {
+public:
+    PidController(double kp, double ki, double kd, double minimum, double maximum);
+    // `feedForward` is added to the PID terms before clamping.
+    double update(double error, double deltaTime, double feedForward = 0.0);
+    void reset();
+    bool saturatedLow() const { return m_saturation < 0; }
+    bool saturatedHigh() const { return m_saturation > 0; }
+
+private:
+    double m_kp, m_ki, m_kd, m_minimum, m_maximum;
+    double m_integral, m_previousError;
+    bool m_hasPrevious;
+    int m_saturation;
+};
+
+enum class ControlAxis : uint8_t { Elevator, Aileron, Rudder, Throttle, Flaps, Gear };
+constexpr uint32_t controlAxisBit(ControlAxis axis) { return 1u << static_cast<unsigned>(axis); }
+
+// Something that flies the aircraft: runs once per physics step, before the aircraft integrates,
+// and writes the controls it owns. Axes it does not own are left as they are.
+class PilotAgent {
+public:
+    virtual ~PilotAgent() = default;
+    virtual std::string name() const = 0;
+    virtual void reset() {}
+    // `scenario` may be null.
+    virtual void control(const Aircraft& aircraft, const TrainingScenario* scenario, double deltaTime, ControlInputs& controls) = 0;
+    // Bits per ControlAxis this agent currently drives.
+    virtual uint32_t ownedAxes() const = 0;
+};
+
+struct AutopilotTargets {
+    bool altitudeHold = false, headingHold = false, speedHold = false;
+    // Fly the scenario's waypoints in order; overrides the three values below.
+    bool navigate = false;
+    double altitude = 0.0;        // ft
+    double heading = 0.0;         // degrees, 0 = +y, 90 = +x (as drawn)
+    double speed = 0.0;           // horizontal, knots
+};
+
+// Cascaded hold loops. Altitude error commands a climb rate, which the elevator holds. The flight
+// models turn by side force rather than by banking, so heading and speed together command a
+// horizontal velocity: throttle holds its x component, aileron its y component, and rudder keeps
+// the nose on the track. Lift grows with airspeed faster than the elevator can push back, so speed
+// is capped where the elevator would run out.
+//
+// Navigating, throttle, flaps and aileron come from a search instead: each candidate setting is
+// flown ahead on the point-mass model, and the one that reaches the waypoint soonest, and leaves
+// the next waypoint soonest reachable after it, is held until the next replan.
+class AutopilotAgent : public PilotAgent {
+public:
+    AutopilotAgent();
+    explicit AutopilotAgent(const AutopilotTargets& targets);
+
+    std::string name() const override { return "Autopilot"; }
+    void reset() override;
+    void control(const Aircraft& aircraft, const TrainingScenario* scenario, double deltaTime, ControlInputs& controls) override;
+    uint32_t ownedAxes() const override;
+
+    const AutopilotTargets& targets() const { return m_targets; }
+    // Also re-engages navigation: with no waypoints it holds what it finds on the next step.
+    void setTargets(const AutopilotTargets& targets) { m_targets = targets; m_holdCaptured = false; m_planLeft = 0.0; }
+    // Holds the aircraft's current altitude, track and ground speed.
+    static AutopilotTargets holdCurrent(const Aircraft& aircraft);
+    // Fastest airspeed at which the elevator can still hold altitude with `reserve` of its nose-down
+    // travel, 0 to 1.
+    static double speedCap(const Aircraft& aircraft, double flaps, double gravity, double reserve);
+    // Elevator that holds level flight at the aircraft's speed and altitude with these flaps.
+    static double levelElevator(const Aircraft& aircraft, double flaps, double gravity);
+    // Track angle of the velocity vector in the heading convention above.
+    static double trackOf(const Aircraft& aircraft);
+
+private:
+    // Sets throttle, flaps and aileron toward the current waypoint and returns the climb rate to hold.
+    double navigate(const Aircraft& aircraft, const TrainingScenario& scenario, double deltaTime, double gravity, ControlInputs& controls);
+    // Picks m_plan for `waypoint`; `next` is the one after it, or null.
+    void plan(const Aircraft& aircraft, const Waypoint& waypoint, const Waypoint* next, double gravity);
+
+    AutopilotTargets m_targets;
+    // Navigating with no waypoints: what the aircraft was doing when the autopilot engaged.
+    AutopilotTargets m_hold;
+    bool m_holdCaptured;
+    // Navigating: the controls chosen, seconds until the next replan, and the waypoint planned for.
+    ControlInputs m_plan;
+    double m_planLeft;
+    size_t m_planWaypoint;
+    PidController m_climbLoop, m_alongLoop, m_acrossLoop;
+};
+
+// Flies a small script: one command per line, run in order, with waits between them. Direct
+// control commands take that axis away from the autopilot; hold commands give it back.
+//
+//   throttle|elevator|aileron|rudder|flaps <value>     gear up|down
+//   altitude|heading|speed <value>|off                 navigate on|off
+//   wait <seconds>                                     until ground | altitude|speed|progress <|> <value>
+//
+// '#' starts a comment. Scripts are deterministic: the same script, aircraft and step always fly
+// the same path.
+class ScriptedPilotAgent : public PilotAgent {
+public:
+    ScriptedPilotAgent();
+    // False with `error` naming the first bad line; the agent is left empty.
+    bool load(const std::string& script, std::string& error);
+    bool loadFile(const std::string& path, std::string& error);
+    // Built-in profile that flies the named scenario (see TrainingScenario), or empty if none.
+    static std::string builtinProfile(const std::string& scenarioName);
+
+    std::string name() const override { return "Script"; }
+    void reset() override;
+    void control(const Aircraft& aircraft, const TrainingScenario* scenario, double deltaTime, ControlInputs& controls) override;
+    uint32_t ownedAxes() const override;
+    bool finished() const { return m_next >= m_steps.size() && !m_waiting; }
+
+private:
+    enum class Op { Set, Gear, Hold, Release, Navigate, Wait, Until };
+    enum class Field { Altitude, Heading, Speed, Progress, Ground };
+    struct Step {
+        Op op = Op::Wait;
+        ControlAxis axis = ControlAxis::Throttle;
+        Field field = Field::Altitude;
+        bool above = false;
+        double value = 0.0;
+        int line = 0;
+    };
+
+    bool conditionMet(const Step& step, const Aircraft& aircraft, const TrainingScenario* scenario) const;
+    void execute(const Step& step);
+
+    std::vector<Step> m_steps;
+    size_t m_next;
+    bool m_waiting;
+    double m_waitLeft;
+    AutopilotAgent m_autopilot;
+    AutopilotTargets m_targets;
+    ControlInputs m_manual;
+    uint32_t m_manualAxes;
+};
+
+#endif
@@ -0,0 +1,148 @@
+// File: Profiler.cpp
+#include "Profiler.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <chrono>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILER_HAS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_HAS_RDTSC 1
+#else
+#define PROFILER_HAS_RDTSC 0
+#endif
+
+namespace {
+    int64_t steadyNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+std::atomic<unsigned> Profiler::s_flags(0);
+thread_local Profiler::ThreadBuffer* Profiler::s_threadBuffer = nullptr;
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : m_startTicks(now()), m_startNs(steadyNs()) {
+    m_scratch.reserve(kWindowSize);
+}
+
+uint64_t Profiler::now() {
+#if PROFILER_HAS_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(steadyNs());
+#endif
+}
+
+const char* Profiler::stageName(ProfileStage stage) {
+    switch (stage) {
+    case ProfileStage::Tick: return "Tick";
+    case ProfileStage::Physics: return "Physics";
+    case ProfileStage::Scenario: return "Scenario";
+    case ProfileStage::Metrics: return "Metrics";
+    case ProfileStage::Recording: return "Recording";
+    case ProfileStage::Audio: return "Audio";
+    case ProfileStage::CockpitPaint: return "Cockpit paint";
+    case ProfileStage::OutsidePaint: return "Outside paint";
+    case ProfileStage::ChartPaint: return "Chart paint";
+    case ProfileStage::HudAttitude: return "HUD attitude";
+    case ProfileStage::HudAirspeed: return "HUD airspeed";
+    case ProfileStage::HudAltimeter: return "HUD altimeter";
+    case ProfileStage::HudHeading: return "HUD heading";
+    case ProfileStage::HudVerticalSpeed: return "HUD vert speed";
+    case ProfileStage::HudThrottle: return "HUD throttle";
+    case ProfileStage::HudWarnings: return "HUD warnings";
+    case ProfileStage::SceneRaster: return "Scene raster";
+    case ProfileStage::SceneWaypoints: return "Scene waypoint";
+    case ProfileStage::SceneTraffic: return "Scene traffic";
+    case ProfileStage::ScenePath: return "Scene path";
+    case ProfileStage::SceneInfo: return "Scene info";
+    case ProfileStage::InputLatency: return "Input latency";
+    default: return "?";
+    }
+}
+
+Profiler::ThreadBuffer* Profiler::registerThread() {
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    m_buffers.push_back(std::make_unique<ThreadBuffer>());
+    return m_buffers.back().get();
+}
+
+void Profiler::record(ProfileStage stage, uint64_t ticks) {
+    if (!s_threadBuffer) s_threadBuffer = registerThread();
+    if (!s_threadBuffer->queue.tryPush({ ticks, stage })) s_threadBuffer->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::finish(ProfileStage stage, uint64_t startTicks) {
+    const uint64_t end = now();
+    const unsigned flags = s_flags.load(std::memory_order_relaxed);
+    if (flags & kStats) instance().record(stage, end - startTicks);
+    if (flags & kTrace) TraceRecorder::instance().complete(stage, startTicks, end);
+}
+
+void Profiler::recordNs(ProfileStage stage, int64_t ns) {
+    if (!enabled() || ns < 0) return;
+    Profiler& profiler = instance();
+    profiler.record(stage, static_cast<uint64_t>(ns / profiler.nsPerTick()));
+}
+
+double Profiler::nsPerTick() const {
+#if PROFILER_HAS_RDTSC
+    // The ratio sharpens as the run gets longer; the first few milliseconds are approximate.
+    const uint64_t ticks = now() - m_startTicks;
+    const int64_t ns = steadyNs() - m_startNs;
+    return ticks > 0 && ns > 0 ? static_cast<double>(ns) / static_cast<double>(ticks) : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+void Profiler::collect() {
+    const double scale = nsPerTick();
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    for (auto& buffer : m_buffers) {
+        Sample sample;
+        while (buffer->queue.tryPop(sample)) {
+            Window& window = m_windows[static_cast<size_t>(sample.stage)];
+            const double ns = static_cast<double>(sample.ticks) * scale;
+            window.ns[window.next] = static_cast<uint32_t>(std::min(ns, 4.0e9));
+            window.next = (window.next + 1) % kWindowSize;
+            window.count = std::min(window.count + 1, kWindowSize);
+        }
+    }
+}
+
+void Profiler::clear() {
+    collect();
+    for (auto& window : m_windows) window.count = window.next = 0;
+}
+
+ProfileStats Profiler::stats(ProfileStage stage) const {
+    const Window& window = m_windows[static_cast<size_t>(stage)];
+    ProfileStats result;
+    result.samples = window.count;
+    if (window.count == 0) return result;
+    m_scratch.assign(window.ns.begin(), window.ns.begin() + window.count);
+    auto at = [&](double quantile) {
+        auto nth = m_scratch.begin() + static_cast<ptrdiff_t>(quantile * (m_scratch.size() - 1));
+        std::nth_element(m_scratch.begin(), nth, m_scratch.end());
+        return *nth / 1000.0;
+    };
+    result.p50Us = at(0.5);
+    result.p99Us = at(0.99);
+    result.maxUs = *std::max_element(m_scratch.begin(), m_scratch.end()) / 1000.0;
+    return result;
+}
+
+uint64_t Profiler::droppedSamples() const {
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    uint64_t dropped = 0;
+    for (const auto& buffer : m_buffers) dropped += buffer->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
@@ -0,0 +1,119 @@
+// File: Profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "SpscQueue.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Set to 0 to compile every PROFILE_SCOPE out entirely.
+#ifndef FLIGHTSIM_PROFILING
+#define FLIGHTSIM_PROFILING 1
+#endif
+
+enum class ProfileStage : uint8_t {
+    Tick, Physics, Scenario, Metrics, Recording, Audio, CockpitPaint, OutsidePaint, ChartPaint,
+    // Inside CockpitPaint and OutsidePaint, one per draw routine.
+    HudAttitude, HudAirspeed, HudAltimeter, HudHeading, HudVerticalSpeed, HudThrottle, HudWarnings,
+    SceneRaster, SceneWaypoints, SceneTraffic, ScenePath, SceneInfo,
+    InputLatency,       // not a scope: device event to the physics state that includes it
+    Count
+};
+
+struct ProfileStats {
+    double p50Us = 0.0, p99Us = 0.0, maxUs = 0.0;
+    size_t samples = 0;
+};
+
+// Scoped stage timers. Each thread pushes (stage, duration) samples into its own lock-free queue;
+// one consumer drains them into a rolling window per stage. Scopes also feed TraceRecorder while
+// tracing is on. With both off a scope costs one relaxed atomic load. Durations are taken with
+// rdtsc where available and converted with a ratio measured against steady_clock since startup.
+class Profiler {
+public:
+    static constexpr size_t kWindowSize = 1024;
+
+    static Profiler& instance();
+    static bool enabled() { return (s_flags.load(std::memory_order_relaxed) & kStats) != 0; }
+    static void setEnabled(bool enabled) { setFlag(kStats, enabled); }
+    // True when either statistics or tracing wants scope timings.
+    static bool active() { return s_flags.load(std::memory_order_relaxed) != 0; }
+    static void setTracing(bool tracing) { setFlag(kTrace, tracing); }
+    static uint64_t now();
+    static const char* stageName(ProfileStage stage);
+    // End of a scope started at `startTicks`: feeds the statistics and/or the trace.
+    static void finish(ProfileStage stage, uint64_t startTicks);
+    // A duration measured on another clock, e.g. across threads; statistics only.
+    static void recordNs(ProfileStage stage, int64_t ns);
+
+    // Any thread; never blocks after the thread's first sample.
+    void record(ProfileStage stage, uint64_t ticks);
+    // Drains all thread buffers into the rolling windows. Call from a single thread.
+    void collect();
+    // Drains the thread buffers and empties every window, so stats() covers only what follows.
+    void clear();
+    ProfileStats stats(ProfileStage stage) const;
+    uint64_t droppedSamples() const;
+    double nsPerTick() const;
+    uint64_t startTicks() const { return m_startTicks; }
+
+private:
+    static constexpr unsigned kStats = 1u, kTrace = 2u;
+
+    struct Sample {
+        uint64_t ticks;
+        ProfileStage stage;
+    };
+    struct ThreadBuffer {
+        ThreadBuffer() : queue(4096), dropped(0) {}
+        SpscQueue<Sample> queue;
+        std::atomic<uint64_t> dropped;
+    };
+    struct Window {
+        std::array<uint32_t, kWindowSize> ns{};
+        size_t count = 0, next = 0;
+    };
+
+    Profiler();
+    ThreadBuffer* registerThread();
+    static void setFlag(unsigned flag, bool on) {
+        if (on) s_flags.fetch_or(flag, std::memory_order_relaxed);
+        else s_flags.fetch_and(~flag, std::memory_order_relaxed);
+    }
+
+    static std::atomic<unsigned> s_flags;
+    static thread_local ThreadBuffer* s_threadBuffer;
+    mutable std::mutex m_registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::array<Window, static_cast<size_t>(ProfileStage::Count)> m_windows;
+    mutable std::vector<uint32_t> m_scratch;
+    uint64_t m_startTicks;
+    int64_t m_startNs;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileStage stage) : m_stage(stage), m_start(Profiler::active() ? Profiler::now() : 0) {}
+    ~ProfileScope() {
+        if (m_start) Profiler::finish(m_stage, m_start);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+    ProfileStage m_stage;
+    uint64_t m_start;
+};
+
+#if FLIGHTSIM_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(stage) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(stage)
+#else
+#define PROFILE_SCOPE(stage) ((void)0)
+#endif
+
+#endif
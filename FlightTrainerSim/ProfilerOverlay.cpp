@@ -0,0 +1,58 @@
+// File: ProfilerOverlay.cpp
+#include "ProfilerOverlay.h"
+#include "Profiler.h"
+#include "GlobalConfig.h"
+#include <QPainter>
+#include <QFont>
+#include <QString>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    constexpr int kPanelWidth = 420, kRowHeight = 16, kBarWidth = 110, kPadding = 8;
+}
+
+void ProfilerOverlay::draw(QPainter& painter, const QRect& bounds) {
+    Profiler& profiler = Profiler::instance();
+    profiler.collect();
+    constexpr int stageCount = static_cast<int>(ProfileStage::Count);
+    const QRect panel(bounds.right() - kPanelWidth - 10, bounds.top() + 10, kPanelWidth, (stageCount + 2) * kRowHeight + 2 * kPadding);
+    const double budgetUs = GlobalConfig::instance().physicsTimeStep() * 1e6;
+
+    painter.save();
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 170));
+    painter.drawRect(panel);
+    painter.setFont(QFont("Courier", 9));
+    painter.setPen(QColor(200, 200, 200));
+    const int textX = panel.left() + kPadding, barX = panel.right() - kPadding - kBarWidth;
+    int baseline = panel.top() + kPadding + 12;
+    char line[96];
+    std::snprintf(line, sizeof(line), "%-14s %8s %8s %8s", "stage (us)", "p50", "p99", "max");
+    painter.drawText(textX, baseline, QString::fromLatin1(line));
+
+    for (int i = 0; i < stageCount; ++i) {
+        const auto stage = static_cast<ProfileStage>(i);
+        const ProfileStats stats = profiler.stats(stage);
+        baseline += kRowHeight;
+        painter.setPen(stats.samples ? QColor(255, 255, 255) : QColor(120, 120, 120));
+        std::snprintf(line, sizeof(line), "%-14s %8.1f %8.1f %8.1f", Profiler::stageName(stage), stats.p50Us, stats.p99Us, stats.maxUs);
+        painter.drawText(textX, baseline, QString::fromLatin1(line));
+        if (!stats.samples) continue;
+
+        auto barLength = [&](double us) { return static_cast<int>(std::min(1.0, us / budgetUs) * kBarWidth); };
+        const int barTop = baseline - 10;
+        painter.fillRect(barX, barTop, kBarWidth, 10, QColor(60, 60, 60));
+        painter.fillRect(barX, barTop, barLength(stats.p99Us), 10, stats.p99Us > budgetUs ? QColor(255, 80, 0) : QColor(0, 140, 0));
+        painter.fillRect(barX, barTop, barLength(stats.p50Us), 10, QColor(0, 230, 0));
+        const int maxX = barX + std::max(1, barLength(stats.maxUs)) - 1;
+        painter.fillRect(maxX, barTop - 1, 2, 12, QColor(255, 255, 0));
+    }
+
+    baseline += kRowHeight;
+    painter.setPen(QColor(200, 200, 200));
+    std::snprintf(line, sizeof(line), "bar = %.1f ms tick, dropped %llu", budgetUs / 1000.0,
+                  static_cast<unsigned long long>(profiler.droppedSamples()));
+    painter.drawText(textX, baseline, QString::fromLatin1(line));
+    painter.restore();
+}
\ No newline at end of file
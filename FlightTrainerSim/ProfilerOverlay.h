@@ -0,0 +1,16 @@
+// File: ProfilerOverlay.h
+#ifndef PROFILEROVERLAY_H
+#define PROFILEROVERLAY_H
+
+#include <QRect>
+
+class QPainter;
+
+// Debug panel with p50/p99/max per profiled stage over the rolling window. Bars are scaled to one
+// physics tick so the budget reads at a glance. Drawn while GlobalConfig::showDebugInfo() is set.
+class ProfilerOverlay {
+public:
+    static void draw(QPainter& painter, const QRect& bounds);
+};
+
+#endif
\ No newline at end of file
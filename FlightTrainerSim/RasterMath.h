@@ -0,0 +1,106 @@
+// File: RasterMath.h
+#ifndef RASTERMATH_H
+#define RASTERMATH_H
+
+#include <cmath>
+
+struct Vec3 {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    Vec3() = default;
+    Vec3(float px, float py, float pz) : x(px), y(py), z(pz) {}
+    Vec3 operator+(const Vec3& o) const { return { x + o.x, y + o.y, z + o.z }; }
+    Vec3 operator-(const Vec3& o) const { return { x - o.x, y - o.y, z - o.z }; }
+    Vec3 operator*(float s) const { return { x * s, y * s, z * s }; }
+    float dot(const Vec3& o) const { return x * o.x + y * o.y + z * o.z; }
+    Vec3 cross(const Vec3& o) const { return { y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x }; }
+    float length() const { return std::sqrt(dot(*this)); }
+    Vec3 normalized() const { const float l = length(); return l > 0.0f ? *this * (1.0f / l) : *this; }
+};
+
+struct Vec4 {
+    float x = 0.0f, y = 0.0f, z = 0.0f, w = 0.0f;
+};
+
+// Row-major 4x4 matrix acting on column vectors (v' = M * v). World space is Z-up.
+struct Mat4 {
+    float m[4][4] = { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } };
+
+    Mat4 operator*(const Mat4& o) const {
+        Mat4 r;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                r.m[i][j] = m[i][0] * o.m[0][j] + m[i][1] * o.m[1][j] + m[i][2] * o.m[2][j] + m[i][3] * o.m[3][j];
+            }
+        }
+        return r;
+    }
+    Vec4 transform(const Vec3& v) const {
+        return { m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3],
+                 m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3],
+                 m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3],
+                 m[3][0] * v.x + m[3][1] * v.y + m[3][2] * v.z + m[3][3] };
+    }
+    Vec3 transformPoint(const Vec3& v) const {
+        const Vec4 r = transform(v);
+        return { r.x, r.y, r.z };
+    }
+    Vec3 transformDirection(const Vec3& v) const {
+        return { m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+                 m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+                 m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z };
+    }
+
+    static Mat4 translation(const Vec3& t) {
+        Mat4 r;
+        r.m[0][3] = t.x; r.m[1][3] = t.y; r.m[2][3] = t.z;
+        return r;
+    }
+    static Mat4 scale(float s) {
+        Mat4 r;
+        r.m[0][0] = r.m[1][1] = r.m[2][2] = s;
+        return r;
+    }
+    static Mat4 rotationX(float radians) {
+        Mat4 r;
+        const float c = std::cos(radians), s = std::sin(radians);
+        r.m[1][1] = c; r.m[1][2] = -s; r.m[2][1] = s; r.m[2][2] = c;
+        return r;
+    }
+    static Mat4 rotationY(float radians) {
+        Mat4 r;
+        const float c = std::cos(radians), s = std::sin(radians);
+        r.m[0][0] = c; r.m[0][2] = s; r.m[2][0] = -s; r.m[2][2] = c;
+        return r;
+    }
+    static Mat4 rotationZ(float radians) {
+        Mat4 r;
+        const float c = std::cos(radians), s = std::sin(radians);
+        r.m[0][0] = c; r.m[0][1] = -s; r.m[1][0] = s; r.m[1][1] = c;
+        return r;
+    }
+    // Camera looking from eye towards target; view space is X right, Y up, -Z forward.
+    static Mat4 lookAt(const Vec3& eye, const Vec3& target, const Vec3& up) {
+        const Vec3 f = (target - eye).normalized();
+        const Vec3 s = f.cross(up).normalized();
+        const Vec3 u = s.cross(f);
+        Mat4 r;
+        r.m[0][0] = s.x;  r.m[0][1] = s.y;  r.m[0][2] = s.z;  r.m[0][3] = -s.dot(eye);
+        r.m[1][0] = u.x;  r.m[1][1] = u.y;  r.m[1][2] = u.z;  r.m[1][3] = -u.dot(eye);
+        r.m[2][0] = -f.x; r.m[2][1] = -f.y; r.m[2][2] = -f.z; r.m[2][3] = f.dot(eye);
+        return r;
+    }
+    // OpenGL-style clip space: visible points satisfy -w <= x, y, z <= w.
+    static Mat4 perspective(float fovYRadians, float aspect, float nearPlane, float farPlane) {
+        Mat4 r;
+        const float f = 1.0f / std::tan(fovYRadians * 0.5f);
+        r.m[0][0] = f / aspect;
+        r.m[1][1] = f;
+        r.m[2][2] = (farPlane + nearPlane) / (nearPlane - farPlane);
+        r.m[2][3] = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+        r.m[3][2] = -1.0f;
+        r.m[3][3] = 0.0f;
+        return r;
+    }
+};
+
+#endif
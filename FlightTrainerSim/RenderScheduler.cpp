@@ -0,0 +1,57 @@
+// File: RenderScheduler.cpp
+#include "RenderScheduler.h"
+#include "SimulationEngine.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cmath>
+
+RenderScheduler::RenderScheduler(SimulationEngine* engine, QObject* parent)
+    : QObject(parent), m_engine(engine), m_refreshRateHz(0.0), m_frameIntervalNs(0), m_dirty(false) {
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &RenderScheduler::onFrame);
+    setRefreshRate(60.0);
+}
+
+void RenderScheduler::addView(QWidget* view, StateSink sink, double maxFps) {
+    const qint64 minInterval = maxFps > 0.0 ? static_cast<qint64>(1e9 / maxFps) : 0;
+    m_views.push_back({ view, std::move(sink), minInterval, 0 });
+}
+
+void RenderScheduler::setViewMaxFps(QWidget* view, double maxFps) {
+    for (View& entry : m_views) {
+        if (entry.widget == view) entry.minIntervalNs = maxFps > 0.0 ? static_cast<qint64>(1e9 / maxFps) : 0;
+    }
+}
+
+void RenderScheduler::setRefreshRate(double hz) {
+    if (hz <= 0.0) return;
+    m_refreshRateHz = hz;
+    m_frameIntervalNs = static_cast<qint64>(1e9 / hz);
+    m_timer.setInterval(std::max(1, static_cast<int>(std::lround(1000.0 / hz))));
+}
+
+void RenderScheduler::requestFrame() {
+    m_dirty = true;
+    if (!m_timer.isActive()) m_timer.start();
+}
+
+void RenderScheduler::onFrame() {
+    TRACE_INSTANT(TraceInstant::RenderTimer);
+    const bool animating = m_engine->isRunning() && !m_engine->isPaused();
+    if (!animating && !m_dirty) {
+        m_timer.stop();
+        return;
+    }
+    const qint64 now = m_engine->clockNs();
+    const AircraftRenderState state = m_engine->renderState(now);
+    const qint64 stateClockNs = m_engine->renderStateClockNs(now);
+    for (auto& view : m_views) {
+        if (!view.widget) continue;
+        // Caps apply while animating; half a frame of slack keeps a capped view from drifting onto alternate frames.
+        if (animating && view.minIntervalNs > 0 && now - view.lastPaintNs + m_frameIntervalNs / 2 < view.minIntervalNs) continue;
+        view.sink(state, stateClockNs);
+        view.widget->update();
+        view.lastPaintNs = now;
+    }
+    m_dirty = false;
+}
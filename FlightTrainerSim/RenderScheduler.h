@@ -0,0 +1,48 @@
+// File: RenderScheduler.h
+#ifndef RENDERSCHEDULER_H
+#define RENDERSCHEDULER_H
+
+#include "RenderState.h"
+#include <QObject>
+#include <QTimer>
+#include <QWidget>
+#include <QPointer>
+#include <functional>
+#include <vector>
+
+class SimulationEngine;
+
+// Paints the views at display refresh (or a per-view cap) independently of the physics rate.
+// Each frame samples one interpolated state from the engine and hands it to every view that is due,
+// with the engine-clock instant it shows.
+class RenderScheduler : public QObject {
+    Q_OBJECT
+public:
+    using StateSink = std::function<void(const AircraftRenderState&, qint64 stateClockNs)>;
+
+    explicit RenderScheduler(SimulationEngine* engine, QObject* parent = nullptr);
+    // maxFps <= 0 paints the view on every display frame.
+    void addView(QWidget* view, StateSink sink, double maxFps = 0.0);
+    void setViewMaxFps(QWidget* view, double maxFps);
+    void setRefreshRate(double hz);
+    double refreshRate() const { return m_refreshRateHz; }
+public slots:
+    void requestFrame();
+private slots:
+    void onFrame();
+private:
+    struct View {
+        QPointer<QWidget> widget;
+        StateSink sink;
+        qint64 minIntervalNs;
+        qint64 lastPaintNs;
+    };
+    SimulationEngine* m_engine;
+    QTimer m_timer;
+    std::vector<View> m_views;
+    double m_refreshRateHz;
+    qint64 m_frameIntervalNs;
+    bool m_dirty;
+};
+
+#endif
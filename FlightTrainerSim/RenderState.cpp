@@ -0,0 +1,73 @@
+// File: RenderState.cpp
+#include "RenderState.h"
+#include "FlightRecorder.h"
+#include "PerformanceEnvelope.h"
+#include <cmath>
+
+namespace {
+    double lerp(double a, double b, double t) { return a + (b - a) * t; }
+
+    double lerpAngle(double a, double b, double t) {
+        const double delta = std::fmod(std::fmod(b - a, 360.0) + 540.0, 360.0) - 180.0;
+        return a + delta * t;
+    }
+}
+
+AircraftRenderState AircraftRenderState::capture(const Aircraft& aircraft, double timestamp) {
+    AircraftRenderState state;
+    state.timestamp = timestamp;
+    state.position = aircraft.position();
+    state.heading = aircraft.heading();
+    state.pitch = aircraft.pitch();
+    state.bank = aircraft.bank();
+    state.speed = aircraft.speed();
+    state.verticalSpeed = aircraft.verticalSpeed();
+    state.throttle = aircraft.controls().throttle;
+    state.fuel = aircraft.fuel();
+    state.stalled = aircraft.isStalled();
+    state.onGround = aircraft.isOnGround();
+    state.overspeed = aircraft.isOverspeed();
+    if (const PerformanceEnvelope* envelope = aircraft.envelope()) {
+        const double flaps = aircraft.controls().flaps;
+        state.stallSpeed = envelope->stallSpeed(aircraft.altitude(), flaps, PerformanceEnvelope::loadFactorForBank(aircraft.bank()));
+        state.maxSpeed = envelope->maxSpeed(aircraft.altitude(), flaps);
+        state.bestClimbSpeed = envelope->bestClimbSpeed(aircraft.altitude(), flaps);
+    }
+    return state;
+}
+
+AircraftRenderState AircraftRenderState::fromRecord(const FlightRecord& record) {
+    AircraftRenderState state;
+    state.timestamp = record.timestamp;
+    state.position = { record.x, record.y, record.altitude };
+    state.heading = record.heading;
+    state.pitch = record.pitch;
+    state.bank = record.bank;
+    state.speed = record.speed;
+    state.verticalSpeed = record.verticalSpeed;
+    state.throttle = record.throttle;
+    state.fuel = record.fuel;
+    state.stalled = (record.events & FlightEvent::Stall) != 0;
+    state.onGround = (record.events & FlightEvent::OnGround) != 0;
+    state.overspeed = (record.events & FlightEvent::Overspeed) != 0;
+    return state;
+}
+
+AircraftRenderState AircraftRenderState::interpolate(const AircraftRenderState& from, const AircraftRenderState& to, double alpha) {
+    AircraftRenderState state = alpha < 0.5 ? from : to;
+    state.timestamp = lerp(from.timestamp, to.timestamp, alpha);
+    state.position.x = lerp(from.position.x, to.position.x, alpha);
+    state.position.y = lerp(from.position.y, to.position.y, alpha);
+    state.position.z = lerp(from.position.z, to.position.z, alpha);
+    state.heading = std::fmod(lerpAngle(from.heading, to.heading, alpha) + 360.0, 360.0);
+    state.pitch = lerp(from.pitch, to.pitch, alpha);
+    state.bank = lerpAngle(from.bank, to.bank, alpha);
+    state.speed = lerp(from.speed, to.speed, alpha);
+    state.verticalSpeed = lerp(from.verticalSpeed, to.verticalSpeed, alpha);
+    state.throttle = lerp(from.throttle, to.throttle, alpha);
+    state.fuel = lerp(from.fuel, to.fuel, alpha);
+    state.stallSpeed = lerp(from.stallSpeed, to.stallSpeed, alpha);
+    state.maxSpeed = lerp(from.maxSpeed, to.maxSpeed, alpha);
+    state.bestClimbSpeed = lerp(from.bestClimbSpeed, to.bestClimbSpeed, alpha);
+    return state;
+}
@@ -0,0 +1,36 @@
+// File: RenderState.h
+#ifndef RENDERSTATE_H
+#define RENDERSTATE_H
+
+#include "Aircraft.h"
+
+struct FlightRecord;
+
+// Snapshot of everything the views draw for the active aircraft. The engine keeps the last two
+// physics states so the renderer can interpolate between them at its own frame rate.
+struct AircraftRenderState {
+    double timestamp = 0.0;
+    Position3D position;
+    double heading = 0.0, pitch = 0.0, bank = 0.0;
+    double speed = 0.0, verticalSpeed = 0.0;
+    double throttle = 0.0, fuel = 0.0;
+    bool stalled = false, onGround = true, overspeed = false;
+    // From the aircraft's performance envelope for its altitude, flaps and bank; 0 when unknown,
+    // as in replays, traffic and aircraft without an envelope.
+    double stallSpeed = 0.0, maxSpeed = 0.0, bestClimbSpeed = 0.0;
+
+    static AircraftRenderState capture(const Aircraft& aircraft, double timestamp);
+    // Rebuilds the state from a recorded tick, for replays.
+    static AircraftRenderState fromRecord(const FlightRecord& record);
+    // Blend with alpha in [0, 1]; angles take the short way round and flags switch at the midpoint.
+    static AircraftRenderState interpolate(const AircraftRenderState& from, const AircraftRenderState& to, double alpha);
+};
+
+// Another aircraft sharing the sky, e.g. a multiplayer participant.
+struct TrafficAircraft {
+    int id = 0;
+    std::string callsign, model;
+    AircraftRenderState state;
+};
+
+#endif
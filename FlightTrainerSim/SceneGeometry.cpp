@@ -0,0 +1,161 @@
+// File: SceneGeometry.cpp
+#include "SceneGeometry.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float kPi = 3.14159265358979f;
+    constexpr float kDegToRad = kPi / 180.0f;
+
+    struct AirframeShape {
+        float length, radius, span, chord, sweep, wingZ, tailSpan, finHeight;
+        uint32_t body, wing;
+    };
+
+    AirframeShape airframeFor(const std::string& modelName) {
+        if (modelName.find("F-16") != std::string::npos) return { 49.0f, 2.6f, 31.0f, 14.0f, 9.0f, -0.5f, 18.0f, 10.0f, 0x8C96A0, 0x737D87 };
+        if (modelName.find("C-130") != std::string::npos) return { 97.0f, 7.0f, 132.0f, 13.0f, 0.0f, 5.5f, 52.0f, 22.0f, 0x9AA08C, 0x7D826E };
+        return { 46.0f, 2.2f, 25.0f, 8.0f, 2.0f, -0.8f, 14.0f, 8.0f, 0xE6E6EB, 0xB4B4C8 };
+    }
+
+    // Flat (two-sided) trapezoid in the XY plane; x mirrored for the left side.
+    void addPlanform(RasterMesh& mesh, float rootX, float tipX, float rootLead, float rootTrail,
+                     float tipLead, float tipTrail, float z, uint32_t color) {
+        for (float side : { 1.0f, -1.0f }) {
+            const uint32_t a = mesh.addVertex({ side * rootX, rootTrail, z });
+            const uint32_t b = mesh.addVertex({ side * tipX, tipTrail, z });
+            const uint32_t c = mesh.addVertex({ side * tipX, tipLead, z });
+            const uint32_t d = mesh.addVertex({ side * rootX, rootLead, z });
+            mesh.addQuad(a, b, c, d, color);
+        }
+    }
+}
+
+RasterMesh SceneGeometry::createAircraftMesh(const std::string& modelName) {
+    // Model space: +Y nose, +X right wing, +Z up. Drawn two-sided, so winding is free.
+    const AirframeShape s = airframeFor(modelName);
+    RasterMesh mesh;
+    constexpr int kSides = 8;
+    const float stations[] = { -0.5f * s.length, -0.3f * s.length, 0.25f * s.length };
+    const float radii[] = { 0.35f * s.radius, s.radius, s.radius };
+    uint32_t rings[3][kSides];
+    for (int r = 0; r < 3; ++r) {
+        for (int k = 0; k < kSides; ++k) {
+            const float angle = 2.0f * kPi * k / kSides;
+            rings[r][k] = mesh.addVertex({ radii[r] * std::cos(angle), stations[r], radii[r] * std::sin(angle) });
+        }
+    }
+    const uint32_t nose = mesh.addVertex({ 0.0f, 0.5f * s.length, 0.0f });
+    const uint32_t tail = mesh.addVertex({ 0.0f, -0.5f * s.length, 0.0f });
+    for (int k = 0; k < kSides; ++k) {
+        const int n = (k + 1) % kSides;
+        for (int r = 0; r < 2; ++r) mesh.addQuad(rings[r][k], rings[r + 1][k], rings[r + 1][n], rings[r][n], s.body);
+        mesh.addTriangle(rings[2][k], nose, rings[2][n], s.body);
+        mesh.addTriangle(rings[0][k], rings[0][n], tail, s.body);
+    }
+
+    const float wingRoot = 0.05f * s.length;
+    addPlanform(mesh, s.radius, 0.5f * s.span, wingRoot + 0.5f * s.chord, wingRoot - 0.5f * s.chord,
+                wingRoot + 0.5f * s.chord - s.sweep, wingRoot - s.sweep, s.wingZ, s.wing);
+    const float tailRoot = -0.42f * s.length, tailChord = 0.35f * s.chord + 3.0f;
+    addPlanform(mesh, 0.4f * s.radius, 0.5f * s.tailSpan, tailRoot + tailChord, tailRoot,
+                tailRoot + 0.5f * tailChord, tailRoot - 0.1f * tailChord, 0.3f * s.radius, s.wing);
+
+    const uint32_t finRootLead = mesh.addVertex({ 0.0f, tailRoot + 1.5f * tailChord, 0.8f * s.radius });
+    const uint32_t finRootTrail = mesh.addVertex({ 0.0f, -0.5f * s.length, 0.3f * s.radius });
+    const uint32_t finTipTrail = mesh.addVertex({ 0.0f, -0.5f * s.length - 0.15f * s.finHeight, s.finHeight });
+    const uint32_t finTipLead = mesh.addVertex({ 0.0f, tailRoot + 0.2f * tailChord, s.finHeight });
+    mesh.addQuad(finRootTrail, finTipTrail, finTipLead, finRootLead, s.wing);
+    return mesh;
+}
+
+Vec3 SceneGeometry::runwayDirection(const Airfield& airfield) {
+    const float heading = static_cast<float>(airfield.runwayHeading) * kDegToRad;
+    return { std::sin(heading), std::cos(heading), 0.0f };
+}
+
+RasterMesh SceneGeometry::createRunwayMesh(const Airfield& airfield) {
+    constexpr float kWidth = 150.0f, kSurfaceZ = 0.5f, kMarkingZ = 1.0f;
+    const Vec3 dir = runwayDirection(airfield);
+    const Vec3 right(dir.y, -dir.x, 0.0f);
+    const Vec3 origin(static_cast<float>(airfield.x), static_cast<float>(airfield.y), 0.0f);
+    const float length = static_cast<float>(airfield.runwayLength);
+    RasterMesh mesh;
+    // Rectangle from `from` to `to` feet along the runway, `halfWidth` either side of `offset`.
+    auto addStrip = [&](float from, float to, float offset, float halfWidth, float z, uint32_t color) {
+        const Vec3 a = origin + dir * from + right * (offset - halfWidth);
+        const Vec3 b = origin + dir * from + right * (offset + halfWidth);
+        const Vec3 c = origin + dir * to + right * (offset + halfWidth);
+        const Vec3 d = origin + dir * to + right * (offset - halfWidth);
+        const uint32_t ia = mesh.addVertex({ a.x, a.y, z }), ib = mesh.addVertex({ b.x, b.y, z });
+        const uint32_t ic = mesh.addVertex({ c.x, c.y, z }), id = mesh.addVertex({ d.x, d.y, z });
+        // Counter-clockwise seen from above regardless of heading.
+        if ((b - a).cross(c - a).z > 0.0f) mesh.addQuad(ia, ib, ic, id, color);
+        else mesh.addQuad(ia, id, ic, ib, color);
+    };
+    addStrip(0.0f, length, 0.0f, 0.5f * kWidth, kSurfaceZ, 0x3C3C46);
+    for (float along = 150.0f; along + 100.0f < length - 150.0f; along += 200.0f) {
+        addStrip(along, along + 100.0f, 0.0f, 1.5f, kMarkingZ, 0xF0F0F0);
+    }
+    for (int bar = 0; bar < 8; ++bar) {
+        const float offset = (bar - 3.5f) * 16.0f;
+        addStrip(10.0f, 110.0f, offset, 2.5f, kMarkingZ, 0xF0F0F0);
+        addStrip(length - 110.0f, length - 10.0f, offset, 2.5f, kMarkingZ, 0xF0F0F0);
+    }
+    return mesh;
+}
+
+double SceneGeometry::terrainHeight(const Environment* environment, double x, double y) {
+    double n = 0.5 + 0.25 * (std::sin(x * 0.0009) + std::cos(y * 0.0011)) + 0.15 * std::sin((x + y) * 0.0031)
+             + 0.08 * std::sin(x * 0.0073 - y * 0.0057);
+    n = std::clamp(n, 0.0, 1.0);
+    double flatten = 1.0;
+    if (environment) {
+        for (const auto& field : environment->airfields()) {
+            const Vec3 dir = runwayDirection(field);
+            const double cx = field.x + dir.x * field.runwayLength * 0.5, cy = field.y + dir.y * field.runwayLength * 0.5;
+            const double dist = std::hypot(x - cx, y - cy) - field.runwayLength * 0.5;
+            flatten = std::min(flatten, std::clamp((dist - 400.0) / 2000.0, 0.0, 1.0));
+        }
+    }
+    return -120.0 * n * flatten;
+}
+
+void SceneGeometry::buildTerrain(RasterMesh& out, const Environment* environment, double centerX, double centerY) {
+    out.clear();
+    const double originX = (std::floor(centerX / kTerrainCellSize) - kTerrainCells / 2) * kTerrainCellSize;
+    const double originY = (std::floor(centerY / kTerrainCellSize) - kTerrainCells / 2) * kTerrainCellSize;
+    const int stride = kTerrainCells + 1;
+    out.positions.reserve(static_cast<size_t>(stride) * stride);
+    out.indices.reserve(static_cast<size_t>(kTerrainCells) * kTerrainCells * 6);
+    out.colors.reserve(static_cast<size_t>(kTerrainCells) * kTerrainCells * 2);
+    for (int j = 0; j <= kTerrainCells; ++j) {
+        for (int i = 0; i <= kTerrainCells; ++i) {
+            const double x = originX + i * kTerrainCellSize, y = originY + j * kTerrainCellSize;
+            out.addVertex({ static_cast<float>(x), static_cast<float>(y), static_cast<float>(terrainHeight(environment, x, y)) });
+        }
+    }
+    for (int j = 0; j < kTerrainCells; ++j) {
+        for (int i = 0; i < kTerrainCells; ++i) {
+            const uint32_t a = j * stride + i, b = a + 1, c = a + stride + 1, d = a + stride;
+            // Lower ground is browner; a world-aligned checker tint gives motion cues.
+            const float depth = std::clamp(-out.positions[a].z / 120.0f, 0.0f, 1.0f);
+            const long cellX = static_cast<long>(std::floor(originX / kTerrainCellSize)) + i;
+            const long cellY = static_cast<long>(std::floor(originY / kTerrainCellSize)) + j;
+            const int tint = ((cellX + cellY) & 1) ? 10 : 0;
+            const uint32_t r = static_cast<uint32_t>(70 + 50 * depth) + tint;
+            const uint32_t g = static_cast<uint32_t>(125 - 30 * depth) + tint;
+            const uint32_t bl = static_cast<uint32_t>(50 + 10 * depth);
+            out.addQuad(a, b, c, d, (r << 16) | (g << 8) | bl);
+        }
+    }
+}
+
+Mat4 SceneGeometry::aircraftTransform(const AircraftRenderState& state, float visualScale) {
+    const Vec3 position(static_cast<float>(state.position.x), static_cast<float>(state.position.y), static_cast<float>(state.position.z));
+    return Mat4::translation(position)
+         * Mat4::rotationZ(-static_cast<float>(state.heading) * kDegToRad)
+         * Mat4::rotationX(static_cast<float>(state.pitch) * kDegToRad)
+         * Mat4::rotationY(static_cast<float>(state.bank) * kDegToRad)
+         * Mat4::scale(visualScale);
+}
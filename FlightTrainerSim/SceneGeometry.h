@@ -0,0 +1,27 @@
+// File: SceneGeometry.h
+#ifndef SCENEGEOMETRY_H
+#define SCENEGEOMETRY_H
+
+#include "SoftwareRasterizer.h"
+#include "Environment.h"
+#include "RenderState.h"
+#include <string>
+
+// Meshes for the outside view. World space matches the simulation: X east, Y north, Z up (feet),
+// headings clockwise from north. Terrain never rises above the simulation's ground plane (z = 0)
+// and is flattened around airfields.
+class SceneGeometry {
+public:
+    static constexpr double kTerrainCellSize = 400.0;
+    static constexpr int kTerrainCells = 50;
+
+    static RasterMesh createAircraftMesh(const std::string& modelName);
+    static RasterMesh createRunwayMesh(const Airfield& airfield);
+    // Grid of kTerrainCells^2 cells centred on (centerX, centerY), snapped to the cell size.
+    static void buildTerrain(RasterMesh& out, const Environment* environment, double centerX, double centerY);
+    static double terrainHeight(const Environment* environment, double x, double y);
+    static Mat4 aircraftTransform(const AircraftRenderState& state, float visualScale);
+    static Vec3 runwayDirection(const Airfield& airfield);
+};
+
+#endif
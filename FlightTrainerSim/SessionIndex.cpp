@@ -0,0 +1,421 @@
+// File: SessionIndex.cpp
+#include "SessionIndex.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    constexpr char kIndexMagic[8] = { 'F', 'T', 'S', 'I', 'D', 'X', '\0', '\1' };
+    // Version 2 allows appended records after the columns; version 1 files have none.
+    constexpr uint32_t kIndexVersion = 2;
+
+    template <typename T>
+    void writePod(std::string& out, const T& value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void writeColumn(std::string& out, const std::vector<T>& column) {
+        out.append(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+    }
+
+    void writeStrings(std::string& out, const std::vector<std::string>& strings) {
+        writePod(out, static_cast<uint32_t>(strings.size()));
+        for (const auto& s : strings) {
+            writePod(out, static_cast<uint32_t>(s.size()));
+            out.append(s);
+        }
+    }
+
+    void writeString(std::string& out, const std::string& s) {
+        writePod(out, static_cast<uint32_t>(s.size()));
+        out.append(s);
+    }
+
+    class Cursor {
+    public:
+        Cursor(const char* data, size_t size) : m_data(data), m_remaining(size) {}
+        bool ok() const { return m_ok; }
+        size_t remaining() const { return m_remaining; }
+
+        template <typename T>
+        T pod() {
+            T value{};
+            read(&value, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void column(std::vector<T>& out, size_t count) {
+            if (count * sizeof(T) > m_remaining) { m_ok = false; return; }
+            out.resize(count);
+            read(out.data(), count * sizeof(T));
+        }
+
+        void string(std::string& out) { bytes(out, pod<uint32_t>()); }
+
+        void strings(std::vector<std::string>& out) {
+            const uint32_t count = pod<uint32_t>();
+            out.clear();
+            for (uint32_t i = 0; i < count && m_ok; ++i) string(out.emplace_back());
+        }
+
+        // The next `count` bytes as a cursor of their own.
+        Cursor take(size_t count) {
+            if (!m_ok || count > m_remaining) { m_ok = false; return Cursor(m_data, 0); }
+            Cursor sub(m_data, count);
+            m_data += count;
+            m_remaining -= count;
+            return sub;
+        }
+
+        void bytes(std::string& out, size_t count) {
+            if (!m_ok || count > m_remaining) { m_ok = false; return; }
+            out.assign(m_data, count);
+            m_data += count;
+            m_remaining -= count;
+        }
+
+    private:
+        const char* m_data;
+        size_t m_remaining;
+        bool m_ok = true;
+
+        void read(void* dst, size_t count) {
+            if (!m_ok || count > m_remaining) { m_ok = false; return; }
+            if (count == 0) return;
+            std::memcpy(dst, m_data, count);
+            m_data += count;
+            m_remaining -= count;
+        }
+    };
+
+    // One appended session: its size, then the entry field by field.
+    std::string encodeRecord(const SessionEntry& entry) {
+        std::string body;
+        writeString(body, entry.sessionFile);
+        writeString(body, entry.traineeId);
+        writeString(body, entry.aircraftModel);
+        writeString(body, entry.scenarioName);
+        writePod(body, entry.startTimeMs);
+        writePod(body, entry.flightTime);
+        writePod(body, entry.overallScore);
+        writePod(body, static_cast<uint32_t>(entry.categoryScores.size()));
+        for (const auto& [category, score] : entry.categoryScores) {
+            writeString(body, category);
+            writePod(body, score);
+        }
+        std::string record;
+        writePod(record, static_cast<uint32_t>(body.size()));
+        return record + body;
+    }
+
+    bool decodeRecord(Cursor& in, SessionEntry& entry) {
+        in.string(entry.sessionFile);
+        in.string(entry.traineeId);
+        in.string(entry.aircraftModel);
+        in.string(entry.scenarioName);
+        entry.startTimeMs = in.pod<int64_t>();
+        entry.flightTime = in.pod<double>();
+        entry.overallScore = in.pod<double>();
+        const uint32_t categories = in.pod<uint32_t>();
+        for (uint32_t i = 0; i < categories && in.ok(); ++i) {
+            std::string category;
+            in.string(category);
+            entry.categoryScores[category] = in.pod<double>();
+        }
+        return in.ok() && in.remaining() == 0;
+    }
+}
+
+uint32_t SessionIndex::Dictionary::intern(const std::string& value) {
+    auto [it, added] = ids.try_emplace(value, static_cast<uint32_t>(strings.size()));
+    if (added) strings.push_back(value);
+    return it->second;
+}
+
+uint32_t SessionIndex::Dictionary::find(const std::string& value) const {
+    auto it = ids.find(value);
+    return it != ids.end() ? it->second : kAny - 1;
+}
+
+bool SessionIndex::Dictionary::index() {
+    ids.clear();
+    ids.reserve(strings.size());
+    for (size_t i = 0; i < strings.size(); ++i) {
+        if (!ids.try_emplace(strings[i], static_cast<uint32_t>(i)).second) return false;
+    }
+    return true;
+}
+
+void SessionIndex::clear() {
+    m_trainees.clear(); m_aircraft.clear(); m_scenarios.clear(); m_categories.clear();
+    m_traineeCol.clear(); m_aircraftCol.clear(); m_scenarioCol.clear();
+    m_startTime.clear(); m_flightTime.clear(); m_overall.clear();
+    m_categoryCols.clear();
+    m_fileOffsets.assign(1, 0);
+    m_fileBlob.clear();
+    m_loadedBytes = 0;
+}
+
+void SessionIndex::add(const SessionEntry& entry) {
+    const size_t row = size();
+    m_traineeCol.push_back(m_trainees.intern(entry.traineeId));
+    m_aircraftCol.push_back(m_aircraft.intern(entry.aircraftModel));
+    m_scenarioCol.push_back(m_scenarios.intern(entry.scenarioName));
+    m_startTime.push_back(entry.startTimeMs);
+    m_flightTime.push_back(static_cast<float>(entry.flightTime));
+    m_overall.push_back(static_cast<float>(entry.overallScore));
+    for (const auto& [category, score] : entry.categoryScores) {
+        if (m_categories.intern(category) == m_categoryCols.size())
+            m_categoryCols.emplace_back(row, std::nanf(""));
+    }
+    for (size_t c = 0; c < m_categories.strings.size(); ++c) {
+        auto it = entry.categoryScores.find(m_categories.strings[c]);
+        m_categoryCols[c].push_back(it != entry.categoryScores.end() ? static_cast<float>(it->second) : std::nanf(""));
+    }
+    m_fileBlob += entry.sessionFile;
+    m_fileOffsets.push_back(static_cast<uint32_t>(m_fileBlob.size()));
+}
+
+SessionEntry SessionIndex::entry(size_t row) const {
+    SessionEntry e;
+    e.sessionFile = m_fileBlob.substr(m_fileOffsets[row], m_fileOffsets[row + 1] - m_fileOffsets[row]);
+    e.traineeId = m_trainees.strings[m_traineeCol[row]];
+    e.aircraftModel = m_aircraft.strings[m_aircraftCol[row]];
+    e.scenarioName = m_scenarios.strings[m_scenarioCol[row]];
+    e.startTimeMs = m_startTime[row];
+    e.flightTime = m_flightTime[row];
+    e.overallScore = m_overall[row];
+    for (size_t c = 0; c < m_categories.strings.size(); ++c) {
+        if (!std::isnan(m_categoryCols[c][row])) e.categoryScores[m_categories.strings[c]] = m_categoryCols[c][row];
+    }
+    return e;
+}
+
+bool SessionIndex::save(const std::string& path) const {
+    const uint32_t rows = static_cast<uint32_t>(size());
+    std::string out;
+    out.reserve(64 + rows * (28 + 4 * m_categories.strings.size()) + m_fileBlob.size());
+    out.append(kIndexMagic, sizeof(kIndexMagic));
+    writePod(out, kIndexVersion);
+    writePod(out, rows);
+    writeStrings(out, m_trainees.strings);
+    writeStrings(out, m_aircraft.strings);
+    writeStrings(out, m_scenarios.strings);
+    writeStrings(out, m_categories.strings);
+    writeColumn(out, m_traineeCol);
+    writeColumn(out, m_aircraftCol);
+    writeColumn(out, m_scenarioCol);
+    writeColumn(out, m_startTime);
+    writeColumn(out, m_flightTime);
+    writeColumn(out, m_overall);
+    for (const auto& col : m_categoryCols) writeColumn(out, col);
+    writeColumn(out, m_fileOffsets);
+    out.append(m_fileBlob);
+
+    const QString filePath = QString::fromStdString(path);
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    if (file.write(out.data(), static_cast<qint64>(out.size())) != static_cast<qint64>(out.size())) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+bool SessionIndex::valid() const {
+    const size_t rows = size();
+    for (size_t row = 0; row < rows; ++row) {
+        if (m_traineeCol[row] >= m_trainees.strings.size() || m_aircraftCol[row] >= m_aircraft.strings.size()
+            || m_scenarioCol[row] >= m_scenarios.strings.size()) return false;
+    }
+    if (m_fileOffsets.size() != rows + 1 || m_fileOffsets.front() != 0 || m_fileOffsets.back() != m_fileBlob.size()) return false;
+    for (size_t row = 0; row < rows; ++row) {
+        if (m_fileOffsets[row + 1] < m_fileOffsets[row]) return false;
+    }
+    return true;
+}
+
+bool SessionIndex::load(const std::string& path) {
+    clear();
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    const QByteArray data = file.readAll();
+    Cursor in(data.constData(), static_cast<size_t>(data.size()));
+
+    char magic[sizeof(kIndexMagic)];
+    for (char& c : magic) c = in.pod<char>();
+    const uint32_t version = in.pod<uint32_t>();
+    const uint32_t rows = in.pod<uint32_t>();
+    if (!in.ok() || std::memcmp(magic, kIndexMagic, sizeof(magic)) != 0 || (version != kIndexVersion && version != 1)) return false;
+
+    in.strings(m_trainees.strings);
+    in.strings(m_aircraft.strings);
+    in.strings(m_scenarios.strings);
+    in.strings(m_categories.strings);
+    in.column(m_traineeCol, rows);
+    in.column(m_aircraftCol, rows);
+    in.column(m_scenarioCol, rows);
+    in.column(m_startTime, rows);
+    in.column(m_flightTime, rows);
+    in.column(m_overall, rows);
+    m_categoryCols.resize(m_categories.strings.size());
+    for (auto& col : m_categoryCols) in.column(col, rows);
+    in.column(m_fileOffsets, rows + 1);
+    if (in.ok() && !m_fileOffsets.empty()) in.bytes(m_fileBlob, m_fileOffsets.back());
+    const bool indexed = m_trainees.index() && m_aircraft.index() && m_scenarios.index() && m_categories.index();
+    if (!in.ok() || !indexed || !valid()) {
+        clear();
+        return false;
+    }
+
+    m_loadedBytes = static_cast<size_t>(data.size()) - in.remaining();
+    while (version == kIndexVersion && in.remaining() > 0) {
+        const uint32_t length = in.pod<uint32_t>();
+        // An append cut short (the process died mid-write) loses that session, not the index.
+        if (!in.ok() || length > in.remaining()) break;
+        Cursor record = in.take(length);
+        SessionEntry entry;
+        if (!decodeRecord(record, entry)) {
+            clear();
+            return false;
+        }
+        add(entry);
+        m_loadedBytes = static_cast<size_t>(data.size()) - in.remaining();
+    }
+    return true;
+}
+
+bool SessionIndex::appendToFile(const std::string& path, const SessionEntry& entry) {
+    const QString filePath = QString::fromStdString(path);
+    size_t appendAt = 0;
+    if (!QFile::exists(filePath)) {
+        if (!SessionIndex().save(path)) return false;
+        appendAt = static_cast<size_t>(QFileInfo(filePath).size());
+    }
+    else {
+        // Only append to an index this version can read back.
+        QFile existing(filePath);
+        char header[sizeof(kIndexMagic) + sizeof(uint32_t)];
+        uint32_t version = 0;
+        if (!existing.open(QIODevice::ReadOnly) || existing.read(header, sizeof(header)) != sizeof(header)) return false;
+        std::memcpy(&version, header + sizeof(kIndexMagic), sizeof(version));
+        if (std::memcmp(header, kIndexMagic, sizeof(kIndexMagic)) != 0) return false;
+        existing.close();
+        SessionIndex index;
+        if (!index.load(path)) return false;
+        // Version 1 has no room for records: rewrite it once in the current layout.
+        if (version != kIndexVersion) {
+            index.add(entry);
+            return index.save(path);
+        }
+        appendAt = index.m_loadedBytes;
+    }
+    const std::string record = encodeRecord(entry);
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadWrite)) return false;
+    if (static_cast<size_t>(file.size()) != appendAt && !file.resize(static_cast<qint64>(appendAt))) return false;
+    if (!file.seek(static_cast<qint64>(appendAt))) return false;
+    return file.write(record.data(), static_cast<qint64>(record.size())) == static_cast<qint64>(record.size());
+}
+
+SessionIndex::ResolvedFilter SessionIndex::resolve(const SessionFilter& filter) const {
+    ResolvedFilter f;
+    f.trainee = filter.traineeId.empty() ? kAny : m_trainees.find(filter.traineeId);
+    f.aircraft = filter.aircraftModel.empty() ? kAny : m_aircraft.find(filter.aircraftModel);
+    f.scenario = filter.scenarioName.empty() ? kAny : m_scenarios.find(filter.scenarioName);
+    f.matchesNothing = f.trainee == kAny - 1 || f.aircraft == kAny - 1 || f.scenario == kAny - 1;
+    f.fromTimeMs = filter.fromTimeMs;
+    f.toTimeMs = filter.toTimeMs;
+    f.minOverall = static_cast<float>(filter.minOverallScore);
+    return f;
+}
+
+bool SessionIndex::matches(const ResolvedFilter& f, size_t row) const {
+    return (f.trainee == kAny || m_traineeCol[row] == f.trainee)
+        && (f.aircraft == kAny || m_aircraftCol[row] == f.aircraft)
+        && (f.scenario == kAny || m_scenarioCol[row] == f.scenario)
+        && m_startTime[row] >= f.fromTimeMs && m_startTime[row] <= f.toTimeMs
+        && m_overall[row] >= f.minOverall;
+}
+
+const float* SessionIndex::column(const std::string& name) const {
+    if (name == kOverallColumn) return m_overall.data();
+    if (name == kFlightTimeColumn) return m_flightTime.data();
+    const uint32_t category = m_categories.find(name);
+    return category < m_categoryCols.size() ? m_categoryCols[category].data() : nullptr;
+}
+
+std::vector<size_t> SessionIndex::select(const SessionFilter& filter) const {
+    std::vector<size_t> rows;
+    const ResolvedFilter f = resolve(filter);
+    if (f.matchesNothing) return rows;
+    for (size_t row = 0; row < size(); ++row) {
+        if (matches(f, row)) rows.push_back(row);
+    }
+    return rows;
+}
+
+SessionAggregate SessionIndex::aggregate(const std::string& column, const SessionFilter& filter) const {
+    SessionAggregate result;
+    const float* values = this->column(column);
+    const ResolvedFilter f = resolve(filter);
+    if (!values || f.matchesNothing) return result;
+
+    double sum = 0.0;
+    float lo = std::numeric_limits<float>::infinity(), hi = -std::numeric_limits<float>::infinity();
+    for (size_t row = 0; row < size(); ++row) {
+        const float v = values[row];
+        if (std::isnan(v) || !matches(f, row)) continue;
+        sum += v;
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+        ++result.count;
+    }
+    if (result.count > 0) {
+        result.mean = sum / result.count;
+        result.min = lo;
+        result.max = hi;
+    }
+    return result;
+}
+
+std::map<std::string, SessionAggregate> SessionIndex::aggregateBy(SessionGroupBy group, const std::string& column,
+                                                                  const SessionFilter& filter) const {
+    std::map<std::string, SessionAggregate> result;
+    const float* values = this->column(column);
+    const ResolvedFilter f = resolve(filter);
+    if (!values || f.matchesNothing) return result;
+
+    const std::vector<uint32_t>* keys = &m_traineeCol;
+    const std::vector<std::string>* names = &m_trainees.strings;
+    if (group == SessionGroupBy::Aircraft) { keys = &m_aircraftCol; names = &m_aircraft.strings; }
+    else if (group == SessionGroupBy::Scenario) { keys = &m_scenarioCol; names = &m_scenarios.strings; }
+
+    struct Accumulator { size_t count = 0; double sum = 0.0; float lo = 0.0f, hi = 0.0f; };
+    std::vector<Accumulator> groups(names->size());
+    for (size_t row = 0; row < size(); ++row) {
+        const float v = values[row];
+        if (std::isnan(v) || !matches(f, row)) continue;
+        Accumulator& acc = groups[(*keys)[row]];
+        acc.lo = acc.count == 0 ? v : std::min(acc.lo, v);
+        acc.hi = acc.count == 0 ? v : std::max(acc.hi, v);
+        acc.sum += v;
+        ++acc.count;
+    }
+    for (size_t g = 0; g < groups.size(); ++g) {
+        if (groups[g].count == 0) continue;
+        SessionAggregate& agg = result[(*names)[g]];
+        agg.count = groups[g].count;
+        agg.mean = groups[g].sum / groups[g].count;
+        agg.min = groups[g].lo;
+        agg.max = groups[g].hi;
+    }
+    return result;
+}
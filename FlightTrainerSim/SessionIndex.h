@@ -0,0 +1,99 @@
+// File: SessionIndex.h
+#ifndef SESSIONINDEX_H
+#define SESSIONINDEX_H
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SessionEntry {
+    std::string sessionFile, traineeId, aircraftModel, scenarioName;
+    int64_t startTimeMs = 0;
+    double flightTime = 0.0;
+    double overallScore = 0.0;
+    std::map<std::string, double> categoryScores;
+};
+
+// Empty strings match anything.
+struct SessionFilter {
+    std::string traineeId, aircraftModel, scenarioName;
+    int64_t fromTimeMs = std::numeric_limits<int64_t>::min();
+    int64_t toTimeMs = std::numeric_limits<int64_t>::max();
+    double minOverallScore = -std::numeric_limits<double>::infinity();
+};
+
+struct SessionAggregate {
+    size_t count = 0;
+    double mean = 0.0, min = 0.0, max = 0.0;
+};
+
+enum class SessionGroupBy { Trainee, Aircraft, Scenario };
+
+// Per-session metadata and debrief scores kept column-wise. Strings are dictionary-encoded, so
+// filters compare small integers and a full scan touches only the columns a query needs. On disk
+// the columns are followed by sessions appended one record at a time since the last save();
+// load() folds those into the columns.
+class SessionIndex {
+public:
+    static constexpr const char* kOverallColumn = "Overall";
+    static constexpr const char* kFlightTimeColumn = "Flight Time";
+
+    SessionIndex() = default;
+    void clear();
+    void add(const SessionEntry& entry);
+    size_t size() const { return m_startTime.size(); }
+    SessionEntry entry(size_t row) const;
+    const std::vector<std::string>& categories() const { return m_categories.strings; }
+
+    // A trailing record cut short by an interrupted append is skipped; see appendToFile().
+    bool load(const std::string& path);
+    // Writes the columns alone, folding in any appended records.
+    bool save(const std::string& path) const;
+    // Appends one record after the last complete one, creating the file if missing. The tail of an
+    // interrupted append is cut off first, so it cannot shift the records that follow it.
+    static bool appendToFile(const std::string& path, const SessionEntry& entry);
+
+    std::vector<size_t> select(const SessionFilter& filter) const;
+    SessionAggregate aggregate(const std::string& column, const SessionFilter& filter) const;
+    std::map<std::string, SessionAggregate> aggregateBy(SessionGroupBy group, const std::string& column,
+                                                        const SessionFilter& filter) const;
+
+private:
+    struct Dictionary {
+        std::vector<std::string> strings;
+        std::unordered_map<std::string, uint32_t> ids;
+        uint32_t intern(const std::string& value);
+        uint32_t find(const std::string& value) const;
+        void clear() { strings.clear(); ids.clear(); }
+        // Rebuilds ids after strings were read; false on a repeated string.
+        bool index();
+    };
+
+    Dictionary m_trainees, m_aircraft, m_scenarios, m_categories;
+    std::vector<uint32_t> m_traineeCol, m_aircraftCol, m_scenarioCol;
+    std::vector<int64_t> m_startTime;
+    std::vector<float> m_flightTime, m_overall;
+    std::vector<std::vector<float>> m_categoryCols;
+    std::vector<uint32_t> m_fileOffsets{0};
+    std::string m_fileBlob;
+    // File length up to the end of the last complete record, as of load().
+    size_t m_loadedBytes = 0;
+
+    struct ResolvedFilter {
+        bool matchesNothing = false;
+        uint32_t trainee, aircraft, scenario;
+        int64_t fromTimeMs, toTimeMs;
+        float minOverall;
+    };
+    static constexpr uint32_t kAny = std::numeric_limits<uint32_t>::max();
+
+    ResolvedFilter resolve(const SessionFilter& filter) const;
+    bool matches(const ResolvedFilter& f, size_t row) const;
+    const float* column(const std::string& name) const;
+    bool valid() const;
+};
+
+#endif
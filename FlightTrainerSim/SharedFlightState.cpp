@@ -0,0 +1,195 @@
+// File: SharedFlightState.cpp
+#include "SharedFlightState.h"
+#include <QSharedMemory>
+#include <QString>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char kSegmentMagic[8] = { 'F', 'T', 'S', 'S', 'H', 'M', '\0', '\1' };
+    constexpr size_t kPayloadWords = (sizeof(SharedFlightState) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    constexpr unsigned kMaxReadAttempts = 64;
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory atomics must be address-free");
+
+    int64_t currentProcessId() {
+#if defined(_WIN32)
+        return static_cast<int64_t>(GetCurrentProcessId());
+#else
+        return static_cast<int64_t>(getpid());
+#endif
+    }
+
+    bool processAlive(int64_t pid) {
+#if defined(_WIN32)
+        HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+        if (!process) return false;
+        DWORD exitCode = 0;
+        const bool alive = GetExitCodeProcess(process, &exitCode) && exitCode == STILL_ACTIVE;
+        CloseHandle(process);
+        return alive;
+#else
+        return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+    }
+}
+
+// The mapped layout. Magic, version and size are written once before the first publication;
+// owner is the publishing process, 0 once it closes.
+struct SharedStateSegment {
+    char magic[8];
+    uint32_t version;
+    uint32_t payloadSize;
+    std::atomic<int64_t> owner;
+    alignas(64) std::atomic<uint64_t> sequence;
+    alignas(64) std::atomic<uint64_t> words[kPayloadWords];
+};
+
+int64_t SharedFlightState::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+SharedStatePublisher::SharedStatePublisher() : m_segment(nullptr) {}
+
+SharedStatePublisher::~SharedStatePublisher() {
+    close();
+}
+
+bool SharedStatePublisher::open(const std::string& key) {
+    close();
+    m_memory = std::make_unique<QSharedMemory>(QString::fromStdString(key));
+    const bool created = m_memory->create(sizeof(SharedStateSegment));
+    if (!created) {
+        // A crashed run can leave the segment behind; reuse it if it is big enough.
+        if (m_memory->error() != QSharedMemory::AlreadyExists || !m_memory->attach() ||
+            m_memory->size() < static_cast<qsizetype>(sizeof(SharedStateSegment))) {
+            std::fprintf(stderr, "Cannot publish shared state '%s': %s\n", key.c_str(), qPrintable(m_memory->errorString()));
+            m_memory.reset();
+            return false;
+        }
+    }
+    auto* segment = static_cast<SharedStateSegment*>(m_memory->data());
+    // A segment in another layout has no owner field to trust; start it over.
+    if (created || std::memcmp(segment->magic, kSegmentMagic, sizeof(kSegmentMagic)) != 0 || segment->version != kSharedFlightStateVersion) {
+        segment = new (segment) SharedStateSegment;
+        segment->owner.store(0, std::memory_order_relaxed);
+    }
+    // One writer per segment: the seqlock cannot keep two apart. Take over only from a process
+    // that has gone, and only once if several try at the same time.
+    int64_t owner = segment->owner.load(std::memory_order_acquire);
+    if ((owner != 0 && processAlive(owner)) || !segment->owner.compare_exchange_strong(owner, currentProcessId())) {
+        std::fprintf(stderr, "Cannot publish shared state '%s': another simulator (process %lld) publishes it\n", key.c_str(),
+                     static_cast<long long>(segment->owner.load(std::memory_order_relaxed)));
+        m_memory.reset();
+        return false;
+    }
+    m_segment = segment;
+    m_segment->sequence.store(0, std::memory_order_relaxed);
+    for (auto& word : m_segment->words) word.store(0, std::memory_order_relaxed);
+    std::memcpy(m_segment->magic, kSegmentMagic, sizeof(kSegmentMagic));
+    m_segment->version = kSharedFlightStateVersion;
+    m_segment->payloadSize = sizeof(SharedFlightState);
+    m_state = SharedFlightState();
+    write();
+    return true;
+}
+
+void SharedStatePublisher::close() {
+    if (m_segment) {
+        m_state.status = SharedSimStatus::Stopped;
+        write();
+        int64_t self = currentProcessId();
+        m_segment->owner.compare_exchange_strong(self, 0, std::memory_order_release);
+    }
+    m_segment = nullptr;
+    m_memory.reset();
+}
+
+void SharedStatePublisher::setSession(const std::string& aircraftModel, const std::string& scenarioName) {
+    std::snprintf(m_state.aircraftModel, sizeof(m_state.aircraftModel), "%s", aircraftModel.c_str());
+    std::snprintf(m_state.scenarioName, sizeof(m_state.scenarioName), "%s", scenarioName.c_str());
+}
+
+void SharedStatePublisher::setStatus(SharedSimStatus status) {
+    m_state.status = status;
+    if (m_segment) write();
+}
+
+void SharedStatePublisher::publish(const FlightRecord& record) {
+    if (!m_segment) return;
+    m_state.record = record;
+    write();
+}
+
+void SharedStatePublisher::write() {
+    ++m_state.tick;
+    m_state.publishNs = SharedFlightState::nowNs();
+    uint64_t words[kPayloadWords] = {};
+    std::memcpy(words, &m_state, sizeof(m_state));
+
+    const uint64_t sequence = m_segment->sequence.load(std::memory_order_relaxed);
+    m_segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kPayloadWords; ++i) m_segment->words[i].store(words[i], std::memory_order_relaxed);
+    m_segment->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+SharedStateReader::SharedStateReader() : m_segment(nullptr) {}
+
+SharedStateReader::~SharedStateReader() {
+    detach();
+}
+
+bool SharedStateReader::attach(const std::string& key) {
+    detach();
+    m_memory = std::make_unique<QSharedMemory>(QString::fromStdString(key));
+    if (!m_memory->attach(QSharedMemory::ReadOnly)) {
+        m_memory.reset();
+        return false;
+    }
+    const auto* segment = static_cast<const SharedStateSegment*>(m_memory->constData());
+    if (m_memory->size() < static_cast<qsizetype>(sizeof(SharedStateSegment)) ||
+        std::memcmp(segment->magic, kSegmentMagic, sizeof(kSegmentMagic)) != 0 || segment->version != kSharedFlightStateVersion || segment->payloadSize != sizeof(SharedFlightState)) {
+        std::fprintf(stderr, "Shared state '%s' has an incompatible layout\n", key.c_str());
+        m_memory.reset();
+        return false;
+    }
+    m_segment = segment;
+    return true;
+}
+
+void SharedStateReader::detach() {
+    m_segment = nullptr;
+    m_memory.reset();
+}
+
+bool SharedStateReader::read(SharedFlightState& out, unsigned* retries) const {
+    if (!m_segment) return false;
+    uint64_t words[kPayloadWords];
+    for (unsigned attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+        const uint64_t before = m_segment->sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            for (size_t i = 0; i < kPayloadWords; ++i) words[i] = m_segment->words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_segment->sequence.load(std::memory_order_relaxed) == before) {
+                std::memcpy(&out, words, sizeof(out));
+                return true;
+            }
+        }
+        if (retries) ++*retries;
+        std::this_thread::yield();
+    }
+    return false;
+}
@@ -0,0 +1,82 @@
+// File: SharedFlightState.h
+#ifndef SHAREDFLIGHTSTATE_H
+#define SHAREDFLIGHTSTATE_H
+
+#include "FlightRecorder.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class QSharedMemory;
+struct SharedStateSegment;
+
+enum class SharedSimStatus : uint32_t { Stopped = 0, Running = 1, Paused = 2 };
+
+// What the engine publishes every tick. Plain data: readers get a copy, never a pointer into the segment.
+struct SharedFlightState {
+    uint64_t tick = 0;              // publications since the segment was created
+    int64_t publishNs = 0;          // steady clock; comparable between processes on the same host
+    SharedSimStatus status = SharedSimStatus::Stopped;
+    uint32_t reserved = 0;
+    FlightRecord record{};
+    char aircraftModel[48] = {};
+    char scenarioName[48] = {};
+
+    // Nanoseconds on the same steady clock, for staleness measurements.
+    static int64_t nowNs();
+};
+
+constexpr uint32_t kSharedFlightStateVersion = 2;
+constexpr const char* kDefaultSharedStateKey = "FlightTrainerSim.state";
+
+// Single writer. The payload lives in a shared-memory segment as lock-free atomic words guarded by
+// a seqlock: publish() bumps the sequence to odd, stores the words and bumps it back to even, so
+// it never waits for readers and readers never block it.
+class SharedStatePublisher {
+public:
+    SharedStatePublisher();
+    ~SharedStatePublisher();
+    SharedStatePublisher(const SharedStatePublisher&) = delete;
+    SharedStatePublisher& operator=(const SharedStatePublisher&) = delete;
+
+    // Creates the segment, or takes over one left behind by a run that has exited. Fails if
+    // another live process publishes to it.
+    bool open(const std::string& key);
+    void close();
+    bool isOpen() const { return m_segment != nullptr; }
+
+    void setSession(const std::string& aircraftModel, const std::string& scenarioName);
+    void setStatus(SharedSimStatus status);
+    void publish(const FlightRecord& record);
+
+private:
+    void write();
+
+    std::unique_ptr<QSharedMemory> m_memory;
+    SharedStateSegment* m_segment;
+    SharedFlightState m_state;
+};
+
+// Any number of readers in any local process.
+class SharedStateReader {
+public:
+    SharedStateReader();
+    ~SharedStateReader();
+    SharedStateReader(const SharedStateReader&) = delete;
+    SharedStateReader& operator=(const SharedStateReader&) = delete;
+
+    // Fails until a publisher has created the segment; callers retry.
+    bool attach(const std::string& key);
+    void detach();
+    bool isAttached() const { return m_segment != nullptr; }
+
+    // Copies the latest consistent state. Returns false if the writer kept the sequence busy for
+    // every attempt; `retries` counts torn reads that were discarded.
+    bool read(SharedFlightState& out, unsigned* retries = nullptr) const;
+
+private:
+    std::unique_ptr<QSharedMemory> m_memory;
+    const SharedStateSegment* m_segment;
+};
+
+#endif
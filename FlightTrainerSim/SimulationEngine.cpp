@@ -1,21 +1,67 @@
 // File: SimulationEngine.cpp - WITH AUDIO
 #include "SimulationEngine.h"
+#include "FrameArena.h"
 #include "GlobalConfig.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+#include "NetSession.h"
+#include "PerformanceEnvelope.h"
+#include "UdpTransport.h"
+#include <QDateTime>
+#include <QDir>
+#include <QHostInfo>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // The debrief history always has room for this much more flight, topped up between ticks.
+    constexpr double kHistoryLeadSeconds = 600.0;
+    constexpr int kHistoryCheckMs = 60000;
+}
 
 SimulationEngine::SimulationEngine(QObject* parent)
     : QObject(parent)
     , m_environment(std::make_unique<Environment>())
     , m_metrics(std::make_unique<FlightMetrics>())
     , m_audioSystem(std::make_unique<AudioSystem>(this))
+    , m_recorder(std::make_unique<FlightRecorder>())
+    , m_statePublisher(std::make_unique<SharedStatePublisher>())
+    , m_netTimer(std::make_unique<QTimer>(this))
     , m_updateTimer(std::make_unique<QTimer>(this))
+    , m_historyTimer(std::make_unique<QTimer>(this))
     , m_isRunning(false)
     , m_isPaused(false)
-    , m_simulationTime(0.0) {
+    , m_simulationTime(0.0)
+    , m_lastScenarioState(ScenarioState::PreFlight)
+    , m_lastProgress(0.0)
+    , m_sessionStartMs(0)
+    , m_lastTickNs(0)
+    , m_audioGearDown(true)
+    , m_audioFlapsMoving(false)
+    , m_audioFlaps(0.0)
+    , m_configVersion(0)
+    , m_tickNs(0.0)
+    , m_inputAxes(0)
+    , m_netLookupId(-1) {
 
-    auto& config = GlobalConfig::instance();
-    int updateIntervalMs = static_cast<int>(1000.0 / config.updateRateHz());
-    m_updateTimer->setInterval(updateIntervalMs);
+    applyConfig(GlobalConfig::instance().snapshot());
+    // Instructor stations and extra displays map this segment; see SharedStateReader.
+    const std::string& stateKey = GlobalConfig::instance().sharedStateKey();
+    if (!stateKey.empty()) m_statePublisher->open(stateKey);
+    m_updateTimer->setTimerType(Qt::PreciseTimer);
+    m_clock.start();
     connect(m_updateTimer.get(), &QTimer::timeout, this, &SimulationEngine::updateSimulation);
+    // Network I/O runs on its own timer so traffic keeps moving while we are paused or stopped.
+    m_netTimer->setTimerType(Qt::PreciseTimer);
+    m_netTimer->setInterval(10);
+    connect(m_netTimer.get(), &QTimer::timeout, this, &SimulationEngine::updateNetwork);
+    m_historyTimer->setInterval(kHistoryCheckMs);
+    connect(m_historyTimer.get(), &QTimer::timeout, this, &SimulationEngine::reserveHistory);
+}
+
+SimulationEngine::~SimulationEngine() {
+    if (m_netLookupId >= 0) QHostInfo::abortHostLookup(m_netLookupId);
+    if (m_netSession) m_netSession->leave();
 }
 
 void SimulationEngine::start() {
@@ -23,7 +69,19 @@ void SimulationEngine::start() {
 
     m_isRunning = true;
     m_isPaused = false;
+    m_audioGearDown = m_activeAircraft->controls().gearDown;
+    m_audioFlaps = m_activeAircraft->controls().flaps;
+    if (m_simulationTime == 0.0) m_sessionStartMs = QDateTime::currentMSecsSinceEpoch();
+    reserveHistory();
+    if (!m_recorder->isOpen()) startRecording();
+    if (!m_netSession) startNetSession();
+    if (!m_inputPoller) startInput();
+    if (m_inputPoller) m_inputPoller->setPaused(false);
+    if (TraceRecorder::enabled()) TraceRecorder::instance().restartHitchClock();
+    m_statePublisher->setSession(m_activeAircraft->flightModel()->getModelName(), m_scenario->name());
+    m_statePublisher->setStatus(SharedSimStatus::Running);
     m_updateTimer->start();
+    m_historyTimer->start();
     emit stateChanged("Running");
 }
 
@@ -35,9 +93,14 @@ void SimulationEngine::pause() {
     if (m_isPaused) {
         m_updateTimer->stop();
         m_audioSystem->stopAll();
+        if (m_inputPoller) m_inputPoller->setPaused(true);
+        m_statePublisher->setStatus(SharedSimStatus::Paused);
         emit stateChanged("Paused");
     }
     else {
+        if (TraceRecorder::enabled()) TraceRecorder::instance().restartHitchClock();
+        if (m_inputPoller) m_inputPoller->setPaused(false);
+        m_statePublisher->setStatus(SharedSimStatus::Running);
         m_updateTimer->start();
         emit stateChanged("Running");
     }
@@ -47,53 +110,138 @@ void SimulationEngine::stop() {
     m_isRunning = false;
     m_isPaused = false;
     m_updateTimer->stop();
+    m_historyTimer->stop();
     m_audioSystem->stopAll();
+    if (m_inputPoller) m_inputPoller->setPaused(true);
+    m_statePublisher->setStatus(SharedSimStatus::Stopped);
+    m_recorder->close();
     emit stateChanged("Stopped");
 }
 
 void SimulationEngine::reset() {
     stop();
 
-    if (m_activeAircraft) m_activeAircraft->reset();
     if (m_scenario) m_scenario->reset();
+    placeAircraft();
     if (m_metrics) m_metrics->reset();
+    if (m_pilot) m_pilot->reset();
 
     m_simulationTime = 0.0;
+    resetRenderStates();
     emit stateChanged("Reset");
     emit simulationUpdated();
 }
 
 void SimulationEngine::setActiveAircraft(std::unique_ptr<Aircraft> aircraft) {
     m_activeAircraft = std::move(aircraft);
+    if (!m_isRunning) placeAircraft();
+    resetRenderStates();
 }
 
 void SimulationEngine::setScenario(std::unique_ptr<TrainingScenario> scenario) {
     m_scenario = std::move(scenario);
     if (m_scenario) m_scenario->reset();
+    if (!m_isRunning) {
+        placeAircraft();
+        resetRenderStates();
+    }
+}
+
+void SimulationEngine::placeAircraft() {
+    if (!m_activeAircraft) return;
+    const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+    m_activeAircraft->setEnvelope(&PerformanceEnvelope::forModel(*m_activeAircraft->flightModel(), config));
+    if (!m_scenario) m_activeAircraft->reset();
+    else if (!m_scenario->placeAircraft(*m_activeAircraft, config)) emit warningIssued("CANNOT TRIM FOR SCENARIO START");
 }
 
 void SimulationEngine::setControlInputs(const ControlInputs& controls) {
-    if (m_activeAircraft) {
-        m_activeAircraft->setControls(controls);
+    if (!m_activeAircraft) return;
+    ControlInputs merged = controls;
+    const ControlInputs& current = m_activeAircraft->controls();
+    auto owned = [this](InputAxis axis) { return (m_inputAxes & (1u << static_cast<unsigned>(axis))) != 0; };
+    if (owned(InputAxis::Elevator)) merged.elevator = current.elevator;
+    if (owned(InputAxis::Aileron)) merged.aileron = current.aileron;
+    if (owned(InputAxis::Rudder)) merged.rudder = current.rudder;
+    if (owned(InputAxis::Throttle)) merged.throttle = current.throttle;
+    if (m_pilot) {
+        const uint32_t axes = m_pilot->ownedAxes();
+        if (axes & controlAxisBit(ControlAxis::Elevator)) merged.elevator = current.elevator;
+        if (axes & controlAxisBit(ControlAxis::Aileron)) merged.aileron = current.aileron;
+        if (axes & controlAxisBit(ControlAxis::Rudder)) merged.rudder = current.rudder;
+        if (axes & controlAxisBit(ControlAxis::Throttle)) merged.throttle = current.throttle;
+        if (axes & controlAxisBit(ControlAxis::Flaps)) merged.flaps = current.flaps;
+        if (axes & controlAxisBit(ControlAxis::Gear)) merged.gearDown = current.gearDown;
     }
+    m_activeAircraft->setControls(merged);
+}
+
+void SimulationEngine::setInputDevice(std::unique_ptr<InputDevice> device) {
+    m_inputPoller.reset();
+    m_inputAxes = 0;
+    if (!device) return;
+    m_inputPoller = std::make_unique<InputPoller>(std::move(device));
+    const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+    m_inputPoller->setRateHz(config.inputPollHz);
+    m_inputPoller->setShaping({ static_cast<float>(config.inputDeadzone), static_cast<float>(config.inputExpo) });
+    m_inputPoller->setPaused(!m_isRunning || m_isPaused);
+    m_inputPoller->start();
+}
+
+void SimulationEngine::setPilotAgent(std::unique_ptr<PilotAgent> agent) {
+    m_pilot = std::move(agent);
+    if (m_pilot) m_pilot->reset();
 }
 
 void SimulationEngine::updateSimulation() {
     if (!m_activeAircraft || !m_scenario || m_isPaused) return;
+    TRACE_INSTANT(TraceInstant::SimulationTimer);
+    PROFILE_SCOPE(ProfileStage::Tick);
+    FrameArena::current().reset();
 
-    double deltaTime = GlobalConfig::instance().physicsTimeStep();
+    // One snapshot per tick: a reload lands between ticks, never inside one.
+    const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+    if (config.version != m_configVersion) applyConfig(config);
+    const double deltaTime = config.physicsTimeStep();
 
     // Update aircraft physics
-    m_activeAircraft->update(deltaTime);
+    const int64_t inputEventNs = applyInput();
+    if (m_pilot) {
+        ControlInputs controls = m_activeAircraft->controls();
+        m_pilot->control(*m_activeAircraft, m_scenario.get(), deltaTime, controls);
+        m_activeAircraft->setControls(controls);
+    }
+    {
+        PROFILE_SCOPE(ProfileStage::Physics);
+        m_activeAircraft->update(deltaTime, config);
+    }
+    m_previousState = m_currentState;
+    m_currentState = AircraftRenderState::capture(*m_activeAircraft, m_simulationTime + deltaTime);
+    m_lastTickNs = m_clock.nsecsElapsed();
+    // Stick movement to the first state that reflects it.
+    if (inputEventNs > 0) Profiler::recordNs(ProfileStage::InputLatency, InputDevice::nowNs() - inputEventNs);
 
     // Update scenario
-    m_scenario->update(*m_activeAircraft, deltaTime);
+    {
+        PROFILE_SCOPE(ProfileStage::Scenario);
+        m_scenario->update(*m_activeAircraft, deltaTime);
+    }
 
     // Record metrics
-    m_metrics->recordSnapshot(*m_activeAircraft, m_simulationTime);
+    {
+        PROFILE_SCOPE(ProfileStage::Metrics);
+        m_metrics->recordSnapshot(*m_activeAircraft, m_simulationTime);
+    }
+    {
+        PROFILE_SCOPE(ProfileStage::Recording);
+        recordTick();
+    }
 
     // Update audio
-    updateAudio();
+    {
+        PROFILE_SCOPE(ProfileStage::Audio);
+        updateAudio();
+    }
 
     // Check scenario completion
     if (m_scenario->isCompleted()) {
@@ -116,21 +264,30 @@ void SimulationEngine::updateSimulation() {
 
 void SimulationEngine::checkWarnings() {
     if (!m_activeAircraft) return;
+    // Literal data: emitting these every tick copies a pointer, not the text.
+    static const QString kStallWarning = QStringLiteral("STALL WARNING");
+    static const QString kLowFuelWarning = QStringLiteral("LOW FUEL");
+    static const QString kAltitudeWarning = QStringLiteral("ALTITUDE WARNING");
+    static const QString kOverspeedWarning = QStringLiteral("OVERSPEED");
 
     if (m_activeAircraft->isStalled()) {
-        emit warningIssued("STALL WARNING");
+        emit warningIssued(kStallWarning);
         m_audioSystem->playSound(SoundType::Stall);
     }
     else {
         m_audioSystem->stopSound(SoundType::Stall);
     }
 
+    if (m_activeAircraft->isOverspeed()) {
+        emit warningIssued(kOverspeedWarning);
+    }
+
     if (m_activeAircraft->fuel() < 100.0) {
-        emit warningIssued("LOW FUEL");
+        emit warningIssued(kLowFuelWarning);
     }
 
     if (m_activeAircraft->altitude() < 50.0 && !m_activeAircraft->isOnGround()) {
-        emit warningIssued("ALTITUDE WARNING");
+        emit warningIssued(kAltitudeWarning);
         m_audioSystem->playWarning();
     }
 }
@@ -143,4 +300,181 @@ void SimulationEngine::updateAudio() {
 
     // Update wind noise based on speed
     m_audioSystem->setWindVolume(m_activeAircraft->speed());
+
+    // Gear and flap transitions
+    const ControlInputs& controls = m_activeAircraft->controls();
+    if (controls.gearDown != m_audioGearDown) {
+        m_audioGearDown = controls.gearDown;
+        m_audioSystem->playSound(m_audioGearDown ? SoundType::GearDown : SoundType::GearUp);
+    }
+    const bool flapsMoving = std::abs(controls.flaps - m_audioFlaps) > 1e-4;
+    if (flapsMoving && !m_audioFlapsMoving) m_audioSystem->playSound(SoundType::FlapsMove);
+    else if (!flapsMoving && m_audioFlapsMoving) m_audioSystem->stopSound(SoundType::FlapsMove);
+    m_audioFlapsMoving = flapsMoving;
+    m_audioFlaps = controls.flaps;
+}
+
+void SimulationEngine::startRecording() {
+    auto& config = GlobalConfig::instance();
+    if (!config.recordFlights()) return;
+
+    QDir dir(QString::fromStdString(config.recordingDirectory()));
+    const QDateTime now = QDateTime::currentDateTime();
+    const QString fileName = now.toString("'flight_'yyyyMMdd_HHmmss'.fdr'");
+
+    FlightSessionInfo info;
+    info.aircraftModel = m_activeAircraft->flightModel()->getModelName();
+    info.scenarioName = m_scenario->name();
+    info.traineeId = config.traineeId();
+    info.timeStep = config.physicsTimeStep();
+    info.startTimeMs = now.toMSecsSinceEpoch();
+    m_lastScenarioState = m_scenario->currentState();
+    m_lastProgress = m_scenario->getProgress();
+
+    if (!dir.mkpath(".") || !m_recorder->open(dir.filePath(fileName).toStdString(), info)) {
+        emit warningIssued("FLIGHT RECORDER UNAVAILABLE");
+    }
+}
+
+void SimulationEngine::startNetSession() {
+    auto& config = GlobalConfig::instance();
+    if (config.netHostPort() > 0) {
+        openNetSession(0);
+        return;
+    }
+    if (config.netJoinAddress().empty() || m_netLookupId >= 0) return;
+
+    // Resolved off the GUI thread; the session opens when the lookup answers.
+    const QString address = QString::fromStdString(config.netJoinAddress());
+    m_netLookupId = UdpTransport::resolve(address, this, [this, address](NetEndpoint hostEndpoint) {
+        m_netLookupId = -1;
+        if (hostEndpoint == 0) {
+            emit warningIssued("MULTIPLAYER: CANNOT RESOLVE " + address);
+            return;
+        }
+        if (!m_netSession) openNetSession(hostEndpoint);
+    });
+    if (m_netLookupId < 0) emit warningIssued("MULTIPLAYER: CANNOT RESOLVE " + address);
+}
+
+void SimulationEngine::openNetSession(NetEndpoint hostEndpoint) {
+    auto& config = GlobalConfig::instance();
+    const bool host = hostEndpoint == 0;
+    if (!m_activeAircraft) return;
+    auto transport = std::make_unique<UdpTransport>();
+    if (!transport->bind(host ? static_cast<quint16>(config.netHostPort()) : 0)) {
+        emit warningIssued("MULTIPLAYER UNAVAILABLE: " + transport->errorString());
+        return;
+    }
+    m_netTransport = std::move(transport);
+    m_netSession = std::make_unique<NetSession>(*m_netTransport, host ? NetSession::Role::Host : NetSession::Role::Client,
+                                                config.callsign(), m_activeAircraft->flightModel()->getModelName());
+    if (!host) m_netSession->connectTo(hostEndpoint);
+    m_netTimer->start();
+}
+
+void SimulationEngine::startInput() {
+    const std::string& path = GlobalConfig::instance().inputDevice();
+    if (path.empty()) return;
+#ifdef __linux__
+    std::string device = path;
+    if (device == "auto") {
+        const std::vector<std::string> found = EvdevInputDevice::findJoysticks();
+        if (found.empty()) {
+            emit warningIssued("NO JOYSTICK FOUND");
+            return;
+        }
+        device = found.front();
+    }
+    std::string error;
+    std::unique_ptr<EvdevInputDevice> stick = EvdevInputDevice::open(device, error);
+    if (!stick) {
+        emit warningIssued("JOYSTICK UNAVAILABLE: " + QString::fromStdString(error));
+        return;
+    }
+    setInputDevice(std::move(stick));
+#else
+    emit warningIssued("JOYSTICK INPUT NEEDS LINUX EVDEV");
+#endif
+}
+
+// Takes the newest stick reading due by now and returns when it was made, or 0 if nothing new
+// arrived. Only the axes the device has are overridden; an unplugged stick hands them back to the panel.
+int64_t SimulationEngine::applyInput() {
+    if (!m_inputPoller) return 0;
+    if (!m_inputPoller->device().connected()) m_inputAxes = 0;
+    InputSample sample;
+    if (!m_inputPoller->takeUntil(InputDevice::nowNs(), sample)) return 0;
+    m_inputAxes = sample.axisMask;
+    ControlInputs controls = m_activeAircraft->controls();
+    auto take = [&sample](InputAxis axis, double& target) {
+        if (sample.axisMask & (1u << static_cast<unsigned>(axis))) target = sample.axes[static_cast<size_t>(axis)];
+    };
+    take(InputAxis::Elevator, controls.elevator);
+    take(InputAxis::Aileron, controls.aileron);
+    take(InputAxis::Rudder, controls.rudder);
+    take(InputAxis::Throttle, controls.throttle);
+    m_activeAircraft->setControls(controls);
+    return sample.eventNs;
+}
+
+void SimulationEngine::updateNetwork() {
+    m_netSession->update(m_clock.nsecsElapsed() / 1e9, GlobalConfig::instance().snapshot().netSendRateHz);
+}
+
+void SimulationEngine::reserveHistory() {
+    m_metrics->reserve(kHistoryLeadSeconds, GlobalConfig::instance().physicsTimeStep());
+}
+
+void SimulationEngine::traffic(qint64 nowNs, std::vector<TrafficAircraft>& out) const {
+    if (m_netSession) m_netSession->traffic(nowNs / 1e9, out);
+    else out.clear();
+}
+
+void SimulationEngine::recordTick() {
+    if (!m_recorder->isOpen() && !m_statePublisher->isOpen() && !m_netSession) return;
+
+    uint32_t events = 0;
+    if (m_activeAircraft->fuel() < 100.0) events |= FlightEvent::LowFuel;
+    if (m_activeAircraft->altitude() < 50.0 && !m_activeAircraft->isOnGround()) events |= FlightEvent::AltitudeWarning;
+    if (m_scenario->currentState() != m_lastScenarioState) events |= FlightEvent::StateChanged;
+    if (m_scenario->getProgress() != m_lastProgress) events |= FlightEvent::WaypointReached;
+    m_lastScenarioState = m_scenario->currentState();
+    m_lastProgress = m_scenario->getProgress();
+
+    const FlightRecord record = FlightRecorder::capture(*m_activeAircraft, *m_scenario, m_simulationTime, events);
+    if (m_recorder->isOpen()) m_recorder->push(record);
+    m_statePublisher->publish(record);
+    if (m_netSession) m_netSession->setLocalState(record);
+}
+
+void SimulationEngine::resetRenderStates() {
+    if (m_activeAircraft) m_currentState = AircraftRenderState::capture(*m_activeAircraft, m_simulationTime);
+    m_previousState = m_currentState;
+    m_lastTickNs = m_clock.nsecsElapsed();
+}
+
+void SimulationEngine::applyConfig(const ConfigSnapshot& config) {
+    // Retime the tick timer when the rate changes; the new step applies from this tick on.
+    m_configVersion = config.version;
+    m_tickNs = config.physicsTimeStep() * 1e9;
+    const int updateIntervalMs = std::max(1, static_cast<int>(1000.0 / config.updateRateHz));
+    if (m_updateTimer->interval() != updateIntervalMs) m_updateTimer->setInterval(updateIntervalMs);
+    if (m_inputPoller) {
+        m_inputPoller->setRateHz(config.inputPollHz);
+        m_inputPoller->setShaping({ static_cast<float>(config.inputDeadzone), static_cast<float>(config.inputExpo) });
+    }
+}
+
+AircraftRenderState SimulationEngine::renderState(qint64 nowNs) const {
+    if (!m_isRunning || m_isPaused) return m_currentState;
+    const double alpha = std::clamp((nowNs - m_lastTickNs) / m_tickNs, 0.0, 1.0);
+    return AircraftRenderState::interpolate(m_previousState, m_currentState, alpha);
+}
+
+qint64 SimulationEngine::renderStateClockNs(qint64 nowNs) const {
+    // A held state is not tied to any tick; traffic keeps moving, so show it as of now.
+    if (!m_isRunning || m_isPaused) return nowNs;
+    const double alpha = std::clamp((nowNs - m_lastTickNs) / m_tickNs, 0.0, 1.0);
+    return m_lastTickNs - static_cast<qint64>((1.0 - alpha) * m_tickNs);
 }
\ No newline at end of file
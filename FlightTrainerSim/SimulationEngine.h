@@ -8,14 +8,26 @@
 #include "FlightMetrics.h"
 #include "AircraftFactory.h"
 #include "AudioSystem.h"
+#include "FlightRecorder.h"
+#include "SharedFlightState.h"
+#include "RenderState.h"
+#include "GlobalConfig.h"
+#include "InputPoller.h"
+#include "NetSession.h"
+#include "PilotAgent.h"
 #include <QObject>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <memory>
+#include <vector>
+
+class UdpTransport;
 
 class SimulationEngine : public QObject {
     Q_OBJECT
 public:
     explicit SimulationEngine(QObject* parent = nullptr);
+    ~SimulationEngine() override;
 
     void start();
     void pause();
@@ -30,12 +42,31 @@ public:
     TrainingScenario* scenario() const { return m_scenario.get(); }
     FlightMetrics* metrics() const { return m_metrics.get(); }
     AudioSystem* audio() const { return m_audioSystem.get(); }
+    FlightRecorder* recorder() const { return m_recorder.get(); }
+    NetSession* netSession() const { return m_netSession.get(); }
+    InputPoller* inputPoller() const { return m_inputPoller.get(); }
+    PilotAgent* pilotAgent() const { return m_pilot.get(); }
 
     void setActiveAircraft(std::unique_ptr<Aircraft> aircraft);
     void setScenario(std::unique_ptr<TrainingScenario> scenario);
+    // Axes a connected stick or the pilot agent owns are kept; the panel still sets everything else.
     void setControlInputs(const ControlInputs& controls);
+    // Starts polling `device` in place of any stick opened from the --input option.
+    void setInputDevice(std::unique_ptr<InputDevice> device);
+    // Agent that flies its axes every tick, after the stick and before physics. Null disengages it.
+    void setPilotAgent(std::unique_ptr<PilotAgent> agent);
 
     double simulationTime() const { return m_simulationTime; }
+    qint64 sessionStartTimeMs() const { return m_sessionStartMs; }
+
+    // Monotonic clock shared with the render scheduler, and the aircraft state blended between the
+    // last two physics ticks for that instant. Rendering runs one tick behind physics.
+    qint64 clockNs() const { return m_clock.nsecsElapsed(); }
+    AircraftRenderState renderState(qint64 nowNs) const;
+    // The instant on that clock which renderState(nowNs) shows; traffic drawn with it is sampled here.
+    qint64 renderStateClockNs(qint64 nowNs) const;
+    // Other aircraft in a multiplayer session, dead-reckoned to nowNs on the same clock.
+    void traffic(qint64 nowNs, std::vector<TrafficAircraft>& out) const;
 
 signals:
     void simulationUpdated();
@@ -43,22 +74,59 @@ signals:
     void warningIssued(const QString& message);
     void stateChanged(const QString& state);
 
-private slots:
+public slots:
+    // One physics tick. The update timer calls it while running; headless tools call it directly.
     void updateSimulation();
 
+private slots:
+    void updateNetwork();
+    void reserveHistory();
+
 private:
     std::unique_ptr<Aircraft> m_activeAircraft;
     std::unique_ptr<Environment> m_environment;
     std::unique_ptr<TrainingScenario> m_scenario;
     std::unique_ptr<FlightMetrics> m_metrics;
     std::unique_ptr<AudioSystem> m_audioSystem;
+    std::unique_ptr<FlightRecorder> m_recorder;
+    std::unique_ptr<SharedStatePublisher> m_statePublisher;
+    std::unique_ptr<UdpTransport> m_netTransport;
+    std::unique_ptr<NetSession> m_netSession;
+    std::unique_ptr<QTimer> m_netTimer;
+    std::unique_ptr<InputPoller> m_inputPoller;
+    std::unique_ptr<PilotAgent> m_pilot;
     std::unique_ptr<QTimer> m_updateTimer;
+    std::unique_ptr<QTimer> m_historyTimer;
+    QElapsedTimer m_clock;
 
     bool m_isRunning, m_isPaused;
     double m_simulationTime;
+    ScenarioState m_lastScenarioState;
+    double m_lastProgress;
+    qint64 m_sessionStartMs;
+    AircraftRenderState m_previousState, m_currentState;
+    qint64 m_lastTickNs;
+    bool m_audioGearDown, m_audioFlapsMoving;
+    double m_audioFlaps;
+    uint64_t m_configVersion;
+    double m_tickNs;
+    uint32_t m_inputAxes;
+    // QHostInfo lookup of the join address in flight, or -1.
+    int m_netLookupId;
 
+    void applyConfig(const ConfigSnapshot& config);
     void checkWarnings();
     void updateAudio();
+    void startRecording();
+    void startNetSession();
+    // Binds and starts the session; joins hostEndpoint if it is not 0, otherwise hosts.
+    void openNetSession(NetEndpoint hostEndpoint);
+    void startInput();
+    int64_t applyInput();
+    void recordTick();
+    void resetRenderStates();
+    // Reset, or trimmed in the scenario's initial condition if it has one.
+    void placeAircraft();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,289 @@
+// File: SoftwareRasterizer.cpp
+#include "SoftwareRasterizer.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FTS_RASTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    uint32_t lerpColor(uint32_t from, uint32_t to, float t) {
+        auto channel = [&](int shift) {
+            const float a = static_cast<float>((from >> shift) & 0xFF), b = static_cast<float>((to >> shift) & 0xFF);
+            return static_cast<uint32_t>(a + (b - a) * t + 0.5f) << shift;
+        };
+        return 0xFF000000u | channel(16) | channel(8) | channel(0);
+    }
+
+    Vec4 lerpClip(const Vec4& a, const Vec4& b, float t) {
+        return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t };
+    }
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int threadCount)
+    : m_width(0), m_height(0), m_stride(0), m_tilesX(0), m_tilesY(0)
+    , m_skyZenith(0xFF143296), m_skyHorizon(0xFF87CEEB), m_fogColor(0xFF87CEEB)
+    , m_fogStart(6000.0f), m_fogEnd(14000.0f), m_light(Vec3(0.4f, -0.3f, 0.85f).normalized())
+    , m_generation(0), m_busyWorkers(0), m_quit(false), m_nextTile(0) {
+    if (threadCount <= 0) threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 1; i < threadCount; ++i) m_workers.emplace_back(&SoftwareRasterizer::workerLoop, this);
+}
+
+SoftwareRasterizer::~SoftwareRasterizer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) worker.join();
+}
+
+void SoftwareRasterizer::beginFrame(int width, int height, const RasterCamera& camera) {
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+    if (width != m_width || height != m_height) {
+        m_width = width;
+        m_height = height;
+        m_stride = (width + 3) & ~3;
+        m_tilesX = (width + kTileSize - 1) / kTileSize;
+        m_tilesY = (height + kTileSize - 1) / kTileSize;
+        m_color.assign(static_cast<size_t>(m_stride) * height, 0xFF000000u);
+        m_depth.assign(static_cast<size_t>(m_stride) * height, 1.0f);
+        m_skyRows.resize(height);
+        m_bins.resize(static_cast<size_t>(m_tilesX) * m_tilesY);
+    }
+    m_camera = camera;
+    const float aspect = static_cast<float>(width) / height;
+    m_viewProjection = Mat4::perspective(camera.fovY, aspect, camera.nearPlane, camera.farPlane)
+                     * Mat4::lookAt(camera.eye, camera.target, camera.up);
+    m_triangles.clear();
+    for (auto& bin : m_bins) bin.clear();
+
+    // Sky fades from zenith to the haze colour at the projected horizon, matching the fog.
+    Vec3 forward = camera.target - camera.eye;
+    forward.z = 0.0f;
+    float horizonY = 0.0f, unusedX = 0.0f;
+    if (forward.length() < 1e-3f || !project(camera.eye + forward.normalized() * (camera.farPlane * 0.9f), unusedX, horizonY)) {
+        horizonY = height * 0.5f;
+    }
+    for (int y = 0; y < height; ++y) {
+        const float t = horizonY > 0.0f ? std::clamp(y / horizonY, 0.0f, 1.0f) : 1.0f;
+        m_skyRows[y] = lerpColor(m_skyZenith, m_skyHorizon, t);
+    }
+}
+
+SoftwareRasterizer::ScreenVertex SoftwareRasterizer::toScreen(const Vec4& clip) const {
+    const float invW = 1.0f / clip.w;
+    return { (clip.x * invW * 0.5f + 0.5f) * m_width,
+             (0.5f - clip.y * invW * 0.5f) * m_height,
+             clip.z * invW * 0.5f + 0.5f };
+}
+
+bool SoftwareRasterizer::project(const Vec3& world, float& screenX, float& screenY) const {
+    const Vec4 clip = m_viewProjection.transform(world);
+    if (clip.w < m_camera.nearPlane) return false;
+    const ScreenVertex s = toScreen(clip);
+    screenX = s.x;
+    screenY = s.y;
+    return true;
+}
+
+uint32_t SoftwareRasterizer::shade(uint32_t color, const Vec3& normal, float distance) const {
+    const float lambert = 0.35f + 0.65f * std::max(0.0f, normal.dot(m_light));
+    auto channel = [&](int shift) {
+        return std::min(255u, static_cast<uint32_t>(((color >> shift) & 0xFF) * lambert)) << shift;
+    };
+    const uint32_t lit = 0xFF000000u | channel(16) | channel(8) | channel(0);
+    const float fog = std::clamp((distance - m_fogStart) / (m_fogEnd - m_fogStart), 0.0f, 1.0f);
+    return fog > 0.0f ? lerpColor(lit, m_fogColor, fog) : lit;
+}
+
+void SoftwareRasterizer::drawMesh(const RasterMesh& mesh, const Mat4& model, bool cullBackFaces) {
+    const Mat4 mvp = m_viewProjection * model;
+    m_clipVerts.resize(mesh.positions.size());
+    for (size_t i = 0; i < mesh.positions.size(); ++i) m_clipVerts[i] = mvp.transform(mesh.positions[i]);
+
+    for (size_t t = 0; t < mesh.triangleCount(); ++t) {
+        const uint32_t i0 = mesh.indices[t * 3], i1 = mesh.indices[t * 3 + 1], i2 = mesh.indices[t * 3 + 2];
+        const Vec4& c0 = m_clipVerts[i0];
+        const Vec4& c1 = m_clipVerts[i1];
+        const Vec4& c2 = m_clipVerts[i2];
+        // Trivially reject triangles entirely outside one frustum plane.
+        if ((c0.x > c0.w && c1.x > c1.w && c2.x > c2.w) || (c0.x < -c0.w && c1.x < -c1.w && c2.x < -c2.w) ||
+            (c0.y > c0.w && c1.y > c1.w && c2.y > c2.w) || (c0.y < -c0.w && c1.y < -c1.w && c2.y < -c2.w) ||
+            (c0.z > c0.w && c1.z > c1.w && c2.z > c2.w)) continue;
+        const bool in0 = c0.z >= -c0.w, in1 = c1.z >= -c1.w, in2 = c2.z >= -c2.w;
+        if (!in0 && !in1 && !in2) continue;
+
+        const Vec3 p0 = model.transformPoint(mesh.positions[i0]);
+        const Vec3 e1 = model.transformPoint(mesh.positions[i1]) - p0;
+        const Vec3 e2 = model.transformPoint(mesh.positions[i2]) - p0;
+        Vec3 normal = e1.cross(e2).normalized();
+        const Vec3 centroid = p0 + (e1 + e2) * (1.0f / 3.0f);
+        const Vec3 toEye = m_camera.eye - centroid;
+        if (!cullBackFaces && normal.dot(toEye) < 0.0f) normal = normal * -1.0f;
+        const uint32_t color = shade(mesh.colors[t], normal, toEye.length());
+
+        if (in0 && in1 && in2) {
+            setupTriangle(c0, c1, c2, color, cullBackFaces);
+            continue;
+        }
+        // Clip against the near plane (z = -w) and fan the resulting polygon.
+        const Vec4* input[3] = { &c0, &c1, &c2 };
+        const bool inside[3] = { in0, in1, in2 };
+        Vec4 polygon[4];
+        int count = 0;
+        for (int k = 0; k < 3; ++k) {
+            const Vec4& a = *input[k];
+            const Vec4& b = *input[(k + 1) % 3];
+            if (inside[k]) polygon[count++] = a;
+            if (inside[k] != inside[(k + 1) % 3]) {
+                const float da = a.z + a.w, db = b.z + b.w;
+                polygon[count++] = lerpClip(a, b, da / (da - db));
+            }
+        }
+        for (int k = 1; k + 1 < count; ++k) setupTriangle(polygon[0], polygon[k], polygon[k + 1], color, cullBackFaces);
+    }
+}
+
+void SoftwareRasterizer::setupTriangle(const Vec4& v0, const Vec4& v1, const Vec4& v2, uint32_t color, bool cullBackFaces) {
+    ScreenVertex s0 = toScreen(v0), s1 = toScreen(v1), s2 = toScreen(v2);
+    float area = (s1.x - s0.x) * (s2.y - s0.y) - (s2.x - s0.x) * (s1.y - s0.y);
+    // Counter-clockwise front faces come out with negative area once Y points down.
+    if (area == 0.0f || (cullBackFaces && area > 0.0f)) return;
+    if (area < 0.0f) {
+        std::swap(s1, s2);
+        area = -area;
+    }
+
+    Triangle tri;
+    tri.minX = std::max(0, static_cast<int>(std::floor(std::min({ s0.x, s1.x, s2.x }))));
+    tri.minY = std::max(0, static_cast<int>(std::floor(std::min({ s0.y, s1.y, s2.y }))));
+    tri.maxX = std::min(m_width - 1, static_cast<int>(std::floor(std::max({ s0.x, s1.x, s2.x }))));
+    tri.maxY = std::min(m_height - 1, static_cast<int>(std::floor(std::max({ s0.y, s1.y, s2.y }))));
+    if (tri.minX > tri.maxX || tri.minY > tri.maxY) return;
+
+    // Edge functions and depth plane are pre-offset so integer pixel coordinates sample pixel centres.
+    const ScreenVertex* v[3] = { &s0, &s1, &s2 };
+    for (int e = 0; e < 3; ++e) {
+        const ScreenVertex& p = *v[e];
+        const ScreenVertex& q = *v[(e + 1) % 3];
+        tri.a[e] = p.y - q.y;
+        tri.b[e] = q.x - p.x;
+        tri.c[e] = -tri.a[e] * p.x - tri.b[e] * p.y + 0.5f * (tri.a[e] + tri.b[e]);
+    }
+    const float dx1 = s1.x - s0.x, dy1 = s1.y - s0.y, dx2 = s2.x - s0.x, dy2 = s2.y - s0.y;
+    const float dz1 = s1.z - s0.z, dz2 = s2.z - s0.z;
+    tri.dzdx = (dz1 * dy2 - dz2 * dy1) / area;
+    tri.dzdy = (dx1 * dz2 - dx2 * dz1) / area;
+    tri.z0 = s0.z - tri.dzdx * s0.x - tri.dzdy * s0.y + 0.5f * (tri.dzdx + tri.dzdy);
+    tri.color = color;
+
+    const uint32_t index = static_cast<uint32_t>(m_triangles.size());
+    m_triangles.push_back(tri);
+    for (int ty = tri.minY / kTileSize; ty <= tri.maxY / kTileSize; ++ty) {
+        for (int tx = tri.minX / kTileSize; tx <= tri.maxX / kTileSize; ++tx) {
+            m_bins[static_cast<size_t>(ty) * m_tilesX + tx].push_back(index);
+        }
+    }
+}
+
+void SoftwareRasterizer::endFrame() {
+    m_nextTile.store(0);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_busyWorkers = static_cast<int>(m_workers.size());
+        ++m_generation;
+    }
+    m_wake.notify_all();
+    processTiles();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busyWorkers == 0; });
+}
+
+void SoftwareRasterizer::workerLoop() {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_quit || m_generation != seen; });
+            if (m_quit) return;
+            seen = m_generation;
+        }
+        processTiles();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyWorkers == 0) m_done.notify_one();
+    }
+}
+
+void SoftwareRasterizer::processTiles() {
+    const int tileCount = m_tilesX * m_tilesY;
+    for (int tile = m_nextTile.fetch_add(1); tile < tileCount; tile = m_nextTile.fetch_add(1)) rasterizeTile(tile);
+}
+
+void SoftwareRasterizer::rasterizeTile(int tile) {
+    const int tileX0 = (tile % m_tilesX) * kTileSize, tileY0 = (tile / m_tilesX) * kTileSize;
+    const int tileX1 = std::min(tileX0 + kTileSize, m_stride), tileY1 = std::min(tileY0 + kTileSize, m_height);
+    for (int y = tileY0; y < tileY1; ++y) {
+        uint32_t* colorRow = m_color.data() + static_cast<size_t>(y) * m_stride;
+        float* depthRow = m_depth.data() + static_cast<size_t>(y) * m_stride;
+        std::fill(colorRow + tileX0, colorRow + tileX1, m_skyRows[y]);
+        std::fill(depthRow + tileX0, depthRow + tileX1, 1.0f);
+    }
+
+    for (uint32_t index : m_bins[tile]) {
+        const Triangle& tri = m_triangles[index];
+        // Start on a 4-pixel boundary; the stride is padded so the last group never overruns a row.
+        const int x0 = std::max(tri.minX, tileX0) & ~3, x1 = std::min(tri.maxX + 1, tileX1);
+        const int y0 = std::max(tri.minY, tileY0), y1 = std::min(tri.maxY + 1, tileY1);
+        for (int y = y0; y < y1; ++y) {
+            uint32_t* colorRow = m_color.data() + static_cast<size_t>(y) * m_stride;
+            float* depthRow = m_depth.data() + static_cast<size_t>(y) * m_stride;
+            float e0 = tri.a[0] * x0 + tri.b[0] * y + tri.c[0];
+            float e1 = tri.a[1] * x0 + tri.b[1] * y + tri.c[1];
+            float e2 = tri.a[2] * x0 + tri.b[2] * y + tri.c[2];
+            float z = tri.z0 + tri.dzdx * x0 + tri.dzdy * y;
+#ifdef FTS_RASTER_SSE2
+            const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+            __m128 ve0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(_mm_set1_ps(tri.a[0]), lane));
+            __m128 ve1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(_mm_set1_ps(tri.a[1]), lane));
+            __m128 ve2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(_mm_set1_ps(tri.a[2]), lane));
+            __m128 vz = _mm_add_ps(_mm_set1_ps(z), _mm_mul_ps(_mm_set1_ps(tri.dzdx), lane));
+            const __m128 step0 = _mm_set1_ps(tri.a[0] * 4.0f), step1 = _mm_set1_ps(tri.a[1] * 4.0f);
+            const __m128 step2 = _mm_set1_ps(tri.a[2] * 4.0f), stepZ = _mm_set1_ps(tri.dzdx * 4.0f);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128i color = _mm_set1_epi32(static_cast<int>(tri.color));
+            for (int x = x0; x < x1; x += 4) {
+                __m128 mask = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(ve0, zero), _mm_cmpge_ps(ve1, zero)), _mm_cmpge_ps(ve2, zero));
+                if (_mm_movemask_ps(mask)) {
+                    const __m128 depth = _mm_loadu_ps(depthRow + x);
+                    mask = _mm_and_ps(mask, _mm_cmplt_ps(vz, depth));
+                    if (_mm_movemask_ps(mask)) {
+                        _mm_storeu_ps(depthRow + x, _mm_or_ps(_mm_and_ps(mask, vz), _mm_andnot_ps(mask, depth)));
+                        const __m128i maskI = _mm_castps_si128(mask);
+                        __m128i* dst = reinterpret_cast<__m128i*>(colorRow + x);
+                        _mm_storeu_si128(dst, _mm_or_si128(_mm_and_si128(maskI, color), _mm_andnot_si128(maskI, _mm_loadu_si128(dst))));
+                    }
+                }
+                ve0 = _mm_add_ps(ve0, step0);
+                ve1 = _mm_add_ps(ve1, step1);
+                ve2 = _mm_add_ps(ve2, step2);
+                vz = _mm_add_ps(vz, stepZ);
+            }
+#else
+            for (int x = x0; x < x1; ++x) {
+                if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f && z < depthRow[x]) {
+                    depthRow[x] = z;
+                    colorRow[x] = tri.color;
+                }
+                e0 += tri.a[0];
+                e1 += tri.a[1];
+                e2 += tri.a[2];
+                z += tri.dzdx;
+            }
+#endif
+        }
+    }
+}
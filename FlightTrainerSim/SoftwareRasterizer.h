@@ -0,0 +1,113 @@
+// File: SoftwareRasterizer.h
+#ifndef SOFTWARERASTERIZER_H
+#define SOFTWARERASTERIZER_H
+
+#include "RasterMath.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Indexed triangle mesh with one 0xRRGGBB colour per triangle. Front faces wind counter-clockwise
+// when seen from outside.
+struct RasterMesh {
+    std::vector<Vec3> positions;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> colors;
+
+    void clear() { positions.clear(); indices.clear(); colors.clear(); }
+    uint32_t addVertex(const Vec3& p) { positions.push_back(p); return static_cast<uint32_t>(positions.size() - 1); }
+    void addTriangle(uint32_t a, uint32_t b, uint32_t c, uint32_t color) {
+        indices.push_back(a); indices.push_back(b); indices.push_back(c);
+        colors.push_back(color);
+    }
+    void addQuad(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t color) {
+        addTriangle(a, b, c, color);
+        addTriangle(a, c, d, color);
+    }
+    size_t triangleCount() const { return colors.size(); }
+};
+
+struct RasterCamera {
+    Vec3 eye, target, up = { 0.0f, 0.0f, 1.0f };
+    float fovY = 1.0f, nearPlane = 10.0f, farPlane = 30000.0f;
+};
+
+// Tile-binned CPU rasterizer with a float depth buffer. drawMesh() transforms, clips, shades and
+// bins triangles on the calling thread; endFrame() clears and rasterizes the 64x64 tiles across a
+// persistent worker pool, four pixels at a time with SSE2 edge functions where available.
+// Output is a 0xFFRRGGBB buffer that can be wrapped by a QImage without copying.
+class SoftwareRasterizer {
+public:
+    static constexpr int kTileSize = 64;
+
+    explicit SoftwareRasterizer(int threadCount = 0);
+    ~SoftwareRasterizer();
+    SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+    SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+
+    void setSkyGradient(uint32_t zenith, uint32_t horizon) { m_skyZenith = zenith; m_skyHorizon = horizon; }
+    void setFog(uint32_t color, float start, float end) { m_fogColor = color; m_fogStart = start; m_fogEnd = end; }
+    void setLightDirection(const Vec3& towardsLight) { m_light = towardsLight.normalized(); }
+
+    void beginFrame(int width, int height, const RasterCamera& camera);
+    void drawMesh(const RasterMesh& mesh, const Mat4& model, bool cullBackFaces = true);
+    void endFrame();
+
+    // World point to pixel coordinates with the current camera; false when behind the near plane.
+    bool project(const Vec3& world, float& screenX, float& screenY) const;
+    const Mat4& viewProjection() const { return m_viewProjection; }
+    const RasterCamera& camera() const { return m_camera; }
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int stride() const { return m_stride; }
+    const uint32_t* pixels() const { return m_color.data(); }
+    uint32_t* pixels() { return m_color.data(); }
+    size_t trianglesBinned() const { return m_triangles.size(); }
+    int threadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+
+private:
+    struct Triangle {
+        float a[3], b[3], c[3];     // edge functions E = a*x + b*y + c, inside when all >= 0
+        float z0, dzdx, dzdy;       // depth plane relative to pixel (0, 0)
+        int minX, minY, maxX, maxY;
+        uint32_t color;
+    };
+    struct ScreenVertex {
+        float x, y, z;
+    };
+
+    int m_width, m_height, m_stride, m_tilesX, m_tilesY;
+    std::vector<uint32_t> m_color;
+    std::vector<float> m_depth;
+    std::vector<uint32_t> m_skyRows;
+    std::vector<Triangle> m_triangles;
+    std::vector<std::vector<uint32_t>> m_bins;
+    std::vector<Vec4> m_clipVerts;
+
+    RasterCamera m_camera;
+    Mat4 m_viewProjection;
+    uint32_t m_skyZenith, m_skyHorizon, m_fogColor;
+    float m_fogStart, m_fogEnd;
+    Vec3 m_light;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake, m_done;
+    uint64_t m_generation;
+    int m_busyWorkers;
+    bool m_quit;
+    std::atomic<int> m_nextTile;
+
+    void workerLoop();
+    void processTiles();
+    void rasterizeTile(int tile);
+    void setupTriangle(const Vec4& v0, const Vec4& v1, const Vec4& v2, uint32_t color, bool cullBackFaces);
+    ScreenVertex toScreen(const Vec4& clip) const;
+    uint32_t shade(uint32_t color, const Vec3& normal, float distance) const;
+};
+
+#endif
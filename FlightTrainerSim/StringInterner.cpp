@@ -0,0 +1,28 @@
+// File: StringInterner.cpp
+#include "StringInterner.h"
+
+namespace {
+    const std::string kEmpty;
+}
+
+InternedString::InternedString() : m_text(&kEmpty) {}
+
+StringInterner& StringInterner::instance() {
+    static StringInterner interner;
+    return interner;
+}
+
+InternedString StringInterner::intern(std::string_view text) {
+    if (text.empty()) return InternedString();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_index.find(text);
+    if (found != m_index.end()) return InternedString(found->second);
+    const std::string& stored = m_strings.emplace_back(text);
+    m_index.emplace(std::string_view(stored), &stored);
+    return InternedString(&stored);
+}
+
+size_t StringInterner::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_strings.size();
+}
@@ -0,0 +1,45 @@
+// File: StringInterner.h
+#ifndef STRINGINTERNER_H
+#define STRINGINTERNER_H
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Handle to a string owned by StringInterner. Copying one is a pointer copy, and two handles are
+// equal exactly when their text is.
+class InternedString {
+public:
+    InternedString();
+    const std::string& str() const { return *m_text; }
+    const char* c_str() const { return m_text->c_str(); }
+    bool empty() const { return m_text->empty(); }
+    bool operator==(InternedString other) const { return m_text == other.m_text; }
+    bool operator!=(InternedString other) const { return m_text != other.m_text; }
+
+private:
+    friend class StringInterner;
+    explicit InternedString(const std::string* text) : m_text(text) {}
+    const std::string* m_text;
+};
+
+// Process-wide table of message and warning text. Interning text that is already in the table
+// only hashes and compares it; new text is copied in once and kept until exit. Thread-safe.
+class StringInterner {
+public:
+    static StringInterner& instance();
+
+    InternedString intern(std::string_view text);
+    size_t size() const;
+
+private:
+    StringInterner() = default;
+
+    mutable std::mutex m_mutex;
+    std::deque<std::string> m_strings;                              // stable addresses
+    std::unordered_map<std::string_view, const std::string*> m_index;   // views into m_strings
+};
+
+#endif
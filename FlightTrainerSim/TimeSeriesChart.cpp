@@ -0,0 +1,181 @@
+// File: TimeSeriesChart.cpp
+#include "TimeSeriesChart.h"
+#include "Profiler.h"
+#include <QPainter>
+#include <QPen>
+#include <QFont>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QPolygonF>
+#include <QVector>
+#include <QLineF>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+TimeSeriesChart::TimeSeriesChart(const QString& title, const QString& unit, const QColor& color, QWidget* parent)
+    : QWidget(parent), m_title(title), m_unit(unit), m_color(color)
+    , m_viewStart(0.0), m_viewEnd(1.0), m_dragging(false), m_dragStartX(0), m_dragViewStart(0.0) {
+    setMinimumHeight(140);
+    setMouseTracking(false);
+}
+
+void TimeSeriesChart::setSeries(std::vector<double> times, const std::vector<double>& values) {
+    m_pyramid.build(std::move(times), values);
+    resetView();
+}
+
+void TimeSeriesChart::setView(double t0, double t1) {
+    applyView(t0, t1, false);
+}
+
+void TimeSeriesChart::resetView() {
+    applyView(m_pyramid.startTime(), m_pyramid.endTime(), true);
+}
+
+void TimeSeriesChart::applyView(double t0, double t1, bool notify) {
+    const double start = m_pyramid.startTime(), end = m_pyramid.endTime();
+    const double fullSpan = std::max(end - start, 1e-3);
+    // Never zoom in past a handful of samples or out past the whole recording.
+    const double minSpan = m_pyramid.size() > 1 ? std::min(fullSpan, 8.0 * fullSpan / (m_pyramid.size() - 1)) : fullSpan;
+    const double span = std::clamp(t1 - t0, minSpan, fullSpan);
+    t0 = std::clamp(t0, start, start + fullSpan - span);
+    m_viewStart = t0;
+    m_viewEnd = t0 + span;
+    update();
+    if (notify) emit viewChanged(m_viewStart, m_viewEnd);
+}
+
+QRect TimeSeriesChart::plotRect() const {
+    return rect().adjusted(60, 22, -12, -22);
+}
+
+QString TimeSeriesChart::formatTime(double seconds) {
+    const int total = static_cast<int>(std::floor(seconds));
+    if (total >= 3600) {
+        return QString("%1:%2:%3").arg(total / 3600).arg((total / 60) % 60, 2, 10, QChar('0')).arg(total % 60, 2, 10, QChar('0'));
+    }
+    return QString("%1:%2").arg(total / 60).arg(total % 60, 2, 10, QChar('0'));
+}
+
+void TimeSeriesChart::paintEvent(QPaintEvent*) {
+    PROFILE_SCOPE(ProfileStage::ChartPaint);
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(20, 24, 30));
+    const QRect plot = plotRect();
+    painter.setPen(QColor(60, 66, 76));
+    painter.drawRect(plot);
+    painter.setFont(QFont("Arial", 9, QFont::Bold));
+    painter.setPen(QColor(220, 220, 220));
+    painter.drawText(QRect(plot.left(), 2, plot.width(), plot.top() - 4), Qt::AlignLeft | Qt::AlignVCenter,
+                     QString("%1 (%2)").arg(m_title, m_unit));
+    if (m_pyramid.empty() || plot.width() <= 0 || plot.height() <= 0) {
+        painter.drawText(plot, Qt::AlignCenter, "No recorded data");
+        return;
+    }
+
+    const int columns = plot.width();
+    m_pyramid.query(m_viewStart, m_viewEnd, columns, m_columns);
+    float lo = std::numeric_limits<float>::infinity(), hi = -lo;
+    for (const auto& range : m_columns) {
+        if (range.min > range.max) continue;
+        lo = std::min(lo, range.min);
+        hi = std::max(hi, range.max);
+    }
+    if (lo > hi) return;
+    if (hi - lo < 1e-3f) { lo -= 1.0f; hi += 1.0f; }
+    const double pad = (hi - lo) * 0.05;
+    const double yMin = lo - pad, yMax = hi + pad;
+    auto yOf = [&](double v) { return plot.bottom() - (v - yMin) / (yMax - yMin) * plot.height(); };
+    auto xOf = [&](double t) { return plot.left() + (t - m_viewStart) / (m_viewEnd - m_viewStart) * plot.width(); };
+
+    painter.setFont(QFont("Arial", 8));
+    for (int i = 0; i <= 4; ++i) {
+        const double value = yMin + (yMax - yMin) * i / 4.0;
+        const int y = static_cast<int>(yOf(value));
+        painter.setPen(QColor(45, 50, 58));
+        painter.drawLine(plot.left(), y, plot.right(), y);
+        painter.setPen(QColor(170, 170, 170));
+        painter.drawText(QRect(0, y - 8, plot.left() - 6, 16), Qt::AlignRight | Qt::AlignVCenter,
+                         QString::number(value, 'f', 0));
+    }
+    for (int i = 0; i <= 5; ++i) {
+        const double t = m_viewStart + (m_viewEnd - m_viewStart) * i / 5.0;
+        const int x = static_cast<int>(xOf(t));
+        painter.setPen(QColor(45, 50, 58));
+        painter.drawLine(x, plot.top(), x, plot.bottom());
+        painter.setPen(QColor(170, 170, 170));
+        painter.drawText(QRect(x - 40, plot.bottom() + 2, 80, 18), Qt::AlignCenter, formatTime(t));
+    }
+
+    painter.setClipRect(plot);
+    painter.setPen(QPen(m_color, 1));
+    size_t first = 0, last = 0;
+    m_pyramid.sampleRange(m_viewStart, m_viewEnd, first, last);
+    if (last - first <= static_cast<size_t>(columns)) {
+        // Zoomed in past one sample per pixel: draw the raw samples.
+        painter.setRenderHint(QPainter::Antialiasing);
+        QPolygonF line;
+        line.reserve(static_cast<int>(last - first));
+        const auto& times = m_pyramid.times();
+        const auto& values = m_pyramid.values();
+        for (size_t i = first; i < last; ++i) line << QPointF(xOf(times[i]), yOf(values[i]));
+        painter.drawPolyline(line);
+    }
+    else {
+        // One vertical min/max bar per column, stretched to touch its neighbour so the trace stays connected.
+        QVector<QLineF> bars;
+        bars.reserve(columns);
+        const ValueRange* prev = nullptr;
+        for (int c = 0; c < columns; ++c) {
+            const ValueRange& range = m_columns[c];
+            if (range.min > range.max) continue;
+            double barMin = range.min, barMax = range.max;
+            if (prev) {
+                barMin = std::min<double>(barMin, prev->max);
+                barMax = std::max<double>(barMax, prev->min);
+            }
+            const double x = plot.left() + c + 0.5;
+            bars.append(QLineF(x, yOf(barMax), x, yOf(barMin) + 0.5));
+            prev = &range;
+        }
+        painter.drawLines(bars);
+    }
+}
+
+void TimeSeriesChart::wheelEvent(QWheelEvent* event) {
+    const QRect plot = plotRect();
+    if (m_pyramid.empty() || plot.width() <= 0) return;
+    const double fraction = std::clamp((event->position().x() - plot.left()) / plot.width(), 0.0, 1.0);
+    const double anchor = m_viewStart + fraction * (m_viewEnd - m_viewStart);
+    const double factor = std::pow(0.8, event->angleDelta().y() / 120.0);
+    const double span = (m_viewEnd - m_viewStart) * factor;
+    applyView(anchor - fraction * span, anchor + (1.0 - fraction) * span, true);
+    event->accept();
+}
+
+void TimeSeriesChart::mousePressEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton) return;
+    m_dragging = true;
+    m_dragStartX = static_cast<int>(event->position().x());
+    m_dragViewStart = m_viewStart;
+    setCursor(Qt::ClosedHandCursor);
+}
+
+void TimeSeriesChart::mouseMoveEvent(QMouseEvent* event) {
+    if (!m_dragging) return;
+    const int plotWidth = std::max(1, plotRect().width());
+    const double span = m_viewEnd - m_viewStart;
+    const double shift = -(event->position().x() - m_dragStartX) / plotWidth * span;
+    applyView(m_dragViewStart + shift, m_dragViewStart + shift + span, true);
+}
+
+void TimeSeriesChart::mouseReleaseEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton) return;
+    m_dragging = false;
+    unsetCursor();
+}
+
+void TimeSeriesChart::mouseDoubleClickEvent(QMouseEvent*) {
+    resetView();
+}
@@ -0,0 +1,47 @@
+// File: TimeSeriesChart.h
+#ifndef TIMESERIESCHART_H
+#define TIMESERIESCHART_H
+
+#include "TimeSeriesPyramid.h"
+#include <QWidget>
+#include <QColor>
+#include <QString>
+#include <vector>
+
+// Zoomable recorded-channel plot. Wheel zooms around the cursor, drag pans, double-click resets.
+// Each repaint reads one min/max pair per pixel column from the pyramid, so cost depends on the
+// widget width rather than on the number of samples.
+class TimeSeriesChart : public QWidget {
+    Q_OBJECT
+public:
+    TimeSeriesChart(const QString& title, const QString& unit, const QColor& color, QWidget* parent = nullptr);
+    void setSeries(std::vector<double> times, const std::vector<double>& values);
+    double viewStart() const { return m_viewStart; }
+    double viewEnd() const { return m_viewEnd; }
+public slots:
+    void setView(double t0, double t1);
+    void resetView();
+signals:
+    void viewChanged(double t0, double t1);
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+private:
+    TimeSeriesPyramid m_pyramid;
+    QString m_title, m_unit;
+    QColor m_color;
+    double m_viewStart, m_viewEnd;
+    bool m_dragging;
+    int m_dragStartX;
+    double m_dragViewStart;
+    std::vector<ValueRange> m_columns;
+    QRect plotRect() const;
+    void applyView(double t0, double t1, bool notify);
+    static QString formatTime(double seconds);
+};
+
+#endif
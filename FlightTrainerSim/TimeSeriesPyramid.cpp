@@ -0,0 +1,77 @@
+// File: TimeSeriesPyramid.cpp
+#include "TimeSeriesPyramid.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+    constexpr ValueRange kEmptyRange = { std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+
+    inline void merge(ValueRange& into, const ValueRange& other) {
+        into.min = std::min(into.min, other.min);
+        into.max = std::max(into.max, other.max);
+    }
+}
+
+void TimeSeriesPyramid::clear() {
+    m_times.clear();
+    m_values.clear();
+    m_levels.clear();
+}
+
+void TimeSeriesPyramid::build(std::vector<double> times, const std::vector<double>& values) {
+    clear();
+    const size_t count = std::min(times.size(), values.size());
+    times.resize(count);
+    m_times = std::move(times);
+    m_values.assign(values.begin(), values.begin() + count);
+    if (count == 0) return;
+
+    std::vector<ValueRange> level((count + kFanout - 1) / kFanout, kEmptyRange);
+    for (size_t i = 0; i < count; ++i) merge(level[i / kFanout], { m_values[i], m_values[i] });
+    m_levels.push_back(std::move(level));
+    while (m_levels.back().size() > 1) {
+        const auto& below = m_levels.back();
+        std::vector<ValueRange> above((below.size() + kFanout - 1) / kFanout, kEmptyRange);
+        for (size_t i = 0; i < below.size(); ++i) merge(above[i / kFanout], below[i]);
+        m_levels.push_back(std::move(above));
+    }
+}
+
+ValueRange TimeSeriesPyramid::reduce(size_t lo, size_t hi) const {
+    // Consume the unaligned ends at each level, then step up to the coarser one.
+    ValueRange result = kEmptyRange;
+    while (lo < hi && lo % kFanout != 0) { merge(result, { m_values[lo], m_values[lo] }); ++lo; }
+    while (hi > lo && hi % kFanout != 0) { --hi; merge(result, { m_values[hi], m_values[hi] }); }
+    lo /= kFanout;
+    hi /= kFanout;
+    for (const auto& level : m_levels) {
+        if (lo >= hi) break;
+        while (lo < hi && lo % kFanout != 0) merge(result, level[lo++]);
+        while (hi > lo && hi % kFanout != 0) merge(result, level[--hi]);
+        lo /= kFanout;
+        hi /= kFanout;
+    }
+    return result;
+}
+
+bool TimeSeriesPyramid::query(double t0, double t1, int columns, std::vector<ValueRange>& out) const {
+    out.assign(std::max(columns, 0), kEmptyRange);
+    if (m_times.empty() || columns <= 0 || t1 <= t0) return false;
+
+    const double slice = (t1 - t0) / columns;
+    auto begin = std::lower_bound(m_times.begin(), m_times.end(), t0);
+    for (int c = 0; c < columns && begin != m_times.end(); ++c) {
+        const double sliceEnd = (c + 1 == columns) ? t1 : t0 + (c + 1) * slice;
+        auto end = std::lower_bound(begin, m_times.end(), sliceEnd);
+        if (end != begin) out[c] = reduce(begin - m_times.begin(), end - m_times.begin());
+        begin = end;
+    }
+    return true;
+}
+
+void TimeSeriesPyramid::sampleRange(double t0, double t1, size_t& first, size_t& last) const {
+    first = std::lower_bound(m_times.begin(), m_times.end(), t0) - m_times.begin();
+    last = std::upper_bound(m_times.begin(), m_times.end(), t1) - m_times.begin();
+    if (first > 0) --first;
+    if (last < m_times.size()) ++last;
+}
@@ -0,0 +1,45 @@
+// File: TimeSeriesPyramid.h
+#ifndef TIMESERIESPYRAMID_H
+#define TIMESERIESPYRAMID_H
+
+#include <cstddef>
+#include <vector>
+
+struct ValueRange {
+    float min, max;
+};
+
+// Min/max decimation pyramid over a time series. Level k summarises kFanout^k raw samples per
+// bucket, so any window can be reduced to one min/max pair per pixel column by reading at most
+// a few buckets per column, and no peak is ever dropped.
+class TimeSeriesPyramid {
+public:
+    static constexpr size_t kFanout = 8;
+
+    TimeSeriesPyramid() = default;
+    void build(std::vector<double> times, const std::vector<double>& values);
+    void clear();
+
+    size_t size() const { return m_times.size(); }
+    bool empty() const { return m_times.empty(); }
+    double startTime() const { return m_times.empty() ? 0.0 : m_times.front(); }
+    double endTime() const { return m_times.empty() ? 0.0 : m_times.back(); }
+    ValueRange valueRange() const { return m_levels.empty() || m_levels.back().empty() ? ValueRange{0.0f, 0.0f} : m_levels.back().front(); }
+    const std::vector<double>& times() const { return m_times; }
+    const std::vector<float>& values() const { return m_values; }
+
+    // Splits [t0, t1) into `columns` equal slices and writes the min/max of each into out.
+    // Slices without samples get min > max. Returns false when the window is empty.
+    bool query(double t0, double t1, int columns, std::vector<ValueRange>& out) const;
+    // Index range of raw samples inside [t0, t1], widened by one on each side for line continuity.
+    void sampleRange(double t0, double t1, size_t& first, size_t& last) const;
+
+private:
+    std::vector<double> m_times;
+    std::vector<float> m_values;
+    std::vector<std::vector<ValueRange>> m_levels;
+
+    ValueRange reduce(size_t begin, size_t end) const;
+};
+
+#endif
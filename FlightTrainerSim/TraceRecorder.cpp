@@ -0,0 +1,232 @@
+// File: TraceRecorder.cpp
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+namespace {
+    enum EventKind : uint64_t { KindStage = 0, KindInstant = 1 };
+    constexpr double kHitchPostRollNs = 1.0e9;
+    constexpr double kHitchCooldownNs = 10.0e9;
+
+    uint64_t packMeta(EventKind kind, uint8_t id) { return (static_cast<uint64_t>(kind) << 8) | id; }
+
+    const char* instantName(TraceInstant marker) {
+        switch (marker) {
+        case TraceInstant::SimulationTimer: return "Simulation timer";
+        case TraceInstant::RenderTimer: return "Render timer";
+        case TraceInstant::Hitch: return "Hitch";
+        default: return "?";
+        }
+    }
+
+    const char* stageCategory(ProfileStage stage) {
+        switch (stage) {
+        case ProfileStage::CockpitPaint:
+        case ProfileStage::OutsidePaint:
+        case ProfileStage::ChartPaint:
+        case ProfileStage::HudAttitude:
+        case ProfileStage::HudAirspeed:
+        case ProfileStage::HudAltimeter:
+        case ProfileStage::HudHeading:
+        case ProfileStage::HudVerticalSpeed:
+        case ProfileStage::HudThrottle:
+        case ProfileStage::HudWarnings:
+        case ProfileStage::SceneRaster:
+        case ProfileStage::SceneWaypoints:
+        case ProfileStage::SceneTraffic:
+        case ProfileStage::ScenePath:
+        case ProfileStage::SceneInfo: return "render";
+        default: return "simulation";
+        }
+    }
+
+    void writeEscaped(FILE* out, const std::string& text) {
+        for (char c : text) {
+            if (c == '"' || c == '\\') std::fputc('\\', out);
+            if (static_cast<unsigned char>(c) >= 0x20) std::fputc(c, out);
+        }
+    }
+}
+
+std::atomic<bool> TraceRecorder::s_enabled(false);
+thread_local TraceRecorder::Ring* TraceRecorder::s_threadRing = nullptr;
+
+TraceRecorder::Ring::Ring(uint32_t id)
+    : words(new std::atomic<uint64_t>[kRingCapacity * 3]()), head(0), threadId(id), name("thread " + std::to_string(id)) {}
+
+TraceRecorder& TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder() : m_lastSimWake(0), m_hitchTicks(0), m_hitchThresholdNs(0.0), m_lastHitchDump(0) {}
+
+TraceRecorder::~TraceRecorder() {
+    if (m_writer.joinable()) m_writer.join();
+}
+
+void TraceRecorder::setEnabled(bool enabled) {
+    if (enabled) instance();
+    s_enabled.store(enabled, std::memory_order_relaxed);
+    Profiler::setTracing(enabled);
+}
+
+TraceRecorder::Ring* TraceRecorder::threadRing() {
+    if (!s_threadRing) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rings.push_back(std::make_unique<Ring>(static_cast<uint32_t>(m_rings.size())));
+        s_threadRing = m_rings.back().get();
+    }
+    return s_threadRing;
+}
+
+void TraceRecorder::setThreadName(const std::string& name) {
+    Ring* ring = threadRing();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ring->name = name;
+}
+
+void TraceRecorder::write(uint64_t start, uint64_t end, uint64_t meta) {
+    Ring* ring = threadRing();
+    const uint64_t index = ring->head.load(std::memory_order_relaxed);
+    std::atomic<uint64_t>* slot = &ring->words[(index & (kRingCapacity - 1)) * 3];
+    slot[0].store(start, std::memory_order_relaxed);
+    slot[1].store(end, std::memory_order_relaxed);
+    slot[2].store(meta, std::memory_order_relaxed);
+    ring->head.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::complete(ProfileStage stage, uint64_t startTicks, uint64_t endTicks) {
+    write(startTicks, endTicks, packMeta(KindStage, static_cast<uint8_t>(stage)));
+}
+
+void TraceRecorder::instant(TraceInstant marker) {
+    const uint64_t now = Profiler::now();
+    write(now, now, packMeta(KindInstant, static_cast<uint8_t>(marker)));
+    if (marker != TraceInstant::SimulationTimer) return;
+
+    const uint64_t last = m_lastSimWake.exchange(now, std::memory_order_relaxed);
+    const double threshold = m_hitchThresholdNs.load(std::memory_order_relaxed);
+    if (last == 0 || threshold <= 0.0) return;
+    if ((now - last) * Profiler::instance().nsPerTick() > threshold) {
+        write(last, now, packMeta(KindInstant, static_cast<uint8_t>(TraceInstant::Hitch)));
+        uint64_t expected = 0;
+        m_hitchTicks.compare_exchange_strong(expected, now, std::memory_order_relaxed);
+    }
+}
+
+void TraceRecorder::setHitchDetection(double thresholdMs, const std::string& directory) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hitchDirectory = directory;
+    m_hitchThresholdNs.store(thresholdMs * 1.0e6, std::memory_order_relaxed);
+}
+
+std::string TraceRecorder::pollHitch() {
+    const uint64_t hitch = m_hitchTicks.load(std::memory_order_relaxed);
+    if (hitch == 0) return std::string();
+    const uint64_t now = Profiler::now();
+    const double nsPerTick = Profiler::instance().nsPerTick();
+    if ((now - hitch) * nsPerTick < kHitchPostRollNs) return std::string();
+    m_hitchTicks.store(0, std::memory_order_relaxed);
+    if (m_lastHitchDump != 0 && (now - m_lastHitchDump) * nsPerTick < kHitchCooldownNs) return std::string();
+    m_lastHitchDump = now;
+
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        directory = m_hitchDirectory.empty() ? "." : m_hitchDirectory;
+    }
+    char name[64];
+    const std::time_t wallClock = std::time(nullptr);
+    std::strftime(name, sizeof(name), "/hitch_%Y%m%d_%H%M%S.json", std::localtime(&wallClock));
+    const std::string path = directory + name;
+    return dump(path) ? path : std::string();
+}
+
+size_t TraceRecorder::eventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& ring : m_rings) count += std::min<uint64_t>(ring->head.load(std::memory_order_acquire), kRingCapacity);
+    return count;
+}
+
+std::vector<TraceRecorder::Event> TraceRecorder::snapshot() const {
+    std::vector<Event> events;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& ring : m_rings) {
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t first = head > kRingCapacity ? head - kRingCapacity : 0;
+        const size_t base = events.size();
+        for (uint64_t i = first; i < head; ++i) {
+            const std::atomic<uint64_t>* slot = &ring->words[(i & (kRingCapacity - 1)) * 3];
+            events.push_back({ slot[0].load(std::memory_order_relaxed), slot[1].load(std::memory_order_relaxed),
+                               slot[2].load(std::memory_order_relaxed), ring->threadId });
+        }
+        // The owner may have lapped the oldest slots while they were copied; drop any it could have touched.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = ring->head.load(std::memory_order_relaxed);
+        const uint64_t valid = after + 1 > kRingCapacity ? after + 1 - kRingCapacity : 0;
+        if (valid > first) {
+            const size_t torn = static_cast<size_t>(std::min(valid - first, head - first));
+            events.erase(events.begin() + base, events.begin() + base + torn);
+        }
+    }
+    return events;
+}
+
+bool TraceRecorder::dump(const std::string& path) {
+    std::vector<Event> events = snapshot();
+    if (events.empty()) return false;
+    std::vector<std::pair<uint32_t, std::string>> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& ring : m_rings) threads.emplace_back(ring->threadId, ring->name);
+    }
+    const Profiler& profiler = Profiler::instance();
+    if (m_writer.joinable()) m_writer.join();
+    m_writer = std::thread(&TraceRecorder::writeJson, path, std::move(events), std::move(threads),
+                           profiler.startTicks(), profiler.nsPerTick());
+    return true;
+}
+
+bool TraceRecorder::writeJson(const std::string& path, std::vector<Event> events,
+                              std::vector<std::pair<uint32_t, std::string>> threads, uint64_t originTicks, double nsPerTick) {
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.start < b.start; });
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "Cannot write trace: %s\n", path.c_str());
+        return false;
+    }
+    auto micros = [&](uint64_t ticks) { return static_cast<double>(ticks - originTicks) * nsPerTick / 1000.0; };
+    std::fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (const auto& [threadId, name] : threads) {
+        std::fprintf(out, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                     first ? "" : ",\n", threadId);
+        writeEscaped(out, name);
+        std::fprintf(out, "\"}}");
+        first = false;
+    }
+    for (const Event& event : events) {
+        const uint8_t id = static_cast<uint8_t>(event.meta & 0xFF);
+        if ((event.meta >> 8) == KindStage) {
+            const auto stage = static_cast<ProfileStage>(id);
+            std::fprintf(out, ",\n{\"ph\":\"X\",\"name\":\"%s\",\"cat\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         Profiler::stageName(stage), stageCategory(stage), event.threadId, micros(event.start),
+                         static_cast<double>(event.end - event.start) * nsPerTick / 1000.0);
+        } else if (static_cast<TraceInstant>(id) == TraceInstant::Hitch) {
+            // Spans the late gap, so it lines up with the missing ticks.
+            std::fprintf(out, ",\n{\"ph\":\"X\",\"name\":\"Hitch\",\"cat\":\"hitch\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         event.threadId, micros(event.start), static_cast<double>(event.end - event.start) * nsPerTick / 1000.0);
+        } else {
+            std::fprintf(out, ",\n{\"ph\":\"i\",\"s\":\"t\",\"name\":\"%s\",\"cat\":\"timer\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                         instantName(static_cast<TraceInstant>(id)), event.threadId, micros(event.start));
+        }
+    }
+    std::fprintf(out, "\n]}\n");
+    const bool ok = std::fflush(out) == 0 && !std::ferror(out);
+    std::fclose(out);
+    if (!ok) std::fprintf(stderr, "Cannot write trace: %s\n", path.c_str());
+    return ok;
+}
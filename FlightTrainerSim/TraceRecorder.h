@@ -0,0 +1,88 @@
+// File: TraceRecorder.h
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include "Profiler.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class TraceInstant : uint8_t { SimulationTimer, RenderTimer, Hitch };
+
+// Opt-in timeline of profiled stages (begin/end via PROFILE_SCOPE) and timer wakeups. Each thread
+// writes into its own preallocated ring that overwrites the oldest events, so recording never
+// allocates or locks. dump() snapshots the rings and writes Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev) on a background thread. A gap between simulation timer wakeups longer than the
+// hitch threshold arms an automatic dump one second later, so the trace shows both sides of it.
+class TraceRecorder {
+public:
+    static constexpr size_t kRingCapacity = size_t(1) << 16;
+
+    static TraceRecorder& instance();
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled);
+    static void mark(TraceInstant marker) {
+        if (enabled()) instance().instant(marker);
+    }
+
+    ~TraceRecorder();
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    void complete(ProfileStage stage, uint64_t startTicks, uint64_t endTicks);
+    void instant(TraceInstant marker);
+    // Labels the calling thread in dumps.
+    void setThreadName(const std::string& name);
+
+    // thresholdMs <= 0 disables hitch detection; hitch traces go to `directory`.
+    void setHitchDetection(double thresholdMs, const std::string& directory);
+    // Forget the last simulation wakeup, e.g. after a pause, so the gap is not taken for a hitch.
+    void restartHitchClock() { m_lastSimWake.store(0, std::memory_order_relaxed); }
+    // Dumps a pending hitch once its post-roll has elapsed. Returns the file written, if any.
+    std::string pollHitch();
+    bool dump(const std::string& path);
+    size_t eventCount() const;
+
+private:
+    struct Ring {
+        explicit Ring(uint32_t id);
+        std::unique_ptr<std::atomic<uint64_t>[]> words;   // three words per event: start, end, kind/id
+        std::atomic<uint64_t> head;
+        uint32_t threadId;
+        std::string name;
+    };
+    struct Event {
+        uint64_t start, end, meta;
+        uint32_t threadId;
+    };
+
+    TraceRecorder();
+    Ring* threadRing();
+    void write(uint64_t start, uint64_t end, uint64_t meta);
+    std::vector<Event> snapshot() const;
+    static bool writeJson(const std::string& path, std::vector<Event> events, std::vector<std::pair<uint32_t, std::string>> threads,
+                          uint64_t originTicks, double nsPerTick);
+
+    static std::atomic<bool> s_enabled;
+    static thread_local Ring* s_threadRing;
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<Ring>> m_rings;
+    std::thread m_writer;
+    std::atomic<uint64_t> m_lastSimWake, m_hitchTicks;
+    std::atomic<double> m_hitchThresholdNs;
+    std::string m_hitchDirectory;
+    uint64_t m_lastHitchDump;
+};
+
+#if FLIGHTSIM_PROFILING
+#define TRACE_INSTANT(marker) TraceRecorder::mark(marker)
+#else
+#define TRACE_INSTANT(marker) ((void)0)
+#endif
+
+#endif
@@ -1,20 +1,32 @@
 // File: TrainingScenario.cpp
 #include "TrainingScenario.h"
+#include "FrameArena.h"
+#include "GlobalConfig.h"
 #include <cmath>
+#include <iterator>
 
 TrainingScenario::TrainingScenario(const std::string& name, const std::string& description)
     : m_name(name), m_description(description), m_currentState(ScenarioState::PreFlight)
-    , m_progress(0.0), m_stateTimer(0.0), m_currentWaypointIndex(0) {}
+    , m_messageStart(0), m_messageCount(0), m_progress(0.0), m_stateTimer(0.0), m_currentWaypointIndex(0) {}
 
 void TrainingScenario::reset() {
     m_currentState = ScenarioState::PreFlight;
     m_progress = 0.0;
     m_stateTimer = 0.0;
     m_currentWaypointIndex = 0;
-    m_messages.clear();
+    m_messageStart = m_messageCount = 0;
     addMessage("Scenario initialized. Ready for pre-flight checks.");
 }
 
+bool TrainingScenario::placeAircraft(Aircraft& aircraft, const ConfigSnapshot& config) const {
+    aircraft.reset();
+    if (!m_initialCondition) return true;
+    const TrimResult trim = TrimTable::forModel(*aircraft.flightModel(), config).lookupNear(*m_initialCondition, config);
+    if (!trim.trimmed) return false;
+    TrimSolver::apply(aircraft, trim, config);
+    return true;
+}
+
 void TrainingScenario::update(const Aircraft& aircraft, double deltaTime) {
     m_stateTimer += deltaTime;
     checkTransitions(aircraft);
@@ -24,12 +36,35 @@ void TrainingScenario::update(const Aircraft& aircraft, double deltaTime) {
 void TrainingScenario::transitionTo(ScenarioState newState) {
     m_currentState = newState;
     m_stateTimer = 0.0;
-    addMessage("State changed to: " + getCurrentStateDescription());
+    addMessage(stateMessage(newState));
+}
+
+void TrainingScenario::addMessage(InternedString msg) {
+    if (m_messageCount < kMaxMessages) {
+        m_messages[(m_messageStart + m_messageCount++) % kMaxMessages] = msg;
+    } else {
+        m_messages[m_messageStart] = msg;
+        m_messageStart = (m_messageStart + 1) % kMaxMessages;
+    }
+}
+
+void TrainingScenario::addWaypoint(const Waypoint& wp) {
+    m_targetWaypoints.push_back(wp);
+    waypointMessage(wp);
+}
+
+void TrainingScenario::addTransitionRule(const StateTransitionRule& rule) {
+    m_transitionRules.push_back(rule);
+    stateMessage(rule.toState);
+    StringInterner::instance().intern(rule.description);
+}
+
+InternedString TrainingScenario::stateMessage(ScenarioState state) {
+    return StringInterner::instance().intern(FrameArena::current().format("State changed to: %s", stateDescription(state)));
 }
 
-void TrainingScenario::addMessage(const std::string& msg) {
-    m_messages.push_back(msg);
-    if (m_messages.size() > 50) m_messages.erase(m_messages.begin());
+InternedString TrainingScenario::waypointMessage(const Waypoint& wp) {
+    return StringInterner::instance().intern(FrameArena::current().format("Waypoint reached: %s", wp.name.c_str()));
 }
 
 void TrainingScenario::checkTransitions(const Aircraft& aircraft) {
@@ -56,13 +91,13 @@ void TrainingScenario::updateProgress(const Aircraft& aircraft) {
             m_progress = 100.0;
         } else {
             m_progress = (100.0 * m_currentWaypointIndex) / m_targetWaypoints.size();
-            addMessage("Waypoint reached: " + currentWP.name);
+            addMessage(waypointMessage(currentWP));
         }
     }
 }
 
-std::string TrainingScenario::getCurrentStateDescription() const {
-    switch (m_currentState) {
+const char* TrainingScenario::stateDescription(ScenarioState state) {
+    switch (state) {
         case ScenarioState::PreFlight: return "Pre-Flight Check";
         case ScenarioState::Takeoff: return "Takeoff Roll";
         case ScenarioState::Climb: return "Initial Climb";
@@ -100,6 +135,7 @@ std::unique_ptr<TrainingScenario> TrainingScenario::createBasicTakeoffScenario()
 
 std::unique_ptr<TrainingScenario> TrainingScenario::createPatternScenario() {
     auto scenario = std::make_unique<TrainingScenario>("Traffic Pattern", "Complete standard traffic pattern");
+    scenario->setInitialCondition({ 1000.0, 100.0, 0.0, 0.0 });
     scenario->addWaypoint({0, 0, 1000, "Upwind", 100, 200});
     scenario->addWaypoint({5000, 3000, 1000, "Crosswind", 90, 200});
     scenario->addWaypoint({5000, 8000, 1000, "Downwind", 90, 200});
@@ -111,6 +147,7 @@ std::unique_ptr<TrainingScenario> TrainingScenario::createPatternScenario() {
 
 std::unique_ptr<TrainingScenario> TrainingScenario::createIFRBasicScenario() {
     auto scenario = std::make_unique<TrainingScenario>("IFR Basic Navigation", "Follow instrument procedures");
+    scenario->setInitialCondition({ 3000.0, 150.0, 0.0, 0.0 });
     scenario->addWaypoint({10000, 0, 3000, "VOR Alpha", 150, 300});
     scenario->addWaypoint({20000, 10000, 5000, "VOR Bravo", 180, 300});
     scenario->addWaypoint({30000, 5000, 3000, "VOR Charlie", 160, 300});
@@ -120,9 +157,34 @@ std::unique_ptr<TrainingScenario> TrainingScenario::createIFRBasicScenario() {
 
 std::unique_ptr<TrainingScenario> TrainingScenario::createEngineFailureScenario() {
     auto scenario = std::make_unique<TrainingScenario>("Engine Failure Recovery", "Handle engine failure at cruise");
+    scenario->setInitialCondition({ 3000.0, 180.0, 0.0, 0.0 });
     scenario->addWaypoint({5000, 0, 3000, "Cruise Point", 180, 300});
     scenario->addWaypoint({8000, 2000, 2000, "Emergency Descent", 120, 300});
     scenario->addWaypoint({10000, 3000, 500, "Emergency Approach", 90, 250});
     scenario->addWaypoint({12000, 3500, 0, "Emergency Landing", 70, 150});
     return scenario;
 }
+
+namespace {
+    std::unique_ptr<TrainingScenario> (*const kBuiltinScenarios[])() = {
+        TrainingScenario::createBasicTakeoffScenario, TrainingScenario::createPatternScenario,
+        TrainingScenario::createIFRBasicScenario, TrainingScenario::createEngineFailureScenario,
+    };
+}
+
+int TrainingScenario::builtinCount() {
+    return static_cast<int>(std::size(kBuiltinScenarios));
+}
+
+std::unique_ptr<TrainingScenario> TrainingScenario::builtin(int index) {
+    if (index < 0 || index >= builtinCount()) return nullptr;
+    return kBuiltinScenarios[index]();
+}
+
+std::unique_ptr<TrainingScenario> TrainingScenario::builtin(const std::string& name) {
+    for (auto factory : kBuiltinScenarios) {
+        auto scenario = factory();
+        if (scenario->name() == name) return scenario;
+    }
+    return nullptr;
+}
@@ -4,10 +4,14 @@
 
 #include "Environment.h"
 #include "Aircraft.h"
+#include "StringInterner.h"
+#include "TrimSolver.h"
+#include <array>
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <optional>
 
 enum class ScenarioState {
     PreFlight, Takeoff, Climb, Cruise, Approach, Landing, Completed, Failed
@@ -28,27 +32,48 @@ public:
     const std::string& description() const { return m_description; }
     ScenarioState currentState() const { return m_currentState; }
     const std::vector<Waypoint>& targetWaypoints() const { return m_targetWaypoints; }
+    size_t currentWaypointIndex() const { return m_currentWaypointIndex; }
     bool isCompleted() const { return m_currentState == ScenarioState::Completed; }
     bool isFailed() const { return m_currentState == ScenarioState::Failed; }
-    void addWaypoint(const Waypoint& wp) { m_targetWaypoints.push_back(wp); }
-    void addTransitionRule(const StateTransitionRule& rule) { m_transitionRules.push_back(rule); }
-    std::string getCurrentStateDescription() const;
+    void addWaypoint(const Waypoint& wp);
+    void addTransitionRule(const StateTransitionRule& rule);
+    // Scenarios that begin in the air start trimmed in this condition (or the nearest speed that
+    // trims); without one the aircraft starts from Aircraft::reset.
+    void setInitialCondition(const TrimCondition& condition) { m_initialCondition = condition; }
+    const std::optional<TrimCondition>& initialCondition() const { return m_initialCondition; }
+    // False if the aircraft cannot trim in the initial condition and was left at Aircraft::reset.
+    bool placeAircraft(Aircraft& aircraft, const ConfigSnapshot& config) const;
+    const char* getCurrentStateDescription() const { return stateDescription(m_currentState); }
+    static const char* stateDescription(ScenarioState state);
     double getProgress() const { return m_progress; }
-    const std::vector<std::string>& getMessages() const { return m_messages; }
+    // The last kMaxMessages messages, oldest first.
+    static constexpr size_t kMaxMessages = 50;
+    size_t messageCount() const { return m_messageCount; }
+    const std::string& message(size_t index) const { return m_messages[(m_messageStart + index) % kMaxMessages].str(); }
     static std::unique_ptr<TrainingScenario> createBasicTakeoffScenario();
     static std::unique_ptr<TrainingScenario> createPatternScenario();
     static std::unique_ptr<TrainingScenario> createIFRBasicScenario();
     static std::unique_ptr<TrainingScenario> createEngineFailureScenario();
+    // The scenarios above in menu order; builtin() returns null for an index or name out of range.
+    static int builtinCount();
+    static std::unique_ptr<TrainingScenario> builtin(int index);
+    static std::unique_ptr<TrainingScenario> builtin(const std::string& name);
 private:
     std::string m_name, m_description;
     ScenarioState m_currentState;
     std::vector<Waypoint> m_targetWaypoints;
     std::vector<StateTransitionRule> m_transitionRules;
-    std::vector<std::string> m_messages;
+    std::optional<TrimCondition> m_initialCondition;
+    std::array<InternedString, kMaxMessages> m_messages;
+    size_t m_messageStart, m_messageCount;
     double m_progress, m_stateTimer;
     size_t m_currentWaypointIndex;
     void transitionTo(ScenarioState newState);
-    void addMessage(const std::string& msg);
+    // Message text is interned when the scenario is built, so a tick only looks it up.
+    void addMessage(InternedString msg);
+    void addMessage(std::string_view msg) { addMessage(StringInterner::instance().intern(msg)); }
+    static InternedString stateMessage(ScenarioState state);
+    static InternedString waypointMessage(const Waypoint& wp);
     void checkTransitions(const Aircraft& aircraft);
     void updateProgress(const Aircraft& aircraft);
 };
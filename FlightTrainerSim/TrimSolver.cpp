@@ -0,0 +1,246 @@
+// File: TrimSolver.cpp
+#include "TrimSolver.h"
+#include "FlightKernel.h"
+#include "GlobalConfig.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+    constexpr double kJacobianStep = 1e-6;
+    // advanceOrientation damps pitch by this every step.
+    constexpr double kPitchDamping = 0.98;
+
+    constexpr char kTrimMagic[8] = { 'F', 'T', 'T', 'R', 'I', 'M', '\0', '\1' };
+    constexpr uint32_t kTrimVersion = 2;
+
+    // Velocity along the flight path; wings level, no sideslip.
+    FlightState pathState(const TrimCondition& condition) {
+        const double angle = condition.flightPathAngle * kDegToRad;
+        FlightState state;
+        state.velocityX = condition.speed * std::cos(angle);
+        state.velocityZ = condition.speed * std::sin(angle);
+        return state;
+    }
+}
+
+TrimResult TrimSolver::solve(const FlightModelParams& params, const TrimCondition& condition, const ConfigSnapshot& config,
+                             double throttleGuess, double elevatorGuess) {
+    TrimResult result;
+    result.condition = condition;
+    const double deltaTime = config.physicsTimeStep();
+    const double density = airDensity(condition.altitude);
+    const FlightState state = pathState(condition);
+    auto accelerations = [&](double throttle, double elevator, double& accelX, double& accelZ) {
+        FlightState next;
+        computeFlightForces(params, state, elevator, 0.0, 0.0, throttle, condition.flaps, density, deltaTime, config.gravity, next);
+        accelX = (next.velocityX - state.velocityX) / deltaTime;
+        accelZ = (next.velocityZ - state.velocityZ) / deltaTime;
+    };
+
+    double throttle = std::clamp(throttleGuess, 0.0, 1.0);
+    double elevator = std::clamp(elevatorGuess, -1.0, 1.0);
+    for (int i = 0;; ++i) {
+        double accelX, accelZ;
+        accelerations(throttle, elevator, accelX, accelZ);
+        result.residual = std::max(std::abs(accelX), std::abs(accelZ));
+        result.iterations = i;
+        result.trimmed = result.residual < kTolerance;
+        if (result.trimmed || i == kMaxIterations) break;
+
+        // Differences step away from the nearer end of travel, so they stay inside it.
+        const double throttleStep = throttle > 0.5 ? -kJacobianStep : kJacobianStep;
+        const double elevatorStep = elevator > 0.0 ? -kJacobianStep : kJacobianStep;
+        double throttleX, throttleZ, elevatorX, elevatorZ;
+        accelerations(throttle + throttleStep, elevator, throttleX, throttleZ);
+        accelerations(throttle, elevator + elevatorStep, elevatorX, elevatorZ);
+        const double xt = (throttleX - accelX) / throttleStep, xe = (elevatorX - accelX) / elevatorStep;
+        const double zt = (throttleZ - accelZ) / throttleStep, ze = (elevatorZ - accelZ) / elevatorStep;
+        const double determinant = xt * ze - xe * zt;
+        if (determinant == 0.0 || !std::isfinite(determinant)) break;
+
+        const double nextThrottle = std::clamp(throttle + (xe * accelZ - ze * accelX) / determinant, 0.0, 1.0);
+        const double nextElevator = std::clamp(elevator + (zt * accelX - xt * accelZ) / determinant, -1.0, 1.0);
+        if (nextThrottle == throttle && nextElevator == elevator) break;   // held at the end of travel
+        throttle = nextThrottle;
+        elevator = nextElevator;
+    }
+    result.throttle = throttle;
+    result.elevator = elevator;
+    return result;
+}
+
+void TrimSolver::apply(Aircraft& aircraft, const TrimResult& trim, const ConfigSnapshot& config) {
+    aircraft.reset();
+    const TrimCondition& condition = trim.condition;
+    const FlightModelParams& params = aircraft.flightModel()->params();
+
+    FlightState state = pathState(condition);
+    FlightState forces;
+    computeFlightForces(params, state, trim.elevator, 0.0, 0.0, trim.throttle, condition.flaps,
+                        airDensity(condition.altitude), config.physicsTimeStep(), config.gravity, forces);
+    state.thrust = forces.thrust;
+    state.drag = forces.drag;
+    state.lift = forces.lift;
+    aircraft.setFlightState(state);
+
+    Position3D position = aircraft.position();
+    position.z = condition.altitude;
+    aircraft.setPosition(position);
+
+    // Pitch moves by the elevator's rate each step and is damped after, so it settles where the two balance.
+    const double pitchStep = trim.elevator * params.pitchRate * config.physicsTimeStep();
+    Orientation orientation = aircraft.orientation();
+    orientation.pitch = std::clamp(kPitchDamping * pitchStep / (1.0 - kPitchDamping), -90.0 * kPitchDamping, 90.0 * kPitchDamping);
+    aircraft.setOrientation(orientation);
+
+    ControlInputs controls;
+    controls.throttle = trim.throttle;
+    controls.elevator = trim.elevator;
+    controls.flaps = condition.flaps;
+    controls.gearDown = false;
+    aircraft.setControls(controls);
+}
+
+TrimTable::TrimTable(const FlightModelParams& params, double gravity) : m_params(params), m_gravity(gravity) {
+    // Sea level to just under the default ceiling; half the stall speed to the model's top speed;
+    // a 10 degree descent to a 15 degree climb; flaps up, half and full.
+    m_altitude = { 0.0, 2000.0, 25 };
+    m_speed = { 0.5 * params.stallSpeed, (params.maxSpeed - 0.5 * params.stallSpeed) / 31.0, 32 };
+    m_angle = { -10.0, 5.0, 6 };
+    m_flaps = { 0.0, 0.5, 3 };
+    const size_t cells = static_cast<size_t>(m_altitude.count) * m_speed.count * m_angle.count * m_flaps.count;
+    m_throttle.assign(cells, 0.0f);
+    m_elevator.assign(cells, 0.0f);
+    m_trimmed.assign(cells, 0);
+}
+
+size_t TrimTable::cell(int altitude, int speed, int angle, int flaps) const {
+    return ((static_cast<size_t>(flaps) * m_angle.count + angle) * m_altitude.count + altitude) * m_speed.count + speed;
+}
+
+void TrimTable::build(const ConfigSnapshot& config) {
+    ConfigSnapshot trimConfig = config;
+    trimConfig.gravity = m_gravity;
+    for (int f = 0; f < m_flaps.count; ++f) {
+        for (int g = 0; g < m_angle.count; ++g) {
+            for (int a = 0; a < m_altitude.count; ++a) {
+                // Along the speed axis each trim starts from the one before it.
+                double throttle = 0.5, elevator = 0.0;
+                for (int s = 0; s < m_speed.count; ++s) {
+                    const TrimCondition condition{ m_altitude.value(a), m_speed.value(s), m_angle.value(g), m_flaps.value(f) };
+                    TrimResult trim = TrimSolver::solve(m_params, condition, trimConfig, throttle, elevator);
+                    if (!trim.trimmed) trim = TrimSolver::solve(m_params, condition, trimConfig);
+                    const size_t c = cell(a, s, g, f);
+                    m_trimmed[c] = trim.trimmed;
+                    m_throttle[c] = static_cast<float>(trim.throttle);
+                    m_elevator[c] = static_cast<float>(trim.elevator);
+                    if (trim.trimmed) {
+                        throttle = trim.throttle;
+                        elevator = trim.elevator;
+                    }
+                }
+            }
+        }
+    }
+}
+
+size_t TrimTable::trimmedCount() const {
+    return static_cast<size_t>(std::count(m_trimmed.begin(), m_trimmed.end(), uint8_t(1)));
+}
+
+bool TrimTable::speedRange(double altitude, double flightPathAngle, double flaps, double& slowest, double& fastest) const {
+    const int a = m_altitude.nearest(altitude), g = m_angle.nearest(flightPathAngle), f = m_flaps.nearest(flaps);
+    bool any = false;
+    for (int s = 0; s < m_speed.count; ++s) {
+        if (!m_trimmed[cell(a, s, g, f)]) continue;
+        if (!any) slowest = m_speed.value(s);
+        fastest = m_speed.value(s);
+        any = true;
+    }
+    return any;
+}
+
+TrimResult TrimTable::lookup(const TrimCondition& condition, const ConfigSnapshot& config) const {
+    const TableAxis* axes[4] = { &m_altitude, &m_speed, &m_angle, &m_flaps };
+    const double values[4] = { condition.altitude, condition.speed, condition.flightPathAngle, condition.flaps };
+    int index[4];
+    double fraction[4];
+    for (int k = 0; k < 4; ++k) axes[k]->locate(values[k], index[k], fraction[k]);
+
+    // Multilinear blend of the 16 surrounding trims; only usable if all that count are trimmed.
+    double throttle = 0.0, elevator = 0.0;
+    bool blended = true;
+    for (int corner = 0; corner < 16 && blended; ++corner) {
+        double weight = 1.0;
+        int at[4];
+        for (int k = 0; k < 4; ++k) {
+            const bool upper = (corner >> k) & 1;
+            at[k] = std::min(index[k] + upper, axes[k]->count - 1);
+            weight *= upper ? fraction[k] : 1.0 - fraction[k];
+        }
+        if (weight == 0.0) continue;
+        const size_t c = cell(at[0], at[1], at[2], at[3]);
+        blended = m_trimmed[c] != 0;
+        throttle += weight * m_throttle[c];
+        elevator += weight * m_elevator[c];
+    }
+    ConfigSnapshot trimConfig = config;
+    trimConfig.gravity = m_gravity;
+    return blended ? TrimSolver::solve(m_params, condition, trimConfig, throttle, elevator)
+                   : TrimSolver::solve(m_params, condition, trimConfig);
+}
+
+TrimResult TrimTable::lookupNear(const TrimCondition& condition, const ConfigSnapshot& config) const {
+    TrimResult result = lookup(condition, config);
+    if (result.trimmed) return result;
+
+    ConfigSnapshot trimConfig = config;
+    trimConfig.gravity = m_gravity;
+    const int a = m_altitude.nearest(condition.altitude), g = m_angle.nearest(condition.flightPathAngle), f = m_flaps.nearest(condition.flaps);
+    const int start = m_speed.nearest(condition.speed);
+    // Outward from the requested speed, first slower then faster at each distance.
+    for (int distance = 0; distance < m_speed.count; ++distance) {
+        for (int s : { start - distance, start + distance }) {
+            if (s < 0 || s >= m_speed.count || (distance == 0 && s != start)) continue;
+            const size_t c = cell(a, s, g, f);
+            if (!m_trimmed[c]) continue;
+            TrimCondition nearby = condition;
+            nearby.speed = m_speed.value(s);
+            const TrimResult trim = TrimSolver::solve(m_params, nearby, trimConfig, m_throttle[c], m_elevator[c]);
+            if (trim.trimmed) return trim;
+        }
+    }
+    return result;
+}
+
+bool TrimTable::save(const std::string& path) const {
+    ModelTableWriter out(kTrimMagic, kTrimVersion, m_params, m_gravity);
+    out.axes({ &m_altitude, &m_speed, &m_angle, &m_flaps });
+    out.column(m_throttle);
+    out.column(m_elevator);
+    out.column(m_trimmed);
+    return out.save(path);
+}
+
+bool TrimTable::load(const std::string& path) {
+    ModelTableReader in;
+    const size_t cells = m_trimmed.size();
+    std::vector<float> throttle, elevator;
+    std::vector<uint8_t> trimmed;
+    if (!in.open(path, kTrimMagic, kTrimVersion, m_params, m_gravity) || !in.axes({ &m_altitude, &m_speed, &m_angle, &m_flaps })
+        || !in.column(throttle, cells) || !in.column(elevator, cells) || !in.column(trimmed, cells) || !in.atEnd()) return false;
+    m_throttle = std::move(throttle);
+    m_elevator = std::move(elevator);
+    m_trimmed = std::move(trimmed);
+    return true;
+}
+
+std::string TrimTable::cachePath(const IFlightModel& model) {
+    return GlobalConfig::instance().cacheDirectory() + "/trim-" + model.fileKey() + ".ftt";
+}
+
+const TrimTable& TrimTable::forModel(const IFlightModel& model, const ConfigSnapshot& config) {
+    return ModelTableCache<TrimTable>::get(model.params(), config.gravity, cachePath(model),
+                                           [&](TrimTable& table) { table.build(config); });
+}
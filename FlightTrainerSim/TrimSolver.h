@@ -0,0 +1,82 @@
+// File: TrimSolver.h
+#ifndef TRIMSOLVER_H
+#define TRIMSOLVER_H
+
+#include "Aircraft.h"
+#include "ModelTable.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ConfigSnapshot;
+
+// A steady flight condition: altitude (ft), speed, flight-path angle (degrees, climbing positive)
+// and flap setting, wings level.
+struct TrimCondition {
+    double altitude = 0.0;
+    double speed = 0.0;
+    double flightPathAngle = 0.0;
+    double flaps = 0.0;
+};
+
+struct TrimResult {
+    bool trimmed = false;
+    TrimCondition condition;
+    double throttle = 0.0, elevator = 0.0;
+    double residual = 0.0;          // largest acceleration left at the solution
+    int iterations = 0;
+};
+
+// Finds the throttle and elevator that hold a condition with no acceleration. Newton's method on
+// the two accelerations the flight model gives, with a finite-difference Jacobian; controls are
+// kept within their travel, and a condition the controls cannot hold (too slow or fast for the
+// elevator at that altitude, or a thrust inside the afterburner step) comes back untrimmed.
+class TrimSolver {
+public:
+    static constexpr int kMaxIterations = 20;
+    static constexpr double kTolerance = 1e-9;
+
+    static TrimResult solve(const FlightModelParams& params, const TrimCondition& condition, const ConfigSnapshot& config,
+                            double throttleGuess = 0.5, double elevatorGuess = 0.0);
+    // Resets the aircraft into the trimmed condition: altitude, velocity along the flight path,
+    // the pitch the elevator settles at, and the trim controls with the gear up.
+    static void apply(Aircraft& aircraft, const TrimResult& trim, const ConfigSnapshot& config);
+};
+
+// Trims for one flight model over a grid of conditions. Built once per model and gravity and
+// cached on disk (see ModelTableCache), so a start from any condition is a table lookup polished
+// by a Newton step instead of a solve from scratch.
+class TrimTable {
+public:
+    static const TrimTable& forModel(const IFlightModel& model, const ConfigSnapshot& config);
+    // Where forModel() caches the table for `model`.
+    static std::string cachePath(const IFlightModel& model);
+
+    TrimTable(const FlightModelParams& params, double gravity);
+    void build(const ConfigSnapshot& config);
+    // Fails unless the file was saved for this table's parameters, gravity and grid.
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    // Interpolated from the grid, then solved from there (usually in one iteration).
+    TrimResult lookup(const TrimCondition& condition, const ConfigSnapshot& config) const;
+    // lookup(), or if that condition cannot be trimmed, the nearest grid speed that can at the
+    // same altitude, flight-path angle and flaps.
+    TrimResult lookupNear(const TrimCondition& condition, const ConfigSnapshot& config) const;
+
+    size_t cellCount() const { return m_trimmed.size(); }
+    size_t trimmedCount() const;
+    // Slowest and fastest trimmed grid speed at a grid condition; false if none is trimmed.
+    bool speedRange(double altitude, double flightPathAngle, double flaps, double& slowest, double& fastest) const;
+
+private:
+    FlightModelParams m_params;
+    double m_gravity;
+    TableAxis m_altitude, m_speed, m_angle, m_flaps;
+    std::vector<float> m_throttle, m_elevator;
+    std::vector<uint8_t> m_trimmed;
+
+    size_t cell(int altitude, int speed, int angle, int flaps) const;
+};
+
+#endif
@@ -0,0 +1,53 @@
+// File: UdpTransport.cpp
+#include "UdpTransport.h"
+#include <QHostInfo>
+
+bool UdpTransport::bind(quint16 port) {
+    return m_socket.bind(QHostAddress::AnyIPv4, port);
+}
+
+NetEndpoint UdpTransport::endpoint(const QHostAddress& address, quint16 port) {
+    return (static_cast<NetEndpoint>(address.toIPv4Address()) << 16) | port;
+}
+
+bool UdpTransport::send(NetEndpoint to, const uint8_t* data, size_t size) {
+    const QHostAddress address(static_cast<quint32>(to >> 16));
+    const qint64 written = m_socket.writeDatagram(reinterpret_cast<const char*>(data), static_cast<qint64>(size),
+                                                  address, static_cast<quint16>(to & 0xFFFF));
+    return written == static_cast<qint64>(size);
+}
+
+bool UdpTransport::receive(NetEndpoint& from, uint8_t* data, size_t& size) {
+    while (m_socket.hasPendingDatagrams()) {
+        QHostAddress address;
+        quint16 port = 0;
+        const qint64 read = m_socket.readDatagram(reinterpret_cast<char*>(data), NetProtocol::kMaxPacketSize, &address, &port);
+        if (read < 0) return false;
+        bool isIPv4 = false;
+        address.toIPv4Address(&isIPv4);
+        if (!isIPv4) continue;
+        from = endpoint(address, port);
+        size = static_cast<size_t>(read);
+        return true;
+    }
+    return false;
+}
+
+int UdpTransport::resolve(const QString& hostAndPort, QObject* context, std::function<void(NetEndpoint)> done) {
+    const int colon = hostAndPort.lastIndexOf(':');
+    if (colon <= 0) return -1;
+    bool ok = false;
+    const uint port = hostAndPort.mid(colon + 1).toUInt(&ok);
+    if (!ok || port == 0 || port > 0xFFFF) return -1;
+
+    // Numeric addresses come back without touching the resolver; names can take its full timeout.
+    return QHostInfo::lookupHost(hostAndPort.left(colon), context, [port, done](const QHostInfo& info) {
+        for (const QHostAddress& candidate : info.addresses()) {
+            if (candidate.protocol() == QAbstractSocket::IPv4Protocol) {
+                done(endpoint(candidate, static_cast<quint16>(port)));
+                return;
+            }
+        }
+        done(0);
+    });
+}
\ No newline at end of file
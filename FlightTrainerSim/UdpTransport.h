@@ -0,0 +1,35 @@
+// File: UdpTransport.h
+#ifndef UDPTRANSPORT_H
+#define UDPTRANSPORT_H
+
+#include "NetSession.h"
+#include <QHostAddress>
+#include <QString>
+#include <QUdpSocket>
+#include <functional>
+
+class QObject;
+
+// NetTransport over an IPv4 UDP socket, polled from the thread that owns it. Endpoints pack the
+// address and port as (address << 16) | port.
+class UdpTransport : public NetTransport {
+public:
+    // Port 0 picks any free port, which is all a joining client needs.
+    bool bind(quint16 port);
+    quint16 localPort() const { return m_socket.localPort(); }
+    QString errorString() const { return m_socket.errorString(); }
+
+    bool send(NetEndpoint to, const uint8_t* data, size_t size) override;
+    bool receive(NetEndpoint& from, uint8_t* data, size_t& size) override;
+
+    // Looks "host:port" up in the background and hands `done` the endpoint on `context`'s thread, or
+    // 0 if it does not resolve to an IPv4 address; `done` is dropped if `context` goes first. Returns
+    // the lookup id, or -1 without calling `done` if the text is not host:port.
+    static int resolve(const QString& hostAndPort, QObject* context, std::function<void(NetEndpoint)> done);
+    static NetEndpoint endpoint(const QHostAddress& address, quint16 port);
+
+private:
+    QUdpSocket m_socket;
+};
+
+#endif
\ No newline at end of file
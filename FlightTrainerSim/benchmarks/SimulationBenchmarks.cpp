@@ -0,0 +1,213 @@
+// File: benchmarks/SimulationBenchmarks.cpp
+// Google Benchmark suite for the per-tick simulation paths and the debrief. Times are per call;
+// items/s counts calls (or, for lookups, entries searched).
+// Usage: benchmarks [--benchmark_filter=REGEX] [--benchmark_format=json] [--benchmark_out=FILE]
+// Example: benchmarks --benchmark_out=bench-1.0.1.json --benchmark_out_format=json
+#include "AircraftFactory.h"
+#include "Environment.h"
+#include "FlightBatch.h"
+#include "FlightMetrics.h"
+#include "GlobalConfig.h"
+#include "PerformanceEnvelope.h"
+#include "TrainingScenario.h"
+#include <benchmark/benchmark.h>
+#include <limits>
+#include <string>
+
+namespace {
+    // Cruise-like inputs, so no model is clipped at a limit while it is timed.
+    FlightState cruiseState() {
+        FlightState state;
+        state.velocityX = 70.0;
+        state.velocityY = 8.0;
+        state.velocityZ = 1.5;
+        return state;
+    }
+
+    ControlInputs cruiseControls() {
+        ControlInputs controls;
+        controls.elevator = 0.05;
+        controls.aileron = -0.1;
+        controls.rudder = 0.02;
+        controls.throttle = 0.6;
+        controls.gearDown = false;
+        return controls;
+    }
+
+    // One simulated session: `seconds` of 60 Hz snapshots from an aircraft flying the cruise inputs.
+    void fillMetrics(FlightMetrics& metrics, Aircraft& aircraft, double seconds) {
+        const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+        const double step = 1.0 / 60.0;
+        aircraft.setControls(cruiseControls());
+        for (double t = 0.0; t < seconds; t += step) {
+            aircraft.update(step, config);
+            metrics.recordSnapshot(aircraft, t);
+        }
+    }
+
+    template <typename Model>
+    void BM_ComputeForces(benchmark::State& state) {
+        Model model;
+        const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+        const FlightState current = cruiseState();
+        const ControlInputs controls = cruiseControls();
+        FlightState next;
+        for (auto _ : state) {
+            model.computeForces(current, controls, 3000.0, 1.0 / 60.0, config, next);
+            benchmark::DoNotOptimize(next);
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(model.getModelName());
+    }
+
+    void BM_AircraftUpdate(benchmark::State& state) {
+        auto aircraft = AircraftFactory::createAircraft(static_cast<AircraftType>(state.range(0)));
+        const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+        aircraft->setControls(cruiseControls());
+        long step = 0;
+        for (auto _ : state) {
+            aircraft->update(1.0 / 60.0, config);
+            benchmark::DoNotOptimize(aircraft->position());
+            // A minute of flight, then start over before fuel or the altitude cap changes the work.
+            if (++step % 3600 == 0) {
+                state.PauseTiming();
+                aircraft->reset();
+                aircraft->setControls(cruiseControls());
+                state.ResumeTiming();
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(aircraft->flightModel()->getModelName());
+    }
+
+    // One step of `range(0)` trainers in a FlightBatch; items are aircraft, so items/s compares
+    // directly with BM_AircraftUpdate.
+    template <typename T>
+    void BM_BatchStep(benchmark::State& state) {
+        const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+        auto aircraft = AircraftFactory::createAircraft(AircraftType::Trainer);
+        aircraft->setControls(cruiseControls());
+        FlightBatch<T> batch(aircraft->flightModel()->params());
+        const auto fill = [&] {
+            batch.clear();
+            for (int64_t i = 0; i < state.range(0); ++i) batch.add(*aircraft);
+        };
+        fill();
+        long step = 0;
+        for (auto _ : state) {
+            batch.step(1.0 / 60.0, config);
+            benchmark::DoNotOptimize(batch.fuel(0));
+            if (++step % 3600 == 0) {
+                state.PauseTiming();
+                fill();
+                state.ResumeTiming();
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // The envelope reads one aircraft makes per tick for the HUD, warnings and scoring.
+    void BM_EnvelopeLookup(benchmark::State& state) {
+        auto aircraft = AircraftFactory::createAircraft(static_cast<AircraftType>(state.range(0)));
+        const PerformanceEnvelope& envelope = PerformanceEnvelope::forModel(*aircraft->flightModel(), GlobalConfig::instance().snapshot());
+        double altitude = 0.0;
+        for (auto _ : state) {
+            altitude = altitude < PerformanceEnvelope::kMaxAltitude ? altitude + 37.0 : 0.0;
+            benchmark::DoNotOptimize(envelope.stallSpeed(altitude, 0.5, 1.4));
+            benchmark::DoNotOptimize(envelope.maxSpeed(altitude, 0.5));
+            benchmark::DoNotOptimize(envelope.bestClimbSpeed(altitude, 0.5));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(aircraft->flightModel()->getModelName());
+    }
+
+    // Built-in takeoff plus `range(0)` extra rules out of PreFlight that never fire, so every tick
+    // evaluates all of them.
+    void BM_ScenarioUpdate(benchmark::State& state) {
+        auto scenario = TrainingScenario::createBasicTakeoffScenario();
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            const double ceiling = 1e9 + static_cast<double>(i);
+            scenario->addTransitionRule({ ScenarioState::PreFlight, ScenarioState::Failed,
+                                          [ceiling](const Aircraft& a) { return a.altitude() > ceiling; },
+                                          "Rule " + std::to_string(i) });
+        }
+        auto aircraft = AircraftFactory::createAircraft(AircraftType::Trainer);
+        for (auto _ : state) {
+            scenario->update(*aircraft, 1.0 / 60.0);
+            benchmark::DoNotOptimize(scenario->getProgress());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // recordSnapshot after `range(0)` seconds of session are already held.
+    void BM_RecordSnapshot(benchmark::State& state) {
+        auto aircraft = AircraftFactory::createAircraft(AircraftType::Trainer);
+        FlightMetrics metrics;
+        metrics.reserve(std::numeric_limits<double>::infinity(), 1.0 / 60.0);   // as the simulator does
+        fillMetrics(metrics, *aircraft, static_cast<double>(state.range(0)));
+        double t = static_cast<double>(state.range(0));
+        for (auto _ : state) {
+            metrics.recordSnapshot(*aircraft, t);
+            t += 1.0 / 60.0;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_DebriefGenerate(benchmark::State& state) {
+        auto aircraft = AircraftFactory::createAircraft(AircraftType::Trainer);
+        auto scenario = TrainingScenario::createPatternScenario();
+        FlightMetrics metrics;
+        fillMetrics(metrics, *aircraft, static_cast<double>(state.range(0)));
+        for (auto _ : state) {
+            DebriefReport report;
+            report.generate(metrics, *scenario, *aircraft);
+            benchmark::DoNotOptimize(report.overallScore());
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetLabel(std::to_string(metrics.sampleCount()) + " samples");
+    }
+
+    // `range(0)` airfields and waypoints on a 200 km grid.
+    void populate(Environment& environment, int64_t count) {
+        for (int64_t i = 0; i < count; ++i) {
+            const double x = static_cast<double>((i * 7919) % 200000) - 100000.0;
+            const double y = static_cast<double>((i * 104729) % 200000) - 100000.0;
+            environment.addAirfield({ "Field " + std::to_string(i), "K" + std::to_string(i), x, y });
+            environment.addWaypoint({ x, y, 3000.0, "WP" + std::to_string(i) });
+        }
+    }
+
+    void BM_FindNearestAirfield(benchmark::State& state) {
+        Environment environment;
+        populate(environment, state.range(0));
+        double x = 0.0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(environment.findNearestAirfield(x, -x));
+            x = x > 90000.0 ? -90000.0 : x + 1234.5;
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(environment.airfields().size()));
+    }
+
+    void BM_FindWaypoint(benchmark::State& state) {
+        Environment environment;
+        populate(environment, state.range(0));
+        const std::string last = environment.waypoints().back().name;
+        for (auto _ : state) benchmark::DoNotOptimize(environment.findWaypoint(last));
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(environment.waypoints().size()));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ComputeForces, TrainerFlightModel);
+BENCHMARK_TEMPLATE(BM_ComputeForces, JetFlightModel);
+BENCHMARK_TEMPLATE(BM_ComputeForces, CargoFlightModel);
+BENCHMARK(BM_AircraftUpdate)->DenseRange(static_cast<int>(AircraftType::Trainer), static_cast<int>(AircraftType::Cargo));
+BENCHMARK_TEMPLATE(BM_BatchStep, float)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_BatchStep, double)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK(BM_EnvelopeLookup)->DenseRange(static_cast<int>(AircraftType::Trainer), static_cast<int>(AircraftType::Cargo));
+BENCHMARK(BM_ScenarioUpdate)->Arg(0)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_RecordSnapshot)->Arg(60)->Arg(3600)->Arg(4 * 3600);
+BENCHMARK(BM_DebriefGenerate)->Arg(60)->Arg(3600)->Arg(4 * 3600)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FindNearestAirfield)->Range(8, 8 << 10);
+BENCHMARK(BM_FindWaypoint)->Range(8, 8 << 10);
+
+BENCHMARK_MAIN();
@@ -1,12 +1,39 @@
 // File: main.cpp
 #include "MainWindow.h"
+#include "GlobalConfig.h"
 #include <QApplication>
+#include <QFile>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 int main(int argc, char* argv[]) {
     QApplication app(argc, argv);
     app.setApplicationName("FlightTrainerSim");
     app.setOrganizationName("Defense Aviation Systems");
     app.setApplicationVersion("1.0.0");
+    // --trace keeps a rolling timeline and writes it on F4 or after a hitch (see TraceRecorder).
+    // --audio turns on cockpit sound.
+    // --config <file> replaces ./flightsim.conf; the file is watched and reloaded while running.
+    // --host <port> or --join <host:port> shares the sky with other trainees; --callsign names us.
+    // --input <device|auto> flies with a joystick or HOTAS (Linux evdev).
+    // --state-key <name> publishes shared state under another segment name; empty turns it off.
+    auto& config = GlobalConfig::instance();
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--trace") == 0) config.setTraceEnabled(true);
+        else if (std::strcmp(argv[i], "--audio") == 0) config.setAudioEnabled(true);
+        else if (std::strcmp(argv[i], "--config") == 0 && hasValue) config.setConfigPath(argv[++i]);
+        else if (std::strcmp(argv[i], "--host") == 0 && hasValue) config.setNetHostPort(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--join") == 0 && hasValue) config.setNetJoinAddress(argv[++i]);
+        else if (std::strcmp(argv[i], "--callsign") == 0 && hasValue) config.setCallsign(argv[++i]);
+        else if (std::strcmp(argv[i], "--input") == 0 && hasValue) config.setInputDevice(argv[++i]);
+        else if (std::strcmp(argv[i], "--state-key") == 0 && hasValue) config.setSharedStateKey(argv[++i]);
+    }
+    std::string error;
+    if (QFile::exists(QString::fromStdString(config.configPath())) && !config.loadFile(config.configPath(), error)) {
+        std::fprintf(stderr, "Ignoring configuration: %s\n", error.c_str());
+    }
     
     MainWindow mainWindow;
     mainWindow.showMaximized();
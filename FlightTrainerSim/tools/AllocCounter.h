@@ -0,0 +1,52 @@
+// File: tools/AllocCounter.h
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+// Heap-allocation counting for the test tools. Replaces the global operator new and delete, so a
+// tool includes it from exactly one of its source files. Every allocation is charged to the tag
+// set on the allocating thread (see AllocScope); tags are the tool's own, below kMaxAllocTags,
+// and a thread that never sets one charges tag 0. Counts are atomic, so read them with
+// allocationCount() while other threads allocate.
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+constexpr int kMaxAllocTags = 8;
+
+inline thread_local int t_allocTag = 0;
+inline std::atomic<uint64_t> g_allocations[kMaxAllocTags];
+// Size of the allocation that took each tag's count from 0, for pointing at the culprit.
+inline std::atomic<size_t> g_firstAllocSize[kMaxAllocTags];
+
+inline uint64_t allocationCount(int tag) { return g_allocations[tag].load(std::memory_order_relaxed); }
+inline size_t firstAllocSize(int tag) { return g_firstAllocSize[tag].load(std::memory_order_relaxed); }
+inline void resetAllocationCount(int tag, uint64_t count = 0) { g_allocations[tag].store(count, std::memory_order_relaxed); }
+
+inline void* countedAlloc(std::size_t size) {
+    if (g_allocations[t_allocTag].fetch_add(1, std::memory_order_relaxed) == 0)
+        g_firstAllocSize[t_allocTag].store(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// Charges this thread's allocations to `tag` until it goes out of scope.
+class AllocScope {
+public:
+    explicit AllocScope(int tag) : m_previous(t_allocTag) { t_allocTag = tag; }
+    ~AllocScope() { t_allocTag = m_previous; }
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+private:
+    int m_previous;
+};
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#endif
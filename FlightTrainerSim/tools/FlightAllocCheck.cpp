@@ -0,0 +1,155 @@
+// File: tools/FlightAllocCheck.cpp
+// Counts heap allocations made inside simulation ticks. Every built-in scenario is flown by every
+// aircraft under its scripted profile, so state changes and waypoint messages happen along the
+// way: once through AutoFlight::step and once through the simulator's own SimulationEngine tick.
+// After a short warm-up any allocation in a tick is a failure: the run reports how many and the
+// first tick that made one. Exits 1 if any run allocated.
+// Usage: FlightAllocCheck [--scenario NAME] [--aircraft trainer|jet|cargo] [--path autofly|engine]
+//        [--max-time S] [--warmup S]
+// Example: FlightAllocCheck --scenario "Basic Takeoff" --max-time 300
+#include "AllocCounter.h"
+#include "AutoFlight.h"
+#include "AircraftFactory.h"
+#include "SimulationEngine.h"
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+    // Allocations inside a tick past the warm-up; everything else is the harness.
+    enum AllocTag { Harness, Tick };
+
+    struct Run {
+        long ticks = 0;
+        double firstAt = -1.0;
+        uint64_t allocations = 0;
+        size_t firstSize = 0;
+        size_t messages = 0;
+    };
+
+    std::unique_ptr<ScriptedPilotAgent> scriptFor(const std::string& scenarioName) {
+        auto agent = std::make_unique<ScriptedPilotAgent>();
+        std::string error;
+        if (!agent->load(ScriptedPilotAgent::builtinProfile(scenarioName), error)) {
+            std::fprintf(stderr, "%s: %s\n", scenarioName.c_str(), error.c_str());
+            return nullptr;
+        }
+        return agent;
+    }
+
+    // Counts one tick if it ran past the warm-up.
+    template <typename Step>
+    void countTick(Run& run, double tickTime, double warmUp, Step step) {
+        const uint64_t before = allocationCount(Tick);
+        {
+            AllocScope scope(tickTime >= warmUp ? Tick : Harness);
+            step();
+        }
+        if (allocationCount(Tick) > before && run.firstAt < 0.0) run.firstAt = tickTime;
+        ++run.ticks;
+    }
+
+    Run flyAutoFlight(AircraftType type, int scenario, const std::string& scenarioName, double maxTime, double warmUp,
+                      const ConfigSnapshot& config) {
+        Run run;
+        AutoFlight flight(AircraftFactory::createAircraft(type), TrainingScenario::builtin(scenario), scriptFor(scenarioName));
+        const double deltaTime = config.physicsTimeStep();
+        flight.reserve(maxTime, config);
+        resetAllocationCount(Tick);
+        while (!flight.finished() && flight.simulationTime() < maxTime)
+            countTick(run, flight.simulationTime(), warmUp, [&] { flight.step(deltaTime, config); });
+        run.allocations = allocationCount(Tick);
+        run.firstSize = firstAllocSize(Tick);
+        run.messages = flight.scenario().messageCount();
+        return run;
+    }
+
+    // The simulator's own tick: warnings, audio calls, recorder push and shared-state publication on
+    // top of the flight itself. The tick that ends the flight stops the recorder and is not counted.
+    Run flyEngine(AircraftType type, int scenario, const std::string& scenarioName, double maxTime, double warmUp) {
+        Run run;
+        SimulationEngine engine;
+        engine.setActiveAircraft(AircraftFactory::createAircraft(type));
+        engine.setScenario(TrainingScenario::builtin(scenario));
+        engine.setPilotAgent(scriptFor(scenarioName));
+        engine.start();
+        // No event loop runs the engine's between-tick history top-up here, so size it for the run.
+        engine.metrics()->reserve(maxTime, GlobalConfig::instance().physicsTimeStep());
+        resetAllocationCount(Tick);
+        while (engine.isRunning() && engine.simulationTime() < maxTime) {
+            const uint64_t before = allocationCount(Tick);
+            const double firstAt = run.firstAt;
+            countTick(run, engine.simulationTime(), warmUp, [&] { engine.updateSimulation(); });
+            if (!engine.isRunning()) {
+                resetAllocationCount(Tick, before);
+                run.firstAt = firstAt;
+            }
+        }
+        engine.stop();
+        run.allocations = allocationCount(Tick);
+        run.firstSize = firstAllocSize(Tick);
+        run.messages = engine.scenario()->messageCount();
+        return run;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    std::string scenarioFilter, aircraftFilter, pathFilter;
+    double maxTime = 600.0, warmUp = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--scenario") == 0 && hasValue) scenarioFilter = argv[++i];
+        else if (std::strcmp(argv[i], "--aircraft") == 0 && hasValue) aircraftFilter = argv[++i];
+        else if (std::strcmp(argv[i], "--path") == 0 && hasValue) pathFilter = argv[++i];
+        else if (std::strcmp(argv[i], "--max-time") == 0 && hasValue) maxTime = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) warmUp = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--scenario NAME] [--aircraft trainer|jet|cargo] [--path autofly|engine]\n"
+                                 "       [--max-time S] [--warmup S]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // The engine records and publishes as the simulator does, into a scratch directory and a segment
+    // of its own so a running simulator is left alone.
+    QTemporaryDir recordings;
+    auto& globalConfig = GlobalConfig::instance();
+    globalConfig.setRecordFlights(recordings.isValid());
+    globalConfig.setRecordingDirectory(recordings.path().toStdString());
+    globalConfig.setSharedStateKey("FlightAllocCheck." + std::to_string(QCoreApplication::applicationPid()));
+    const ConfigSnapshot& config = globalConfig.snapshot();
+
+    std::printf("%-24s %-8s %-8s %8s %9s %8s %12s\n", "scenario", "aircraft", "path", "ticks", "messages", "allocs", "first at");
+    int runs = 0, failures = 0;
+    for (int s = 0; s < TrainingScenario::builtinCount(); ++s) {
+        const std::string scenarioName = TrainingScenario::builtin(s)->name();
+        if (!scenarioFilter.empty() && scenarioName != scenarioFilter) continue;
+        if (!scriptFor(scenarioName)) return 1;
+        for (const auto& entry : AircraftFactory::kKeys) {
+            if (!aircraftFilter.empty() && aircraftFilter != entry.key) continue;
+            for (const char* path : { "autofly", "engine" }) {
+                if (!pathFilter.empty() && pathFilter != path) continue;
+                const Run run = std::strcmp(path, "engine") == 0 ? flyEngine(entry.type, s, scenarioName, maxTime, warmUp)
+                                                                 : flyAutoFlight(entry.type, s, scenarioName, maxTime, warmUp, config);
+                char firstText[32] = "-";
+                if (run.firstAt >= 0.0) std::snprintf(firstText, sizeof(firstText), "%.2fs (%zuB)", run.firstAt, run.firstSize);
+                std::printf("%-24s %-8s %-8s %8ld %9zu %8llu %12s\n", scenarioName.c_str(), entry.key, path, run.ticks,
+                            run.messages, static_cast<unsigned long long>(run.allocations), firstText);
+                ++runs;
+                if (run.allocations > 0) ++failures;
+            }
+        }
+    }
+    if (runs == 0) {
+        std::fprintf(stderr, "No scenario/aircraft/path matched\n");
+        return 1;
+    }
+    std::printf("%s: %d of %d runs allocated inside a tick after %.1f s of warm-up\n", failures ? "FAIL" : "PASS",
+                failures, runs, warmUp);
+    return failures ? 1 : 0;
+}
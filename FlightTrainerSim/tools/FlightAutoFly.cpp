@@ -0,0 +1,165 @@
+// File: tools/FlightAutoFly.cpp
+// Flies built-in scenarios with no window or audio, each aircraft in turn, under the autopilot or
+// a script, and reports how each flight ended and how far ahead of real time it ran.
+// Usage: FlightAutoFly [--scenario NAME] [--aircraft trainer|jet|cargo] [--agent autopilot|script]
+//        [--script FILE] [--rate HZ] [--max-time S] [--repeat N] [-j threads] [--trace S]
+// Example: FlightAutoFly --agent script --repeat 20 -j 8
+#include "AutoFlight.h"
+#include "AircraftFactory.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Job {
+        int scenario = 0;
+        AircraftType aircraft = AircraftType::Trainer;
+        AutoFlightResult result;
+        std::string error;
+    };
+
+    const char* outcome(const AutoFlightResult& r) {
+        return r.completed ? "completed" : r.failed ? "failed" : "timeout";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string scenarioFilter, aircraftFilter, agentName = "script", scriptPath;
+    double rateHz = 0.0, maxTime = 1800.0, traceInterval = 0.0;
+    int repeat = 1;
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--scenario") == 0 && hasValue) scenarioFilter = argv[++i];
+        else if (std::strcmp(argv[i], "--aircraft") == 0 && hasValue) aircraftFilter = argv[++i];
+        else if (std::strcmp(argv[i], "--agent") == 0 && hasValue) agentName = argv[++i];
+        else if (std::strcmp(argv[i], "--script") == 0 && hasValue) scriptPath = argv[++i];
+        else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) rateHz = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-time") == 0 && hasValue) maxTime = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--repeat") == 0 && hasValue) repeat = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "-j") == 0 && hasValue) threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--trace") == 0 && hasValue) traceInterval = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--scenario NAME] [--aircraft trainer|jet|cargo] [--agent autopilot|script]\n"
+                                 "       [--script FILE] [--rate HZ] [--max-time S] [--repeat N] [-j threads] [--trace S]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (agentName != "autopilot" && agentName != "script") {
+        std::fprintf(stderr, "Unknown agent: %s\n", agentName.c_str());
+        return 1;
+    }
+
+    auto& globalConfig = GlobalConfig::instance();
+    if (rateHz > 0.0) globalConfig.setUpdateRate(rateHz);
+    const ConfigSnapshot& config = globalConfig.snapshot();
+
+    std::vector<Job> jobs;
+    for (int s = 0; s < TrainingScenario::builtinCount(); ++s) {
+        if (!scenarioFilter.empty() && TrainingScenario::builtin(s)->name() != scenarioFilter) continue;
+        for (const auto& aircraft : AircraftFactory::kKeys) {
+            if (!aircraftFilter.empty() && aircraftFilter != aircraft.key) continue;
+            for (int r = 0; r < repeat; ++r) {
+                Job job;
+                job.scenario = s;
+                job.aircraft = aircraft.type;
+                jobs.push_back(job);
+            }
+        }
+    }
+    if (jobs.empty()) {
+        std::fprintf(stderr, "No scenario/aircraft matches\n");
+        return 1;
+    }
+    // Tracing prints from inside the flight, so it only makes sense one flight at a time.
+    if (traceInterval > 0.0) threadCount = 1;
+
+    auto fly = [&](Job& job) {
+        std::unique_ptr<TrainingScenario> scenario = TrainingScenario::builtin(job.scenario);
+        std::unique_ptr<PilotAgent> agent;
+        if (agentName == "autopilot") {
+            AutopilotTargets targets;
+            targets.navigate = true;
+            agent = std::make_unique<AutopilotAgent>(targets);
+        }
+        else {
+            auto script = std::make_unique<ScriptedPilotAgent>();
+            std::string error;
+            const bool loaded = scriptPath.empty() ? script->load(ScriptedPilotAgent::builtinProfile(scenario->name()), error)
+                                                   : script->loadFile(scriptPath, error);
+            if (!loaded) {
+                job.error = error;
+                return;
+            }
+            agent = std::move(script);
+        }
+        AutoFlight flight(AircraftFactory::createAircraft(job.aircraft), std::move(scenario), std::move(agent));
+        if (traceInterval <= 0.0) {
+            job.result = flight.run(maxTime, config);
+            return;
+        }
+        // Fly to each trace point in turn; the last leg's result carries the totals.
+        long steps = 0;
+        double wallSeconds = 0.0;
+        do {
+            const Aircraft& a = flight.aircraft();
+            const ControlInputs& c = a.controls();
+            std::printf("t=%7.1f pos=(%8.0f,%8.0f,%7.0f) v=(%6.1f,%6.1f,%6.1f) wp=%zu elev=%+.2f ail=%+.2f thr=%.2f\n",
+                        flight.simulationTime(), a.position().x, a.position().y, a.altitude(), a.flightState().velocityX,
+                        a.flightState().velocityY, a.flightState().velocityZ, flight.scenario().currentWaypointIndex(),
+                        c.elevator, c.aileron, c.throttle);
+            job.result = flight.run(std::min(flight.simulationTime() + traceInterval, maxTime), config);
+            steps += job.result.steps;
+            wallSeconds += job.result.wallSeconds;
+        } while (!flight.finished() && flight.simulationTime() < maxTime);
+        job.result.steps = steps;
+        job.result.wallSeconds = wallSeconds;
+    };
+
+    const auto startTime = std::chrono::steady_clock::now();
+    std::atomic<size_t> nextJob(0);
+    std::vector<std::thread> workers;
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, jobs.size()));
+    for (unsigned t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&]() {
+            for (size_t i = nextJob.fetch_add(1); i < jobs.size(); i = nextJob.fetch_add(1)) fly(jobs[i]);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::printf("%-26s %-22s %-10s %8s %9s %8s %9s %10s %6s\n", "scenario", "aircraft", "outcome", "progress", "sim s", "wall ms",
+                "x real", "steps/s", "score");
+    size_t completed = 0, broken = 0;
+    double simulated = 0.0;
+    long steps = 0;
+    for (const Job& job : jobs) {
+        const std::string scenarioName = TrainingScenario::builtin(job.scenario)->name();
+        const std::string aircraftName = AircraftFactory::getAircraftTypeName(job.aircraft);
+        if (!job.error.empty()) {
+            std::printf("%-26s %-22s script error: %s\n", scenarioName.c_str(), aircraftName.c_str(), job.error.c_str());
+            ++broken;
+            continue;
+        }
+        const AutoFlightResult& r = job.result;
+        const double wall = std::max(r.wallSeconds, 1e-9);
+        std::printf("%-26s %-22s %-10s %7.0f%% %9.1f %8.1f %9.0f %10.0f %6.1f\n", scenarioName.c_str(), aircraftName.c_str(),
+                    outcome(r), r.progress, r.simulatedSeconds, r.wallSeconds * 1000.0, r.simulatedSeconds / wall, r.steps / wall,
+                    r.score);
+        if (!r.trimmed) std::printf("  (cannot trim at the scenario's initial condition; started from reset)\n");
+        if (r.completed) ++completed;
+        simulated += r.simulatedSeconds;
+        steps += r.steps;
+    }
+    std::printf("%zu/%zu flights completed, %.0f s simulated in %.2f s on %u threads (%.0fx real time, %.0f steps/s at %.0f Hz)\n",
+                completed, jobs.size(), simulated, elapsed, threadCount, simulated / std::max(elapsed, 1e-9),
+                steps / std::max(elapsed, 1e-9), config.updateRateHz);
+    return broken > 0 ? 1 : 0;
+}
\ No newline at end of file
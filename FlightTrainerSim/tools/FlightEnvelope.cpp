@@ -0,0 +1,78 @@
+// File: tools/FlightEnvelope.cpp
+// Builds (or loads) the cached performance envelopes and prints them: stall speed clean, with full
+// flaps and in a 60 degree bank, max and best-climb speed and climb rate every 5000 ft, the service
+// ceiling, and what a lookup costs. Exits 1 if an envelope's clean 1 g stall speed at sea level
+// is not the model's own stall speed.
+// Usage: FlightEnvelope [--aircraft trainer|jet|cargo] [--cache DIR] [--rebuild]
+// Example: FlightEnvelope --aircraft cargo --rebuild
+#include "AircraftFactory.h"
+#include "GlobalConfig.h"
+#include "PerformanceEnvelope.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string aircraftFilter;
+    bool rebuild = false;
+    GlobalConfig& globalConfig = GlobalConfig::instance();
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--aircraft") == 0 && hasValue) aircraftFilter = argv[++i];
+        else if (std::strcmp(argv[i], "--cache") == 0 && hasValue) globalConfig.setCacheDirectory(argv[++i]);
+        else if (std::strcmp(argv[i], "--rebuild") == 0) rebuild = true;
+        else {
+            std::fprintf(stderr, "Usage: %s [--aircraft trainer|jet|cargo] [--cache DIR] [--rebuild]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const ConfigSnapshot& config = globalConfig.snapshot();
+    int runs = 0, failures = 0;
+    for (const auto& entry : AircraftFactory::kKeys) {
+        if (!aircraftFilter.empty() && aircraftFilter != entry.key) continue;
+        ++runs;
+        // Pick the model up without an Aircraft, which would load the envelope before the timer starts.
+        auto model = AircraftFactory::createFlightModel(entry.type);
+        const std::string path = PerformanceEnvelope::cachePath(*model);
+        if (rebuild) std::remove(path.c_str());
+
+        const auto start = std::chrono::steady_clock::now();
+        const PerformanceEnvelope& envelope = PerformanceEnvelope::forModel(*model, config);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%s: envelope ready in %.2f ms (%s)\n", model->getModelName().c_str(), ms, path.c_str());
+        std::printf("  ceiling %.0f ft clean, %.0f ft full flaps\n", envelope.serviceCeiling(0.0), envelope.serviceCeiling(1.0));
+        std::printf("  %8s %8s %8s %8s %8s %8s %10s\n", "ft", "Vs", "Vs flap", "Vs 60", "Vmax", "Vy", "climb fpm");
+        const double bank60 = PerformanceEnvelope::loadFactorForBank(60.0);
+        for (double altitude = 0.0; altitude <= PerformanceEnvelope::kMaxAltitude; altitude += 5000.0) {
+            std::printf("  %8.0f %8.1f %8.1f %8.1f %8.1f %8.1f %10.0f\n", altitude, envelope.stallSpeed(altitude, 0.0),
+                        envelope.stallSpeed(altitude, 1.0), envelope.stallSpeed(altitude, 0.0, bank60),
+                        envelope.maxSpeed(altitude, 0.0), envelope.bestClimbSpeed(altitude, 0.0), envelope.climbRate(altitude, 0.0));
+        }
+
+        const int kLookups = 1000000;
+        double sum = 0.0;
+        const auto lookupStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < kLookups; ++i) {
+            const double altitude = (i % 6000) * 10.0;
+            const double flaps = (i % 5) * 0.25;
+            sum += envelope.stallSpeed(altitude, flaps, 1.0 + (i % 7) * 0.4) + envelope.maxSpeed(altitude, flaps) +
+                   envelope.bestClimbSpeed(altitude, flaps);
+        }
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - lookupStart).count();
+        std::printf("  %.1f ns per stall + max + best-climb lookup (checksum %.0f)\n", ns / kLookups, sum);
+
+        const double stall = envelope.stallSpeed(0.0, 0.0);
+        if (std::abs(stall - model->getStallSpeed()) > 1e-9 * model->getStallSpeed()) {
+            std::printf("  FAIL: sea-level stall speed %.6f, model says %.6f\n", stall, model->getStallSpeed());
+            ++failures;
+        }
+    }
+    if (runs == 0) {
+        std::fprintf(stderr, "No aircraft matched\n");
+        return 1;
+    }
+    return failures ? 1 : 0;
+}
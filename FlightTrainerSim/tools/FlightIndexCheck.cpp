@@ -0,0 +1,94 @@
+// File: tools/FlightIndexCheck.cpp
+// Checks that the session index survives an append cut short: writes two sessions, starts a third
+// and truncates it mid-record as a crash would, appends a fourth and reloads. The two complete
+// sessions and the fourth must load intact, and the partial third must be gone. Exits 1 on any
+// mismatch.
+// Usage: FlightIndexCheck
+#include "SessionIndex.h"
+#include <QFile>
+#include <QTemporaryDir>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    SessionEntry session(int n) {
+        SessionEntry entry;
+        entry.sessionFile = "flight_" + std::to_string(n) + ".fdr";
+        entry.traineeId = n % 2 ? "alice" : "bob";
+        entry.aircraftModel = "Cessna 172";
+        entry.scenarioName = "Traffic Pattern";
+        entry.startTimeMs = 1750000000000 + n * 600000;
+        entry.flightTime = 300.0 + n;
+        entry.overallScore = 70.0 + n;
+        entry.categoryScores["Altitude Control"] = 60.0 + n;
+        return entry;
+    }
+
+    bool same(const SessionEntry& a, const SessionEntry& b) {
+        return a.sessionFile == b.sessionFile && a.traineeId == b.traineeId && a.aircraftModel == b.aircraftModel
+            && a.scenarioName == b.scenarioName && a.startTimeMs == b.startTimeMs
+            && static_cast<float>(a.flightTime) == static_cast<float>(b.flightTime)
+            && static_cast<float>(a.overallScore) == static_cast<float>(b.overallScore);
+    }
+
+    qint64 fileSize(const std::string& path) {
+        QFile file(QString::fromStdString(path));
+        return file.open(QIODevice::ReadOnly) ? file.size() : -1;
+    }
+
+    bool expect(const std::string& path, const std::vector<int>& sessions, const char* stage) {
+        SessionIndex index;
+        if (!index.load(path)) {
+            std::fprintf(stderr, "FAIL %s: index does not load\n", stage);
+            return false;
+        }
+        if (index.size() != sessions.size()) {
+            std::fprintf(stderr, "FAIL %s: %zu sessions, expected %zu\n", stage, index.size(), sessions.size());
+            return false;
+        }
+        for (size_t row = 0; row < sessions.size(); ++row) {
+            if (!same(index.entry(row), session(sessions[row]))) {
+                std::fprintf(stderr, "FAIL %s: row %zu is not session %d\n", stage, row, sessions[row]);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        std::fprintf(stderr, "Cannot create a temporary directory\n");
+        return 1;
+    }
+    const std::string path = dir.path().toStdString() + "/sessions.fsi";
+
+    bool ok = SessionIndex::appendToFile(path, session(1)) && SessionIndex::appendToFile(path, session(2));
+    const qint64 complete = fileSize(path);
+    ok = ok && SessionIndex::appendToFile(path, session(3));
+    const qint64 withThird = fileSize(path);
+    if (!ok || complete <= 0 || withThird <= complete) {
+        std::fprintf(stderr, "FAIL: cannot write the index\n");
+        return 1;
+    }
+    {
+        QFile file(QString::fromStdString(path));
+        if (!file.open(QIODevice::ReadWrite) || !file.resize(complete + (withThird - complete) / 2)) {
+            std::fprintf(stderr, "FAIL: cannot truncate the index\n");
+            return 1;
+        }
+    }
+    ok = expect(path, { 1, 2 }, "after the interrupted append");
+
+    if (!SessionIndex::appendToFile(path, session(4))) {
+        std::fprintf(stderr, "FAIL: append after the interrupted one\n");
+        return 1;
+    }
+    ok = expect(path, { 1, 2, 4 }, "after the next append") && ok;
+    ok = SessionIndex::appendToFile(path, session(5)) && expect(path, { 1, 2, 4, 5 }, "after a further append") && ok;
+
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
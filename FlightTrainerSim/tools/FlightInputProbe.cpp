@@ -0,0 +1,133 @@
+// File: tools/FlightInputProbe.cpp
+// Polls a stick the way the simulator does and measures how old each reading is by the time a
+// physics step consumes it. Without --device a virtual stick is moved from another thread, which
+// times the poller and queue alone; with a real device the numbers include the kernel path too.
+// Usage: FlightInputProbe [--device PATH|auto] [--rate HZ] [--tick-hz HZ] [--seconds S] [--quiet]
+// Example: FlightInputProbe --rate 2000 --tick-hz 120
+#include "InputPoller.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    double percentile(std::vector<double>& values, double q) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        return values[static_cast<size_t>(q * (values.size() - 1))];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string devicePath;
+    double rateHz = InputPoller::kDefaultRateHz, tickHz = 60.0, seconds = 10.0;
+    bool quiet = false;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--device") == 0 && hasValue) devicePath = argv[++i];
+        else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) rateHz = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--tick-hz") == 0 && hasValue) tickHz = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) seconds = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else {
+            std::fprintf(stderr, "Usage: %s [--device PATH|auto] [--rate HZ] [--tick-hz HZ] [--seconds S] [--quiet]\n", argv[0]);
+            return 1;
+        }
+    }
+    tickHz = std::clamp(tickHz, 1.0, 1000.0);
+
+    std::unique_ptr<InputDevice> device;
+    VirtualInputDevice* virtualStick = nullptr;
+    if (devicePath.empty()) {
+        auto stick = std::make_unique<VirtualInputDevice>();
+        virtualStick = stick.get();
+        device = std::move(stick);
+    }
+    else {
+#ifdef __linux__
+        if (devicePath == "auto") {
+            const std::vector<std::string> found = EvdevInputDevice::findJoysticks();
+            if (found.empty()) {
+                std::fprintf(stderr, "No joystick found under /dev/input\n");
+                return 1;
+            }
+            devicePath = found.front();
+        }
+        std::string error;
+        device = EvdevInputDevice::open(devicePath, error);
+        if (!device) {
+            std::fprintf(stderr, "%s: %s\n", devicePath.c_str(), error.c_str());
+            return 1;
+        }
+#else
+        std::fprintf(stderr, "Hardware devices need Linux evdev; run without --device for the virtual stick\n");
+        return 1;
+#endif
+    }
+    std::printf("device: %s\n", device->name().c_str());
+
+    InputPoller poller(std::move(device));
+    poller.setRateHz(rateHz);
+    poller.start();
+
+    // The virtual stick sweeps every axis at an odd interval so events land all over the tick.
+    std::atomic<bool> moving(virtualStick != nullptr);
+    std::thread mover;
+    if (virtualStick) {
+        mover = std::thread([virtualStick, &moving] {
+            double phase = 0.0;
+            while (moving.load()) {
+                phase += 0.05;
+                virtualStick->set(InputAxis::Elevator, static_cast<float>(std::sin(phase)));
+                virtualStick->set(InputAxis::Aileron, static_cast<float>(std::cos(phase * 0.7)));
+                virtualStick->set(InputAxis::Throttle, static_cast<float>(0.5 + 0.5 * std::sin(phase * 0.3)));
+                std::this_thread::sleep_for(std::chrono::microseconds(2300));
+            }
+        });
+    }
+
+    // Stand-in for the physics step: take the newest reading due, note its age when the step ends.
+    using Clock = std::chrono::steady_clock;
+    const auto tick = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / tickHz));
+    const auto startTime = Clock::now();
+    auto next = startTime;
+    std::vector<double> latencyUs, pollDelayUs;
+    long ticks = 0, ticksWithInput = 0, merged = 0;
+    while (Clock::now() - startTime < std::chrono::duration<double>(seconds)) {
+        next += tick;
+        std::this_thread::sleep_until(next);
+        ++ticks;
+        InputSample sample;
+        int superseded = 0;
+        if (!poller.takeUntil(InputDevice::nowNs(), sample, &superseded)) continue;
+        ++ticksWithInput;
+        merged += superseded;
+        latencyUs.push_back((InputDevice::nowNs() - sample.eventNs) / 1000.0);
+        pollDelayUs.push_back((sample.polledNs - sample.eventNs) / 1000.0);
+        if (!quiet && !virtualStick) {
+            std::printf("elev %+.3f  ail %+.3f  rud %+.3f  thr %.3f  buttons %08x  age %.2fms\n", sample.axes[0], sample.axes[1],
+                        sample.axes[2], sample.axes[3], sample.buttons, latencyUs.back() / 1000.0);
+        }
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - startTime).count();
+    moving.store(false);
+    if (mover.joinable()) mover.join();
+    poller.stop();
+
+    std::printf("poll rate: requested %.0fHz, achieved %.0fHz, worst wake-up %.0fus late\n", rateHz, poller.polls() / elapsed,
+                poller.maxWakeLateUs());
+    std::printf("ticks: %ld at %.0fHz, %ld with new input, %ld superseded readings, %llu dropped on a full queue\n", ticks, tickHz,
+                ticksWithInput, merged, static_cast<unsigned long long>(poller.dropped()));
+    const double pollP50 = percentile(pollDelayUs, 0.5), pollP99 = percentile(pollDelayUs, 0.99);
+    std::printf("event to poll:  p50=%.0fus p99=%.0fus\n", pollP50, pollP99);
+    const double p50 = percentile(latencyUs, 0.5), p99 = percentile(latencyUs, 0.99);
+    std::printf("event to step:  p50=%.0fus p99=%.0fus max=%.0fus (%zu samples)\n", p50, p99,
+                latencyUs.empty() ? 0.0 : latencyUs.back(), latencyUs.size());
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+// File: tools/FlightNetHarness.cpp
+// Runs a host and up to 31 clients through an in-memory network that drops, delays and reorders
+// datagrams, with every aircraft flying a known path, and reports bandwidth, CPU per update and
+// how far the dead-reckoned traffic strays from the true positions.
+// Usage: FlightNetHarness [--clients N] [--loss PCT] [--latency MS] [--jitter MS] [--rate HZ] [--seconds S]
+// Example: FlightNetHarness --clients 31 --loss 10 --latency 80 --jitter 30
+#include "NetSession.h"
+#include "FlightRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr double kStep = 0.01;                  // session update period, as in the simulator
+
+    struct Datagram {
+        double deliverAt;
+        NetEndpoint from;
+        std::vector<uint8_t> bytes;
+    };
+
+    class LoopbackNetwork {
+    public:
+        LoopbackNetwork(size_t endpoints, double loss, double latency, double jitter)
+            : m_queues(endpoints + 1), m_loss(loss), m_latency(latency), m_jitter(jitter), m_random(42), m_now(0.0),
+              m_dropped(0), m_delivered(0) {}
+
+        void setTime(double now) { m_now = now; }
+        void send(NetEndpoint from, NetEndpoint to, const uint8_t* data, size_t size) {
+            if (to >= m_queues.size() || std::uniform_real_distribution<double>(0.0, 1.0)(m_random) < m_loss) {
+                ++m_dropped;
+                return;
+            }
+            const double delay = m_latency + std::uniform_real_distribution<double>(-m_jitter, m_jitter)(m_random);
+            m_queues[to].push_back({ m_now + std::max(0.0, delay), from, std::vector<uint8_t>(data, data + size) });
+        }
+        // Earliest due datagram first, so jitter reorders as it would on a real path.
+        bool receive(NetEndpoint at, NetEndpoint& from, uint8_t* data, size_t& size) {
+            auto& queue = m_queues[at];
+            auto due = queue.end();
+            for (auto it = queue.begin(); it != queue.end(); ++it) {
+                if (it->deliverAt <= m_now && (due == queue.end() || it->deliverAt < due->deliverAt)) due = it;
+            }
+            if (due == queue.end()) return false;
+            from = due->from;
+            size = due->bytes.size();
+            std::copy(due->bytes.begin(), due->bytes.end(), data);
+            queue.erase(due);
+            ++m_delivered;
+            return true;
+        }
+        uint64_t dropped() const { return m_dropped; }
+        uint64_t delivered() const { return m_delivered; }
+
+    private:
+        std::vector<std::deque<Datagram>> m_queues;
+        double m_loss, m_latency, m_jitter;
+        std::mt19937 m_random;
+        double m_now;
+        uint64_t m_dropped, m_delivered;
+    };
+
+    class LoopbackTransport : public NetTransport {
+    public:
+        LoopbackTransport(LoopbackNetwork& network, NetEndpoint self) : m_network(network), m_self(self) {}
+        bool send(NetEndpoint to, const uint8_t* data, size_t size) override {
+            m_network.send(m_self, to, data, size);
+            return true;
+        }
+        bool receive(NetEndpoint& from, uint8_t* data, size_t& size) override {
+            return m_network.receive(m_self, from, data, size);
+        }
+    private:
+        LoopbackNetwork& m_network;
+        NetEndpoint m_self;
+    };
+
+    // Each aircraft orbits its own centre; odd ones reverse their turn every 20 s so the dead
+    // reckoning sees roll-outs as well as steady turns.
+    FlightRecord truth(int entity, double t) {
+        const double radius = 600.0 + 40.0 * entity;
+        const double speed = 70.0 + 3.0 * entity;
+        const double cx = 2000.0 * (entity % 6), cy = 2000.0 * (entity / 6);
+        double angle = speed * t / radius + entity;
+        double direction = 1.0;
+        if (entity % 2 == 1) {
+            const double phase = std::fmod(t, 40.0);
+            direction = phase < 20.0 ? 1.0 : -1.0;
+            angle = speed * (phase < 20.0 ? phase : 40.0 - phase) / radius + entity;
+        }
+        FlightRecord r{};
+        r.timestamp = t;
+        r.x = cx + radius * std::cos(angle);
+        r.y = cy + radius * std::sin(angle);
+        r.altitude = 1500.0 + 100.0 * entity + 50.0 * std::sin(t * 0.2 + entity);
+        r.velocityX = -direction * speed * std::sin(angle);
+        r.velocityY = direction * speed * std::cos(angle);
+        r.velocityZ = 10.0 * std::cos(t * 0.2 + entity);
+        r.heading = std::fmod(std::atan2(r.velocityX, r.velocityY) * 180.0 / 3.14159265358979 + 360.0, 360.0);
+        r.bank = direction * std::atan(speed * speed / (radius * 32.2)) * 180.0 / 3.14159265358979;
+        r.pitch = 2.0;
+        r.throttle = 0.7;
+        r.speed = speed;
+        return r;
+    }
+
+    double percentile(std::vector<double>& values, double q) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        return values[static_cast<size_t>(q * (values.size() - 1))];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int clients = NetProtocol::kMaxParticipants - 1;
+    double lossPct = 5.0, latencyMs = 50.0, jitterMs = 20.0, rateHz = 20.0, seconds = 60.0;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--clients") == 0 && hasValue) clients = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--loss") == 0 && hasValue) lossPct = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--latency") == 0 && hasValue) latencyMs = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--jitter") == 0 && hasValue) jitterMs = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) rateHz = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) seconds = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--clients N] [--loss PCT] [--latency MS] [--jitter MS] [--rate HZ] [--seconds S]\n", argv[0]);
+            return 1;
+        }
+    }
+    clients = std::clamp(clients, 1, NetProtocol::kMaxParticipants - 1);
+    jitterMs = std::min(jitterMs, latencyMs);
+
+    LoopbackNetwork network(static_cast<size_t>(clients) + 1, lossPct / 100.0, latencyMs / 1000.0, jitterMs / 1000.0);
+    std::vector<std::unique_ptr<LoopbackTransport>> transports;
+    std::vector<std::unique_ptr<NetSession>> sessions;
+    for (int i = 0; i <= clients; ++i) {
+        transports.push_back(std::make_unique<LoopbackTransport>(network, static_cast<NetEndpoint>(i + 1)));
+        const NetSession::Role role = i == 0 ? NetSession::Role::Host : NetSession::Role::Client;
+        char callsign[16];
+        std::snprintf(callsign, sizeof(callsign), "TRN%02d", i);
+        sessions.push_back(std::make_unique<NetSession>(*transports.back(), role, callsign, "Cessna 172"));
+        if (i > 0) sessions.back()->connectTo(1);
+    }
+
+    // Dead-reckoning error is measured from the first client's view once everyone has joined.
+    std::vector<double> errors, hostUpdateUs, clientUpdateUs;
+    std::vector<TrafficAircraft> traffic;
+    const double settle = 2.0;
+    const long steps = static_cast<long>(seconds / kStep);
+    for (long step = 0; step <= steps; ++step) {
+        const double t = step * kStep;
+        network.setTime(t);
+        for (int i = 0; i <= clients; ++i) {
+            NetSession& session = *sessions[static_cast<size_t>(i)];
+            if (session.connected()) session.setLocalState(truth(session.entityId(), t));
+            const auto start = std::chrono::steady_clock::now();
+            session.update(t, rateHz);
+            const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            if (t >= settle) (i == 0 ? hostUpdateUs : clientUpdateUs).push_back(us);
+        }
+        if (t < settle) continue;
+        sessions[1]->traffic(t, traffic);
+        for (const TrafficAircraft& aircraft : traffic) {
+            const FlightRecord r = truth(aircraft.id, t);
+            const Position3D& p = aircraft.state.position;
+            errors.push_back(std::sqrt((p.x - r.x) * (p.x - r.x) + (p.y - r.y) * (p.y - r.y) + (p.z - r.altitude) * (p.z - r.altitude)));
+        }
+    }
+
+    const NetStats& host = sessions[0]->stats();
+    uint64_t clientBytes = 0, lost = 0, undecodable = host.undecodable, oversized = host.oversized;
+    int joined = 0;
+    for (int i = 1; i <= clients; ++i) {
+        const NetStats& stats = sessions[static_cast<size_t>(i)]->stats();
+        clientBytes += stats.bytesSent + stats.bytesReceived;
+        lost += stats.packetsLost;
+        undecodable += stats.undecodable;
+        oversized += stats.oversized;
+        if (sessions[static_cast<size_t>(i)]->connected()) ++joined;
+    }
+    lost += host.packetsLost;
+
+    std::printf("participants=%d joined=%d visible-from-client-1=%d rate=%.0fHz loss=%.1f%% latency=%.0f+-%.0fms duration=%.0fs\n",
+                clients + 1, joined, sessions[1]->participantCount(), rateHz, lossPct, latencyMs, jitterMs, seconds);
+    std::printf("bandwidth: host out %.1f KB/s, host in %.1f KB/s, per client (up+down) %.2f KB/s\n",
+                host.bytesSent / seconds / 1024.0, host.bytesReceived / seconds / 1024.0, clientBytes / seconds / 1024.0 / clients);
+    std::printf("packets: delivered=%llu dropped=%llu seen-as-lost=%llu undecodable=%llu oversized=%llu\n",
+                static_cast<unsigned long long>(network.delivered()), static_cast<unsigned long long>(network.dropped()),
+                static_cast<unsigned long long>(lost), static_cast<unsigned long long>(undecodable),
+                static_cast<unsigned long long>(oversized));
+    std::printf("update cpu: host p50=%.1fus p99=%.1fus, client p50=%.1fus p99=%.1fus\n",
+                percentile(hostUpdateUs, 0.5), percentile(hostUpdateUs, 0.99), percentile(clientUpdateUs, 0.5), percentile(clientUpdateUs, 0.99));
+    const double p50 = percentile(errors, 0.5), p99 = percentile(errors, 0.99);
+    std::printf("dead-reckoning error: p50=%.2f p99=%.2f max=%.2f (%zu samples)\n",
+                p50, p99, errors.empty() ? 0.0 : errors.back(), errors.size());
+    return 0;
+}
@@ -0,0 +1,215 @@
+// File: tools/FlightPaintBench.cpp
+// Paints Cockpit3DView and Outside3DView offscreen, frame after frame, while a synthetic flight
+// moves the aircraft, and reports the per-frame time distribution of each draw routine for every
+// combination of window size and flight-path length.
+// Usage: FlightPaintBench [-n frames] [-s WxH[,WxH...]] [--path N[,N...]] [-v cockpit|outside|both]
+//                         [--traffic N] [--json FILE]
+// Example: FlightPaintBench -s 1280x720,2560x1440 --path 0,1000 --json paint.json
+#include "Cockpit3DView.h"
+#include "Outside3DView.h"
+#include "AircraftFactory.h"
+#include "Environment.h"
+#include "GlobalConfig.h"
+#include "Profiler.h"
+#include <QApplication>
+#include <QImage>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr double kStep = 1.0 / 60.0;
+    constexpr int kMaxPath = static_cast<int>(Aircraft::kFlightPathLength);
+
+    const ProfileStage kCockpitStages[] = {
+        ProfileStage::CockpitPaint, ProfileStage::HudAttitude, ProfileStage::HudAirspeed, ProfileStage::HudAltimeter,
+        ProfileStage::HudHeading, ProfileStage::HudVerticalSpeed, ProfileStage::HudThrottle, ProfileStage::HudWarnings,
+    };
+    const ProfileStage kOutsideStages[] = {
+        ProfileStage::OutsidePaint, ProfileStage::SceneRaster, ProfileStage::SceneWaypoints, ProfileStage::SceneTraffic,
+        ProfileStage::ScenePath, ProfileStage::SceneInfo,
+    };
+
+    struct Row {
+        std::string view;
+        int width, height, path;
+        ProfileStage stage;
+        ProfileStats stats;
+    };
+
+    // Weaving climbs and turns, so every tape, the attitude ball and the trail keep moving.
+    void fly(Aircraft& aircraft, double& time) {
+        ControlInputs controls = aircraft.controls();
+        controls.elevator = 0.15 * std::sin(time / 5.0);
+        controls.aileron = 0.4 * std::sin(time / 7.0);
+        controls.rudder = 0.1 * std::sin(time / 3.0);
+        controls.throttle = 0.4;
+        controls.gearDown = false;
+        aircraft.setControls(controls);
+        aircraft.update(kStep, GlobalConfig::instance().snapshot());
+        time += kStep;
+    }
+
+    // Other aircraft in a ring around ours, each on its own heading.
+    std::vector<TrafficAircraft> trafficAround(const Aircraft& aircraft, double time, int count) {
+        std::vector<TrafficAircraft> traffic(static_cast<size_t>(count));
+        const AircraftRenderState own = AircraftRenderState::capture(aircraft, time);
+        for (int i = 0; i < count; ++i) {
+            const double angle = 2.0 * M_PI * i / count;
+            TrafficAircraft& other = traffic[static_cast<size_t>(i)];
+            other.id = i + 1;
+            other.callsign = "TFC" + std::to_string(i + 1);
+            other.model = i % 2 ? "C-130 Hercules" : "F-16 Fighting Falcon";
+            other.state = own;
+            other.state.position.x += 800.0 * std::cos(angle);
+            other.state.position.y += 800.0 * std::sin(angle);
+            other.state.heading = std::fmod(own.heading + 45.0 * i, 360.0);
+        }
+        return traffic;
+    }
+
+    bool parseList(const char* text, std::vector<int>& out) {
+        out.clear();
+        std::stringstream list(text);
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            char* end = nullptr;
+            const long value = std::strtol(item.c_str(), &end, 10);
+            if (item.empty() || *end != '\0' || value < 0) return false;
+            out.push_back(static_cast<int>(value));
+        }
+        return !out.empty();
+    }
+
+    bool parseSizes(const char* text, std::vector<std::pair<int, int>>& out) {
+        out.clear();
+        std::stringstream list(text);
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            int width = 0, height = 0;
+            if (std::sscanf(item.c_str(), "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) return false;
+            out.emplace_back(width, height);
+        }
+        return !out.empty();
+    }
+
+    bool writeJson(const std::string& path, const std::vector<Row>& rows, int frames) {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) return false;
+        std::fprintf(file, "{\"frames\":%d,\"results\":[", frames);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const Row& row = rows[i];
+            std::fprintf(file, "%s\n{\"view\":\"%s\",\"width\":%d,\"height\":%d,\"path\":%d,\"stage\":\"%s\","
+                               "\"samples\":%zu,\"p50_us\":%.2f,\"p99_us\":%.2f,\"max_us\":%.2f}",
+                         i ? "," : "", row.view.c_str(), row.width, row.height, row.path, Profiler::stageName(row.stage),
+                         row.stats.samples, row.stats.p50Us, row.stats.p99Us, row.stats.maxUs);
+        }
+        std::fprintf(file, "\n]}\n");
+        return std::fclose(file) == 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int frames = 300, trafficCount = 0;
+    std::vector<std::pair<int, int>> sizes = { { 800, 600 }, { 1280, 720 }, { 1920, 1080 } };
+    std::vector<int> pathLengths = { 0, 250, kMaxPath };
+    std::string view = "both", jsonPath;
+    bool badArgs = false;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "-n") == 0 && hasValue) frames = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "-s") == 0 && hasValue) badArgs |= !parseSizes(argv[++i], sizes);
+        else if (std::strcmp(argv[i], "--path") == 0 && hasValue) badArgs |= !parseList(argv[++i], pathLengths);
+        else if (std::strcmp(argv[i], "-v") == 0 && hasValue) view = argv[++i];
+        else if (std::strcmp(argv[i], "--traffic") == 0 && hasValue) trafficCount = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue) jsonPath = argv[++i];
+        else badArgs = true;
+    }
+    const bool paintCockpit = view == "cockpit" || view == "both";
+    const bool paintOutside = view == "outside" || view == "both";
+    // Each stage's distribution is the profiler's rolling window, so a run is at most one window long.
+    if (badArgs || frames <= 0 || frames > static_cast<int>(Profiler::kWindowSize) || trafficCount < 0
+        || (!paintCockpit && !paintOutside)) {
+        std::fprintf(stderr, "Usage: %s [-n frames (1-%zu)] [-s WxH[,WxH...]] [--path N[,N...]] "
+                             "[-v cockpit|outside|both] [--traffic N] [--json FILE]\n", argv[0], Profiler::kWindowSize);
+        return 1;
+    }
+
+    // No display needed: the offscreen platform provides fonts and a paint engine.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    Profiler::setEnabled(true);
+    Profiler& profiler = Profiler::instance();
+    Environment environment;
+    std::vector<Row> rows;
+
+    std::printf("%-8s %10s %5s  %-14s %9s %9s %9s\n", "view", "size", "path", "stage", "p50 us", "p99 us", "max us");
+    for (const auto& dimensions : sizes) {
+        const int width = dimensions.first, height = dimensions.second;
+        for (int pathLength : pathLengths) {
+            pathLength = std::min(pathLength, kMaxPath);
+            // A fresh flight for each combination, flown until its trail has the requested length.
+            auto aircraft = AircraftFactory::createAircraft(AircraftType::Trainer);
+            double time = 0.0;
+            while (static_cast<int>(aircraft->flightPathSize()) < pathLength) fly(*aircraft, time);
+
+            Cockpit3DView cockpit;
+            Outside3DView outside;
+            cockpit.setAircraft(aircraft.get());
+            outside.setAircraft(aircraft.get());
+            outside.setEnvironment(&environment);
+            cockpit.resize(width, height);
+            outside.resize(width, height);
+            QImage image(width, height, QImage::Format_RGB32);
+
+            profiler.clear();
+            for (int frame = 0; frame < frames; ++frame) {
+                fly(*aircraft, time);
+                const AircraftRenderState state = AircraftRenderState::capture(*aircraft, time);
+                if (paintCockpit) {
+                    cockpit.setRenderState(state);
+                    cockpit.render(&image);
+                }
+                if (paintOutside) {
+                    outside.setRenderState(state);
+                    outside.setTraffic(trafficAround(*aircraft, time, trafficCount));
+                    outside.render(&image);
+                }
+                profiler.collect();
+            }
+
+            auto report = [&](const char* name, const ProfileStage* stages, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    Row row{ name, width, height, static_cast<int>(aircraft->flightPathSize()), stages[i], profiler.stats(stages[i]) };
+                    if (row.stats.samples == 0) continue;
+                    char sizeText[24];
+                    std::snprintf(sizeText, sizeof(sizeText), "%dx%d", width, height);
+                    std::printf("%-8s %10s %5d  %-14s %9.1f %9.1f %9.1f\n", name, sizeText, row.path, Profiler::stageName(row.stage),
+                                row.stats.p50Us, row.stats.p99Us, row.stats.maxUs);
+                    rows.push_back(row);
+                }
+            };
+            if (paintCockpit) report("cockpit", kCockpitStages, std::size(kCockpitStages));
+            if (paintOutside) report("outside", kOutsideStages, std::size(kOutsideStages));
+        }
+    }
+    if (rows.empty()) {
+        std::fprintf(stderr, "No paint timings recorded; was this built with FLIGHTSIM_PROFILING off?\n");
+        return 1;
+    }
+    if (profiler.droppedSamples() > 0) {
+        std::fprintf(stderr, "%llu profiler samples dropped; distributions are incomplete\n",
+                     static_cast<unsigned long long>(profiler.droppedSamples()));
+    }
+    if (!jsonPath.empty() && !writeJson(jsonPath, rows, frames)) {
+        std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// File: tools/FlightPrecision.cpp
+// Accuracy of the batch integrator against Aircraft (double, the reference). Flies a batch of
+// aircraft starting at increasing distances from the world origin, each with its own slowly varying
+// controls, through FlightBatch<double> and FlightBatch<float>, with and without the local origin,
+// and reports the worst position, altitude and speed error of each against the same aircraft
+// flown one by one. Exits 1 if FlightBatch<double> with absolute positions does not reproduce
+// Aircraft exactly, since then the two no longer run the same math.
+// Usage: FlightPrecision [--aircraft trainer|jet|cargo] [--minutes M] [--lanes N]
+// Example: FlightPrecision --aircraft cargo --minutes 60
+#include "AircraftFactory.h"
+#include "FlightBatch.h"
+#include "GlobalConfig.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+    const double kOffsets[] = { 0.0, 1e5, 1e6, 1e7 };     // ft from the world origin
+
+    struct Errors {
+        double position = 0.0, altitude = 0.0, speed = 0.0;
+    };
+
+    ControlInputs controlsAt(int lane, double time) {
+        ControlInputs controls;
+        controls.elevator = 0.1 * std::sin(time / (5.0 + lane));
+        controls.aileron = 0.3 * std::sin(time / (7.0 + 0.5 * lane));
+        controls.rudder = 0.2 * std::sin(time / (3.0 + 0.25 * lane));
+        controls.throttle = 0.5 + 0.3 * std::sin(time / 11.0);
+        controls.gearDown = false;
+        return controls;
+    }
+
+    template <typename T>
+    void runBatch(const char* label, double rebaseDistance, AircraftType type, int lanes, long steps,
+                  const std::vector<std::vector<Position3D>>& reference, const std::vector<std::vector<double>>& referenceSpeed,
+                  bool& exact) {
+        const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+        const double step = config.physicsTimeStep();
+        std::vector<Errors> worst(std::size(kOffsets));
+        auto prototype = AircraftFactory::createAircraft(type);
+        FlightBatch<T> batch(prototype->flightModel()->params());
+        batch.setRebaseDistance(rebaseDistance);
+        for (size_t o = 0; o < std::size(kOffsets); ++o) {
+            for (int lane = 0; lane < lanes; ++lane) {
+                auto aircraft = AircraftFactory::createAircraft(type);
+                aircraft->setPosition({ kOffsets[o], kOffsets[o] * 0.5, 3000.0 });
+                batch.add(*aircraft);
+            }
+        }
+        double time = 0.0;
+        for (long s = 0; s < steps; ++s) {
+            for (size_t i = 0; i < batch.size(); ++i) batch.setControls(i, controlsAt(static_cast<int>(i % lanes), time));
+            batch.step(step, config);
+            time += step;
+        }
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const size_t o = i / lanes;
+            const Position3D p = batch.position(i);
+            const Position3D& r = reference[o][i % lanes];
+            const BasicFlightState<T> state = batch.flightState(i);
+            const double speed = std::sqrt(double(state.velocityX) * state.velocityX + double(state.velocityY) * state.velocityY
+                                           + double(state.velocityZ) * state.velocityZ);
+            Errors& e = worst[o];
+            e.position = std::max(e.position, std::hypot(p.x - r.x, p.y - r.y));
+            e.altitude = std::max(e.altitude, std::abs(p.z - r.z));
+            e.speed = std::max(e.speed, std::abs(speed - referenceSpeed[o][i % lanes]));
+        }
+        for (size_t o = 0; o < std::size(kOffsets); ++o) {
+            std::printf("%-22s %10.0e %14.6g %12.6g %12.6g\n", label, kOffsets[o], worst[o].position, worst[o].altitude, worst[o].speed);
+            exact = exact && worst[o].position == 0.0 && worst[o].altitude == 0.0 && worst[o].speed == 0.0;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string aircraftName = "trainer";
+    double minutes = 30.0;
+    int lanes = 16;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--aircraft") == 0 && hasValue) aircraftName = argv[++i];
+        else if (std::strcmp(argv[i], "--minutes") == 0 && hasValue) minutes = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--lanes") == 0 && hasValue) lanes = std::atoi(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--aircraft trainer|jet|cargo] [--minutes M] [--lanes N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (minutes <= 0.0 || lanes <= 0) {
+        std::fprintf(stderr, "Need a positive duration and lane count\n");
+        return 1;
+    }
+    const AircraftType type = aircraftName == "jet" ? AircraftType::Jet
+                            : aircraftName == "cargo" ? AircraftType::Cargo : AircraftType::Trainer;
+    const ConfigSnapshot& config = GlobalConfig::instance().snapshot();
+    const double step = config.physicsTimeStep();
+    const long steps = static_cast<long>(minutes * 60.0 / step);
+
+    // The reference: every aircraft flown on its own, in double, with absolute positions.
+    std::vector<std::vector<Position3D>> reference(std::size(kOffsets));
+    std::vector<std::vector<double>> referenceSpeed(std::size(kOffsets));
+    for (size_t o = 0; o < std::size(kOffsets); ++o) {
+        for (int lane = 0; lane < lanes; ++lane) {
+            auto aircraft = AircraftFactory::createAircraft(type);
+            aircraft->setPosition({ kOffsets[o], kOffsets[o] * 0.5, 3000.0 });
+            double time = 0.0;
+            for (long s = 0; s < steps; ++s) {
+                aircraft->setControls(controlsAt(lane, time));
+                aircraft->update(step, config);
+                time += step;
+            }
+            reference[o].push_back(aircraft->position());
+            referenceSpeed[o].push_back(aircraft->speed());
+        }
+    }
+
+    std::printf("%d %s aircraft per offset, %.0f min at %.0f Hz; worst error against Aircraft (double)\n",
+                lanes, aircraftName.c_str(), minutes, 1.0 / step);
+    std::printf("%-22s %10s %14s %12s %12s\n", "batch", "offset ft", "position ft", "altitude ft", "speed");
+    const double absolute = std::numeric_limits<double>::infinity();
+    bool exact = true, ignored = true;
+    runBatch<double>("double, absolute", absolute, type, lanes, steps, reference, referenceSpeed, exact);
+    runBatch<double>("double, local origin", FlightBatch<double>::kDefaultRebaseDistance, type, lanes, steps, reference, referenceSpeed, ignored);
+    runBatch<float>("float, absolute", absolute, type, lanes, steps, reference, referenceSpeed, ignored);
+    runBatch<float>("float, local origin", FlightBatch<float>::kDefaultRebaseDistance, type, lanes, steps, reference, referenceSpeed, ignored);
+    if (!exact) {
+        std::printf("FAIL: FlightBatch<double> no longer reproduces Aircraft\n");
+        return 1;
+    }
+    return 0;
+}
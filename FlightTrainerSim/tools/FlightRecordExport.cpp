@@ -0,0 +1,46 @@
+// File: tools/FlightRecordExport.cpp
+// Converts a flight data recording (.fdr) to CSV.
+// Usage: FlightRecordExport <recording.fdr> [output.csv]
+#include "FlightRecorder.h"
+#include <cstdio>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <recording.fdr> [output.csv]\n", argv[0]);
+        return 1;
+    }
+
+    FlightRecordReader reader(argv[1]);
+    if (!reader.isOpen()) {
+        std::fprintf(stderr, "Cannot read flight recording: %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (argc >= 3) {
+        out = std::fopen(argv[2], "w");
+        if (!out) {
+            std::fprintf(stderr, "Cannot open output file: %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    std::fprintf(out, "# aircraft=%s scenario=%s trainee=%s start_ms=%lld time_step=%g records=%zu\n",
+                 reader.aircraftModel().c_str(), reader.scenarioName().c_str(), reader.traineeId().c_str(),
+                 static_cast<long long>(reader.header().startTimeMs), reader.header().timeStep, reader.size());
+    std::fprintf(out, "timestamp,x,y,altitude,heading,pitch,bank,velocity_x,velocity_y,velocity_z,"
+                      "speed,vertical_speed,thrust,drag,lift,elevator,aileron,rudder,throttle,flaps,"
+                      "fuel,scenario_progress,scenario_state,events\n");
+    for (const auto& r : reader) {
+        std::fprintf(out, "%.4f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.4f,%.4f,%.4f,%.4f,%.4f,%.2f,%.2f,%.2f,"
+                          "%.4f,%.4f,%.4f,%.4f,%.4f,%.3f,%.2f,%u,0x%02x\n",
+                     r.timestamp, r.x, r.y, r.altitude, r.heading, r.pitch, r.bank,
+                     r.velocityX, r.velocityY, r.velocityZ, r.speed, r.verticalSpeed,
+                     r.thrust, r.drag, r.lift, r.elevator, r.aileron, r.rudder, r.throttle, r.flaps,
+                     r.fuel, r.scenarioProgress, r.scenarioState, r.events);
+    }
+
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,216 @@
+// File: tools/FlightReplayRender.cpp
+// Renders the cockpit HUD and outside view of a recording to image sequences, without a display.
+// Frames are rendered in parallel, one renderer pair per worker thread.
+// Usage: FlightReplayRender <recording.fdr> -o <dir> [-v cockpit|outside|both] [-s 1280x720]
+//                           [-r fps] [-f png|raw] [-j threads] [--from s] [--to s]
+// Raw output is one file per view of back-to-back 32-bit frames, e.g. for ffmpeg:
+//   ffmpeg -f rawvideo -pix_fmt bgra -s 1280x720 -r 30 -i cockpit.raw cockpit.mp4
+#include "FlightRecorder.h"
+#include "RenderState.h"
+#include "Environment.h"
+#include "CockpitHudRenderer.h"
+#include "OutsideSceneRenderer.h"
+#include <QGuiApplication>
+#include <QFile>
+#include <QImage>
+#include <QPainter>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // Matches Aircraft::recordPosition(): one trail point every half second, the last 1000 kept.
+    constexpr double kPathInterval = 0.5;
+    constexpr size_t kPathLength = Aircraft::kFlightPathLength;
+    // PNG quality 80 maps to zlib level 1: much faster than the default for a modest size cost.
+    constexpr int kPngQuality = 80;
+
+    struct ReplayTrail {
+        std::vector<Position3D> points;
+        std::vector<double> times;
+    };
+
+    ReplayTrail buildTrail(const FlightRecordReader& reader) {
+        ReplayTrail trail;
+        double last = -kPathInterval;
+        for (const FlightRecord& record : reader) {
+            if (record.timestamp - last < kPathInterval) continue;
+            trail.points.push_back({ record.x, record.y, record.altitude });
+            trail.times.push_back(record.timestamp);
+            last = record.timestamp;
+        }
+        return trail;
+    }
+
+    AircraftRenderState stateAt(const FlightRecordReader& reader, double t) {
+        const FlightRecord* next = std::upper_bound(reader.begin(), reader.end(), t,
+            [](double time, const FlightRecord& record) { return time < record.timestamp; });
+        if (next == reader.begin()) return AircraftRenderState::fromRecord(*next);
+        if (next == reader.end()) return AircraftRenderState::fromRecord(*(next - 1));
+        const FlightRecord& prev = *(next - 1);
+        const double span = next->timestamp - prev.timestamp;
+        return AircraftRenderState::interpolate(AircraftRenderState::fromRecord(prev), AircraftRenderState::fromRecord(*next),
+                                                span > 0.0 ? (t - prev.timestamp) / span : 1.0);
+    }
+
+    bool parseSize(const char* text, int& width, int& height) {
+        return std::sscanf(text, "%dx%d", &width, &height) == 2 && width > 0 && height > 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string inputPath, outputDir, view = "both", format = "png";
+    int width = 1280, height = 720;
+    double fps = 30.0, from = 0.0, to = -1.0;
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    bool badArgs = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) outputDir = argv[++i];
+        else if (std::strcmp(argv[i], "-v") == 0 && i + 1 < argc) view = argv[++i];
+        else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc) badArgs |= !parseSize(argv[++i], width, height);
+        else if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc) fps = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "-f") == 0 && i + 1 < argc) format = argv[++i];
+        else if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--from") == 0 && i + 1 < argc) from = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--to") == 0 && i + 1 < argc) to = std::atof(argv[++i]);
+        else if (inputPath.empty()) inputPath = argv[i];
+        else badArgs = true;
+    }
+    const bool drawCockpit = view == "cockpit" || view == "both";
+    const bool drawOutside = view == "outside" || view == "both";
+    if (badArgs || inputPath.empty() || outputDir.empty() || fps <= 0.0 || (!drawCockpit && !drawOutside)
+        || (format != "png" && format != "raw")) {
+        std::fprintf(stderr, "Usage: %s <recording.fdr> -o <dir> [-v cockpit|outside|both] [-s 1280x720] "
+                             "[-r fps] [-f png|raw] [-j threads] [--from s] [--to s]\n", argv[0]);
+        return 1;
+    }
+
+    // Fonts need a QGuiApplication; the offscreen platform provides one without a display server.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    FlightRecordReader reader(inputPath);
+    if (!reader.isOpen() || reader.empty()) {
+        std::fprintf(stderr, "Cannot read flight recording: %s\n", inputPath.c_str());
+        return 1;
+    }
+    std::error_code ec;
+    fs::create_directories(outputDir, ec);
+    if (ec) {
+        std::fprintf(stderr, "Cannot create output directory %s: %s\n", outputDir.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    const double startTime = std::max(from, reader[0].timestamp);
+    const double endTime = to >= 0.0 ? std::min(to, reader[reader.size() - 1].timestamp) : reader[reader.size() - 1].timestamp;
+    if (endTime < startTime) {
+        std::fprintf(stderr, "Empty time range %.2f..%.2f s\n", startTime, endTime);
+        return 1;
+    }
+    const size_t frameCount = static_cast<size_t>(std::floor((endTime - startTime) * fps)) + 1;
+    const std::string aircraftModel = reader.aircraftModel();
+    const ReplayTrail trail = buildTrail(reader);
+    const Environment environment;
+
+    // Raw output is preallocated so workers can write their frames in place, in any order.
+    const qint64 frameBytes = static_cast<qint64>(width) * height * 4;
+    const std::string cockpitRaw = (fs::path(outputDir) / "cockpit.raw").string();
+    const std::string outsideRaw = (fs::path(outputDir) / "outside.raw").string();
+    if (format == "raw") {
+        for (const auto& [enabled, path] : { std::make_pair(drawCockpit, cockpitRaw), std::make_pair(drawOutside, outsideRaw) }) {
+            if (!enabled) continue;
+            QFile file(QString::fromStdString(path));
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || !file.resize(frameBytes * static_cast<qint64>(frameCount))) {
+                std::fprintf(stderr, "Cannot create %s\n", path.c_str());
+                return 1;
+            }
+        }
+    }
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    std::atomic<size_t> nextFrame(0), framesDone(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> workers;
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, frameCount));
+    for (unsigned t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&]() {
+            CockpitHudRenderer cockpit;
+            OutsideSceneRenderer outside(1);
+            cockpit.setAircraftModel(aircraftModel);
+            outside.setAircraftModel(aircraftModel);
+            outside.setEnvironment(&environment);
+            QImage image(width, height, QImage::Format_RGB32);
+            QFile cockpitFile(QString::fromStdString(cockpitRaw)), outsideFile(QString::fromStdString(outsideRaw));
+            if (format == "raw" && ((drawCockpit && !cockpitFile.open(QIODevice::ReadWrite))
+                                    || (drawOutside && !outsideFile.open(QIODevice::ReadWrite)))) {
+                failed = true;
+                return;
+            }
+            char name[64];
+            auto write = [&](QFile& rawFile, const char* prefix, size_t frame) {
+                if (format == "raw") {
+                    return rawFile.seek(frameBytes * static_cast<qint64>(frame))
+                        && rawFile.write(reinterpret_cast<const char*>(image.constBits()), frameBytes) == frameBytes;
+                }
+                std::snprintf(name, sizeof(name), "%s_%06zu.png", prefix, frame);
+                return image.save(QString::fromStdString((fs::path(outputDir) / name).string()), "PNG", kPngQuality);
+            };
+
+            for (;;) {
+                const size_t frame = nextFrame.fetch_add(1, std::memory_order_relaxed);
+                if (frame >= frameCount || failed.load(std::memory_order_relaxed)) break;
+                const double time = startTime + frame / fps;
+                const AircraftRenderState state = stateAt(reader, time);
+                if (drawCockpit) {
+                    cockpit.setRenderState(state);
+                    QPainter painter(&image);
+                    cockpit.render(painter, image.size(), 1.0);
+                    painter.end();
+                    if (!write(cockpitFile, "cockpit", frame)) failed = true;
+                }
+                if (drawOutside) {
+                    const size_t end = std::upper_bound(trail.times.begin(), trail.times.end(), time) - trail.times.begin();
+                    const size_t first = end > kPathLength ? end - kPathLength : 0;
+                    outside.setRenderState(state);
+                    outside.setFlightPath(trail.points.data() + first, end - first, first);
+                    QPainter painter(&image);
+                    outside.render(painter, image.size());
+                    painter.end();
+                    if (!write(outsideFile, "outside", frame)) failed = true;
+                }
+                framesDone.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    while (framesDone.load() < frameCount && !failed.load()) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        const size_t done = framesDone.load();
+        std::fprintf(stderr, "\r%zu/%zu frames, %.1f fps, %.1fx real time", done, frameCount,
+                     done / elapsed, done / fps / elapsed);
+    }
+    for (auto& worker : workers) worker.join();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    std::fprintf(stderr, "\n");
+    if (failed) {
+        std::fprintf(stderr, "Failed writing frames to %s\n", outputDir.c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "Rendered %zu frames (%.1f s of flight) on %u threads in %.2f s (%.1fx real time)\n",
+                 frameCount, (endTime - startTime), threadCount, elapsed, elapsed > 0.0 ? (endTime - startTime) / elapsed : 0.0);
+    if (format == "raw") {
+        std::fprintf(stderr, "Raw frames are %dx%d bgra at %g fps\n", width, height, fps);
+    }
+    return 0;
+}
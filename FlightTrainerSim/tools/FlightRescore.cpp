@@ -0,0 +1,172 @@
+// File: tools/FlightRescore.cpp
+// Re-runs DebriefReport over every recording below a directory and writes one CSV row per session.
+// Usage: FlightRescore <recordings-dir> [-o results.csv] [-i sessions.fsi] [-j threads]
+#include "FlightRecorder.h"
+#include "FlightMetrics.h"
+#include "SessionIndex.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct SessionResult {
+    bool valid = false;
+    std::string traineeId, aircraftModel, scenarioName;
+    long long startTimeMs = 0;
+    size_t recordCount = 0;
+    double flightTime = 0.0, overallScore = 0.0;
+    std::map<std::string, double> categoryScores;
+};
+
+static void rescore(const std::string& path, FlightMetrics& metrics, DebriefReport& report, SessionResult& out) {
+    FlightRecordReader reader(path);
+    if (!reader.isOpen()) return;
+    metrics.loadRecording(reader);
+    const double completion = reader.empty() ? 0.0
+        : DebriefReport::completionScore(static_cast<ScenarioState>(reader[reader.size() - 1].scenarioState),
+                                         reader[reader.size() - 1].scenarioProgress);
+    out.traineeId = reader.traineeId();
+    out.aircraftModel = reader.aircraftModel();
+    out.scenarioName = reader.scenarioName();
+    out.startTimeMs = reader.header().startTimeMs;
+    out.recordCount = reader.size();
+    report.generate(metrics, out.scenarioName, out.aircraftModel, completion);
+    out.flightTime = metrics.totalFlightTime();
+    out.overallScore = report.overallScore();
+    out.categoryScores = report.categoryScores();
+    out.valid = true;
+}
+
+static std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) return text;
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+int main(int argc, char* argv[]) {
+    std::string inputDir, outputPath, indexPath;
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) outputPath = argv[++i];
+        else if (std::strcmp(argv[i], "-i") == 0 && i + 1 < argc) indexPath = argv[++i];
+        else if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (inputDir.empty()) inputDir = argv[i];
+    }
+    if (inputDir.empty()) {
+        std::fprintf(stderr, "Usage: %s <recordings-dir> [-o results.csv] [-i sessions.fsi] [-j threads]\n", argv[0]);
+        return 1;
+    }
+
+    std::error_code ec;
+    std::vector<std::string> paths;
+    for (fs::recursive_directory_iterator it(inputDir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file() && it->path().extension() == ".fdr") paths.push_back(it->path().string());
+    }
+    if (ec) {
+        std::fprintf(stderr, "Cannot scan %s: %s\n", inputDir.c_str(), ec.message().c_str());
+        return 1;
+    }
+    std::sort(paths.begin(), paths.end());
+
+    // Workers claim small batches of sessions; each keeps its own metrics/report so their
+    // buffers are reused across sessions instead of reallocated.
+    const auto startTime = std::chrono::steady_clock::now();
+    std::vector<SessionResult> results(paths.size());
+    std::atomic<size_t> nextIndex(0);
+    constexpr size_t kBatchSize = 8;
+    std::vector<std::thread> workers;
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, std::max<size_t>(1, paths.size())));
+    for (unsigned t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&]() {
+            FlightMetrics metrics;
+            DebriefReport report;
+            for (;;) {
+                const size_t first = nextIndex.fetch_add(kBatchSize, std::memory_order_relaxed);
+                if (first >= paths.size()) break;
+                const size_t last = std::min(first + kBatchSize, paths.size());
+                for (size_t i = first; i < last; ++i) rescore(paths[i], metrics, report, results[i]);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::vector<std::string> categories;
+    for (const auto& result : results) {
+        for (const auto& entry : result.categoryScores) {
+            if (std::find(categories.begin(), categories.end(), entry.first) == categories.end())
+                categories.push_back(entry.first);
+        }
+    }
+
+    FILE* out = stdout;
+    if (!outputPath.empty()) {
+        out = std::fopen(outputPath.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "Cannot open output file: %s\n", outputPath.c_str());
+            return 1;
+        }
+    }
+    std::fprintf(out, "file,trainee,aircraft,scenario,start_ms,records,flight_time,overall");
+    for (const auto& category : categories) std::fprintf(out, ",%s", csvField(category).c_str());
+    std::fprintf(out, "\n");
+
+    size_t failed = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        if (!r.valid) {
+            ++failed;
+            continue;
+        }
+        std::fprintf(out, "%s,%s,%s,%s,%lld,%zu,%.2f,%.2f", csvField(paths[i]).c_str(), csvField(r.traineeId).c_str(),
+                     csvField(r.aircraftModel).c_str(), csvField(r.scenarioName).c_str(),
+                     r.startTimeMs, r.recordCount, r.flightTime, r.overallScore);
+        for (const auto& category : categories) {
+            auto it = r.categoryScores.find(category);
+            if (it != r.categoryScores.end()) std::fprintf(out, ",%.2f", it->second);
+            else std::fprintf(out, ",");
+        }
+        std::fprintf(out, "\n");
+    }
+    if (out != stdout) std::fclose(out);
+
+    if (!indexPath.empty()) {
+        SessionIndex index;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            if (!r.valid) continue;
+            SessionEntry entry;
+            entry.sessionFile = paths[i];
+            entry.traineeId = r.traineeId;
+            entry.aircraftModel = r.aircraftModel;
+            entry.scenarioName = r.scenarioName;
+            entry.startTimeMs = r.startTimeMs;
+            entry.flightTime = r.flightTime;
+            entry.overallScore = r.overallScore;
+            entry.categoryScores = r.categoryScores;
+            index.add(entry);
+        }
+        if (!index.save(indexPath)) {
+            std::fprintf(stderr, "Cannot write session index: %s\n", indexPath.c_str());
+            return 1;
+        }
+    }
+
+    std::fprintf(stderr, "Rescored %zu sessions (%zu unreadable) on %u threads in %.3f s (%.0f sessions/s)\n",
+                 results.size() - failed, failed, threadCount, elapsed,
+                 elapsed > 0.0 ? results.size() / elapsed : 0.0);
+    return failed == results.size() && !results.empty() ? 1 : 0;
+}
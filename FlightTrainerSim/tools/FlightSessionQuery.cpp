@@ -0,0 +1,90 @@
+// File: tools/FlightSessionQuery.cpp
+// Filters and aggregates the session index across trainees.
+// Usage: FlightSessionQuery <sessions.fsi> [--trainee ID] [--aircraft MODEL] [--scenario NAME]
+//        [--since YYYY-MM-DD] [--until YYYY-MM-DD] [--column NAME] [--group-by trainee|aircraft|scenario] [--list]
+// Example: FlightSessionQuery sessions.fsi --aircraft "C-130 Hercules" --scenario "Traffic Pattern"
+//          --since 2025-06-01 --column "Altitude Control"
+#include "SessionIndex.h"
+#include <QDate>
+#include <QDateTime>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+static bool parseDate(const char* text, bool endOfDay, int64_t& outMs) {
+    const QDate date = QDate::fromString(QString::fromUtf8(text), Qt::ISODate);
+    if (!date.isValid()) return false;
+    outMs = endOfDay ? date.endOfDay().toMSecsSinceEpoch() : date.startOfDay().toMSecsSinceEpoch();
+    return true;
+}
+
+static void printAggregate(const char* label, const SessionAggregate& agg) {
+    std::printf("%-32s count=%-8zu mean=%7.2f min=%7.2f max=%7.2f\n", label, agg.count, agg.mean, agg.min, agg.max);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <sessions.fsi> [--trainee ID] [--aircraft MODEL] [--scenario NAME]\n"
+                             "       [--since YYYY-MM-DD] [--until YYYY-MM-DD] [--column NAME]\n"
+                             "       [--group-by trainee|aircraft|scenario] [--list]\n", argv[0]);
+        return 1;
+    }
+
+    SessionFilter filter;
+    std::string column = SessionIndex::kOverallColumn;
+    std::string groupBy;
+    bool list = false;
+    for (int i = 2; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--trainee") == 0 && hasValue) filter.traineeId = argv[++i];
+        else if (std::strcmp(argv[i], "--aircraft") == 0 && hasValue) filter.aircraftModel = argv[++i];
+        else if (std::strcmp(argv[i], "--scenario") == 0 && hasValue) filter.scenarioName = argv[++i];
+        else if (std::strcmp(argv[i], "--column") == 0 && hasValue) column = argv[++i];
+        else if (std::strcmp(argv[i], "--group-by") == 0 && hasValue) groupBy = argv[++i];
+        else if (std::strcmp(argv[i], "--list") == 0) list = true;
+        else if (std::strcmp(argv[i], "--since") == 0 && hasValue) {
+            if (!parseDate(argv[++i], false, filter.fromTimeMs)) { std::fprintf(stderr, "Bad date: %s\n", argv[i]); return 1; }
+        }
+        else if (std::strcmp(argv[i], "--until") == 0 && hasValue) {
+            if (!parseDate(argv[++i], true, filter.toTimeMs)) { std::fprintf(stderr, "Bad date: %s\n", argv[i]); return 1; }
+        }
+        else {
+            std::fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    SessionIndex index;
+    if (!index.load(argv[1])) {
+        std::fprintf(stderr, "Cannot read session index: %s\n", argv[1]);
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (list) {
+        for (size_t row : index.select(filter)) {
+            const SessionEntry e = index.entry(row);
+            std::printf("%s  %-12s %-22s %-24s %s=%.1f\n",
+                        QDateTime::fromMSecsSinceEpoch(e.startTimeMs).toString(Qt::ISODate).toStdString().c_str(),
+                        e.traineeId.c_str(), e.aircraftModel.c_str(), e.scenarioName.c_str(),
+                        SessionIndex::kOverallColumn, e.overallScore);
+        }
+    }
+    else if (!groupBy.empty()) {
+        SessionGroupBy group = SessionGroupBy::Trainee;
+        if (groupBy == "aircraft") group = SessionGroupBy::Aircraft;
+        else if (groupBy == "scenario") group = SessionGroupBy::Scenario;
+        else if (groupBy != "trainee") {
+            std::fprintf(stderr, "Unknown group: %s\n", groupBy.c_str());
+            return 1;
+        }
+        for (const auto& [name, agg] : index.aggregateBy(group, column, filter)) printAggregate(name.c_str(), agg);
+    }
+    else {
+        printAggregate(column.c_str(), index.aggregate(column, filter));
+    }
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%zu sessions indexed, query took %.3f ms\n", index.size(), elapsedMs);
+    return 0;
+}
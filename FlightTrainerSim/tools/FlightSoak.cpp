@@ -0,0 +1,219 @@
+// File: tools/FlightSoak.cpp
+// Long-session soak test: flies one aircraft headless for simulated hours as fast as the CPU
+// allows, running the same per-tick subsystems as the simulator. Each window of simulated time
+// reports resident memory, heap allocations per subsystem and tick latency percentiles. Exits 1 if
+// memory grows, allocations persist or latency drifts past the budgets once the first window
+// (warm-up) is over.
+// Usage: FlightSoak [--hours H] [--aircraft trainer|jet|cargo] [--scenario NAME] [--rate HZ]
+//        [--window MIN] [--rss-budget MB] [--drift-budget X] [--alloc-budget N]
+// Example: FlightSoak --hours 8 --aircraft cargo --window 60
+#include "AllocCounter.h"
+#include "AircraftFactory.h"
+#include "FlightMetrics.h"
+#include "FlightRecorder.h"
+#include "FrameArena.h"
+#include "GlobalConfig.h"
+#include "PilotAgent.h"
+#include "TrainingScenario.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+// Every heap allocation in the process is charged to the subsystem running on that thread.
+namespace {
+    enum Subsystem { Harness, Agent, Physics, Scenario, Metrics, Recorder, SubsystemCount };
+    const char* const kSubsystemNames[SubsystemCount] = { "harness", "agent", "physics", "scenario", "metrics", "recorder" };
+    static_assert(SubsystemCount <= kMaxAllocTags, "one allocation tag per subsystem");
+
+    // Resident set size in bytes, or 0 where the platform is not supported.
+    size_t residentBytes() {
+#if defined(__linux__)
+        FILE* statm = std::fopen("/proc/self/statm", "r");
+        if (!statm) return 0;
+        unsigned long pages = 0, resident = 0;
+        const bool ok = std::fscanf(statm, "%lu %lu", &pages, &resident) == 2;
+        std::fclose(statm);
+        return ok ? resident * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#elif defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.WorkingSetSize : 0;
+#else
+        return 0;
+#endif
+    }
+
+    struct Window {
+        double endHours = 0.0;
+        double rssMb = 0.0;
+        size_t snapshots = 0;
+        uint64_t allocations[SubsystemCount] = {};
+        double p50Us = 0.0, p99Us = 0.0, maxUs = 0.0;
+    };
+
+    double percentileUs(std::vector<uint32_t>& ns, double quantile) {
+        auto nth = ns.begin() + static_cast<ptrdiff_t>(quantile * (ns.size() - 1));
+        std::nth_element(ns.begin(), nth, ns.end());
+        return *nth / 1000.0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string aircraftName = "cargo", scenarioName = "IFR Basic Navigation";
+    double hours = 8.0, rateHz = 0.0, windowMinutes = 30.0;
+    double rssBudgetMb = 16.0, driftBudget = 2.0, allocBudget = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--hours") == 0 && hasValue) hours = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--aircraft") == 0 && hasValue) aircraftName = argv[++i];
+        else if (std::strcmp(argv[i], "--scenario") == 0 && hasValue) scenarioName = argv[++i];
+        else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) rateHz = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--window") == 0 && hasValue) windowMinutes = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--rss-budget") == 0 && hasValue) rssBudgetMb = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--drift-budget") == 0 && hasValue) driftBudget = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--alloc-budget") == 0 && hasValue) allocBudget = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--hours H] [--aircraft trainer|jet|cargo] [--scenario NAME] [--rate HZ]\n"
+                                 "       [--window MIN] [--rss-budget MB] [--drift-budget X] [--alloc-budget N]\n", argv[0]);
+            return 1;
+        }
+    }
+    AircraftType type;
+    if (!AircraftFactory::typeForKey(aircraftName, type)) {
+        std::fprintf(stderr, "Unknown aircraft: %s\n", aircraftName.c_str());
+        return 1;
+    }
+    auto scenario = TrainingScenario::builtin(scenarioName);
+    if (!scenario || hours <= 0.0 || windowMinutes <= 0.0 || windowMinutes * 60.0 > hours * 3600.0) {
+        std::fprintf(stderr, "Need a known scenario, and at least one %.0f-minute window in %.1f h\n", windowMinutes, hours);
+        return 1;
+    }
+
+    auto& globalConfig = GlobalConfig::instance();
+    if (rateHz > 0.0) globalConfig.setUpdateRate(rateHz);
+    const ConfigSnapshot& config = globalConfig.snapshot();
+    const double deltaTime = config.physicsTimeStep();
+    const long ticksPerWindow = std::max(1L, static_cast<long>(windowMinutes * 60.0 / deltaTime));
+    const long windowCount = static_cast<long>(hours * 60.0 / windowMinutes);
+
+    auto aircraft = AircraftFactory::createAircraft(type);
+    FlightMetrics metrics;
+    metrics.reserve(hours * 3600.0, deltaTime);
+    // A ferry leg: hold altitude, track and speed for the whole session.
+    AutopilotTargets targets;
+    targets.altitudeHold = targets.headingHold = targets.speedHold = true;
+    targets.altitude = 3000.0;
+    targets.heading = 90.0;
+    targets.speed = 80.0;
+    AutopilotAgent agent(targets);
+
+    std::vector<uint32_t> tickNs(static_cast<size_t>(ticksPerWindow));
+    std::vector<Window> windows;
+    windows.reserve(static_cast<size_t>(windowCount));
+
+    std::printf("%7s %8s %10s", "sim h", "RSS MB", "snapshots");
+    for (int s = Agent; s < SubsystemCount; ++s) std::printf(" %9s", kSubsystemNames[s]);
+    std::printf(" %9s %9s %9s\n", "p50 us", "p99 us", "max us");
+
+    double simulationTime = 0.0;
+    const auto wallStart = std::chrono::steady_clock::now();
+    for (long w = 0; w < windowCount; ++w) {
+        uint64_t allocationsBefore[SubsystemCount];
+        for (int s = 0; s < SubsystemCount; ++s) allocationsBefore[s] = allocationCount(s);
+        for (long t = 0; t < ticksPerWindow; ++t) {
+            const auto tickStart = std::chrono::steady_clock::now();
+            FrameArena::current().reset();
+            {
+                AllocScope scope(Agent);
+                ControlInputs controls = aircraft->controls();
+                agent.control(*aircraft, scenario.get(), deltaTime, controls);
+                aircraft->setControls(controls);
+            }
+            {
+                AllocScope scope(Physics);
+                aircraft->update(deltaTime, config);
+                // The flight models burn a tank in minutes; keep it topped up so the leg lasts.
+                if (aircraft->fuel() < 500.0) aircraft->setFuel(1000.0);
+            }
+            {
+                AllocScope scope(Scenario);
+                scenario->update(*aircraft, deltaTime);
+            }
+            {
+                AllocScope scope(Metrics);
+                metrics.recordSnapshot(*aircraft, simulationTime);
+            }
+            {
+                AllocScope scope(Recorder);
+                const FlightRecord record = FlightRecorder::capture(*aircraft, *scenario, simulationTime, 0);
+                (void)record;
+            }
+            simulationTime += deltaTime;
+            tickNs[static_cast<size_t>(t)] = static_cast<uint32_t>(std::min<int64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tickStart).count(), UINT32_MAX));
+        }
+
+        Window window;
+        window.endHours = simulationTime / 3600.0;
+        window.rssMb = residentBytes() / (1024.0 * 1024.0);
+        window.snapshots = metrics.snapshots().size();
+        for (int s = 0; s < SubsystemCount; ++s) window.allocations[s] = allocationCount(s) - allocationsBefore[s];
+        window.p50Us = percentileUs(tickNs, 0.5);
+        window.p99Us = percentileUs(tickNs, 0.99);
+        window.maxUs = *std::max_element(tickNs.begin(), tickNs.end()) / 1000.0;
+        windows.push_back(window);
+
+        std::printf("%7.2f %8.1f %10zu", window.endHours, window.rssMb, window.snapshots);
+        for (int s = Agent; s < SubsystemCount; ++s) std::printf(" %9llu", static_cast<unsigned long long>(window.allocations[s]));
+        std::printf(" %9.2f %9.2f %9.1f\n", window.p50Us, window.p99Us, window.maxUs);
+        std::fflush(stdout);
+    }
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    std::printf("%.1f h simulated in %.1f s (%.0fx real time)\n", simulationTime / 3600.0, wallSeconds, simulationTime / wallSeconds);
+
+    // Budgets are measured from the end of the warm-up window.
+    if (windows.size() < 2) {
+        std::printf("Only one window: nothing to compare against warm-up\n");
+        return 0;
+    }
+    bool failed = false;
+    const Window& warmUp = windows.front();
+    const Window& baseline = windows[1];
+    const Window& last = windows.back();
+    const double rssGrowth = last.rssMb - warmUp.rssMb;
+    if (warmUp.rssMb > 0.0 && rssGrowth > rssBudgetMb) {
+        std::printf("FAIL: RSS grew %.1f MB after warm-up (budget %.1f MB)\n", rssGrowth, rssBudgetMb);
+        failed = true;
+    }
+    uint64_t steadyAllocations = 0;
+    for (size_t w = 1; w < windows.size(); ++w) {
+        for (int s = Agent; s < SubsystemCount; ++s) steadyAllocations += windows[w].allocations[s];
+    }
+    const double allocationsPerTick = static_cast<double>(steadyAllocations) / (ticksPerWindow * static_cast<double>(windows.size() - 1));
+    if (allocationsPerTick > allocBudget) {
+        std::printf("FAIL: %.4f allocations per tick after warm-up (budget %.4f)\n", allocationsPerTick, allocBudget);
+        failed = true;
+    }
+    // Last window against the first one after warm-up.
+    const double p50Drift = last.p50Us / std::max(baseline.p50Us, 0.001);
+    const double p99Drift = last.p99Us / std::max(baseline.p99Us, 0.001);
+    if (p50Drift > driftBudget || p99Drift > driftBudget) {
+        std::printf("FAIL: tick latency drifted %.2fx (p50) / %.2fx (p99) (budget %.2fx)\n", p50Drift, p99Drift, driftBudget);
+        failed = true;
+    }
+    std::printf("%s: RSS %+.1f MB, %.4f allocations/tick, p50 drift %.2fx, p99 drift %.2fx\n", failed ? "FAIL" : "PASS",
+                rssGrowth, allocationsPerTick, p50Drift, p99Drift);
+    return failed ? 1 : 0;
+}
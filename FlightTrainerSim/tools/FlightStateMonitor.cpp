@@ -0,0 +1,83 @@
+// File: tools/FlightStateMonitor.cpp
+// Follows the state the running simulator publishes to shared memory, as an instructor station or
+// extra display would, and reports how stale each sample was when read.
+// Usage: FlightStateMonitor [--key NAME] [--rate HZ] [--count N] [--quiet]
+// Example: FlightStateMonitor --rate 60 --count 600 --quiet
+#include "SharedFlightState.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char* statusName(SharedSimStatus status) {
+    switch (status) {
+    case SharedSimStatus::Running: return "running";
+    case SharedSimStatus::Paused: return "paused";
+    default: return "stopped";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string key = kDefaultSharedStateKey;
+    double rateHz = 10.0;
+    long count = 0;
+    bool quiet = false;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--key") == 0 && hasValue) key = argv[++i];
+        else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) rateHz = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--count") == 0 && hasValue) count = std::atol(argv[++i]);
+        else if (std::strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else {
+            std::fprintf(stderr, "Usage: %s [--key NAME] [--rate HZ] [--count N] [--quiet]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (rateHz <= 0.0) rateHz = 10.0;
+
+    SharedStateReader reader;
+    while (!reader.attach(key)) {
+        std::fprintf(stderr, "Waiting for simulator to publish '%s'...\n", key.c_str());
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    const auto period = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / rateHz));
+    auto next = std::chrono::steady_clock::now();
+    std::vector<double> agesUs;
+    unsigned retries = 0;
+    uint64_t lastTick = 0;
+    long samples = 0, failed = 0;
+    while (count <= 0 || samples + failed < count) {
+        SharedFlightState state;
+        if (!reader.read(state, &retries)) {
+            ++failed;
+        } else {
+            ++samples;
+            const double ageUs = (SharedFlightState::nowNs() - state.publishNs) / 1000.0;
+            // Only a running simulator is expected to be fresh. Polling well above the tick rate makes
+            // this the publish-to-read latency; at lower rates it also includes time since the tick.
+            if (state.status == SharedSimStatus::Running && state.tick != lastTick) agesUs.push_back(ageUs);
+            lastTick = state.tick;
+            if (!quiet) {
+                const FlightRecord& r = state.record;
+                std::printf("%-8s %-22s t=%8.2fs alt=%7.1f spd=%6.1f hdg=%5.1f pitch=%5.1f bank=%6.1f age=%8.1fus\n",
+                            statusName(state.status), state.aircraftModel, r.timestamp, r.altitude, r.speed, r.heading,
+                            r.pitch, r.bank, ageUs);
+            }
+        }
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+
+    std::printf("samples=%ld failed=%ld torn-retries=%u\n", samples, failed, retries);
+    if (!agesUs.empty()) {
+        std::sort(agesUs.begin(), agesUs.end());
+        auto at = [&](double q) { return agesUs[static_cast<size_t>(q * (agesUs.size() - 1))]; };
+        std::printf("age of newly seen ticks: p50=%.1fus p99=%.1fus max=%.1fus\n", at(0.5), at(0.99), agesUs.back());
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+// File: tools/FlightTrim.cpp
+// Builds (or loads) the cached trim tables and reports them: how long the table took, how many
+// grid conditions trim, and the trimmed speed band at each altitude in level flight. With a
+// condition it solves that one instead, then flies the aircraft hands-off from it, with fuel kept
+// topped up, and reports how far altitude and speed drift from the trimmed path. Level trims hold
+// it; climbs and descents wander off as the air density changes along the way.
+// Usage: FlightTrim [--aircraft trainer|jet|cargo] [--cache DIR] [--rebuild]
+//        [--altitude FT --speed V [--gamma DEG] [--flaps F] [--verify S]]
+// Example: FlightTrim --aircraft jet --altitude 30000 --speed 250 --verify 60
+#include "AircraftFactory.h"
+#include "GlobalConfig.h"
+#include "TrimSolver.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string aircraftFilter;
+    bool rebuild = false, single = false;
+    TrimCondition condition;
+    double verifySeconds = 60.0;
+    GlobalConfig& globalConfig = GlobalConfig::instance();
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--aircraft") == 0 && hasValue) aircraftFilter = argv[++i];
+        else if (std::strcmp(argv[i], "--cache") == 0 && hasValue) globalConfig.setCacheDirectory(argv[++i]);
+        else if (std::strcmp(argv[i], "--rebuild") == 0) rebuild = true;
+        else if (std::strcmp(argv[i], "--altitude") == 0 && hasValue) { condition.altitude = std::atof(argv[++i]); single = true; }
+        else if (std::strcmp(argv[i], "--speed") == 0 && hasValue) { condition.speed = std::atof(argv[++i]); single = true; }
+        else if (std::strcmp(argv[i], "--gamma") == 0 && hasValue) condition.flightPathAngle = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--flaps") == 0 && hasValue) condition.flaps = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--verify") == 0 && hasValue) verifySeconds = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--aircraft trainer|jet|cargo] [--cache DIR] [--rebuild]\n"
+                                 "       [--altitude FT --speed V [--gamma DEG] [--flaps F] [--verify S]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const ConfigSnapshot& config = globalConfig.snapshot();
+    int runs = 0, failures = 0;
+    for (const auto& entry : AircraftFactory::kKeys) {
+        if (!aircraftFilter.empty() && aircraftFilter != entry.key) continue;
+        ++runs;
+        auto aircraft = AircraftFactory::createAircraft(entry.type);
+        const IFlightModel& model = *aircraft->flightModel();
+        const std::string path = TrimTable::cachePath(model);
+        if (rebuild) std::remove(path.c_str());
+
+        const auto start = std::chrono::steady_clock::now();
+        const TrimTable& table = TrimTable::forModel(model, config);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%s: %zu of %zu conditions trimmed, table ready in %.1f ms (%s)\n", model.getModelName().c_str(),
+                    table.trimmedCount(), table.cellCount(), ms, path.c_str());
+
+        if (!single) {
+            for (double altitude = 0.0; altitude <= 40000.0; altitude += 10000.0) {
+                double slowest, fastest;
+                if (table.speedRange(altitude, 0.0, 0.0, slowest, fastest)) {
+                    std::printf("  %6.0f ft level: %6.1f to %6.1f\n", altitude, slowest, fastest);
+                }
+                else std::printf("  %6.0f ft level: no trim\n", altitude);
+            }
+            continue;
+        }
+
+        const auto solveStart = std::chrono::steady_clock::now();
+        const TrimResult trim = table.lookup(condition, config);
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - solveStart).count();
+        if (!trim.trimmed) {
+            std::printf("  %.0f ft, %.1f, %.1f deg, flaps %.2f: cannot trim (residual %.3g)\n", condition.altitude,
+                        condition.speed, condition.flightPathAngle, condition.flaps, trim.residual);
+            ++failures;
+            continue;
+        }
+        std::printf("  throttle %.4f, elevator %+.4f after %d iteration(s) in %.1f us\n", trim.throttle, trim.elevator,
+                    trim.iterations, us);
+
+        TrimSolver::apply(*aircraft, trim, config);
+        const double climb = condition.speed * std::sin(condition.flightPathAngle * 3.14159265358979323846 / 180.0);
+        const double step = config.physicsTimeStep();
+        for (double t = 0.0; t < verifySeconds; t += step) {
+            aircraft->setFuel(1000.0);
+            aircraft->update(step, config);
+        }
+        const double expectedAltitude = condition.altitude + climb * verifySeconds;
+        std::printf("  after %.0f s hands-off: altitude %+.2f ft, speed %+.3f from the trimmed path\n", verifySeconds,
+                    aircraft->altitude() - expectedAltitude, aircraft->speed() - condition.speed);
+    }
+    if (runs == 0) {
+        std::fprintf(stderr, "No aircraft matched\n");
+        return 1;
+    }
+    return failures ? 1 : 0;
+}